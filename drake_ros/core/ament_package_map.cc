@@ -0,0 +1,226 @@
+#include "drake_ros/core/ament_package_map.h"
+
+#include <unistd.h>
+
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <map>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <system_error>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <ament_index_cpp/get_search_paths.hpp>
+#include <drake/common/drake_throw.h>
+
+#include "internal_ament_package_map.h"  // NOLINT(build/include)
+
+namespace drake_ros {
+namespace core {
+namespace {
+
+namespace fs = std::filesystem;
+
+// Location of the package index within an ament prefix.
+constexpr char kPackageIndexPath[] =
+    "share/ament_index/resource_index/packages";
+
+struct AmentPackages {
+  // Package share directories, by package name.
+  std::map<std::string, std::string> directories;
+  // Package names, by package share directory.
+  std::unordered_map<std::string, std::string> names;
+};
+
+// Computes a key that changes whenever the ament index may have changed,
+// i.e. whenever prefixes change or packages are (un)installed in them.
+std::string CalcCacheKey(const std::vector<std::string>& prefixes) {
+  std::stringstream key;
+  for (const std::string& prefix : prefixes) {
+    key << prefix << '\t';
+    std::error_code error;
+    const fs::file_time_type last_write_time =
+        fs::last_write_time(fs::path(prefix) / kPackageIndexPath, error);
+    if (error) {
+      key << '-';
+    } else {
+      key << last_write_time.time_since_epoch().count();
+    }
+    key << '\n';
+  }
+  return key.str();
+}
+
+std::optional<fs::path> GetCacheDirectory() {
+  const char* xdg_cache_home = std::getenv("XDG_CACHE_HOME");
+  if (xdg_cache_home != nullptr && *xdg_cache_home != '\0') {
+    return fs::path(xdg_cache_home) / "drake_ros";
+  }
+  const char* home = std::getenv("HOME");
+  if (home != nullptr && *home != '\0') {
+    return fs::path(home) / ".cache" / "drake_ros";
+  }
+  return std::nullopt;
+}
+
+// Cache files are made of the cache key, an empty line, and then one line
+// per package with its name and share directory separated by a tab.
+bool LoadCache(const fs::path& cache_path, const std::string& key,
+               std::map<std::string, std::string>* directories) {
+  std::ifstream cache_file(cache_path);
+  if (!cache_file) {
+    return false;
+  }
+  const std::string content{std::istreambuf_iterator<char>(cache_file),
+                            std::istreambuf_iterator<char>()};
+  if (content.size() <= key.size() || content.compare(0, key.size(), key) ||
+      content[key.size()] != '\n') {
+    return false;
+  }
+  std::stringstream lines(content.substr(key.size() + 1));
+  std::string line;
+  while (std::getline(lines, line)) {
+    const size_t separator = line.find('\t');
+    if (separator == std::string::npos) {
+      directories->clear();
+      return false;
+    }
+    directories->emplace(line.substr(0, separator),
+                         line.substr(separator + 1));
+  }
+  return true;
+}
+
+void StoreCache(const fs::path& cache_path, const std::string& key,
+                const std::map<std::string, std::string>& directories) {
+  std::error_code error;
+  fs::create_directories(cache_path.parent_path(), error);
+  if (error) {
+    return;
+  }
+  // Write and then rename, so that concurrent processes never read a
+  // partially written cache.
+  fs::path temporary_path = cache_path;
+  temporary_path += "." + std::to_string(getpid()) + ".tmp";
+  {
+    std::ofstream cache_file(temporary_path);
+    cache_file << key << '\n';
+    for (const auto& [name, directory] : directories) {
+      cache_file << name << '\t' << directory << '\n';
+    }
+    if (!cache_file) {
+      cache_file.close();
+      fs::remove(temporary_path, error);
+      return;
+    }
+  }
+  fs::rename(temporary_path, cache_path, error);
+  if (error) {
+    fs::remove(temporary_path, error);
+  }
+}
+
+// Crawls the ament index of `prefixes`, as ament_index_cpp does.
+std::map<std::string, std::string> CrawlAmentIndex(
+    const std::vector<std::string>& prefixes) {
+  std::map<std::string, std::string> directories;
+  for (const std::string& prefix : prefixes) {
+    std::error_code error;
+    for (const fs::directory_entry& entry : fs::directory_iterator(
+             fs::path(prefix) / kPackageIndexPath, error)) {
+      const std::string name = entry.path().filename().string();
+      if (name.empty() || name[0] == '.' || !entry.is_regular_file(error)) {
+        continue;
+      }
+      // N.B. Earlier prefixes take precedence.
+      const fs::path directory = fs::path(prefix) / "share" / name;
+      directories.emplace(name, directory.lexically_normal().string());
+    }
+  }
+  return directories;
+}
+
+AmentPackages LoadAmentPackages() {
+  AmentPackages packages;
+  packages.directories = internal::LoadAmentPackageDirectories(
+      ament_index_cpp::get_search_paths(), GetCacheDirectory());
+  for (const auto& [name, directory] : packages.directories) {
+    packages.names[directory] = name;
+  }
+  return packages;
+}
+
+const AmentPackages& GetAmentPackages() {
+  // N.B. Static initialization is thread-safe, and is retried if it throws.
+  static const AmentPackages* const packages =
+      new AmentPackages(LoadAmentPackages());
+  return *packages;
+}
+
+}  // namespace
+
+namespace internal {
+std::map<std::string, std::string> LoadAmentPackageDirectories(
+    const std::vector<std::string>& prefixes,
+    const std::optional<fs::path>& cache_directory) {
+  const std::string key = CalcCacheKey(prefixes);
+  std::optional<fs::path> cache_path;
+  if (cache_directory) {
+    std::stringstream file_name;
+    file_name << "ament_packages_" << std::hex << std::hash<std::string>{}(key)
+              << ".cache";
+    cache_path = *cache_directory / file_name.str();
+  }
+
+  std::map<std::string, std::string> directories;
+  if (!cache_path || !LoadCache(*cache_path, key, &directories)) {
+    directories = CrawlAmentIndex(prefixes);
+    if (cache_path) {
+      StoreCache(*cache_path, key, directories);
+    }
+  }
+  return directories;
+}
+}  // namespace internal
+
+const std::map<std::string, std::string>& GetAmentPackageDirectories() {
+  return GetAmentPackages().directories;
+}
+
+void PopulatePackageMapFromAmentIndex(
+    drake::multibody::PackageMap* package_map) {
+  DRAKE_THROW_UNLESS(package_map != nullptr);
+  for (const auto& [name, directory] : GetAmentPackageDirectories()) {
+    std::error_code error;
+    if (!package_map->Contains(name) && fs::is_directory(directory, error)) {
+      package_map->Add(name, directory);
+    }
+  }
+}
+
+std::optional<std::string> GetAmentPackageUri(const std::string& path) {
+  const fs::path file_path = fs::path(path).lexically_normal();
+  if (!file_path.is_absolute()) {
+    return std::nullopt;
+  }
+  const AmentPackages& packages = GetAmentPackages();
+  // Look up every parent directory, innermost first.
+  for (fs::path directory = file_path.parent_path();
+       directory != directory.root_path();
+       directory = directory.parent_path()) {
+    auto it = packages.names.find(directory.string());
+    if (it != packages.names.end()) {
+      return "package://" + it->second + "/" +
+             file_path.lexically_relative(directory).generic_string();
+    }
+  }
+  return std::nullopt;
+}
+}  // namespace core
+}  // namespace drake_ros
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <map>
+#include <optional>
+#include <string>
+
+#include <drake/multibody/parsing/package_map.h>
+
+namespace drake_ros {
+namespace core {
+/** Returns the location of all packages in the ament index, as a map from
+ package name to package share directory.
+
+ The ament index is crawled once per process, on first call. Crawl results
+ are also cached on disk, under `$XDG_CACHE_HOME/drake_ros` or
+ `$HOME/.cache/drake_ros` if XDG_CACHE_HOME is not set, and keyed on the
+ AMENT_PREFIX_PATH contents: the prefixes it lists and the last time
+ packages were (un)installed in each. Thus subsequent processes skip the
+ crawl altogether until the ament index changes. Failure to read or write
+ the disk cache is not an error. This function is thread-safe.
+
+ @throws std::runtime_error if AMENT_PREFIX_PATH is not set.
+ */
+const std::map<std::string, std::string>& GetAmentPackageDirectories();
+
+/** Adds all packages in the ament index to a Drake `package_map`, so that
+ Drake's Parser can resolve `package://` URIs to them. Packages already in
+ the map are left as-is. See GetAmentPackageDirectories().
+
+ @throws std::runtime_error if AMENT_PREFIX_PATH is not set.
+ */
+void PopulatePackageMapFromAmentIndex(
+    drake::multibody::PackageMap* package_map);
+
+/** Returns a `package://` URI for the file at the given absolute `path`, if
+ it is within the share directory of a package in the ament index, and
+ std::nullopt otherwise. See GetAmentPackageDirectories().
+
+ @throws std::runtime_error if AMENT_PREFIX_PATH is not set.
+ */
+std::optional<std::string> GetAmentPackageUri(const std::string& path);
+}  // namespace core
+}  // namespace drake_ros
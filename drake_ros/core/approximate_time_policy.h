@@ -0,0 +1,246 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace drake_ros {
+namespace core {
+namespace internal {
+// An approximate time synchronization policy for N streams of stamped values,
+// following that of the ROS message_filters package.
+//
+// Values are buffered in per-stream queues. A set is emitted, one value per
+// stream, when no later set could have a smaller time spread. Sets are built
+// from values that are strictly newer than those in previously emitted sets,
+// and no set spans more than a given maximum interval. Unlike message_filters,
+// inter-message lower bounds are not supported, so a set may only be emitted
+// once every stream has received a value past the set.
+// This class is not thread-safe.
+// This class conforms to the ROS 2 C++ style for consistency.
+template <typename T>
+class ApproximateTimePolicy final {
+ public:
+  // A value along with its stamp, in nanoseconds.
+  struct Stamped {
+    int64_t stamp;
+    T value;
+  };
+
+  using Callback = std::function<void(std::vector<T>)>;
+
+  // Constructs a policy for `num_streams` streams, keeping at most
+  // `queue_size` values per stream, and penalizing older sets by
+  // `age_penalty` (as a fraction of their time spread).
+  ApproximateTimePolicy(size_t num_streams, size_t queue_size,
+                        int64_t max_interval_duration, double age_penalty,
+                        Callback callback)
+      : queue_size_(queue_size),
+        max_interval_duration_(max_interval_duration),
+        age_penalty_(age_penalty),
+        callback_(std::move(callback)),
+        deques_(num_streams),
+        past_(num_streams),
+        has_dropped_messages_(num_streams, false) {
+    if (num_streams < 2) {
+      throw std::invalid_argument("at least 2 streams are required");
+    }
+    if (queue_size == 0) {
+      throw std::invalid_argument("queue size must be positive");
+    }
+    if (age_penalty < 0.0) {
+      throw std::invalid_argument("age penalty must be non-negative");
+    }
+  }
+
+  // Adds a `value` stamped at `stamp` nanoseconds to the `i`-th stream.
+  void add(size_t i, int64_t stamp, T value) {
+    std::deque<Stamped>& deque = deques_.at(i);
+    deque.push_back({stamp, std::move(value)});
+    if (deque.size() == 1u) {
+      ++num_non_empty_deques_;
+      if (num_non_empty_deques_ == deques_.size()) {
+        process();
+      }
+    }
+    // Check whether there are more values than allowed in the queue.
+    if (deque.size() + past_[i].size() > queue_size_) {
+      // Cancel ongoing candidate search, if any.
+      num_non_empty_deques_ = 0;  // Recomputed from scratch below.
+      for (size_t j = 0; j < deques_.size(); ++j) {
+        recover(j);
+      }
+      // Drop the oldest value in the offending stream.
+      deque.pop_front();
+      has_dropped_messages_[i] = true;
+      if (deque.empty()) {
+        --num_non_empty_deques_;
+      }
+      if (has_pivot_) {
+        // The candidate may no longer be valid.
+        has_pivot_ = false;
+        process();
+      }
+    }
+  }
+
+ private:
+  // Moves the front value of the `i`-th stream to the past.
+  void dequeMoveFrontToPast(size_t i) {
+    past_[i].push_back(std::move(deques_[i].front()));
+    deques_[i].pop_front();
+    if (deques_[i].empty()) {
+      --num_non_empty_deques_;
+    }
+  }
+
+  // Drops the front value of the `i`-th stream.
+  void dequeDeleteFront(size_t i) {
+    deques_[i].pop_front();
+    if (deques_[i].empty()) {
+      --num_non_empty_deques_;
+    }
+  }
+
+  // Moves past values of the `i`-th stream back to its queue.
+  void recover(size_t i) {
+    std::vector<Stamped>& past = past_[i];
+    std::deque<Stamped>& deque = deques_[i];
+    while (!past.empty()) {
+      deque.push_front(std::move(past.back()));
+      past.pop_back();
+    }
+    if (!deque.empty()) {
+      ++num_non_empty_deques_;
+    }
+  }
+
+  // Makes a candidate out of the front values of every stream. Candidate
+  // values are not copied but kept at the front of each stream, and
+  // recovered from the past when published.
+  void makeCandidate() {
+    for (std::vector<Stamped>& past : past_) {
+      // Delete all past values, since a better candidate was found.
+      past.clear();
+    }
+  }
+
+  // Emits the current candidate, and drops it along with older values.
+  void publishCandidate() {
+    // Recover hidden values. Candidate values are then at the front.
+    num_non_empty_deques_ = 0;  // Recomputed from scratch below.
+    std::vector<T> values;
+    values.reserve(deques_.size());
+    for (size_t i = 0; i < deques_.size(); ++i) {
+      std::vector<Stamped>& past = past_[i];
+      std::deque<Stamped>& deque = deques_[i];
+      while (!past.empty()) {
+        deque.push_front(std::move(past.back()));
+        past.pop_back();
+      }
+      values.push_back(std::move(deque.front().value));
+      deque.pop_front();
+      if (!deque.empty()) {
+        ++num_non_empty_deques_;
+      }
+    }
+    has_pivot_ = false;
+    callback_(std::move(values));
+  }
+
+  // Returns the index and stamp of the earliest (if `end` is false) or the
+  // latest (if `end` is true) front value across streams.
+  std::pair<size_t, int64_t> getCandidateBoundary(bool end) const {
+    size_t index = 0;
+    int64_t stamp = deques_[0].front().stamp;
+    for (size_t i = 1; i < deques_.size(); ++i) {
+      const int64_t other_stamp = deques_[i].front().stamp;
+      if ((other_stamp < stamp) ^ end) {
+        index = i;
+        stamp = other_stamp;
+      }
+    }
+    return {index, stamp};
+  }
+
+  void process() {
+    // While no deque is empty.
+    while (num_non_empty_deques_ == deques_.size()) {
+      const auto [end_index, end_stamp] = getCandidateBoundary(true);
+      const auto [start_index, start_stamp] = getCandidateBoundary(false);
+      for (size_t i = 0; i < deques_.size(); ++i) {
+        if (i != end_index) {
+          // No dropped values before the candidate end for these streams.
+          has_dropped_messages_[i] = false;
+        }
+      }
+      if (!has_pivot_) {
+        // No candidate yet, the one at hand is the best so far.
+        if (end_stamp - start_stamp > max_interval_duration_) {
+          // This candidate spans too long, drop its earliest value.
+          dequeDeleteFront(start_index);
+          continue;
+        }
+        if (has_dropped_messages_[end_index]) {
+          // A value was dropped before the candidate end. A better candidate
+          // could have been built with it, so give up on this one.
+          dequeDeleteFront(start_index);
+          continue;
+        }
+        makeCandidate();
+        candidate_start_ = start_stamp;
+        candidate_end_ = end_stamp;
+        pivot_ = end_index;
+        pivot_stamp_ = end_stamp;
+        has_pivot_ = true;
+        dequeMoveFrontToPast(start_index);
+      } else {
+        if (static_cast<double>(end_stamp - candidate_end_) *
+                (1.0 + age_penalty_) >=
+            static_cast<double>(start_stamp - candidate_start_)) {
+          // Not better than the current candidate, move along.
+          dequeMoveFrontToPast(start_index);
+        } else {
+          // Better than the current candidate.
+          makeCandidate();
+          candidate_start_ = start_stamp;
+          candidate_end_ = end_stamp;
+          dequeMoveFrontToPast(start_index);
+        }
+      }
+      if (start_index == pivot_) {
+        // All possible candidates for this pivot have been explored.
+        publishCandidate();
+      } else if (static_cast<double>(end_stamp - candidate_end_) *
+                     (1.0 + age_penalty_) >=
+                 static_cast<double>(pivot_stamp_ - candidate_start_)) {
+        // No later candidate can do better.
+        publishCandidate();
+      }
+    }
+  }
+
+  const size_t queue_size_;
+  const int64_t max_interval_duration_;
+  const double age_penalty_;
+  const Callback callback_;
+
+  std::vector<std::deque<Stamped>> deques_;
+  std::vector<std::vector<Stamped>> past_;
+  std::vector<bool> has_dropped_messages_;
+  size_t num_non_empty_deques_{0};
+
+  // Time span of the current candidate, if any.
+  int64_t candidate_start_{0};
+  int64_t candidate_end_{0};
+  // Whether there is a candidate, and thus a pivot.
+  bool has_pivot_{false};
+  size_t pivot_{0};
+  int64_t pivot_stamp_{0};
+};
+}  // namespace internal
+}  // namespace core
+}  // namespace drake_ros
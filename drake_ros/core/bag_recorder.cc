@@ -0,0 +1,183 @@
+#include "drake_ros/core/bag_recorder.h"
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include <drake/common/drake_throw.h>
+#include <rclcpp/logger.hpp>
+#include <rclcpp/logging.hpp>
+#include <rosbag2_compression/compression_options.hpp>
+#include <rosbag2_compression/sequential_compression_writer.hpp>
+#include <rosbag2_cpp/converter_options.hpp>
+#include <rosbag2_cpp/writer.hpp>
+#include <rosbag2_cpp/writers/sequential_writer.hpp>
+#include <rosbag2_storage/storage_options.hpp>
+
+namespace drake_ros {
+namespace core {
+namespace {
+// A message pending writing.
+struct Entry {
+  std::string topic_name;
+  std::string type_name;
+  std::shared_ptr<const rclcpp::SerializedMessage> message;
+  rclcpp::Time time;
+};
+}  // namespace
+
+struct BagRecorder::Impl {
+  void WriteLoop() {
+    std::deque<Entry> batch;
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+      cv.wait(lock, [this]() { return stop || !queue.empty(); });
+      if (queue.empty()) {
+        break;  // stop requested and nothing left to write
+      }
+      batch.swap(queue);
+      cv.notify_all();  // wake up writers blocked on a full queue
+
+      lock.unlock();
+      std::exception_ptr write_error;
+      try {
+        for (const Entry& entry : batch) {
+          writer->write(entry.message, entry.topic_name, entry.type_name,
+                        entry.time);
+        }
+      } catch (...) {
+        write_error = std::current_exception();
+      }
+      const size_t num_written = batch.size();
+      batch.clear();
+      lock.lock();
+
+      num_pending -= num_written;
+      if (write_error) {
+        // Stop recording, dropping all pending messages, and leave the
+        // error to be rethrown by the next call.
+        error = write_error;
+        num_pending -= queue.size();
+        queue.clear();
+        cv.notify_all();
+        break;
+      }
+      cv.notify_all();
+    }
+  }
+
+  // Rethrows the error that stopped recording, if any. The lock on `mutex`
+  // must be held.
+  void RethrowErrorIfAny() {
+    if (error) {
+      error_reported = true;
+      std::rethrow_exception(error);
+    }
+  }
+
+  BagRecorderParams params;
+  std::unique_ptr<rosbag2_cpp::Writer> writer;
+
+  std::mutex mutex;
+  std::condition_variable cv;
+  // Messages not yet taken by the background thread.
+  std::deque<Entry> queue;
+  // Messages not yet written, queued or otherwise.
+  size_t num_pending{0};
+  bool stop{false};
+  // Error that stopped recording, if any.
+  std::exception_ptr error;
+  // Whether `error` was rethrown to the user.
+  bool error_reported{false};
+  std::thread thread;
+};
+
+BagRecorder::BagRecorder(const std::string& uri, BagRecorderParams params)
+    : impl_(new Impl()) {
+  impl_->params = std::move(params);
+
+  if (impl_->params.compression_format.empty()) {
+    impl_->writer = std::make_unique<rosbag2_cpp::Writer>(
+        std::make_unique<rosbag2_cpp::writers::SequentialWriter>());
+  } else {
+    rosbag2_compression::CompressionOptions compression_options;
+    compression_options.compression_format =
+        impl_->params.compression_format;
+    compression_options.compression_mode =
+        impl_->params.compress_files
+            ? rosbag2_compression::CompressionMode::FILE
+            : rosbag2_compression::CompressionMode::MESSAGE;
+    compression_options.compression_queue_size = 0;
+    compression_options.compression_threads = 1;
+    impl_->writer = std::make_unique<rosbag2_cpp::Writer>(
+        std::make_unique<rosbag2_compression::SequentialCompressionWriter>(
+            compression_options));
+  }
+
+  rosbag2_storage::StorageOptions storage_options;
+  storage_options.uri = uri;
+  storage_options.storage_id = impl_->params.storage_id;
+  rosbag2_cpp::ConverterOptions converter_options;
+  converter_options.input_serialization_format = "cdr";
+  converter_options.output_serialization_format = "cdr";
+  impl_->writer->open(storage_options, converter_options);
+
+  impl_->thread = std::thread(&Impl::WriteLoop, impl_.get());
+}
+
+BagRecorder::~BagRecorder() {
+  {
+    std::lock_guard<std::mutex> lock(impl_->mutex);
+    impl_->stop = true;
+  }
+  impl_->cv.notify_all();
+  impl_->thread.join();
+  // Close the bag before anything else goes away.
+  impl_->writer.reset();
+  if (impl_->error && !impl_->error_reported) {
+    // Destructors cannot throw, so the error is logged instead.
+    try {
+      std::rethrow_exception(impl_->error);
+    } catch (const std::exception& e) {
+      RCLCPP_ERROR(rclcpp::get_logger("drake_ros"),
+                   "Bag recording stopped early: %s", e.what());
+    } catch (...) {
+      RCLCPP_ERROR(rclcpp::get_logger("drake_ros"),
+                   "Bag recording stopped early: unknown error");
+    }
+  }
+}
+
+void BagRecorder::Write(
+    const std::string& topic_name, const std::string& type_name,
+    std::shared_ptr<const rclcpp::SerializedMessage> message,
+    const rclcpp::Time& time) {
+  DRAKE_THROW_UNLESS(message != nullptr);
+  {
+    std::unique_lock<std::mutex> lock(impl_->mutex);
+    if (impl_->params.max_queue_size > 0) {
+      impl_->cv.wait(lock, [this]() {
+        return impl_->error ||
+               impl_->queue.size() < impl_->params.max_queue_size;
+      });
+    }
+    impl_->RethrowErrorIfAny();
+    impl_->queue.push_back({topic_name, type_name, std::move(message), time});
+    ++impl_->num_pending;
+  }
+  impl_->cv.notify_all();
+}
+
+void BagRecorder::Flush() {
+  std::unique_lock<std::mutex> lock(impl_->mutex);
+  impl_->cv.wait(lock, [this]() { return impl_->num_pending == 0; });
+  impl_->RethrowErrorIfAny();
+}
+
+}  // namespace core
+}  // namespace drake_ros
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include <rclcpp/serialized_message.hpp>
+#include <rclcpp/time.hpp>
+
+#include "drake_ros/core/message_sink_interface.h"
+
+namespace drake_ros {
+namespace core {
+
+/** Set of parameters that configure a BagRecorder. */
+struct BagRecorderParams {
+  /** Storage plugin to use e.g. "sqlite3" (the default, as shipped with
+   rosbag2) or "mcap" (if the rosbag2_storage_mcap plugin is installed). */
+  std::string storage_id{"sqlite3"};
+
+  /** Compression format to use e.g. "zstd" (if the rosbag2_compression_zstd
+   plugin is installed). Empty to disable compression. */
+  std::string compression_format{};
+
+  /** Whether to compress whole files rather than individual messages.
+   Only applicable if compression is enabled. */
+  bool compress_files{true};
+
+  /** Maximum number of messages that may be pending writing. When full,
+   writes block until the background thread catches up. Zero for no
+   limit. */
+  size_t max_queue_size{0};
+};
+
+/** A message sink that records messages into a rosbag2 bag.
+
+ This sink is only available if rosbag2 is, and it is built as a library
+ of its own: `drake_ros_core_bag` in CMake, `//core:bag_recorder` in Bazel.
+
+ Messages are handed off to a background thread that writes them to
+ storage, so writes from the simulation loop only cost a queue insertion.
+ Serialized messages are kept, not copied, until written.
+
+ If storage fails, recording stops and pending messages are dropped. The
+ error is rethrown by the next call to Write() or Flush(), or else logged
+ when the recorder is destroyed.
+ */
+class BagRecorder final : public MessageSinkInterface {
+ public:
+  /** A constructor for the bag recorder.
+   @param[in] uri bag URI. Typically, a path to a directory that does not
+     exist yet.
+   @param[in] params optional recorder configuration.
+   */
+  explicit BagRecorder(const std::string& uri, BagRecorderParams params = {});
+
+  /** Writes all pending messages and closes the bag. */
+  ~BagRecorder() override;
+
+  /** Queues a message for recording.
+   @throws the error that stopped recording, if any.
+   */
+  void Write(const std::string& topic_name, const std::string& type_name,
+             std::shared_ptr<const rclcpp::SerializedMessage> message,
+             const rclcpp::Time& time) override;
+
+  /** Blocks until all messages written so far have been recorded.
+   @throws the error that stopped recording, if any.
+   */
+  void Flush();
+
+ private:
+  struct Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace core
+}  // namespace drake_ros
@@ -0,0 +1,332 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <rclcpp/serialized_message.hpp>
+
+namespace drake_ros {
+namespace core {
+
+/** Compile-time CDR codec for C++ ROS messages of `MessageT` type.
+
+ Specializations describe a message by listing its fields, in order, out
+ of which CdrEncoder and CdrDecoder put together (de)serialization code
+ that needs no typesupport introspection. Fields that are contiguous
+ sequences or arrays of primitives (or of flat messages, see below) are
+ copied in bulk, which brings encoding and decoding close to memcpy speed
+ for messages dominated by them.
+
+ A specialization for a message that has any non-flat field must derive
+ from StructCdrCodec and define:
+
+ @code{.cpp}
+ template <typename Stream, typename Message>
+ static void Visit(Stream* stream, Message& message) {
+   stream->Visit(message.first_field);
+   stream->Visit(message.second_field);
+ }
+ @endcode
+
+ where `Message` is `const MessageT` when encoding and `MessageT` when
+ decoding. A specialization for a message whose in-memory layout matches
+ its CDR layout (i.e. a message made of primitive fields of the same
+ size, or of other such messages) may derive from FlatCdrCodec instead,
+ so that it is copied in bulk too.
+
+ Specializations must be visible wherever CdrSerializer<MessageT> is used.
+ See cdr_message_codecs.h for those drake_ros provides. */
+template <typename MessageT>
+struct CdrCodec {
+  static constexpr bool kEnabled = false;
+};
+
+/** Base for codecs of messages with fields listed by a Visit() method. */
+struct StructCdrCodec {
+  static constexpr bool kEnabled = true;
+};
+
+/** Base for codecs of messages that can be copied in bulk.
+ @tparam Alignment CDR alignment of the message i.e. that of its largest
+   primitive field. */
+template <size_t Alignment>
+struct FlatCdrCodec {
+  static constexpr bool kEnabled = true;
+  static constexpr size_t kFlatAlignment = Alignment;
+};
+
+namespace internal {
+
+template <typename T>
+struct IsStdVector : std::false_type {};
+
+template <typename T, typename Allocator>
+struct IsStdVector<std::vector<T, Allocator>> : std::true_type {};
+
+template <typename T>
+struct IsStdArray : std::false_type {};
+
+template <typename T, size_t N>
+struct IsStdArray<std::array<T, N>> : std::true_type {};
+
+template <typename T>
+struct IsStdString : std::false_type {};
+
+template <typename Traits, typename Allocator>
+struct IsStdString<std::basic_string<char, Traits, Allocator>>
+    : std::true_type {};
+
+// Returns the CDR alignment of T if it can be copied in bulk, zero if not.
+// N.B. bool is not, as not every byte is a valid bool.
+template <typename T>
+constexpr size_t GetFlatAlignment() {
+  if constexpr (std::is_arithmetic_v<T> && !std::is_same_v<T, bool>) {
+    return sizeof(T);
+  } else if constexpr (requires { CdrCodec<T>::kFlatAlignment; }) {
+    static_assert(std::is_standard_layout_v<T>);
+    return CdrCodec<T>::kFlatAlignment;
+  } else {
+    return 0;
+  }
+}
+
+// Size of the encapsulation header that precedes CDR encoded data.
+constexpr size_t kCdrHeaderSize = 4;
+
+}  // namespace internal
+
+/** Encodes messages in little endian CDR, as ROS 2 middlewares do. Data
+ is aligned relative to the end of the encapsulation header, and padding
+ is zeroed.
+ @tparam kDryRun if true, the encoder computes the encoded size but does
+   not write anything. */
+template <bool kDryRun>
+class CdrEncoder {
+ public:
+  /** @param[out] data buffer to write to, right past the encapsulation
+     header, large enough for all the data to be encoded. Ignored (and
+     may be null) on dry runs. */
+  explicit CdrEncoder(uint8_t* data) : data_(data) {}
+
+  /** Returns the number of bytes encoded so far. */
+  size_t size() const { return offset_; }
+
+  /** Encodes a message field. */
+  template <typename T>
+  void Visit(const T& value) {
+    if constexpr (std::is_same_v<T, bool>) {
+      Visit(static_cast<uint8_t>(value ? 1 : 0));
+    } else if constexpr (internal::IsStdString<T>::value) {
+      // N.B. Strings are encoded null terminated.
+      Visit(static_cast<uint32_t>(value.size() + 1));
+      WriteBytes(value.data(), value.size());
+      WriteBytes("", 1);
+    } else if constexpr (internal::IsStdVector<T>::value) {
+      Visit(static_cast<uint32_t>(value.size()));
+      if constexpr (std::is_same_v<typename T::value_type, bool>) {
+        for (const bool element : value) {
+          Visit(element);
+        }
+      } else {
+        VisitElements(value.data(), value.size());
+      }
+    } else if constexpr (internal::IsStdArray<T>::value) {
+      VisitElements(value.data(), value.size());
+    } else if constexpr (internal::GetFlatAlignment<T>() > 0) {
+      VisitElements(&value, 1);
+    } else {
+      static_assert(CdrCodec<T>::kEnabled, "no CdrCodec for field type");
+      CdrCodec<T>::Visit(this, value);
+    }
+  }
+
+ private:
+  template <typename T>
+  void VisitElements(const T* elements, size_t count) {
+    constexpr size_t kAlignment = internal::GetFlatAlignment<T>();
+    if constexpr (kAlignment > 0) {
+      // N.B. Nothing is written for empty sequences, not even padding.
+      if (count > 0) {
+        Align(kAlignment);
+        WriteBytes(elements, count * sizeof(T));
+      }
+    } else {
+      for (size_t i = 0; i < count; ++i) {
+        Visit(elements[i]);
+      }
+    }
+  }
+
+  void Align(size_t alignment) {
+    const size_t padding = (alignment - offset_ % alignment) % alignment;
+    if constexpr (!kDryRun) {
+      std::memset(data_ + offset_, 0, padding);
+    }
+    offset_ += padding;
+  }
+
+  void WriteBytes(const void* bytes, size_t size) {
+    if constexpr (!kDryRun) {
+      if (size > 0) {
+        std::memcpy(data_ + offset_, bytes, size);
+      }
+    }
+    offset_ += size;
+  }
+
+  uint8_t* data_;
+  size_t offset_{0};
+};
+
+/** Decodes messages from little endian CDR, as encoded by CdrEncoder or
+ by ROS 2 middlewares. */
+class CdrDecoder {
+ public:
+  /** @param[in] data buffer to read from, right past the encapsulation
+       header.
+     @param[in] size size of the buffer, in bytes. */
+  CdrDecoder(const uint8_t* data, size_t size) : data_(data), size_(size) {}
+
+  /** Decodes a message field.
+   @throws std::runtime_error if data is truncated. */
+  template <typename T>
+  void Visit(T& value) {
+    if constexpr (std::is_same_v<T, bool>) {
+      uint8_t byte{};
+      Visit(byte);
+      value = byte != 0;
+    } else if constexpr (internal::IsStdString<T>::value) {
+      uint32_t length{};
+      Visit(length);
+      const char* characters = reinterpret_cast<const char*>(Take(length));
+      // N.B. Drop the null terminator, if any.
+      value.assign(characters, length > 0 ? length - 1 : 0);
+    } else if constexpr (internal::IsStdVector<T>::value) {
+      uint32_t count{};
+      Visit(count);
+      using Element = typename T::value_type;
+      // Every element takes at least one byte. Check before resizing, so
+      // that corrupt data cannot trigger huge allocations.
+      if (count > size_ - offset_) {
+        throw std::runtime_error("CDR data is truncated");
+      }
+      value.resize(count);
+      if constexpr (std::is_same_v<Element, bool>) {
+        for (size_t i = 0; i < count; ++i) {
+          bool element{};
+          Visit(element);
+          value[i] = element;
+        }
+      } else {
+        VisitElements(value.data(), count);
+      }
+    } else if constexpr (internal::IsStdArray<T>::value) {
+      VisitElements(value.data(), value.size());
+    } else if constexpr (internal::GetFlatAlignment<T>() > 0) {
+      VisitElements(&value, 1);
+    } else {
+      static_assert(CdrCodec<T>::kEnabled, "no CdrCodec for field type");
+      CdrCodec<T>::Visit(this, value);
+    }
+  }
+
+ private:
+  template <typename T>
+  void VisitElements(T* elements, size_t count) {
+    constexpr size_t kAlignment = internal::GetFlatAlignment<T>();
+    if constexpr (kAlignment > 0) {
+      if (count > 0) {
+        Align(kAlignment);
+        std::memcpy(static_cast<void*>(elements), Take(count * sizeof(T)),
+                    count * sizeof(T));
+      }
+    } else {
+      for (size_t i = 0; i < count; ++i) {
+        Visit(elements[i]);
+      }
+    }
+  }
+
+  void Align(size_t alignment) {
+    Take((alignment - offset_ % alignment) % alignment);
+  }
+
+  const uint8_t* Take(size_t size) {
+    if (size > size_ - offset_) {
+      throw std::runtime_error("CDR data is truncated");
+    }
+    const uint8_t* bytes = data_ + offset_;
+    offset_ += size;
+    return bytes;
+  }
+
+  const uint8_t* data_;
+  size_t size_;
+  size_t offset_{0};
+};
+
+/** Whether messages of `MessageT` type can be (de)serialized with a
+ CdrCodec in this host. */
+template <typename MessageT>
+constexpr bool kHasCdrCodec =
+    CdrCodec<MessageT>::kEnabled && std::endian::native == std::endian::little;
+
+/** Serializes a message with its CdrCodec. The output is the same, byte
+ for byte, as that of rclcpp::Serialization.
+ @param[in] message message to serialize.
+ @param[out] serialized_message serialized message to write to. Its
+   buffer is reused if large enough. */
+template <typename MessageT>
+void EncodeCdr(const MessageT& message,
+               rclcpp::SerializedMessage* serialized_message) {
+  static_assert(kHasCdrCodec<MessageT>);
+  CdrEncoder<true> sizer(nullptr);
+  sizer.Visit(message);
+  const size_t size = internal::kCdrHeaderSize + sizer.size();
+  if (serialized_message->capacity() < size) {
+    serialized_message->reserve(size);
+  }
+  rcl_serialized_message_t& rcl_serialized_message =
+      serialized_message->get_rcl_serialized_message();
+  uint8_t* buffer = rcl_serialized_message.buffer;
+  // Encapsulation header: CDR, little endian, no options.
+  buffer[0] = 0x00;
+  buffer[1] = 0x01;
+  buffer[2] = 0x00;
+  buffer[3] = 0x00;
+  CdrEncoder<false> encoder(buffer + internal::kCdrHeaderSize);
+  encoder.Visit(message);
+  rcl_serialized_message.buffer_length = size;
+}
+
+/** Deserializes a message with its CdrCodec.
+ @param[in] serialized_message serialized message to read from.
+ @param[out] message message to write to.
+ @returns false if data is not little endian CDR, true otherwise.
+ @throws std::runtime_error if data is truncated. */
+template <typename MessageT>
+bool DecodeCdr(const rclcpp::SerializedMessage& serialized_message,
+               MessageT* message) {
+  static_assert(kHasCdrCodec<MessageT>);
+  const rcl_serialized_message_t& rcl_serialized_message =
+      serialized_message.get_rcl_serialized_message();
+  const uint8_t* buffer = rcl_serialized_message.buffer;
+  const size_t size = rcl_serialized_message.buffer_length;
+  if (size < internal::kCdrHeaderSize || buffer[0] != 0x00 ||
+      buffer[1] != 0x01) {
+    return false;
+  }
+  CdrDecoder decoder(buffer + internal::kCdrHeaderSize,
+                     size - internal::kCdrHeaderSize);
+  decoder.Visit(*message);
+  return true;
+}
+
+}  // namespace core
+}  // namespace drake_ros
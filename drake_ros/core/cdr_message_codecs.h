@@ -0,0 +1,225 @@
+#pragma once
+
+#include <builtin_interfaces/msg/duration.hpp>
+#include <builtin_interfaces/msg/time.hpp>
+#include <geometry_msgs/msg/point.hpp>
+#include <geometry_msgs/msg/pose.hpp>
+#include <geometry_msgs/msg/quaternion.hpp>
+#include <geometry_msgs/msg/vector3.hpp>
+#include <sensor_msgs/msg/compressed_image.hpp>
+#include <sensor_msgs/msg/image.hpp>
+#include <sensor_msgs/msg/joint_state.hpp>
+#include <sensor_msgs/msg/point_cloud2.hpp>
+#include <sensor_msgs/msg/point_field.hpp>
+#include <std_msgs/msg/color_rgba.hpp>
+#include <std_msgs/msg/float64_multi_array.hpp>
+#include <std_msgs/msg/header.hpp>
+#include <std_msgs/msg/multi_array_dimension.hpp>
+#include <std_msgs/msg/multi_array_layout.hpp>
+#include <visualization_msgs/msg/marker.hpp>
+#include <visualization_msgs/msg/marker_array.hpp>
+#include <visualization_msgs/msg/mesh_file.hpp>
+#include <visualization_msgs/msg/uv_coordinate.hpp>
+
+#include "drake_ros/core/cdr_codec.h"
+
+/* CdrCodec specializations for messages dominated by primitive sequences
+ (joint states, multi-arrays, point clouds, images and markers) and for
+ the messages these are made of. Fields are listed in .msg order. */
+
+namespace drake_ros {
+namespace core {
+
+template <typename Allocator>
+struct CdrCodec<builtin_interfaces::msg::Time_<Allocator>>
+    : FlatCdrCodec<4> {};
+
+template <typename Allocator>
+struct CdrCodec<builtin_interfaces::msg::Duration_<Allocator>>
+    : FlatCdrCodec<4> {};
+
+template <typename Allocator>
+struct CdrCodec<geometry_msgs::msg::Point_<Allocator>> : FlatCdrCodec<8> {};
+
+template <typename Allocator>
+struct CdrCodec<geometry_msgs::msg::Quaternion_<Allocator>>
+    : FlatCdrCodec<8> {};
+
+template <typename Allocator>
+struct CdrCodec<geometry_msgs::msg::Vector3_<Allocator>>
+    : FlatCdrCodec<8> {};
+
+template <typename Allocator>
+struct CdrCodec<geometry_msgs::msg::Pose_<Allocator>> : FlatCdrCodec<8> {};
+
+template <typename Allocator>
+struct CdrCodec<std_msgs::msg::ColorRGBA_<Allocator>> : FlatCdrCodec<4> {};
+
+// N.B. Flat messages must not have any padding in memory.
+static_assert(sizeof(builtin_interfaces::msg::Time) == 8);
+static_assert(sizeof(builtin_interfaces::msg::Duration) == 8);
+static_assert(sizeof(geometry_msgs::msg::Point) == 24);
+static_assert(sizeof(geometry_msgs::msg::Quaternion) == 32);
+static_assert(sizeof(geometry_msgs::msg::Vector3) == 24);
+static_assert(sizeof(geometry_msgs::msg::Pose) == 56);
+static_assert(sizeof(std_msgs::msg::ColorRGBA) == 16);
+
+template <typename Allocator>
+struct CdrCodec<std_msgs::msg::Header_<Allocator>> : StructCdrCodec {
+  template <typename Stream, typename Message>
+  static void Visit(Stream* stream, Message& message) {
+    stream->Visit(message.stamp);
+    stream->Visit(message.frame_id);
+  }
+};
+
+template <typename Allocator>
+struct CdrCodec<std_msgs::msg::MultiArrayDimension_<Allocator>>
+    : StructCdrCodec {
+  template <typename Stream, typename Message>
+  static void Visit(Stream* stream, Message& message) {
+    stream->Visit(message.label);
+    stream->Visit(message.size);
+    stream->Visit(message.stride);
+  }
+};
+
+template <typename Allocator>
+struct CdrCodec<std_msgs::msg::MultiArrayLayout_<Allocator>>
+    : StructCdrCodec {
+  template <typename Stream, typename Message>
+  static void Visit(Stream* stream, Message& message) {
+    stream->Visit(message.dim);
+    stream->Visit(message.data_offset);
+  }
+};
+
+template <typename Allocator>
+struct CdrCodec<std_msgs::msg::Float64MultiArray_<Allocator>>
+    : StructCdrCodec {
+  template <typename Stream, typename Message>
+  static void Visit(Stream* stream, Message& message) {
+    stream->Visit(message.layout);
+    stream->Visit(message.data);
+  }
+};
+
+template <typename Allocator>
+struct CdrCodec<sensor_msgs::msg::JointState_<Allocator>> : StructCdrCodec {
+  template <typename Stream, typename Message>
+  static void Visit(Stream* stream, Message& message) {
+    stream->Visit(message.header);
+    stream->Visit(message.name);
+    stream->Visit(message.position);
+    stream->Visit(message.velocity);
+    stream->Visit(message.effort);
+  }
+};
+
+template <typename Allocator>
+struct CdrCodec<sensor_msgs::msg::PointField_<Allocator>> : StructCdrCodec {
+  template <typename Stream, typename Message>
+  static void Visit(Stream* stream, Message& message) {
+    stream->Visit(message.name);
+    stream->Visit(message.offset);
+    stream->Visit(message.datatype);
+    stream->Visit(message.count);
+  }
+};
+
+template <typename Allocator>
+struct CdrCodec<sensor_msgs::msg::PointCloud2_<Allocator>>
+    : StructCdrCodec {
+  template <typename Stream, typename Message>
+  static void Visit(Stream* stream, Message& message) {
+    stream->Visit(message.header);
+    stream->Visit(message.height);
+    stream->Visit(message.width);
+    stream->Visit(message.fields);
+    stream->Visit(message.is_bigendian);
+    stream->Visit(message.point_step);
+    stream->Visit(message.row_step);
+    stream->Visit(message.data);
+    stream->Visit(message.is_dense);
+  }
+};
+
+template <typename Allocator>
+struct CdrCodec<sensor_msgs::msg::Image_<Allocator>> : StructCdrCodec {
+  template <typename Stream, typename Message>
+  static void Visit(Stream* stream, Message& message) {
+    stream->Visit(message.header);
+    stream->Visit(message.height);
+    stream->Visit(message.width);
+    stream->Visit(message.encoding);
+    stream->Visit(message.is_bigendian);
+    stream->Visit(message.step);
+    stream->Visit(message.data);
+  }
+};
+
+template <typename Allocator>
+struct CdrCodec<sensor_msgs::msg::CompressedImage_<Allocator>>
+    : StructCdrCodec {
+  template <typename Stream, typename Message>
+  static void Visit(Stream* stream, Message& message) {
+    stream->Visit(message.header);
+    stream->Visit(message.format);
+    stream->Visit(message.data);
+  }
+};
+
+template <typename Allocator>
+struct CdrCodec<visualization_msgs::msg::UVCoordinate_<Allocator>>
+    : FlatCdrCodec<4> {};
+
+static_assert(sizeof(visualization_msgs::msg::UVCoordinate) == 8);
+
+template <typename Allocator>
+struct CdrCodec<visualization_msgs::msg::MeshFile_<Allocator>>
+    : StructCdrCodec {
+  template <typename Stream, typename Message>
+  static void Visit(Stream* stream, Message& message) {
+    stream->Visit(message.filename);
+    stream->Visit(message.data);
+  }
+};
+
+template <typename Allocator>
+struct CdrCodec<visualization_msgs::msg::Marker_<Allocator>>
+    : StructCdrCodec {
+  template <typename Stream, typename Message>
+  static void Visit(Stream* stream, Message& message) {
+    stream->Visit(message.header);
+    stream->Visit(message.ns);
+    stream->Visit(message.id);
+    stream->Visit(message.type);
+    stream->Visit(message.action);
+    stream->Visit(message.pose);
+    stream->Visit(message.scale);
+    stream->Visit(message.color);
+    stream->Visit(message.lifetime);
+    stream->Visit(message.frame_locked);
+    stream->Visit(message.points);
+    stream->Visit(message.colors);
+    stream->Visit(message.texture_resource);
+    stream->Visit(message.texture);
+    stream->Visit(message.uv_coordinates);
+    stream->Visit(message.text);
+    stream->Visit(message.mesh_resource);
+    stream->Visit(message.mesh_file);
+    stream->Visit(message.mesh_use_embedded_materials);
+  }
+};
+
+template <typename Allocator>
+struct CdrCodec<visualization_msgs::msg::MarkerArray_<Allocator>>
+    : StructCdrCodec {
+  template <typename Stream, typename Message>
+  static void Visit(Stream* stream, Message& message) {
+    stream->Visit(message.markers);
+  }
+};
+
+}  // namespace core
+}  // namespace drake_ros
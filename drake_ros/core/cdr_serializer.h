@@ -0,0 +1,54 @@
+#pragma once
+
+#include <drake/common/value.h>
+#include <rclcpp/serialized_message.hpp>
+
+#include "drake_ros/core/cdr_codec.h"
+#include "drake_ros/core/cdr_message_codecs.h"
+#include "drake_ros/core/serializer.h"
+
+namespace drake_ros {
+namespace core {
+/** A (de)serialization interface implementation that is bound to C++ ROS
+ messages of `MessageT` type, and that uses its CdrCodec if any.
+
+ Messages with a CdrCodec are (de)serialized with it, bypassing
+ typesupport. Otherwise, or on big endian hosts, or for data that is not
+ little endian CDR, it falls back to Serializer<MessageT>. Pass it to
+ publisher and subscriber system constructors to opt in e.g.
+
+ @code{.cpp}
+ auto publisher = std::make_unique<RosPublisherSystem>(
+     std::make_shared<CdrSerializer<sensor_msgs::msg::JointState>>(),
+     "joint_states", qos, ros);
+ @endcode
+
+ This header includes the codecs in cdr_message_codecs.h, and thus the
+ sensor_msgs and visualization_msgs headers they need. It is part of a
+ library of its own: `drake_ros_core_cdr` in CMake, `//core:cdr_serializer`
+ in Bazel. */
+template <typename MessageT>
+class CdrSerializer : public Serializer<MessageT> {
+ public:
+  void SerializeInto(const drake::AbstractValue& abstract_value,
+                     rclcpp::SerializedMessage* message) const override {
+    if constexpr (kHasCdrCodec<MessageT>) {
+      EncodeCdr(abstract_value.get_value<MessageT>(), message);
+    } else {
+      Serializer<MessageT>::SerializeInto(abstract_value, message);
+    }
+  }
+
+  void Deserialize(const rclcpp::SerializedMessage& serialized_message,
+                   drake::AbstractValue* abstract_value) const override {
+    if constexpr (kHasCdrCodec<MessageT>) {
+      if (DecodeCdr(serialized_message,
+                    &abstract_value->get_mutable_value<MessageT>())) {
+        return;
+      }
+    }
+    Serializer<MessageT>::Deserialize(serialized_message, abstract_value);
+  }
+};
+}  // namespace core
+}  // namespace drake_ros
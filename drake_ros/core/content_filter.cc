@@ -0,0 +1,61 @@
+#include "drake_ros/core/content_filter.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <utility>
+
+#include "drake_ros/core/serialized_header.h"
+
+namespace drake_ros {
+namespace core {
+namespace {
+// A string hash that also takes string views, for heterogeneous lookups.
+struct StringHash {
+  using is_transparent = void;
+
+  size_t operator()(std::string_view value) const {
+    return std::hash<std::string_view>{}(value);
+  }
+};
+}  // namespace
+
+ContentFilter MakeHeaderFrameIdFilter(
+    const std::unordered_set<std::string>& frame_ids) {
+  ContentFilter filter;
+  // DDS string literals cannot hold single quotes, as the filter grammar
+  // has no escape sequences. Leave filtering to the prefilter if any does.
+  const bool expressible =
+      std::none_of(frame_ids.begin(), frame_ids.end(),
+                   [](const std::string& frame_id) {
+                     return frame_id.find('\'') != std::string::npos;
+                   });
+  if (expressible) {
+    for (const std::string& frame_id : frame_ids) {
+      if (!filter.expression.empty()) {
+        filter.expression += " OR ";
+      }
+      filter.expression +=
+          "header.frame_id = %" +
+          std::to_string(filter.expression_parameters.size());
+      filter.expression_parameters.push_back("'" + frame_id + "'");
+    }
+  }
+  // Look frame IDs up by view, so as to not allocate a string per message.
+  std::unordered_set<std::string, StringHash, std::equal_to<>> frame_id_set(
+      frame_ids.begin(), frame_ids.end());
+  filter.prefilter = [frame_id_set = std::move(frame_id_set)](
+                         const rclcpp::SerializedMessage& message) {
+    const std::optional<std::string_view> frame_id =
+        PeekHeaderFrameId(message);
+    return frame_id.has_value() &&
+           frame_id_set.find(*frame_id) != frame_id_set.end();
+  };
+  return filter;
+}
+}  // namespace core
+}  // namespace drake_ros
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <functional>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include <rclcpp/serialized_message.hpp>
+
+namespace drake_ros {
+namespace core {
+/** A content filter for ROS subscriptions.
+
+ A content filter drops unwanted messages before they are deserialized.
+ If the RMW implementation supports content-filtered topics, the filter
+ `expression` is handed over to it, and unwanted messages may not even
+ reach the process. Otherwise, or if no `expression` is given, the
+ `prefilter` predicate is applied on serialized messages as they arrive.
+ */
+struct ContentFilter {
+  /** A predicate on serialized messages. Returns true to keep a message. */
+  using Prefilter = std::function<bool(const rclcpp::SerializedMessage&)>;
+
+  /** Filter expression, in DDS content-filtered topic SQL-like syntax
+   e.g. "header.frame_id = %0". Empty for none. */
+  std::string expression{};
+
+  /** Parameters for `%N` placeholders in the filter `expression`.
+   Note string parameters must be quoted e.g. "'world'". */
+  std::vector<std::string> expression_parameters{};
+
+  /** Predicate on serialized messages to apply whenever the RMW
+   implementation does not filter content. Null for none. */
+  Prefilter prefilter{};
+};
+
+/** Makes a content filter that keeps messages whose header frame ID is one
+ of `frame_ids`. Message types must have a `std_msgs/msg/Header` as their
+ first field. Messages without a header are dropped by the prefilter.
+ As DDS filter expressions cannot quote single quotes, frame IDs with any
+ are matched by the prefilter alone. */
+ContentFilter MakeHeaderFrameIdFilter(
+    const std::unordered_set<std::string>& frame_ids);
+}  // namespace core
+}  // namespace drake_ros
@@ -1,18 +1,85 @@
 #include "drake_ros/core/drake_ros.h"
 
+#include <atomic>
 #include <chrono>
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <stdexcept>
 #include <string>
+#include <thread>
+#include <utility>
 
+#include "entity_pool.h"     // NOLINT(build/include)
+#include "realtime_audit.h"  // NOLINT(build/include)
 #include <rclcpp/executors.hpp>
 #include <rclcpp/node.hpp>
 
 namespace drake_ros {
 namespace core {
+namespace {
+// A callback group serviced by an executor of its own, in a thread of its
+// own, both set up on first use.
+class ThreadedCallbackGroup final {
+ public:
+  ~ThreadedCallbackGroup() { Stop(); }
+
+  // Returns the callback group of `node`, setting it up on first call.
+  rclcpp::CallbackGroup::SharedPtr Get(rclcpp::Node* node,
+                                       rclcpp::Context::SharedPtr context) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!group_) {
+      // Keep this work away from the executor spun by Spin().
+      group_ = node->create_callback_group(
+          rclcpp::CallbackGroupType::MutuallyExclusive,
+          /* automatically_add_to_executor_with_node */ false);
+      rclcpp::ExecutorOptions eo;
+      eo.context = context;
+      executor_.reset(new rclcpp::executors::SingleThreadedExecutor(eo));
+      executor_->add_callback_group(group_, node->get_node_base_interface());
+      thread_ = std::thread([this, context]() {
+        // Spin in bounded chunks, as a cancellation may come before
+        // spinning.
+        while (!stop_ && rclcpp::ok(context)) {
+          executor_->spin_once(std::chrono::milliseconds(100));
+        }
+      });
+    }
+    return group_;
+  }
+
+  // Stops the thread, if any.
+  void Stop() {
+    if (thread_.joinable()) {
+      stop_ = true;
+      executor_->cancel();
+      thread_.join();
+    }
+  }
+
+ private:
+  // Mutex to synchronize setup.
+  std::mutex mutex_;
+  rclcpp::CallbackGroup::SharedPtr group_;
+  rclcpp::executors::SingleThreadedExecutor::UniquePtr executor_;
+  std::thread thread_;
+  // Flag to stop the thread.
+  std::atomic<bool> stop_{false};
+};
+}  // namespace
+
 struct DrakeRos::Impl {
   rclcpp::Context::SharedPtr context;
   rclcpp::Node::SharedPtr node;
-  rclcpp::executors::SingleThreadedExecutor::UniquePtr executor;
+  // Executor to spin the node with, if any.
+  rclcpp::Executor::SharedPtr executor;
+  // Publishers and subscriptions shared by systems.
+  std::unique_ptr<internal::EntityPool> entity_pool;
+
+  // Work serviced in the background e.g. wall timers.
+  ThreadedCallbackGroup background;
+  // High priority work.
+  ThreadedCallbackGroup high_priority;
 };
 
 DrakeRos::DrakeRos(const std::string& node_name,
@@ -27,20 +94,44 @@ DrakeRos::DrakeRos(const std::string& node_name,
 
   impl_->node.reset(new rclcpp::Node(node_name, node_options));
 
-  // TODO(hidmic): optionally take a user-provided Executor instance
   rclcpp::ExecutorOptions eo;
   eo.context = impl_->context;
-  impl_->executor.reset(new rclcpp::executors::SingleThreadedExecutor(eo));
+  impl_->executor =
+      std::make_shared<rclcpp::executors::SingleThreadedExecutor>(eo);
 
   impl_->executor->add_node(impl_->node->get_node_base_interface());
+
+  impl_->entity_pool =
+      std::make_unique<internal::EntityPool>(impl_->node.get());
 }
 
-DrakeRos::~DrakeRos() {}
+DrakeRos::DrakeRos(rclcpp::Node::SharedPtr node,
+                   rclcpp::Executor::SharedPtr executor)
+    : impl_(new Impl()) {
+  if (!node) {
+    throw std::invalid_argument("node must not be null");
+  }
+  impl_->context = node->get_node_base_interface()->get_context();
+  impl_->node = std::move(node);
+  impl_->executor = std::move(executor);
+
+  impl_->entity_pool =
+      std::make_unique<internal::EntityPool>(impl_->node.get());
+}
+
+DrakeRos::~DrakeRos() {
+  impl_->high_priority.Stop();
+  impl_->background.Stop();
+}
 
 const rclcpp::Node& DrakeRos::get_node() const { return *impl_->node; }
 
 rclcpp::Node* DrakeRos::get_mutable_node() const { return impl_->node.get(); }
 
+internal::EntityPool* DrakeRos::get_mutable_entity_pool() const {
+  return impl_->entity_pool.get();
+}
+
 void DrakeRos::Spin(int timeout_millis) {
   if (timeout_millis < 0) {
     // To match `DrakeLcm::HandleSubscriptions()`'s behavior,
@@ -49,9 +140,50 @@ void DrakeRos::Spin(int timeout_millis) {
   }
   // TODO(hidmic): switch to rclcpp::Executor::spin_all() when and if a zero
   // timeout is supported. See https://github.com/ros2/rclcpp/issues/1825.
+  if (!impl_->executor) {
+    // The node is spun elsewhere.
+    return;
+  }
+  internal::ScopedDelegateCall call;
   impl_->executor->spin_some(std::chrono::milliseconds(timeout_millis));
 }
 
+void DrakeRos::SpinUntil(std::chrono::steady_clock::time_point deadline) {
+  if (!impl_->executor) {
+    // The node is spun elsewhere.
+    std::this_thread::sleep_until(deadline);
+    return;
+  }
+  internal::ScopedDelegateCall call;
+  for (auto now = std::chrono::steady_clock::now(); now < deadline;
+       now = std::chrono::steady_clock::now()) {
+    if (!rclcpp::ok(impl_->context)) {
+      // The executor would not wait anymore.
+      std::this_thread::sleep_until(deadline);
+      return;
+    }
+    impl_->executor->spin_once(deadline - now);
+  }
+}
+
+rclcpp::TimerBase::SharedPtr DrakeRos::CreateWallTimer(
+    std::chrono::nanoseconds period, std::function<void()> callback) {
+  return impl_->node->create_wall_timer(
+      period, std::move(callback),
+      impl_->background.Get(impl_->node.get(), impl_->context));
+}
+
+rclcpp::CallbackGroup::SharedPtr DrakeRos::GetCallbackGroup(
+    CallbackPriority priority) {
+  switch (priority) {
+    case CallbackPriority::kNormal:
+      return nullptr;
+    case CallbackPriority::kHigh:
+      return impl_->high_priority.Get(impl_->node.get(), impl_->context);
+  }
+  throw std::invalid_argument("unknown callback priority");
+}
+
 void init(int argc, const char** argv) {
   if (!rclcpp::ok()) {
     rclcpp::init(argc, argv);
@@ -1,13 +1,30 @@
 #pragma once
 
+#include <chrono>
+#include <functional>
 #include <memory>
 #include <string>
 
+#include <rclcpp/executor.hpp>
 #include <rclcpp/node.hpp>
 #include <rclcpp/node_options.hpp>
 
 namespace drake_ros {
 namespace core {
+namespace internal {
+class EntityPool;
+}  // namespace internal
+
+/** Priority classes for ROS work, e.g. subscription callbacks. */
+enum class CallbackPriority {
+  /** Work serviced by DrakeRos::Spin(), in no particular order. */
+  kNormal,
+  /** Work serviced as soon as it is ready, ahead of and regardless of any
+   normal priority work pending, in a thread of its own. Meant for
+   latency-sensitive traffic, e.g. command topics, that must not queue up
+   behind bursts of bulky traffic, e.g. visualization topics. */
+  kHigh,
+};
 
 /** A Drake ROS interface that wraps a live ROS node.
 
@@ -24,6 +41,21 @@ class DrakeRos final {
   DrakeRos(const std::string& node_name,
            rclcpp::NodeOptions node_options = rclcpp::NodeOptions{});
 
+  /** A constructor that wraps an externally owned ROS `node`, e.g. one
+   loaded into a component container alongside other nodes.
+
+   If an `executor` is given, Spin() spins it. Adding the `node` to it is up
+   to the caller. Otherwise, the `node` is assumed to be spun elsewhere
+   (e.g. by the component container) and Spin() does nothing, in which case
+   subscription callbacks run concurrently with simulation.
+
+   @param[in] node ROS node to wrap.
+   @param[in] executor optional ROS executor to spin.
+   @throws std::invalid_argument if `node` is null.
+   */
+  explicit DrakeRos(rclcpp::Node::SharedPtr node,
+                    rclcpp::Executor::SharedPtr executor = nullptr);
+
   ~DrakeRos();
 
   /** Returns a constant reference to the underlying ROS node. */
@@ -41,6 +73,7 @@ class DrakeRos final {
 
    This method's behavior has been modeled after that of the
    `drake::lcm::DrakeLcm::HandleSubscriptions()` method (to a partial extent).
+   It does nothing if the underlying node is spun elsewhere.
 
    @param[in] timeout_millis Timeout, in milliseconds, when fetching work.
      Negative timeout values are not allowed. If timeout is 0, the call will
@@ -51,6 +84,51 @@ class DrakeRos final {
    */
   void Spin(int timeout_millis = 0);
 
+  /** Spins the underlying ROS node until a given deadline, waiting for work
+   and dispatching it as soon as it becomes available.
+
+   Unlike Spin(), this method blocks until the deadline. It is meant to put
+   otherwise idle time to use e.g. while pacing simulation to realtime.
+   If the underlying node is spun elsewhere, or the ROS context is shut
+   down, it simply sleeps until the deadline.
+
+   @param[in] deadline Time point to spin until. If already past, the call
+     returns immediately.
+   */
+  void SpinUntil(std::chrono::steady_clock::time_point deadline);
+
+  /** Creates a timer that fires at a fixed wall-clock rate, regardless of
+   whether and how often Spin() is called.
+
+   Wall timers are serviced by a background thread owned by this interface,
+   started on first use. Their callbacks are thus called concurrently with
+   the rest of the program, and must be thread-safe.
+
+   @param[in] period Timer period.
+   @param[in] callback Timer callback.
+   @returns the timer, which fires until canceled or destroyed.
+   */
+  rclcpp::TimerBase::SharedPtr CreateWallTimer(
+      std::chrono::nanoseconds period, std::function<void()> callback);
+
+  /** Returns the callback group to service work of a given `priority` with.
+
+   Normal priority work is serviced with the node default callback group,
+   for which null is returned. High priority work is serviced with a
+   dedicated callback group, by a background thread owned by this
+   interface, started on first use. Callbacks in that group are thus called
+   concurrently with the rest of the program, and must be thread-safe.
+
+   @param[in] priority Priority class of the work to service.
+   @returns the callback group, or null for the node default group.
+   */
+  rclcpp::CallbackGroup::SharedPtr GetCallbackGroup(CallbackPriority priority);
+
+  /** (Internal use only) Returns the pool of ROS publishers and
+   subscriptions that drake_ros systems using this interface share, so that
+   systems using the same topic, type, and QoS share middleware entities. */
+  internal::EntityPool* get_mutable_entity_pool() const;
+
  private:
   struct Impl;
   std::unique_ptr<Impl> impl_;
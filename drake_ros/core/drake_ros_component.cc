@@ -0,0 +1,77 @@
+#include "drake_ros/core/drake_ros_component.h"
+
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include <rclcpp/node.hpp>
+#include <rclcpp/timer.hpp>
+
+#include "drake_ros/core/ros_interface_system.h"
+
+namespace drake_ros {
+namespace core {
+struct DrakeRosComponent::Impl {
+  // Component node, also held by the ROS interface.
+  rclcpp::Node::SharedPtr node;
+  // Interface to the component node, owned by the diagram.
+  DrakeRos* ros{nullptr};
+  std::unique_ptr<drake::systems::Diagram<double>> diagram;
+  std::unique_ptr<drake::systems::Simulator<double>> simulator;
+  // Timer to advance simulation with.
+  rclcpp::TimerBase::SharedPtr timer;
+};
+
+DrakeRosComponent::DrakeRosComponent(const std::string& node_name,
+                                     const rclcpp::NodeOptions& options,
+                                     DiagramPopulator populate,
+                                     const DrakeRosComponentParams& params)
+    : impl_(new Impl()) {
+  impl_->node = std::make_shared<rclcpp::Node>(node_name, options);
+  const double time_step =
+      impl_->node->declare_parameter("time_step", params.time_step);
+  if (!(time_step > 0.0)) {
+    throw std::invalid_argument("time_step must be positive");
+  }
+
+  drake::systems::DiagramBuilder<double> builder;
+  // The component node is spun by the executor it is loaded into.
+  auto ros_interface_system = builder.AddSystem<RosInterfaceSystem>(
+      std::make_unique<DrakeRos>(impl_->node));
+  impl_->ros = ros_interface_system->get_ros_interface();
+  populate(&builder, impl_->ros);
+  impl_->diagram = builder.Build();
+
+  impl_->simulator =
+      std::make_unique<drake::systems::Simulator<double>>(*impl_->diagram);
+  impl_->simulator->Initialize();
+
+  drake::systems::Simulator<double>* simulator = impl_->simulator.get();
+  impl_->timer = impl_->node->create_wall_timer(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::duration<double>(time_step)),
+      [simulator, time_step]() {
+        simulator->AdvanceTo(simulator->get_context().get_time() + time_step);
+      });
+}
+
+DrakeRosComponent::~DrakeRosComponent() {
+  // Stop simulation before tearing it down.
+  impl_->timer->cancel();
+}
+
+rclcpp::node_interfaces::NodeBaseInterface::SharedPtr
+DrakeRosComponent::get_node_base_interface() const {
+  return impl_->node->get_node_base_interface();
+}
+
+DrakeRos* DrakeRosComponent::get_ros_interface() const { return impl_->ros; }
+
+const drake::systems::Simulator<double>& DrakeRosComponent::get_simulator()
+    const {
+  return *impl_->simulator;
+}
+}  // namespace core
+}  // namespace drake_ros
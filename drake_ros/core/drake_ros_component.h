@@ -0,0 +1,93 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+
+#include <drake/systems/analysis/simulator.h>
+#include <drake/systems/framework/diagram_builder.h>
+#include <rclcpp/node_interfaces/node_base_interface.hpp>
+#include <rclcpp/node_options.hpp>
+
+#include "drake_ros/core/drake_ros.h"
+
+namespace drake_ros {
+namespace core {
+
+/** Set of parameters that configure a DrakeRosComponent. */
+struct DrakeRosComponentParams {
+  /** Default simulation time step, in seconds. Simulation advances by one
+   time step per time step of wall-clock time. It may be overridden by the
+   `time_step` ROS parameter of the component node. */
+  double time_step{0.01};
+};
+
+/** A base class for ROS components that simulate a Drake diagram.
+
+ The component owns a ROS node, which is spun by whichever executor the
+ component is loaded into (e.g. that of a component container), alongside
+ other nodes. A `DrakeRos` interface wraps this node for systems in the
+ diagram to use. Simulation advances on a wall timer of the component node,
+ and thus in that executor too.
+
+ To make a component out of a diagram, derive from this class and register
+ the derived class:
+
+ @code{.cpp}
+ class MySimulation : public drake_ros::core::DrakeRosComponent {
+  public:
+   explicit MySimulation(const rclcpp::NodeOptions& options)
+       : DrakeRosComponent("my_simulation", options, &PopulateMyDiagram) {}
+ };
+
+ RCLCPP_COMPONENTS_REGISTER_NODE(MySimulation)
+ @endcode
+
+ Node options are forwarded to the component node. Note drake_ros systems
+ exchange serialized messages, which rclcpp does not convey intra-process,
+ so their traffic with co-located nodes goes through the RMW implementation
+ regardless of `use_intra_process_comms`.
+ */
+class DrakeRosComponent {
+ public:
+  /** A function to populate the component diagram.
+   @param[in] builder builder for the component diagram, which already
+     contains a RosInterfaceSystem for the component node.
+   @param[in] ros interface to the component node.
+   */
+  using DiagramPopulator = std::function<void(
+      drake::systems::DiagramBuilder<double>* builder, DrakeRos* ros)>;
+
+  /** A constructor that builds the component diagram and starts simulating
+   it, as soon as the component node is spun.
+   @param[in] node_name name of the component node.
+   @param[in] options options for the component node.
+   @param[in] populate function to populate the component diagram.
+   @param[in] params optional component configuration.
+   @throws std::invalid_argument if the time step is not positive.
+   */
+  DrakeRosComponent(const std::string& node_name,
+                    const rclcpp::NodeOptions& options,
+                    DiagramPopulator populate,
+                    const DrakeRosComponentParams& params = {});
+
+  virtual ~DrakeRosComponent();
+
+  /** Returns the component node base interface, as required by
+   `rclcpp_components`. */
+  rclcpp::node_interfaces::NodeBaseInterface::SharedPtr
+  get_node_base_interface() const;
+
+  /** Returns the interface to the component node. */
+  DrakeRos* get_ros_interface() const;
+
+  /** Returns the component simulator. Note it is advanced from within the
+   executor that spins the component node. */
+  const drake::systems::Simulator<double>& get_simulator() const;
+
+ private:
+  struct Impl;
+  std::unique_ptr<Impl> impl_;
+};
+}  // namespace core
+}  // namespace drake_ros
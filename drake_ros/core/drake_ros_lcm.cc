@@ -0,0 +1,378 @@
+#include "drake_ros/core/drake_ros_lcm.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <regex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <drake/common/drake_throw.h>
+#include <rclcpp/node.hpp>
+#include <std_msgs/msg/u_int8_multi_array.hpp>
+
+namespace drake_ros {
+namespace core {
+namespace {
+using drake::lcm::DrakeLcmInterface;
+using LcmMessage = std_msgs::msg::UInt8MultiArray;
+using LcmMessagePtr = std::shared_ptr<const LcmMessage>;
+
+constexpr char kLcmMessageType[] = "std_msgs/msg/UInt8MultiArray";
+
+// Returns the LCM channel an LCM message was published to.
+const std::string* GetChannel(const LcmMessage& message) {
+  if (message.layout.dim.empty()) {
+    return nullptr;
+  }
+  return &message.layout.dim[0].label;
+}
+
+// A subscription to one or more LCM channels.
+class LcmSubscription final : public drake::lcm::DrakeSubscriptionInterface {
+ public:
+  // Subscribes to `channel` only.
+  LcmSubscription(std::string channel,
+                  DrakeLcmInterface::MultichannelHandlerFunction handler)
+      : channel_(std::move(channel)), handler_(std::move(handler)) {}
+
+  // Subscribes to all channels matching `regex`.
+  LcmSubscription(std::regex regex,
+                  DrakeLcmInterface::MultichannelHandlerFunction handler)
+      : regex_(std::move(regex)), handler_(std::move(handler)) {}
+
+  void set_unsubscribe_on_delete(bool enabled) override {
+    unsubscribe_on_delete_ = enabled;
+  }
+
+  void set_queue_capacity(int capacity) override {
+    if (capacity < 1) {
+      throw std::invalid_argument("queue capacity must be positive");
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    capacity_ = static_cast<size_t>(capacity);
+    while (queue_.size() > capacity_) {
+      queue_.pop_front();
+    }
+  }
+
+  bool unsubscribe_on_delete() const { return unsubscribe_on_delete_; }
+
+  bool is_multichannel() const { return regex_.has_value(); }
+
+  bool Matches(const std::string& channel) const {
+    if (regex_) {
+      return std::regex_match(channel, *regex_);
+    }
+    return channel == *channel_;
+  }
+
+  // Queues a `message`, dropping the oldest one if the queue is full.
+  void Enqueue(LcmMessagePtr message) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (queue_.size() == capacity_) {
+      queue_.pop_front();
+    }
+    queue_.push_back(std::move(message));
+  }
+
+  bool HasPending() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return !queue_.empty();
+  }
+
+  // Invokes the handler for every queued message. Returns how many.
+  int Dispatch() {
+    std::deque<LcmMessagePtr> queue;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      queue.swap(queue_);
+    }
+    for (const LcmMessagePtr& message : queue) {
+      handler_(*GetChannel(*message), message->data.data(),
+               static_cast<int>(message->data.size()));
+    }
+    return static_cast<int>(queue.size());
+  }
+
+ private:
+  const std::optional<std::string> channel_;
+  const std::optional<std::regex> regex_;
+  const DrakeLcmInterface::MultichannelHandlerFunction handler_;
+  std::atomic<bool> unsubscribe_on_delete_{false};
+  // Mutex to synchronize access to the queue.
+  mutable std::mutex mutex_;
+  std::deque<LcmMessagePtr> queue_;
+  size_t capacity_{1};
+};
+}  // namespace
+
+struct DrakeRosLcm::Impl {
+  DrakeRos* ros;
+  DrakeRosLcmParams params;
+  // Fully qualified topic prefix, ending with a slash.
+  std::string resolved_topic_prefix;
+
+  // Mutex to synchronize access to all members below.
+  std::mutex mutex;
+  // Condition variable to wait for messages on.
+  std::condition_variable cv;
+  // Publishers, by fully qualified topic name.
+  std::map<std::string, rclcpp::Publisher<LcmMessage>::SharedPtr> pubs;
+  // Subscriptions, by fully qualified topic name.
+  std::map<std::string, rclcpp::Subscription<LcmMessage>::SharedPtr> subs;
+  // LCM subscriptions, held until unsubscribed on deletion (if ever).
+  std::vector<std::shared_ptr<LcmSubscription>> lcm_subs;
+  // Whether any LCM subscription spans many channels.
+  bool has_multichannel_subs{false};
+  // Last time topics were discovered, if ever.
+  std::optional<std::chrono::steady_clock::time_point> last_discovery_time;
+
+  std::string ResolveTopicName(const std::string& topic_name) const {
+    return ros->get_mutable_node()
+        ->get_node_topics_interface()
+        ->resolve_topic_name(topic_name);
+  }
+
+  // Subscribes to a topic, if not subscribed already. Must be called with
+  // the mutex held.
+  void EnsureSubscribed(const std::string& resolved_topic_name) {
+    if (subs.count(resolved_topic_name) > 0) {
+      return;
+    }
+    subs[resolved_topic_name] =
+        ros->get_mutable_node()->create_subscription<LcmMessage>(
+            resolved_topic_name, params.qos, [this](LcmMessagePtr message) {
+              HandleMessage(std::move(message));
+            });
+  }
+
+  // Queues a message for all LCM subscriptions to its channel.
+  void HandleMessage(LcmMessagePtr message) {
+    const std::string* channel = GetChannel(*message);
+    if (channel == nullptr) {
+      return;
+    }
+    bool queued = false;
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      for (const auto& lcm_sub : lcm_subs) {
+        if (lcm_sub->Matches(*channel)) {
+          lcm_sub->Enqueue(message);
+          queued = true;
+        }
+      }
+    }
+    if (queued) {
+      cv.notify_all();
+    }
+  }
+
+  // Subscribes to newly found LCM channel topics, at most once per
+  // discovery period. Must be called with the mutex held.
+  void DiscoverTopics() {
+    if (!has_multichannel_subs) {
+      return;
+    }
+    const auto now = std::chrono::steady_clock::now();
+    if (last_discovery_time &&
+        now - *last_discovery_time <
+            std::chrono::duration<double>(params.discovery_period)) {
+      return;
+    }
+    last_discovery_time = now;
+    for (const auto& [topic_name, types] :
+         ros->get_node().get_topic_names_and_types()) {
+      if (topic_name.rfind(resolved_topic_prefix, 0) != 0) {
+        continue;
+      }
+      if (std::find(types.begin(), types.end(), kLcmMessageType) ==
+          types.end()) {
+        continue;
+      }
+      EnsureSubscribed(topic_name);
+    }
+  }
+
+  // Adds an LCM subscription.
+  std::shared_ptr<LcmSubscription> AddSubscription(
+      std::shared_ptr<LcmSubscription> lcm_sub,
+      const std::optional<std::string>& topic_name) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (topic_name) {
+      EnsureSubscribed(ResolveTopicName(*topic_name));
+    }
+    if (lcm_sub->is_multichannel()) {
+      has_multichannel_subs = true;
+      // Discover topics right away.
+      last_discovery_time.reset();
+    }
+    lcm_subs.push_back(lcm_sub);
+    return lcm_sub;
+  }
+
+  // Returns LCM subscriptions that are still alive. Must be called with
+  // the mutex held.
+  std::vector<std::shared_ptr<LcmSubscription>> GetLiveSubscriptions() {
+    // Drop subscriptions no one else holds, if so requested.
+    lcm_subs.erase(std::remove_if(lcm_subs.begin(), lcm_subs.end(),
+                                  [](const auto& lcm_sub) {
+                                    return lcm_sub->unsubscribe_on_delete() &&
+                                           lcm_sub.use_count() == 1;
+                                  }),
+                   lcm_subs.end());
+    return lcm_subs;
+  }
+};
+
+DrakeRosLcm::DrakeRosLcm(DrakeRos* ros, const DrakeRosLcmParams& params)
+    : impl_(new Impl()) {
+  DRAKE_THROW_UNLESS(ros != nullptr);
+  if (!(params.discovery_period >= 0.0)) {
+    throw std::invalid_argument("discovery_period must be non-negative");
+  }
+  impl_->ros = ros;
+  impl_->params = params;
+  impl_->resolved_topic_prefix = impl_->ResolveTopicName(params.topic_prefix);
+  if (impl_->resolved_topic_prefix.back() != '/') {
+    impl_->resolved_topic_prefix += '/';
+  }
+}
+
+DrakeRosLcm::~DrakeRosLcm() {}
+
+std::string DrakeRosLcm::GetTopicName(std::string_view channel) const {
+  std::string topic_name = impl_->params.topic_prefix + "/";
+  if (!channel.empty() &&
+      std::isdigit(static_cast<unsigned char>(channel[0]))) {
+    // Topic name tokens may not start with a digit.
+    topic_name += '_';
+  }
+  for (char c : channel) {
+    const bool valid = std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+    topic_name += valid ? c : '_';
+  }
+  return topic_name;
+}
+
+std::string DrakeRosLcm::get_lcm_url() const {
+  return "ros2:" + impl_->resolved_topic_prefix;
+}
+
+void DrakeRosLcm::Publish(const std::string& channel, const void* data,
+                          int data_size, std::optional<double> time_sec) {
+  (void)time_sec;
+  DRAKE_THROW_UNLESS(!channel.empty());
+  DRAKE_THROW_UNLESS(data_size >= 0);
+  DRAKE_THROW_UNLESS(data != nullptr || data_size == 0);
+  const std::string topic_name = GetTopicName(channel);
+  rclcpp::Publisher<LcmMessage>::SharedPtr pub;
+  {
+    std::lock_guard<std::mutex> lock(impl_->mutex);
+    const std::string resolved_topic_name =
+        impl_->ResolveTopicName(topic_name);
+    auto it = impl_->pubs.find(resolved_topic_name);
+    if (it == impl_->pubs.end()) {
+      it = impl_->pubs
+               .emplace(resolved_topic_name,
+                        impl_->ros->get_mutable_node()
+                            ->create_publisher<LcmMessage>(
+                                resolved_topic_name, impl_->params.qos))
+               .first;
+    }
+    pub = it->second;
+  }
+
+  // A 1-D layout, as documented in the header: size and stride are both
+  // the number of bytes, and the label carries the channel name.
+  LcmMessage message;
+  message.layout.dim.resize(1);
+  message.layout.dim[0].label = channel;
+  message.layout.dim[0].size = static_cast<uint32_t>(data_size);
+  message.layout.dim[0].stride = static_cast<uint32_t>(data_size);
+  const auto* bytes = static_cast<const uint8_t*>(data);
+  message.data.assign(bytes, bytes + data_size);
+  pub->publish(message);
+}
+
+std::shared_ptr<drake::lcm::DrakeSubscriptionInterface> DrakeRosLcm::Subscribe(
+    const std::string& channel, HandlerFunction handler) {
+  DRAKE_THROW_UNLESS(!channel.empty());
+  DRAKE_THROW_UNLESS(handler != nullptr);
+  return impl_->AddSubscription(
+      std::make_shared<LcmSubscription>(
+          channel,
+          [handler = std::move(handler)](std::string_view, const void* data,
+                                         int size) { handler(data, size); }),
+      GetTopicName(channel));
+}
+
+std::shared_ptr<drake::lcm::DrakeSubscriptionInterface>
+DrakeRosLcm::SubscribeMultichannel(std::string_view regex,
+                                   MultichannelHandlerFunction handler) {
+  DRAKE_THROW_UNLESS(handler != nullptr);
+  return impl_->AddSubscription(
+      std::make_shared<LcmSubscription>(std::regex(std::string(regex)),
+                                        std::move(handler)),
+      std::nullopt);
+}
+
+std::shared_ptr<drake::lcm::DrakeSubscriptionInterface>
+DrakeRosLcm::SubscribeAllChannels(MultichannelHandlerFunction handler) {
+  return SubscribeMultichannel(".*", std::move(handler));
+}
+
+int DrakeRosLcm::HandleSubscriptions(int timeout_millis) {
+  DRAKE_THROW_UNLESS(timeout_millis >= 0);
+  const auto deadline = std::chrono::steady_clock::now() +
+                        std::chrono::milliseconds(timeout_millis);
+  int num_handled = 0;
+  while (true) {
+    std::vector<std::shared_ptr<LcmSubscription>> lcm_subs;
+    {
+      std::lock_guard<std::mutex> lock(impl_->mutex);
+      impl_->DiscoverTopics();
+    }
+    // Messages may be received here, or elsewhere if the node is spun
+    // elsewhere.
+    impl_->ros->Spin(0);
+    {
+      std::lock_guard<std::mutex> lock(impl_->mutex);
+      lcm_subs = impl_->GetLiveSubscriptions();
+    }
+    // Invoke handlers without holding the lock, as they may publish.
+    for (const auto& lcm_sub : lcm_subs) {
+      num_handled += lcm_sub->Dispatch();
+    }
+    const auto now = std::chrono::steady_clock::now();
+    if (num_handled > 0 || now >= deadline) {
+      break;
+    }
+    // Wait for messages to arrive, polling the node every so often.
+    constexpr auto kPollPeriod = std::chrono::milliseconds(10);
+    std::unique_lock<std::mutex> lock(impl_->mutex);
+    impl_->cv.wait_until(lock, std::min(deadline, now + kPollPeriod), [&]() {
+      return std::any_of(
+          impl_->lcm_subs.begin(), impl_->lcm_subs.end(),
+          [](const auto& lcm_sub) { return lcm_sub->HasPending(); });
+    });
+  }
+  return num_handled;
+}
+
+void DrakeRosLcm::OnHandleSubscriptionsError(const std::string& error_message) {
+  throw std::runtime_error(error_message);
+}
+}  // namespace core
+}  // namespace drake_ros
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include <drake/lcm/drake_lcm_interface.h>
+#include <rclcpp/qos.hpp>
+
+#include "drake_ros/core/drake_ros.h"
+
+namespace drake_ros {
+namespace core {
+
+/** Set of parameters that configure a DrakeRosLcm. */
+struct DrakeRosLcmParams {
+  /** Namespace for LCM channel topics, relative to that of the node. */
+  std::string topic_prefix{"lcm"};
+
+  /** Quality of service for LCM channel topics. */
+  rclcpp::QoS qos{rclcpp::QoS(10).reliable()};
+
+  /** Minimum period, in seconds, between ROS graph queries to discover new
+   LCM channel topics, for multichannel subscriptions only. */
+  double discovery_period{1.0};
+};
+
+/** A Drake LCM interface implementation that uses ROS as transport.
+
+ LCM messages are carried, as raw payloads, over one ROS topic per LCM
+ channel, namely `<topic_prefix>/<channel>` with characters that are not
+ valid in ROS topic names replaced by underscores. The ROS message type is
+ `std_msgs/msg/UInt8MultiArray`, with a plain one-dimensional layout: the
+ payload is the data, and the layout has a single dimension whose size and
+ stride are both the payload size, as for any 1-D array, and whose label
+ is the LCM channel (so that LCM channel names survive topic name
+ sanitization). The layout data offset is always zero.
+
+ This allows LCM-based systems (e.g. DrakeVisualizer via LcmInterfaceSystem)
+ to run over the same ROS node, and thus the same transport and executor,
+ as drake_ros systems.
+
+ As with drake::lcm::DrakeLcm, subscription handlers are only invoked from
+ within HandleSubscriptions(). Messages received in between are queued,
+ up to each subscription queue capacity (1 by default, i.e. only the latest
+ message is kept).
+ */
+class DrakeRosLcm final : public drake::lcm::DrakeLcmInterface {
+ public:
+  /** A constructor that uses the given `ros` interface.
+   @param[in] ros interface to the ROS node to use. It must outlive this
+     instance.
+   @param[in] params optional configuration.
+   */
+  explicit DrakeRosLcm(DrakeRos* ros, const DrakeRosLcmParams& params = {});
+
+  ~DrakeRosLcm() override;
+
+  /** Returns the ROS topic name for a given LCM `channel`. */
+  std::string GetTopicName(std::string_view channel) const;
+
+  std::string get_lcm_url() const override;
+
+  void Publish(const std::string& channel, const void* data, int data_size,
+               std::optional<double> time_sec) override;
+
+  std::shared_ptr<drake::lcm::DrakeSubscriptionInterface> Subscribe(
+      const std::string& channel, HandlerFunction handler) override;
+
+  std::shared_ptr<drake::lcm::DrakeSubscriptionInterface>
+  SubscribeMultichannel(std::string_view regex,
+                        MultichannelHandlerFunction handler) override;
+
+  std::shared_ptr<drake::lcm::DrakeSubscriptionInterface>
+  SubscribeAllChannels(MultichannelHandlerFunction handler) override;
+
+  /** Spins the ROS node (see DrakeRos::Spin()) and invokes handlers for
+   all queued messages, waiting up to `timeout_millis` for messages to
+   arrive if none is queued.
+   @returns the number of messages handled.
+   */
+  int HandleSubscriptions(int timeout_millis) override;
+
+ private:
+  void OnHandleSubscriptionsError(const std::string& error_message) override;
+
+  struct Impl;
+  std::unique_ptr<Impl> impl_;
+};
+}  // namespace core
+}  // namespace drake_ros
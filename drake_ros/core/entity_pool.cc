@@ -0,0 +1,125 @@
+#include "entity_pool.h"  // NOLINT(build/include)
+
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace drake_ros {
+namespace core {
+namespace internal {
+std::shared_ptr<SharedSubscription> SharedSubscription::make(
+    rclcpp::Node* node, const rosidl_message_type_support_t& ts,
+    const std::string& topic_name, const rclcpp::QoS& qos,
+    rclcpp::CallbackGroup::SharedPtr group,
+    const rclcpp::ContentFilterOptions& content_filter_options) {
+  std::shared_ptr<SharedSubscription> shared_sub(new SharedSubscription());
+  // The subscription may outlive this instance while it is being executed.
+  std::weak_ptr<SharedSubscription> weak_shared_sub = shared_sub;
+  shared_sub->sub_ = std::make_shared<Subscription>(
+      node->get_node_base_interface().get(), ts, topic_name, qos,
+      [weak_shared_sub](std::shared_ptr<rclcpp::SerializedMessage> message) {
+        if (auto shared_sub = weak_shared_sub.lock()) {
+          shared_sub->dispatch(message);
+        }
+      },
+      /* message_pool_size */ 0u, content_filter_options);
+  node->get_node_topics_interface()->add_subscription(shared_sub->sub_,
+                                                      std::move(group));
+  return shared_sub;
+}
+
+size_t SharedSubscription::add_callback(Callback callback,
+                                        size_t message_pool_size) {
+  sub_->grow_message_pool(message_pool_size);
+  std::lock_guard<AuditedMutex> lock(mutex_);
+  const size_t id = next_id_++;
+  callbacks_.emplace_back(id, std::move(callback));
+  return id;
+}
+
+void SharedSubscription::remove_callback(size_t id) {
+  std::lock_guard<AuditedMutex> lock(mutex_);
+  callbacks_.erase(
+      std::remove_if(callbacks_.begin(), callbacks_.end(),
+                     [id](const auto& entry) { return entry.first == id; }),
+      callbacks_.end());
+}
+
+void SharedSubscription::dispatch(
+    const std::shared_ptr<rclcpp::SerializedMessage>& message) {
+  std::lock_guard<AuditedMutex> lock(mutex_);
+  for (const auto& [id, callback] : callbacks_) {
+    (void)id;
+    callback(message);
+  }
+}
+
+template <typename EntityT>
+std::shared_ptr<EntityT> EntityPool::find(
+    std::vector<Entry<EntityT>>* entries, const std::string& topic_name,
+    const rosidl_message_type_support_t& ts, const rclcpp::QoS& qos,
+    const rclcpp::CallbackGroup* group) {
+  std::shared_ptr<EntityT> entity;
+  auto it = entries->begin();
+  while (it != entries->end()) {
+    std::shared_ptr<EntityT> candidate = it->entity.lock();
+    if (!candidate) {
+      it = entries->erase(it);
+      continue;
+    }
+    if (!entity && it->topic_name == topic_name && it->ts == &ts &&
+        it->qos == qos && it->group == group) {
+      entity = std::move(candidate);
+    }
+    ++it;
+  }
+  return entity;
+}
+
+std::shared_ptr<Publisher> EntityPool::get_publisher(
+    const rosidl_message_type_support_t& ts, const std::string& topic_name,
+    const rclcpp::QoS& qos) {
+  // Compare fully qualified names e.g. for private topics.
+  const std::string resolved_topic_name =
+      node_->get_node_topics_interface()->resolve_topic_name(topic_name);
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::shared_ptr<Publisher> pub =
+      find(&publishers_, resolved_topic_name, ts, qos, nullptr);
+  if (!pub) {
+    pub = std::make_shared<Publisher>(node_->get_node_base_interface().get(),
+                                      ts, topic_name, qos);
+    node_->get_node_topics_interface()->add_publisher(pub, nullptr);
+    publishers_.push_back({resolved_topic_name, &ts, qos, nullptr, pub});
+  }
+  return pub;
+}
+
+std::unique_ptr<SubscriptionToken> EntityPool::subscribe(
+    const rosidl_message_type_support_t& ts, const std::string& topic_name,
+    const rclcpp::QoS& qos, SharedSubscription::Callback callback,
+    size_t message_pool_size, rclcpp::CallbackGroup::SharedPtr group) {
+  // Compare fully qualified names e.g. for private topics.
+  const std::string resolved_topic_name =
+      node_->get_node_topics_interface()->resolve_topic_name(topic_name);
+  std::shared_ptr<SharedSubscription> shared_sub;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    shared_sub =
+        find(&subscriptions_, resolved_topic_name, ts, qos, group.get());
+    if (!shared_sub) {
+      shared_sub =
+          SharedSubscription::make(node_, ts, topic_name, qos, group);
+      subscriptions_.push_back(
+          {resolved_topic_name, &ts, qos, group.get(), shared_sub});
+    }
+  }
+  const size_t id =
+      shared_sub->add_callback(std::move(callback), message_pool_size);
+  return std::make_unique<SubscriptionToken>(std::move(shared_sub), id);
+}
+}  // namespace internal
+}  // namespace core
+}  // namespace drake_ros
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "publisher.h"       // NOLINT(build/include)
+#include "realtime_audit.h"  // NOLINT(build/include)
+#include "subscription.h"    // NOLINT(build/include)
+#include <rclcpp/node.hpp>
+#include <rclcpp/qos.hpp>
+#include <rclcpp/serialized_message.hpp>
+#include <rclcpp/subscription_content_filter_options.hpp>
+#include <rosidl_runtime_c/message_type_support_struct.h>
+
+namespace drake_ros {
+namespace core {
+namespace internal {
+// A subscription shared by all subscribers to a topic with a given type and
+// QoS. Every message taken is fanned out to all subscriber callbacks.
+// Subscriptions that cannot be shared (e.g. content filtered ones) may use
+// it on their own, outside any pool, for their callbacks to be removable.
+// This class conforms to the ROS 2 C++ style for consistency.
+class SharedSubscription final
+    : public std::enable_shared_from_this<SharedSubscription> {
+ public:
+  using Callback =
+      std::function<void(std::shared_ptr<rclcpp::SerializedMessage>)>;
+
+  // Subscribes to `topic_name` on `node`, servicing it with `group` (or the
+  // node default callback group if null). Content filter options, if any,
+  // are set on creation. Throws if the middleware rejects them.
+  static std::shared_ptr<SharedSubscription> make(
+      rclcpp::Node* node, const rosidl_message_type_support_t& ts,
+      const std::string& topic_name, const rclcpp::QoS& qos,
+      rclcpp::CallbackGroup::SharedPtr group = nullptr,
+      const rclcpp::ContentFilterOptions& content_filter_options = {});
+
+  // Adds a `callback` for messages, growing the message pool by
+  // `message_pool_size`. Returns an ID to remove it with.
+  size_t add_callback(Callback callback, size_t message_pool_size);
+
+  // Removes the callback with the given `id`. Once this returns, the
+  // callback is guaranteed not to be called (anymore).
+  void remove_callback(size_t id);
+
+  // Returns counts of QoS events on the shared subscription so far.
+  QosEventStatus get_qos_event_status() const {
+    return sub_->get_qos_event_status();
+  }
+
+  // Returns the underlying subscription.
+  Subscription* get_subscription() const { return sub_.get(); }
+
+ private:
+  SharedSubscription() = default;
+
+  void dispatch(const std::shared_ptr<rclcpp::SerializedMessage>& message);
+
+  // Mutex to synchronize callback dispatch and (de)registration.
+  AuditedMutex mutex_;
+  // Registered callbacks along with their IDs.
+  std::vector<std::pair<size_t, Callback>> callbacks_;
+  size_t next_id_{0};
+  std::shared_ptr<Subscription> sub_;
+};
+
+// Keeps a callback registered with a shared subscription while alive.
+class SubscriptionToken final {
+ public:
+  SubscriptionToken(std::shared_ptr<SharedSubscription> shared_sub, size_t id)
+      : shared_sub_(std::move(shared_sub)), id_(id) {}
+
+  ~SubscriptionToken() { shared_sub_->remove_callback(id_); }
+
+  // Returns counts of QoS events on the shared subscription so far.
+  QosEventStatus get_qos_event_status() const {
+    return shared_sub_->get_qos_event_status();
+  }
+
+  SubscriptionToken(const SubscriptionToken&) = delete;
+  SubscriptionToken& operator=(const SubscriptionToken&) = delete;
+
+ private:
+  std::shared_ptr<SharedSubscription> shared_sub_;
+  size_t id_;
+};
+
+// A pool of publishers and subscriptions, shared by topic, type and QoS.
+// Systems that publish or subscribe to the same topic with the same type and
+// QoS thus share the underlying middleware entities.
+// This class conforms to the ROS 2 C++ style for consistency.
+class EntityPool final {
+ public:
+  explicit EntityPool(rclcpp::Node* node) : node_(node) {}
+
+  // Returns a publisher to `topic_name` with `ts` type and `qos`, creating
+  // it if no other is alive. Publisher events are handled as the node spins.
+  std::shared_ptr<Publisher> get_publisher(
+      const rosidl_message_type_support_t& ts, const std::string& topic_name,
+      const rclcpp::QoS& qos);
+
+  // Subscribes `callback` to `topic_name` with `ts` type and `qos`, sharing
+  // the underlying subscription with other subscribers if any. The pool of
+  // serialized messages to reuse grows by `message_pool_size`. The
+  // subscription is serviced with `group` (or the node default callback
+  // group if null), and only shared with subscribers using the same group.
+  // The callback is called until the returned token is destroyed.
+  std::unique_ptr<SubscriptionToken> subscribe(
+      const rosidl_message_type_support_t& ts, const std::string& topic_name,
+      const rclcpp::QoS& qos, SharedSubscription::Callback callback,
+      size_t message_pool_size = 0u,
+      rclcpp::CallbackGroup::SharedPtr group = nullptr);
+
+ private:
+  // Entities are kept by weak reference, and thus go away with their users.
+  template <typename EntityT>
+  struct Entry {
+    std::string topic_name;
+    const rosidl_message_type_support_t* ts;
+    rclcpp::QoS qos;
+    // Callback group, null for the node default callback group.
+    const rclcpp::CallbackGroup* group;
+    std::weak_ptr<EntityT> entity;
+  };
+
+  // Looks up a live entity in `entries`, pruning expired entries on the go.
+  template <typename EntityT>
+  static std::shared_ptr<EntityT> find(std::vector<Entry<EntityT>>* entries,
+                                       const std::string& topic_name,
+                                       const rosidl_message_type_support_t& ts,
+                                       const rclcpp::QoS& qos,
+                                       const rclcpp::CallbackGroup* group);
+
+  rclcpp::Node* node_;
+  // Mutex to synchronize access to the pool.
+  std::mutex mutex_;
+  std::vector<Entry<Publisher>> publishers_;
+  std::vector<Entry<SharedSubscription>> subscriptions_;
+};
+}  // namespace internal
+}  // namespace core
+}  // namespace drake_ros
@@ -0,0 +1,104 @@
+#include "drake_ros/core/inbound_message_log.h"
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <drake/common/drake_throw.h>
+
+namespace drake_ros {
+namespace core {
+namespace {
+// Log files start with this magic string, followed by entries. Each entry
+// is made of the time as a raw double, the message length as an uint64_t,
+// and the message bytes. Values are stored in host byte order.
+constexpr char kMagic[] = "drake_ros_inbound_log_v1";
+
+template <typename T>
+void WriteValue(std::ofstream& stream, const T& value) {
+  stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+bool ReadValue(std::ifstream& stream, T* value) {
+  return static_cast<bool>(
+      stream.read(reinterpret_cast<char*>(value), sizeof(T)));
+}
+}  // namespace
+
+void InboundMessageLog::Append(
+    double time, std::shared_ptr<const rclcpp::SerializedMessage> message) {
+  DRAKE_THROW_UNLESS(message != nullptr);
+  std::lock_guard<std::mutex> lock(mutex_);
+  entries_.push_back({time, std::move(message)});
+}
+
+std::vector<InboundMessageLog::Entry> InboundMessageLog::entries() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return entries_;
+}
+
+size_t InboundMessageLog::size() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return entries_.size();
+}
+
+void InboundMessageLog::Save(const std::string& path) const {
+  std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+  if (!stream) {
+    throw std::runtime_error("cannot open '" + path + "' for writing");
+  }
+  stream.write(kMagic, sizeof(kMagic));
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (const Entry& entry : entries_) {
+    const rcl_serialized_message_t& rcl_serialized_message =
+        entry.message->get_rcl_serialized_message();
+    WriteValue(stream, entry.time);
+    WriteValue(stream,
+               static_cast<uint64_t>(rcl_serialized_message.buffer_length));
+    stream.write(reinterpret_cast<const char*>(rcl_serialized_message.buffer),
+                 rcl_serialized_message.buffer_length);
+  }
+  if (!stream) {
+    throw std::runtime_error("failed to write '" + path + "'");
+  }
+}
+
+std::unique_ptr<InboundMessageLog> InboundMessageLog::Load(
+    const std::string& path) {
+  std::ifstream stream(path, std::ios::binary);
+  if (!stream) {
+    throw std::runtime_error("cannot open '" + path + "' for reading");
+  }
+  char magic[sizeof(kMagic)];
+  if (!stream.read(magic, sizeof(magic)) ||
+      std::memcmp(magic, kMagic, sizeof(kMagic)) != 0) {
+    throw std::runtime_error("'" + path + "' is not an inbound message log");
+  }
+
+  auto log = std::make_unique<InboundMessageLog>();
+  double time;
+  while (ReadValue(stream, &time)) {
+    uint64_t length;
+    if (!ReadValue(stream, &length)) {
+      throw std::runtime_error("'" + path + "' is truncated");
+    }
+    auto message = std::make_shared<rclcpp::SerializedMessage>(length);
+    rcl_serialized_message_t& rcl_serialized_message =
+        message->get_rcl_serialized_message();
+    if (!stream.read(reinterpret_cast<char*>(rcl_serialized_message.buffer),
+                     length)) {
+      throw std::runtime_error("'" + path + "' is truncated");
+    }
+    rcl_serialized_message.buffer_length = length;
+    log->entries_.push_back({time, std::move(message)});
+  }
+  return log;
+}
+}  // namespace core
+}  // namespace drake_ros
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <rclcpp/serialized_message.hpp>
+
+namespace drake_ros {
+namespace core {
+/** A log of serialized ROS messages, along with the exact simulation times
+ at which they were applied by a RosSubscriberSystem.
+
+ Logs are populated by subscriber systems in capture mode and consumed by
+ subscriber systems in replay mode. See RosSubscriberSystem documentation
+ for further reference. Appending to a log is thread-safe.
+ */
+class InboundMessageLog final {
+ public:
+  /** A log entry. */
+  struct Entry {
+    /** Simulation time at which the message was applied, in seconds. */
+    double time{0.0};
+    /** The serialized message applied. */
+    std::shared_ptr<const rclcpp::SerializedMessage> message;
+  };
+
+  InboundMessageLog() = default;
+
+  /** Appends a `message` applied at simulation `time`. */
+  void Append(double time,
+              std::shared_ptr<const rclcpp::SerializedMessage> message);
+
+  /** Returns a copy of all entries, in order of appending. Messages are
+   shared, not copied. */
+  std::vector<Entry> entries() const;
+
+  /** Returns the number of entries in the log. */
+  size_t size() const;
+
+  /** Saves the log to a file at `path`, overwriting it if need be.
+   Times are saved bit-for-bit.
+   @throws std::runtime_error if the file cannot be written.
+   */
+  void Save(const std::string& path) const;
+
+  /** Loads a log from a file at `path`, as saved by Save().
+   @throws std::runtime_error if the file cannot be read or is not a log.
+   */
+  static std::unique_ptr<InboundMessageLog> Load(const std::string& path);
+
+ private:
+  mutable std::mutex mutex_;
+  std::vector<Entry> entries_;
+};
+}  // namespace core
+}  // namespace drake_ros
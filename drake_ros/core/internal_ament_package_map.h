@@ -0,0 +1,26 @@
+#pragma once
+
+#include <filesystem>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace drake_ros {
+namespace core {
+namespace internal {
+
+/* Returns the location of all packages in the ament index of the given
+ `prefixes`, as a map from package name to package share directory. Earlier
+ prefixes take precedence, as in AMENT_PREFIX_PATH.
+
+ Results are cached in `cache_directory`, if any, and keyed on the
+ prefixes and the last time packages were (un)installed in each. A cache
+ file is used as long as its key matches and it is well formed. */
+std::map<std::string, std::string> LoadAmentPackageDirectories(
+    const std::vector<std::string>& prefixes,
+    const std::optional<std::filesystem::path>& cache_directory);
+
+}  // namespace internal
+}  // namespace core
+}  // namespace drake_ros
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include <rclcpp/serialized_message.hpp>
+#include <rclcpp/time.hpp>
+
+namespace drake_ros {
+namespace core {
+/** An interface for sinks of serialized ROS messages, such as recorders.
+
+ Sinks are fed by publisher systems with the very same serialized messages
+ they publish, so no extra serialization takes place. Implementations
+ are expected to return quickly, deferring any expensive work (e.g. I/O),
+ as they are usually called from the simulation loop.
+ */
+class MessageSinkInterface {
+ public:
+  virtual ~MessageSinkInterface() = default;
+
+  /** Writes a serialized ROS message.
+   @param[in] topic_name Fully qualified name of the topic the message
+     was published to.
+   @param[in] type_name Name of the ROS message type
+     e.g. "std_msgs/msg/String".
+   @param[in] message the serialized ROS message. It is never modified
+     after this call, so it may be kept (rather than copied) if need be.
+   @param[in] time the time at which the message was published.
+   */
+  virtual void Write(const std::string& topic_name,
+                     const std::string& type_name,
+                     std::shared_ptr<const rclcpp::SerializedMessage> message,
+                     const rclcpp::Time& time) = 0;
+};
+}  // namespace core
+}  // namespace drake_ros
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+#include "realtime_audit.h"  // NOLINT(build/include)
+
+namespace drake_ros {
+namespace core {
+namespace internal {
+// A synchronized, single-value buffer that keeps the latest value put into it.
+//
+// Values are tagged with a monotonically increasing sequence number. Unlike a
+// queue, reading does not consume the value, so any number of readers (e.g.
+// one per Context of the same system) can observe it and use the sequence
+// number to tell whether they have seen it already.
+// This class conforms to the ROS 2 C++ style for consistency.
+template <typename T>
+class MessageSlot final {
+ public:
+  // Stores `value` as the latest value, bumping the sequence number.
+  void Put(std::shared_ptr<T> value) {
+    std::lock_guard<AuditedMutex> lock(mutex_);
+    value_ = std::move(value);
+    sequence_.fetch_add(1, std::memory_order_release);
+  }
+
+  // Returns the latest value along with its sequence number, or a null value
+  // and a sequence number of 0 if no value has been put yet.
+  std::pair<std::shared_ptr<T>, uint64_t> Get() const {
+    std::lock_guard<AuditedMutex> lock(mutex_);
+    return {value_, sequence_.load(std::memory_order_relaxed)};
+  }
+
+  // Returns the sequence number of the latest value, without locking.
+  uint64_t sequence() const {
+    return sequence_.load(std::memory_order_acquire);
+  }
+
+ private:
+  // Mutex to synchronize access to the value.
+  mutable AuditedMutex mutex_;
+  // Latest value (i.e. a buffer of size 1).
+  std::shared_ptr<T> value_;
+  // Number of values put so far.
+  std::atomic<uint64_t> sequence_{0};
+};
+}  // namespace internal
+}  // namespace core
+}  // namespace drake_ros
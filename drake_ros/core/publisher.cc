@@ -1,7 +1,11 @@
 #include "publisher.h"  // NOLINT(build/include)
 
+#include <memory>
 #include <string>
+#include <utility>
 
+#include "qos_event_counters.h"  // NOLINT(build/include)
+#include "realtime_audit.h"      // NOLINT(build/include)
 #include <rclcpp/version.h>
 
 namespace drake_ros {
@@ -19,16 +23,43 @@ rcl_publisher_options_t publisher_options(const rclcpp::QoS& qos) {
 Publisher::Publisher(rclcpp::node_interfaces::NodeBaseInterface* node_base,
                      const rosidl_message_type_support_t& type_support,
                      const std::string& topic_name, const rclcpp::QoS& qos)
+    : Publisher(node_base, type_support, topic_name, qos,
+                std::make_shared<QosEventCounters>()) {}
+
+Publisher::Publisher(rclcpp::node_interfaces::NodeBaseInterface* node_base,
+                     const rosidl_message_type_support_t& type_support,
+                     const std::string& topic_name, const rclcpp::QoS& qos,
+                     std::shared_ptr<QosEventCounters> event_counters)
 #if RCLCPP_VERSION_GTE(18, 0, 0)
     : rclcpp::PublisherBase(node_base, topic_name, type_support,
                             publisher_options(qos),
-                            /* event_callbacks */ {},
-                            /* use_default_callbacks */ true)
+                            QosEventCounters::make_publisher_callbacks(
+                                event_counters, topic_name),
+                            /* use_default_callbacks */ true),
 #else
     : rclcpp::PublisherBase(node_base, topic_name, type_support,
-                            publisher_options(qos))
+                            publisher_options(qos)),
+#endif
+      event_counters_(std::move(event_counters)) {
+#if !RCLCPP_VERSION_GTE(18, 0, 0)
+  // Bind event callbacks as rclcpp::Publisher would.
+  const rclcpp::PublisherEventCallbacks callbacks =
+      QosEventCounters::make_publisher_callbacks(event_counters_, topic_name);
+  auto try_add_event_handler = [this](const auto& callback,
+                                      rcl_publisher_event_type_t event_type) {
+    try {
+      add_event_handler(callback, event_type);
+    } catch (const rclcpp::UnsupportedEventTypeException&) {
+      // Not all RMW implementations support all events.
+    }
+  };
+  try_add_event_handler(callbacks.deadline_callback,
+                        RCL_PUBLISHER_OFFERED_DEADLINE_MISSED);
+  try_add_event_handler(callbacks.liveliness_callback,
+                        RCL_PUBLISHER_LIVELINESS_LOST);
+  try_add_event_handler(callbacks.incompatible_qos_callback,
+                        RCL_PUBLISHER_OFFERED_INCOMPATIBLE_QOS);
 #endif
-{
 }
 
 Publisher::~Publisher() {}
@@ -36,6 +67,7 @@ Publisher::~Publisher() {}
 void Publisher::publish(const rclcpp::SerializedMessage& serialized_msg) {
   // TODO(sloretz) Copied from rosbag2_transport GenericPublisher, can it be
   // upstreamed to rclcpp?
+  ScopedDelegateCall call;
   auto return_code = rcl_publish_serialized_message(
       get_publisher_handle().get(),
       &serialized_msg.get_rcl_serialized_message(), NULL);
@@ -45,6 +77,9 @@ void Publisher::publish(const rclcpp::SerializedMessage& serialized_msg) {
         return_code, "failed to publish serialized message");
   }
 }
+QosEventStatus Publisher::get_qos_event_status() const {
+  return event_counters_->get_status();
+}
 }  // namespace internal
 }  // namespace core
 }  // namespace drake_ros
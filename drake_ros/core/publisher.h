@@ -8,9 +8,13 @@
 #include <rclcpp/serialized_message.hpp>
 #include <rosidl_runtime_c/message_type_support_struct.h>
 
+#include "drake_ros/core/qos_event_status.h"
+
 namespace drake_ros {
 namespace core {
 namespace internal {
+class QosEventCounters;
+
 // A type-erased version of rclcpp:::Publisher<Message>.
 // This class conforms to the ROS 2 C++ style for consistency.
 class Publisher final : public rclcpp::PublisherBase {
@@ -22,6 +26,17 @@ class Publisher final : public rclcpp::PublisherBase {
   ~Publisher();
 
   void publish(const rclcpp::SerializedMessage& serialized_msg);
+
+  // Returns counts of QoS events on this publisher so far.
+  QosEventStatus get_qos_event_status() const;
+
+ private:
+  Publisher(rclcpp::node_interfaces::NodeBaseInterface* node_base,
+            const rosidl_message_type_support_t& ts,
+            const std::string& topic_name, const rclcpp::QoS& qos,
+            std::shared_ptr<QosEventCounters> event_counters);
+
+  std::shared_ptr<QosEventCounters> event_counters_;
 };
 }  // namespace internal
 }  // namespace core
@@ -0,0 +1,96 @@
+#include "qos_event_counters.h"  // NOLINT(build/include)
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include <rclcpp/logging.hpp>
+#include <rclcpp/qos.hpp>
+
+namespace drake_ros {
+namespace core {
+namespace internal {
+namespace {
+// Warns about incompatible QoS, as rclcpp default event callbacks would.
+void WarnIncompatibleQos(const char* message, const std::string& topic_name,
+                         rmw_qos_policy_kind_t last_policy_kind) {
+  RCLCPP_WARN(rclcpp::get_logger("drake_ros"),
+              "%s on topic '%s'. Last incompatible policy: %s", message,
+              topic_name.c_str(),
+              rclcpp::qos_policy_name_from_kind(last_policy_kind).c_str());
+}
+}  // namespace
+
+rclcpp::PublisherEventCallbacks QosEventCounters::make_publisher_callbacks(
+    std::shared_ptr<QosEventCounters> counters,
+    const std::string& topic_name) {
+  rclcpp::PublisherEventCallbacks callbacks;
+  callbacks.deadline_callback =
+      [counters](rclcpp::QOSDeadlineOfferedInfo& info) {
+        counters->deadline_missed_.store(info.total_count,
+                                         std::memory_order_relaxed);
+      };
+  callbacks.liveliness_callback =
+      [counters](rclcpp::QOSLivelinessLostInfo& info) {
+        counters->liveliness_lost_.store(info.total_count,
+                                         std::memory_order_relaxed);
+      };
+  callbacks.incompatible_qos_callback =
+      [counters, topic_name](rclcpp::QOSOfferedIncompatibleQoSInfo& info) {
+        counters->incompatible_qos_.store(info.total_count,
+                                          std::memory_order_relaxed);
+        WarnIncompatibleQos(
+            "New subscription discovered requesting incompatible QoS",
+            topic_name, info.last_policy_kind);
+      };
+  return callbacks;
+}
+
+rclcpp::SubscriptionEventCallbacks
+QosEventCounters::make_subscription_callbacks(
+    std::shared_ptr<QosEventCounters> counters,
+    const std::string& topic_name) {
+  rclcpp::SubscriptionEventCallbacks callbacks;
+  callbacks.deadline_callback =
+      [counters](rclcpp::QOSDeadlineRequestedInfo& info) {
+        counters->deadline_missed_.store(info.total_count,
+                                         std::memory_order_relaxed);
+      };
+  callbacks.liveliness_callback =
+      [counters](rclcpp::QOSLivelinessChangedInfo& info) {
+        // Only count publishers that are no longer alive.
+        if (info.not_alive_count_change > 0) {
+          counters->liveliness_lost_.fetch_add(info.not_alive_count_change,
+                                               std::memory_order_relaxed);
+        }
+        counters->alive_publishers_.store(info.alive_count,
+                                          std::memory_order_relaxed);
+      };
+  callbacks.incompatible_qos_callback =
+      [counters, topic_name](rclcpp::QOSRequestedIncompatibleQoSInfo& info) {
+        counters->incompatible_qos_.store(info.total_count,
+                                          std::memory_order_relaxed);
+        WarnIncompatibleQos(
+            "New publisher discovered offering incompatible QoS", topic_name,
+            info.last_policy_kind);
+      };
+  callbacks.message_lost_callback =
+      [counters](rclcpp::QOSMessageLostInfo& info) {
+        counters->messages_lost_.store(static_cast<int>(info.total_count),
+                                       std::memory_order_relaxed);
+      };
+  return callbacks;
+}
+
+QosEventStatus QosEventCounters::get_status() const {
+  QosEventStatus status;
+  status.deadline_missed = deadline_missed_.load(std::memory_order_relaxed);
+  status.liveliness_lost = liveliness_lost_.load(std::memory_order_relaxed);
+  status.alive_publishers = alive_publishers_.load(std::memory_order_relaxed);
+  status.incompatible_qos = incompatible_qos_.load(std::memory_order_relaxed);
+  status.messages_lost = messages_lost_.load(std::memory_order_relaxed);
+  return status;
+}
+}  // namespace internal
+}  // namespace core
+}  // namespace drake_ros
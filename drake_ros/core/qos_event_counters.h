@@ -0,0 +1,46 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include <rclcpp/publisher_base.hpp>
+#include <rclcpp/subscription_base.hpp>
+
+#include "drake_ros/core/qos_event_status.h"
+
+namespace drake_ros {
+namespace core {
+namespace internal {
+// Counts QoS events, as reported by the middleware via event callbacks.
+// Counts are updated on the executor thread without blocking, and may be
+// read from any thread.
+// This class conforms to the ROS 2 C++ style for consistency.
+class QosEventCounters final {
+ public:
+  // Returns event callbacks for a publisher to `topic_name` that update
+  // `counters`.
+  static rclcpp::PublisherEventCallbacks make_publisher_callbacks(
+      std::shared_ptr<QosEventCounters> counters,
+      const std::string& topic_name);
+
+  // Returns event callbacks for a subscription to `topic_name` that update
+  // `counters`.
+  static rclcpp::SubscriptionEventCallbacks make_subscription_callbacks(
+      std::shared_ptr<QosEventCounters> counters,
+      const std::string& topic_name);
+
+  // Returns all counts so far. Each count is up to date on its own.
+  QosEventStatus get_status() const;
+
+ private:
+  std::atomic<int> deadline_missed_{0};
+  std::atomic<int> liveliness_lost_{0};
+  std::atomic<int> alive_publishers_{0};
+  std::atomic<int> incompatible_qos_{0};
+  std::atomic<int> messages_lost_{0};
+};
+}  // namespace internal
+}  // namespace core
+}  // namespace drake_ros
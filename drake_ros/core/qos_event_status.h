@@ -0,0 +1,33 @@
+#pragma once
+
+namespace drake_ros {
+namespace core {
+
+/** Counts of QoS events on a ROS publisher or subscription, as reported by
+ the middleware. Counts are cumulative since the underlying entity was
+ created, and events that do not apply to an entity are never counted.
+ */
+struct QosEventStatus {
+  /** Number of missed deadlines, i.e. deadline periods that elapsed without
+   a message being published (publishers) or received (subscriptions). */
+  int deadline_missed{0};
+
+  /** Number of times liveliness was lost (publishers), or the number of
+   times a matched publisher was deemed no longer alive (subscriptions). */
+  int liveliness_lost{0};
+
+  /** Number of matched publishers currently alive (subscriptions only). */
+  int alive_publishers{0};
+
+  /** Number of times a publisher or subscription with incompatible QoS was
+   discovered. No messages flow between incompatible entities. */
+  int incompatible_qos{0};
+
+  /** Number of messages lost e.g. dropped by the middleware before they
+   could be taken (subscriptions only). */
+  int messages_lost{0};
+
+  bool operator==(const QosEventStatus&) const = default;
+};
+}  // namespace core
+}  // namespace drake_ros
@@ -0,0 +1,96 @@
+#include "drake_ros/core/realtime.h"
+
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include "realtime_audit.h"  // NOLINT(build/include)
+
+namespace drake_ros {
+namespace core {
+namespace internal {
+namespace {
+// Scope the calling thread is executing in.
+thread_local CallScope g_call_scope{CallScope::kOther};
+
+// Number of lock contentions so far.
+std::atomic<uint64_t> g_lock_contention_count{0};
+}  // namespace
+
+CallScope GetCallScope() { return g_call_scope; }
+
+void RecordLockContention() {
+  g_lock_contention_count.fetch_add(1, std::memory_order_relaxed);
+}
+
+ScopedCall::ScopedCall(CallScope scope) : previous_scope_(g_call_scope) {
+  g_call_scope = scope;
+}
+
+ScopedCall::~ScopedCall() { g_call_scope = previous_scope_; }
+}  // namespace internal
+
+namespace {
+[[noreturn]] void ThrowFromErrno(const std::string& what, int error) {
+  throw std::runtime_error(what + ": " + std::strerror(error));
+}
+}  // namespace
+
+void ConfigureRealtime(const RealtimeParams& params) {
+  if (params.thread_priority != 0) {
+    const int min_priority = sched_get_priority_min(SCHED_FIFO);
+    const int max_priority = sched_get_priority_max(SCHED_FIFO);
+    if (params.thread_priority < min_priority ||
+        params.thread_priority > max_priority) {
+      throw std::invalid_argument("thread priority must be in [" +
+                                  std::to_string(min_priority) + ", " +
+                                  std::to_string(max_priority) + "]");
+    }
+    sched_param param{};
+    param.sched_priority = params.thread_priority;
+    const int error =
+        pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+    if (error != 0) {
+      ThrowFromErrno("failed to set thread priority", error);
+    }
+  }
+
+  if (!params.cpu_affinity.empty()) {
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    for (int cpu : params.cpu_affinity) {
+      if (cpu < 0 || cpu >= CPU_SETSIZE) {
+        throw std::invalid_argument("invalid CPU index " +
+                                    std::to_string(cpu));
+      }
+      CPU_SET(cpu, &cpu_set);
+    }
+    const int error =
+        pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set);
+    if (error != 0) {
+      ThrowFromErrno("failed to set thread affinity", error);
+    }
+  }
+
+  if (params.lock_memory) {
+    if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {
+      ThrowFromErrno("failed to lock memory", errno);
+    }
+  }
+}
+
+bool IsInDrakeRosCall() {
+  return internal::GetCallScope() == internal::CallScope::kDrakeRos;
+}
+
+uint64_t GetLockContentionCount() {
+  return internal::g_lock_contention_count.load(std::memory_order_relaxed);
+}
+}  // namespace core
+}  // namespace drake_ros
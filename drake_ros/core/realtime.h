@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace drake_ros {
+namespace core {
+/** Set of parameters that configure a thread for real-time operation.
+
+ Default values leave the thread (and process) as-is.
+ */
+struct RealtimeParams {
+  /** SCHED_FIFO priority to run the thread with, in [1, 99].
+   If zero, thread scheduling is left unchanged. */
+  int thread_priority{0};
+
+  /** Indices of the CPUs to pin the thread to.
+   If empty, thread affinity is left unchanged. */
+  std::vector<int> cpu_affinity{};
+
+  /** Whether to lock all current and future process memory in RAM,
+   so that it is never paged out. */
+  bool lock_memory{false};
+};
+
+/** Configures the calling thread for real-time operation.
+
+ This is meant to be called from the thread that steps simulation, and
+ thus spins the DrakeRos interface, before simulation starts. Note that
+ real-time scheduling and memory locking usually require privileges
+ (e.g. CAP_SYS_NICE and CAP_IPC_LOCK on Linux).
+
+ Note this does not make the publish and receive path allocation free.
+ In steady state, i.e. once buffers have grown to fit the messages at
+ hand, drake_ros code itself does not allocate in RosPublisherSystem
+ publication (unless message sinks or wall-clock publication are in use),
+ in RosSubscriberSystem message updates, nor in subscription callbacks
+ (provided subscriptions have a large enough message pool, see
+ RosSubscriberParams). The code drake_ros delegates to, namely the rclcpp
+ executor within DrakeRos::Spin(), the ROS middleware, and message
+ (de)serialization, is out of its control and may allocate on every
+ step. See IsInDrakeRosCall() to audit drake_ros code alone.
+
+ @param[in] params Real-time configuration.
+ @throws std::invalid_argument if the priority or any CPU index is out of
+   range.
+ @throws std::runtime_error if the configuration cannot be applied.
+ */
+void ConfigureRealtime(const RealtimeParams& params);
+
+/** Returns true if the calling thread is executing drake_ros code in the
+ publish and receive path, and false otherwise, including when drake_ros
+ code is executing code it delegates to (e.g. the rclcpp executor, ROS
+ middleware, and message serialization). This is meant to be used in
+ allocation hooks to audit drake_ros code real-time behavior. Allocations
+ in delegate code are deliberately not accounted for. */
+bool IsInDrakeRosCall();
+
+/** Returns the number of times, so far and process-wide, that drake_ros
+ code in the publish and receive path had to wait on a lock held by
+ another thread. */
+uint64_t GetLockContentionCount();
+}  // namespace core
+}  // namespace drake_ros
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <mutex>
+
+namespace drake_ros {
+namespace core {
+namespace internal {
+// Where the calling thread is executing code, for auditing purposes.
+enum class CallScope {
+  // Code outside drake_ros e.g. Drake or user code.
+  kOther,
+  // drake_ros code in the publish and receive path.
+  kDrakeRos,
+  // Code drake_ros delegates to e.g. ROS middleware or message serialization.
+  kDelegate,
+};
+
+// Returns the scope the calling thread is executing in.
+CallScope GetCallScope();
+
+// Records a lock contention.
+void RecordLockContention();
+
+// Sets the scope the calling thread is executing in, and restores the
+// previous one on destruction. Scopes may nest e.g. drake_ros callbacks
+// called from within the ROS middleware.
+// This class conforms to the ROS 2 C++ style for consistency.
+class ScopedCall final {
+ public:
+  explicit ScopedCall(CallScope scope);
+
+  ~ScopedCall();
+
+  ScopedCall(const ScopedCall&) = delete;
+  ScopedCall& operator=(const ScopedCall&) = delete;
+
+ private:
+  CallScope previous_scope_;
+};
+
+// A scope for drake_ros code in the publish and receive path.
+class ScopedDrakeRosCall final {
+ public:
+  ScopedDrakeRosCall() : call_(CallScope::kDrakeRos) {}
+
+ private:
+  ScopedCall call_;
+};
+
+// A scope for code drake_ros delegates to.
+class ScopedDelegateCall final {
+ public:
+  ScopedDelegateCall() : call_(CallScope::kDelegate) {}
+
+ private:
+  ScopedCall call_;
+};
+
+// A mutex that records contentions i.e. every time a thread has to wait
+// for another to release it. It meets BasicLockable requirements.
+class AuditedMutex final {
+ public:
+  void lock() {
+    if (!mutex_.try_lock()) {
+      RecordLockContention();
+      mutex_.lock();
+    }
+  }
+
+  bool try_lock() { return mutex_.try_lock(); }
+
+  void unlock() { mutex_.unlock(); }
+
+ private:
+  std::mutex mutex_;
+};
+}  // namespace internal
+}  // namespace core
+}  // namespace drake_ros
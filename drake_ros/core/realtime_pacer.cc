@@ -0,0 +1,81 @@
+#include "drake_ros/core/realtime_pacer.h"
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+namespace drake_ros {
+namespace core {
+struct RealtimePacer::Impl {
+  DrakeRos* ros;
+  double target_realtime_rate;
+  // Whether simulated time is anchored to wall-clock time.
+  bool anchored{false};
+  // Simulated time at the anchor.
+  double anchor_time{0.0};
+  // Wall-clock time at the anchor.
+  std::chrono::steady_clock::time_point anchor_realtime;
+};
+
+RealtimePacer::RealtimePacer(DrakeRos* ros, double target_realtime_rate)
+    : impl_(new Impl()) {
+  if (ros == nullptr) {
+    throw std::invalid_argument("ros must not be null");
+  }
+  if (!(target_realtime_rate > 0.0)) {
+    throw std::invalid_argument("target realtime rate must be positive");
+  }
+  impl_->ros = ros;
+  impl_->target_realtime_rate = target_realtime_rate;
+}
+
+RealtimePacer::~RealtimePacer() {}
+
+double RealtimePacer::target_realtime_rate() const {
+  return impl_->target_realtime_rate;
+}
+
+void RealtimePacer::Pace(double time) {
+  if (!impl_->anchored || time < impl_->anchor_time) {
+    impl_->anchored = true;
+    impl_->anchor_time = time;
+    impl_->anchor_realtime = std::chrono::steady_clock::now();
+    return;
+  }
+  const std::chrono::duration<double> elapsed_realtime(
+      (time - impl_->anchor_time) / impl_->target_realtime_rate);
+  impl_->ros->SpinUntil(
+      impl_->anchor_realtime +
+      std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+          elapsed_realtime));
+}
+
+void RealtimePacer::Reset() { impl_->anchored = false; }
+
+void EnableRealtimePacing(drake::systems::Simulator<double>* simulator,
+                          DrakeRos* ros, double target_realtime_rate) {
+  if (simulator == nullptr) {
+    throw std::invalid_argument("simulator must not be null");
+  }
+  auto pacer = std::make_shared<RealtimePacer>(ros, target_realtime_rate);
+  simulator->set_target_realtime_rate(0.0);
+  simulator->set_monitor(
+      [pacer, monitor = simulator->get_monitor()](
+          const drake::systems::Context<double>& root_context) {
+        drake::systems::EventStatus status =
+            drake::systems::EventStatus::DidNothing();
+        if (monitor) {
+          status = monitor(root_context);
+          if (status.severity() >=
+              drake::systems::EventStatus::kReachedTermination) {
+            return status;
+          }
+        }
+        pacer->Pace(root_context.get_time());
+        return status;
+      });
+}
+}  // namespace core
+}  // namespace drake_ros
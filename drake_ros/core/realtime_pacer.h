@@ -0,0 +1,79 @@
+#pragma once
+
+#include <memory>
+
+#include <drake/systems/analysis/simulator.h>
+
+#include "drake_ros/core/drake_ros.h"
+
+namespace drake_ros {
+namespace core {
+/** Paces simulation to a target realtime rate, servicing ROS work in the
+ slack between simulation steps.
+
+ A drake::systems::Simulator with a target realtime rate sleeps whenever
+ simulation runs ahead of wall-clock time, and ROS work is only serviced
+ when RosInterfaceSystem instances spin their DrakeRos interface, i.e. once
+ per step. A pacer instead waits for ROS work in the DrakeRos interface
+ executor up to the next realtime deadline, so that inbound messages are
+ processed as soon as they arrive while still honoring the realtime rate.
+
+ Like the Simulator, a pacer never waits when simulation runs behind
+ wall-clock time. See EnableRealtimePacing() to pace a Simulator.
+ */
+class RealtimePacer {
+ public:
+  /** A constructor for a realtime pacer.
+   @param[in] ros ROS interface to spin while pacing. It must outlive
+     this pacer.
+   @param[in] target_realtime_rate Ratio of simulated time to wall-clock
+     time to pace to.
+   @throws std::invalid_argument if `ros` is null or the target realtime
+     rate is not positive.
+   */
+  explicit RealtimePacer(DrakeRos* ros, double target_realtime_rate = 1.0);
+
+  ~RealtimePacer();
+
+  /** Returns the target realtime rate. */
+  double target_realtime_rate() const;
+
+  /** Spins the ROS interface until wall-clock time catches up with
+   simulated `time`, as per the target realtime rate.
+
+   The first call after construction or Reset() anchors simulated time to
+   wall-clock time and returns immediately, as do calls with a simulated
+   time earlier than the last anchor e.g. after the simulation context is
+   reset.
+   */
+  void Pace(double time);
+
+  /** Drops the current anchor, so that the next Pace() call anchors
+   simulated time to wall-clock time anew e.g. after a pause. */
+  void Reset();
+
+ private:
+  struct Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
+/** Paces a `simulator` to a target realtime rate with a RealtimePacer.
+
+ The pacer is installed as (part of) the simulator monitor, called after
+ every simulation step. Any monitor already set is called first, and the
+ pacer only runs if it does not end simulation. The simulator's own target
+ realtime rate is set to zero, as pacing is taken over by the pacer: do not
+ set it again. To stop pacing, clear the simulator monitor.
+
+ @param[in] simulator Simulator to pace.
+ @param[in] ros ROS interface to spin while pacing. It must outlive
+   the simulator.
+ @param[in] target_realtime_rate Ratio of simulated time to wall-clock time
+   to pace to.
+ @throws std::invalid_argument if `simulator` or `ros` are null, or the
+   target realtime rate is not positive.
+ */
+void EnableRealtimePacing(drake::systems::Simulator<double>* simulator,
+                          DrakeRos* ros, double target_realtime_rate = 1.0);
+}  // namespace core
+}  // namespace drake_ros
@@ -0,0 +1,152 @@
+#include "drake_ros/core/rollout_runner.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <rclcpp/context.hpp>
+#include <rclcpp/init_options.hpp>
+#include <rclcpp/node_options.hpp>
+
+#include "drake_ros/core/ros_interface_system.h"
+
+namespace drake_ros {
+namespace core {
+namespace {
+// A worker, owning an isolated ROS context and a diagram instance.
+struct Worker {
+  ~Worker() {
+    // Destroy the diagram (and the node it owns) before shutting down.
+    diagram.reset();
+    if (context && context->is_valid()) {
+      context->shutdown("rollout runner is done");
+    }
+  }
+
+  // ROS context for this worker only.
+  rclcpp::Context::SharedPtr context;
+  // Interface to this worker's node, owned by the diagram.
+  DrakeRos* ros{nullptr};
+  // Diagram instance for this worker.
+  std::unique_ptr<drake::systems::Diagram<double>> diagram;
+};
+}  // namespace
+
+struct RolloutRunner::Impl {
+  RolloutFunction rollout;
+  RolloutRunnerParams params;
+  std::vector<std::unique_ptr<Worker>> workers;
+};
+
+RolloutRunner::RolloutRunner(DiagramPopulator populate,
+                             RolloutFunction rollout,
+                             RolloutRunnerParams params)
+    : impl_(new Impl()) {
+  if (params.num_workers <= 0) {
+    throw std::invalid_argument("num_workers must be positive");
+  }
+  DRAKE_THROW_UNLESS(populate != nullptr);
+  DRAKE_THROW_UNLESS(rollout != nullptr);
+  impl_->rollout = std::move(rollout);
+  impl_->params = std::move(params);
+
+  impl_->workers.reserve(impl_->params.num_workers);
+  for (int i = 0; i < impl_->params.num_workers; ++i) {
+    auto worker = std::make_unique<Worker>();
+
+    rclcpp::InitOptions init_options;
+    if (impl_->params.base_domain_id.has_value()) {
+      init_options.set_domain_id(*impl_->params.base_domain_id + i);
+    }
+    worker->context = std::make_shared<rclcpp::Context>();
+    worker->context->init(0, nullptr, init_options);
+
+    rclcpp::NodeOptions node_options;
+    node_options.context(worker->context);
+    // Do not let process-wide arguments (e.g. remappings) leak into workers.
+    node_options.use_global_arguments(false);
+    if (impl_->params.isolate_by_namespace) {
+      node_options.arguments(
+          {"--ros-args", "-r",
+           "__ns:=/" + impl_->params.namespace_prefix + std::to_string(i)});
+    }
+
+    drake::systems::DiagramBuilder<double> builder;
+    auto* ros_system = builder.AddSystem<RosInterfaceSystem>(
+        std::make_unique<DrakeRos>(impl_->params.node_name, node_options));
+    worker->ros = ros_system->get_ros_interface();
+    populate(&builder, worker->ros, i);
+    worker->diagram = builder.Build();
+
+    impl_->workers.push_back(std::move(worker));
+  }
+}
+
+RolloutRunner::~RolloutRunner() {}
+
+int RolloutRunner::num_workers() const {
+  return static_cast<int>(impl_->workers.size());
+}
+
+DrakeRos* RolloutRunner::get_mutable_ros_interface(int worker_index) const {
+  DRAKE_THROW_UNLESS(worker_index >= 0 && worker_index < num_workers());
+  return impl_->workers[worker_index]->ros;
+}
+
+const drake::systems::Diagram<double>& RolloutRunner::get_diagram(
+    int worker_index) const {
+  DRAKE_THROW_UNLESS(worker_index >= 0 && worker_index < num_workers());
+  return *impl_->workers[worker_index]->diagram;
+}
+
+void RolloutRunner::Run(int num_rollouts) {
+  DRAKE_THROW_UNLESS(num_rollouts >= 0);
+
+  std::atomic<int> next_rollout_index{0};
+  std::atomic<bool> failed{false};
+  std::mutex error_mutex;
+  std::exception_ptr error;
+
+  auto work = [&](Worker* worker) {
+    while (!failed.load()) {
+      const int rollout_index = next_rollout_index.fetch_add(1);
+      if (rollout_index >= num_rollouts) {
+        break;
+      }
+      try {
+        drake::systems::Simulator<double> simulator(*worker->diagram);
+        simulator.set_target_realtime_rate(impl_->params.target_realtime_rate);
+        impl_->rollout(rollout_index, &simulator);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(error_mutex);
+        if (!error) {
+          error = std::current_exception();
+        }
+        failed.store(true);
+      }
+    }
+  };
+
+  const int num_threads = std::min(num_workers(), num_rollouts);
+  std::vector<std::thread> threads;
+  threads.reserve(num_threads);
+  for (int i = 0; i < num_threads; ++i) {
+    threads.emplace_back(work, impl_->workers[i].get());
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+}  // namespace core
+}  // namespace drake_ros
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+
+#include <drake/systems/analysis/simulator.h>
+#include <drake/systems/framework/diagram.h>
+#include <drake/systems/framework/diagram_builder.h>
+
+#include "drake_ros/core/drake_ros.h"
+
+namespace drake_ros {
+namespace core {
+
+/** Set of parameters that configure a RolloutRunner. */
+struct RolloutRunnerParams {
+  /** Number of worker threads. Each worker gets its own ROS context, node,
+   and diagram instance. */
+  int num_workers{1};
+
+  /** Name given to every worker node. */
+  std::string node_name{"drake_ros_rollout"};
+
+  /** Whether to isolate workers by pushing each worker node into a namespace
+   of its own, namely `/<namespace_prefix><worker index>`. Note this only
+   isolates relative topic names. */
+  bool isolate_by_namespace{true};
+
+  /** Prefix for worker namespaces. */
+  std::string namespace_prefix{"worker_"};
+
+  /** If set, workers are isolated in ROS domains of their own, starting
+   at this domain ID and increasing by one for every worker. */
+  std::optional<size_t> base_domain_id{std::nullopt};
+
+  /** Target realtime rate for every rollout simulator. Zero (the default)
+   runs rollouts as fast as possible. */
+  double target_realtime_rate{0.0};
+};
+
+/** A runner for many short, independent simulations within a single process.
+
+ The runner sets up a pool of workers once. Each worker owns a ROS context,
+ a `DrakeRos` node within it (managed by a RosInterfaceSystem), and a diagram
+ instance built around that node. Rollouts are then distributed across
+ worker threads, each running on a fresh context of its worker's diagram.
+ As no ROS context, node nor diagram is created per rollout, per-rollout
+ startup cost is that of creating a new diagram context.
+ */
+class RolloutRunner final {
+ public:
+  /** A function to populate a worker diagram.
+   @param[in] builder builder for the worker diagram, which already contains
+     a RosInterfaceSystem for the worker node.
+   @param[in] ros interface to the worker node.
+   @param[in] worker_index index of the worker the diagram is for.
+   */
+  using DiagramPopulator = std::function<void(
+      drake::systems::DiagramBuilder<double>* builder, DrakeRos* ros,
+      int worker_index)>;
+
+  /** A function to carry out a rollout.
+   @param[in] rollout_index index of the rollout to carry out.
+   @param[in] simulator simulator for the rollout, constructed on a fresh
+     context but not yet initialized.
+   */
+  using RolloutFunction = std::function<void(
+      int rollout_index, drake::systems::Simulator<double>* simulator)>;
+
+  /** A constructor that sets up all workers.
+   @param[in] populate function to populate each worker diagram.
+   @param[in] rollout function to carry out each rollout.
+   @param[in] params optional runner configuration.
+   @throws std::invalid_argument if `params.num_workers` is not positive.
+   */
+  RolloutRunner(DiagramPopulator populate, RolloutFunction rollout,
+                RolloutRunnerParams params = {});
+
+  ~RolloutRunner();
+
+  /** Returns the number of workers. */
+  int num_workers() const;
+
+  /** Returns the interface to the node of the given worker. */
+  DrakeRos* get_mutable_ros_interface(int worker_index) const;
+
+  /** Returns the diagram of the given worker. */
+  const drake::systems::Diagram<double>& get_diagram(int worker_index) const;
+
+  /** Carries out `num_rollouts` rollouts concurrently, blocking until all of
+   them are done. Rollout indices go from 0 to `num_rollouts` - 1.
+   @throws the first exception thrown by any rollout, if any, once all
+     ongoing rollouts are done. Pending rollouts are not carried out.
+   */
+  void Run(int num_rollouts);
+
+ private:
+  struct Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace core
+}  // namespace drake_ros
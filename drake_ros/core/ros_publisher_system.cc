@@ -1,37 +1,132 @@
 #include "drake_ros/core/ros_publisher_system.h"
 
+#include <chrono>
 #include <memory>
+#include <mutex>
+#include <stdexcept>
 #include <string>
 #include <unordered_set>
 #include <utility>
+#include <vector>
 
-#include "publisher.h"  // NOLINT(build/include)
+#include "entity_pool.h"     // NOLINT(build/include)
+#include "message_slot.h"    // NOLINT(build/include)
+#include "publisher.h"       // NOLINT(build/include)
+#include "realtime_audit.h"  // NOLINT(build/include)
+#include <rclcpp/duration.hpp>
+#include <rclcpp/time.hpp>
+#include <rclcpp/timer.hpp>
 
 #include "drake_ros/core/serializer_interface.h"
 
 namespace drake_ros {
 namespace core {
+namespace {
+// State shared with the wall-clock republishing timer, if any.
+struct Republisher {
+  // Publisher for serialized messages.
+  std::shared_ptr<internal::Publisher> pub;
+  // Latest message to be (re)published.
+  internal::MessageSlot<const rclcpp::SerializedMessage> slot;
+};
+}  // namespace
+
 struct RosPublisherSystem::Impl {
+  ~Impl() {
+    if (timer) {
+      // Stop republishing before the publisher goes away.
+      timer->cancel();
+    }
+  }
+
   // Interface for message (de)serialization.
   std::shared_ptr<const SerializerInterface> serializer;
   // Publisher for serialized messages.
-  std::unique_ptr<internal::Publisher> pub;
+  std::shared_ptr<internal::Publisher> pub;
+  // Sinks for published messages, if any.
+  std::vector<std::shared_ptr<MessageSinkInterface>> sinks;
+  // Topic and type names to write messages to sinks with, if any.
+  std::string topic_name;
+  std::string type_name;
+  // Wall-clock republishing state, if enabled.
+  std::shared_ptr<Republisher> republisher;
+  // Wall-clock republishing timer, if enabled.
+  rclcpp::TimerBase::SharedPtr timer;
+  // Cache entry index for the serialized input message.
+  drake::systems::CacheIndex serialized_message_cache_index;
+  // AbstractState index where QoS event counts are latched, if enabled.
+  drake::systems::AbstractStateIndex qos_event_status_state_index;
+  // Mutex to synchronize access to the message pool.
+  internal::AuditedMutex message_pool_mutex;
+  // Serialized messages to share with the wall-clock timer and sinks, if
+  // any. It grows up to the number of messages held at once.
+  std::vector<std::shared_ptr<rclcpp::SerializedMessage>> message_pool;
+
+  // Returns a serialized message from the pool that no one else holds.
+  std::shared_ptr<rclcpp::SerializedMessage> BorrowMessage() {
+    std::lock_guard<internal::AuditedMutex> lock(message_pool_mutex);
+    for (const auto& message : message_pool) {
+      // Messages only held by the pool can be reused. No one else can get
+      // a hold of them but through the pool, which is locked.
+      if (message.use_count() == 1) {
+        return message;
+      }
+    }
+    message_pool.push_back(std::make_shared<rclcpp::SerializedMessage>());
+    return message_pool.back();
+  }
 };
 
 RosPublisherSystem::RosPublisherSystem(
     std::shared_ptr<const SerializerInterface> serializer,
     const std::string& topic_name, const rclcpp::QoS& qos, DrakeRos* ros,
     const std::unordered_set<drake::systems::TriggerType>& publish_triggers,
-    double publish_period)
+    double publish_period, const RosPublisherParams& params)
     : impl_(new Impl()) {
+  if (params.wall_clock_publish_period < 0.0) {
+    throw std::invalid_argument("wall_clock_publish_period must be >= 0");
+  }
   impl_->serializer = std::move(serializer);
 
-  impl_->pub = std::make_unique<internal::Publisher>(
-      ros->get_mutable_node()->get_node_base_interface().get(),
+  impl_->pub = ros->get_mutable_entity_pool()->get_publisher(
       *impl_->serializer->GetTypeSupport(), topic_name, qos);
 
+  if (params.wall_clock_publish_period > 0.0) {
+    impl_->republisher = std::make_shared<Republisher>();
+    impl_->republisher->pub = impl_->pub;
+    std::weak_ptr<Republisher> weak_republisher = impl_->republisher;
+    impl_->timer = ros->CreateWallTimer(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::duration<double>(params.wall_clock_publish_period)),
+        [weak_republisher]() {
+          auto republisher = weak_republisher.lock();
+          if (!republisher) {
+            return;
+          }
+          auto message = republisher->slot.Get().first;
+          if (message) {
+            republisher->pub->publish(*message);
+          }
+        });
+  }
+
   DeclareAbstractInputPort("message",
                            *(impl_->serializer->CreateDefaultValue()));
+  // Serialize into a per-context buffer, reused across publications.
+  impl_->serialized_message_cache_index =
+      DeclareCacheEntry("serialized_message", rclcpp::SerializedMessage(),
+                        &RosPublisherSystem::CalcSerializedMessage,
+                        {get_input_port().ticket()})
+          .cache_index();
+
+  if (params.qos_event_status_port) {
+    impl_->qos_event_status_state_index =
+        DeclareAbstractState(drake::Value<QosEventStatus>());
+    DeclareStateOutputPort("qos_event_status",
+                           impl_->qos_event_status_state_index);
+    DeclarePerStepUnrestrictedUpdateEvent(
+        &RosPublisherSystem::LatchQosEventStatus);
+  }
 
   // vvv Mostly copied from LcmPublisherSystem vvv
   // Check that publish_triggers does not contain an unsupported trigger.
@@ -79,11 +174,93 @@ void RosPublisherSystem::Publish(
   impl_->pub->publish(serialized_msg);
 }
 
+void RosPublisherSystem::AddMessageSink(
+    std::shared_ptr<MessageSinkInterface> sink) {
+  DRAKE_THROW_UNLESS(sink != nullptr);
+  if (impl_->serializer->GetTypeName().empty()) {
+    throw std::invalid_argument(
+        "message sinks require a serializer that knows its type name");
+  }
+  if (impl_->sinks.empty()) {
+    impl_->topic_name = impl_->pub->get_topic_name();
+    impl_->type_name = impl_->serializer->GetTypeName();
+  }
+  impl_->sinks.push_back(std::move(sink));
+}
+
+QosEventStatus RosPublisherSystem::GetQosEventStatus() const {
+  return impl_->pub->get_qos_event_status();
+}
+
+void RosPublisherSystem::CalcSerializedMessage(
+    const drake::systems::Context<double>& context,
+    rclcpp::SerializedMessage* message) const {
+  const drake::AbstractValue& input =
+      get_input_port().Eval<drake::AbstractValue>(context);
+  internal::ScopedDelegateCall call;
+  impl_->serializer->SerializeInto(input, message);
+}
+
+drake::systems::EventStatus RosPublisherSystem::LatchQosEventStatus(
+    const drake::systems::Context<double>& context,
+    drake::systems::State<double>* state) const {
+  internal::ScopedDrakeRosCall call;
+  const QosEventStatus status = impl_->pub->get_qos_event_status();
+  if (status == context.get_abstract_state<QosEventStatus>(
+                    impl_->qos_event_status_state_index)) {
+    return drake::systems::EventStatus::DidNothing();
+  }
+  state->get_mutable_abstract_state()
+      .get_mutable_value(impl_->qos_event_status_state_index)
+      .set_value<QosEventStatus>(status);
+  return drake::systems::EventStatus::Succeeded();
+}
+
 drake::systems::EventStatus RosPublisherSystem::PublishInput(
     const drake::systems::Context<double>& context) const {
+  // Evaluate the input ahead, as upstream computations are none of ours.
   const drake::AbstractValue& input =
       get_input_port().Eval<drake::AbstractValue>(context);
-  impl_->pub->publish(impl_->serializer->Serialize(input));
+  internal::ScopedDrakeRosCall call;
+  if (!impl_->republisher && impl_->sinks.empty()) {
+    const auto& serialized_message =
+        get_cache_entry(impl_->serialized_message_cache_index)
+            .Eval<rclcpp::SerializedMessage>(context);
+    if (serialized_message.size() == 0) {
+      // Nothing to publish e.g. a default serialized message value.
+      return drake::systems::EventStatus::DidNothing();
+    }
+    impl_->pub->publish(serialized_message);
+    return drake::systems::EventStatus::Succeeded();
+  }
+
+  // Serialize into a pooled message instead of the per-context buffer, and
+  // share it with the wall-clock timer and all sinks as-is. It is reused
+  // once they are all done with it.
+  std::shared_ptr<rclcpp::SerializedMessage> message = impl_->BorrowMessage();
+  {
+    internal::ScopedDelegateCall delegate_call;
+    impl_->serializer->SerializeInto(input, message.get());
+  }
+  if (message->size() == 0) {
+    // Nothing to publish e.g. a default serialized message value.
+    return drake::systems::EventStatus::DidNothing();
+  }
+  if (impl_->republisher) {
+    // Leave publication to the wall-clock timer.
+    impl_->republisher->slot.Put(message);
+  } else {
+    impl_->pub->publish(*message);
+  }
+  if (impl_->sinks.empty()) {
+    return drake::systems::EventStatus::Succeeded();
+  }
+
+  rclcpp::Time time{0, 0, RCL_ROS_TIME};
+  time += rclcpp::Duration::from_seconds(context.get_time());
+  for (const auto& sink : impl_->sinks) {
+    sink->Write(impl_->topic_name, impl_->type_name, message, time);
+  }
   return drake::systems::EventStatus::Succeeded();
 }
 }  // namespace core
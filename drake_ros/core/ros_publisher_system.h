@@ -10,11 +10,31 @@
 #include <rmw/rmw.h>
 
 #include "drake_ros/core/drake_ros.h"
+#include "drake_ros/core/message_sink_interface.h"
+#include "drake_ros/core/qos_event_status.h"
+#include "drake_ros/core/serialized_message_serializer.h"
 #include "drake_ros/core/serializer.h"
 #include "drake_ros/core/serializer_interface.h"
 
 namespace drake_ros {
 namespace core {
+
+/** Set of parameters that configure a RosPublisherSystem. */
+struct RosPublisherParams {
+  /** If positive, the period, in seconds of wall-clock time, at which to
+   publish messages. Publish triggers then only update the message to be
+   published next, and the latest message is (re)published at this fixed
+   real-time rate, regardless of simulation speed. If zero (the default),
+   messages are published as triggered. */
+  double wall_clock_publish_period{0.0};
+
+  /** Whether to declare a `qos_event_status` output port, providing the
+   QosEventStatus of the underlying ROS publisher. Its value is latched into
+   state by a per-step unrestricted update event, and thus only changes at
+   step boundaries. */
+  bool qos_event_status_port{false};
+};
+
 /** A system that can publish ROS messages.
  It accepts ROS messages on its sole input port and publishes them
  to a ROS topic.
@@ -36,11 +56,30 @@ class RosPublisherSystem : public drake::systems::LeafSystem<double> {
       const std::string& topic_name, const rclcpp::QoS& qos, DrakeRos* ros,
       const std::unordered_set<drake::systems::TriggerType>& publish_triggers =
           kDefaultTriggerTypes,
-      double publish_period = 0.0) {
+      double publish_period = 0.0, const RosPublisherParams& params = {}) {
     // Assume C++ typesupport since this is a C++ template function
     return std::make_unique<RosPublisherSystem>(
         std::make_unique<Serializer<MessageT>>(), topic_name, qos, ros,
-        publish_triggers, publish_period);
+        publish_triggers, publish_period, params);
+  }
+
+  /** Instantiates a publisher system for a given ROS message type, that
+   takes serialized messages (i.e. `rclcpp::SerializedMessage` values) on
+   its input port and publishes them as-is. Empty messages are not
+   published. See `RosPublisherSystem::RosPublisherSystem` documentation
+   for further reference on function arguments.
+
+   @tparam MessageT C++ ROS message type.
+   */
+  template <typename MessageT>
+  static std::unique_ptr<RosPublisherSystem> MakeSerialized(
+      const std::string& topic_name, const rclcpp::QoS& qos, DrakeRos* ros,
+      const std::unordered_set<drake::systems::TriggerType>& publish_triggers =
+          kDefaultTriggerTypes,
+      double publish_period = 0.0, const RosPublisherParams& params = {}) {
+    return std::make_unique<RosPublisherSystem>(
+        SerializedMessageSerializer::Make<MessageT>(), topic_name, qos, ros,
+        publish_triggers, publish_period, params);
   }
 
   /** A constructor for the ROS publisher system.
@@ -56,13 +95,17 @@ class RosPublisherSystem : public drake::systems::LeafSystem<double> {
      every step and when forced (via Publish).
    @param[in] publish_period optional publishing period, in seconds.
      Only applicable when periodic publishing is enabled.
+   @param[in] params optional publisher configuration.
+   @throws std::invalid_argument if `params.wall_clock_publish_period`
+     is negative.
    */
   RosPublisherSystem(std::shared_ptr<const SerializerInterface> serializer,
                      const std::string& topic_name, const rclcpp::QoS& qos,
                      DrakeRos* ros,
                      const std::unordered_set<drake::systems::TriggerType>&
                          publish_triggers = kDefaultTriggerTypes,
-                     double publish_period = 0.0);
+                     double publish_period = 0.0,
+                     const RosPublisherParams& params = {});
 
   ~RosPublisherSystem() override;
 
@@ -76,11 +119,35 @@ class RosPublisherSystem : public drake::systems::LeafSystem<double> {
   /** Publishes a serialized ROS message. */
   void Publish(const rclcpp::SerializedMessage& serialized_message);
 
+  /** Adds a sink for messages published by this system.
+
+   Every message published from the input port is also written to `sink`,
+   timestamped with simulation time. The very same serialized message is
+   shared with ROS and all sinks, not copied, and its buffer is reused once
+   no sink holds it anymore. Messages published directly via Publish() are
+   not written. Sinks must be added before simulation starts.
+   */
+  void AddMessageSink(std::shared_ptr<MessageSinkInterface> sink);
+
+  /** Returns counts of QoS events (e.g. offered deadlines missed) on the
+   underlying ROS publisher so far. These are updated as the ROS node spins,
+   regardless of simulation. */
+  QosEventStatus GetQosEventStatus() const;
+
  protected:
   drake::systems::EventStatus PublishInput(
       const drake::systems::Context<double>& context) const;
 
  private:
+  // Serializes the input message into a per-context buffer.
+  void CalcSerializedMessage(const drake::systems::Context<double>& context,
+                             rclcpp::SerializedMessage* message) const;
+
+  // Latches QoS event counts into state, if they changed.
+  drake::systems::EventStatus LatchQosEventStatus(
+      const drake::systems::Context<double>& context,
+      drake::systems::State<double>* state) const;
+
   struct Impl;
   std::unique_ptr<Impl> impl_;
 };
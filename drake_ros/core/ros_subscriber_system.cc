@@ -1,72 +1,235 @@
 #include "drake_ros/core/ros_subscriber_system.h"
 
+#include <algorithm>
+#include <cstdint>
 #include <memory>
-#include <mutex>
+#include <stdexcept>
 #include <string>
 #include <utility>
+#include <vector>
 
-#include "subscription.h"  // NOLINT(build/include)
+#include "entity_pool.h"     // NOLINT(build/include)
+#include "message_slot.h"    // NOLINT(build/include)
+#include "realtime_audit.h"  // NOLINT(build/include)
+#include "subscription.h"    // NOLINT(build/include)
 #include <drake/systems/framework/abstract_values.h>
+#include <rclcpp/exceptions.hpp>
+#include <rclcpp/logging.hpp>
+#include <rclcpp/subscription_content_filter_options.hpp>
 
 namespace drake_ros {
 namespace core {
-namespace {
-// A synchronized queue of `MessageT` messages.
-template <typename MessageT>
-class MessageQueue {
- public:
-  void PutMessage(std::shared_ptr<MessageT> message) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    message_ = message;
-  }
-
-  std::shared_ptr<MessageT> TakeMessage() {
-    std::lock_guard<std::mutex> lock(mutex_);
-    return std::move(message_);
-  }
-
- private:
-  // Mutex to synchronize access to the queue.
-  std::mutex mutex_;
-  // Last received message (i.e. queue of size 1).
-  std::shared_ptr<MessageT> message_;
-};
-}  // namespace
-
 struct RosSubscriberSystem::Impl {
   // Interface for message (de)serialization.
   std::shared_ptr<const SerializerInterface> serializer;
-  // Subscription to serialized messages.
-  std::shared_ptr<internal::Subscription> sub;
-  // Queue of serialized messages.
-  MessageQueue<rclcpp::SerializedMessage> queue;
-  // AbstractState index where the message is stored.
+  // Latest serialized message, shared by all contexts.
+  internal::MessageSlot<rclcpp::SerializedMessage> slot;
+  // Whether message deserialization is deferred until output evaluation.
+  bool lazy_deserialization{false};
+  // AbstractState index where the message is stored, deserialized or
+  // serialized depending on whether deserialization is lazy.
   drake::systems::AbstractStateIndex message_state_index;
+  // AbstractState index where the sequence number of the stored message is
+  // kept, so that each context tracks which messages it has already seen.
+  // In replay mode, it is the number of log entries applied instead.
+  drake::systems::AbstractStateIndex sequence_state_index;
+  // Predicate to filter incoming messages with, if any.
+  ContentFilter::Prefilter prefilter;
+  // Whether the RMW implementation filters content.
+  bool content_filtered_by_middleware{false};
+  // Log to capture applied messages into, if any.
+  std::shared_ptr<InboundMessageLog> capture_log;
+  // Entries to replay, if in replay mode.
+  std::vector<InboundMessageLog::Entry> replay_entries;
+  bool replay{false};
+  // AbstractState index where QoS event counts are latched, if enabled.
+  drake::systems::AbstractStateIndex qos_event_status_state_index;
+  // Token for a subscription to serialized messages, shared unless content
+  // filtered. Declared last so that it is destroyed first, i.e. so that the
+  // callback is removed before anything it uses goes away.
+  std::unique_ptr<internal::SubscriptionToken> token;
+
+  // Returns QoS event counts on the subscription in use, if any.
+  QosEventStatus GetQosEventStatus() const {
+    if (token) {
+      return token->get_qos_event_status();
+    }
+    return {};
+  }
+
+  // Stores a serialized message in state.
+  void StoreMessage(std::shared_ptr<const rclcpp::SerializedMessage> message,
+                    drake::systems::AbstractValues* abstract_state) const {
+    drake::AbstractValue& abstract_value =
+        abstract_state->get_mutable_value(message_state_index);
+    if (lazy_deserialization) {
+      abstract_value
+          .set_value<std::shared_ptr<const rclcpp::SerializedMessage>>(
+              std::move(message));
+    } else {
+      internal::ScopedDelegateCall call;
+      serializer->Deserialize(*message, &abstract_value);
+    }
+  }
 };
 
 RosSubscriberSystem::RosSubscriberSystem(
     std::shared_ptr<const SerializerInterface> serializer,
-    const std::string& topic_name, const rclcpp::QoS& qos, DrakeRos* ros)
+    const std::string& topic_name, const rclcpp::QoS& qos, DrakeRos* ros,
+    const RosSubscriberParams& params)
     : impl_(new Impl()) {
+  const ContentFilter& content_filter = params.content_filter;
   impl_->serializer = std::move(serializer);
 
   rclcpp::Node* node = ros->get_mutable_node();
-  impl_->sub = std::make_shared<internal::Subscription>(
-      node->get_node_base_interface().get(),
-      *impl_->serializer->GetTypeSupport(), topic_name, qos,
-      std::bind(&MessageQueue<rclcpp::SerializedMessage>::PutMessage,
-                &impl_->queue, std::placeholders::_1));
-  node->get_node_topics_interface()->add_subscription(impl_->sub, nullptr);
-
-  impl_->message_state_index =
-      DeclareAbstractState(*(impl_->serializer->CreateDefaultValue()));
-
-  DeclareStateOutputPort(drake::systems::kUseDefaultName,
-                         impl_->message_state_index);
+  rclcpp::CallbackGroup::SharedPtr group =
+      ros->GetCallbackGroup(params.priority);
+  Impl* impl = impl_.get();
+  auto callback = [impl](std::shared_ptr<rclcpp::SerializedMessage> message) {
+    if (impl->prefilter && !impl->prefilter(*message)) {
+      return;
+    }
+    impl->slot.Put(std::move(message));
+  };
+  // Prefilter unless the RMW implementation filters content.
+  impl_->prefilter = content_filter.prefilter;
+  if (content_filter.expression.empty()) {
+    // Share the subscription with other systems subscribed to the same
+    // topic, so that messages are taken once for all.
+    impl_->token = ros->get_mutable_entity_pool()->subscribe(
+        *impl_->serializer->GetTypeSupport(), topic_name, qos,
+        std::move(callback), params.message_pool_size, group);
+  } else {
+    // Content filters apply to the whole subscription, so it is not shared.
+    // Its callback is removable all the same, as it may be called by another
+    // thread (e.g. if high priority) while this system is being destroyed.
+    // The filter is set on creation, for the middleware to never deliver
+    // unwanted messages, not even those in flight.
+    rclcpp::ContentFilterOptions content_filter_options;
+    content_filter_options.filter_expression = content_filter.expression;
+    content_filter_options.expression_parameters =
+        content_filter.expression_parameters;
+    std::shared_ptr<internal::SharedSubscription> filtered_sub;
+    try {
+      filtered_sub = internal::SharedSubscription::make(
+          node, *impl_->serializer->GetTypeSupport(), topic_name, qos, group,
+          content_filter_options);
+      impl_->content_filtered_by_middleware =
+          filtered_sub->get_subscription()->is_cft_enabled();
+    } catch (const rclcpp::exceptions::RCLError& e) {
+      // Most likely unsupported by the RMW implementation.
+      RCLCPP_DEBUG(node->get_logger(),
+                   "Content filtering unavailable for '%s', falling back: %s",
+                   topic_name.c_str(), e.what());
+      filtered_sub = internal::SharedSubscription::make(
+          node, *impl_->serializer->GetTypeSupport(), topic_name, qos, group);
+    }
+    if (impl_->content_filtered_by_middleware) {
+      impl_->prefilter = nullptr;
+    }
+    // N.B. The callback is only added once the prefilter is settled.
+    const size_t id = filtered_sub->add_callback(std::move(callback),
+                                                 params.message_pool_size);
+    impl_->token = std::make_unique<internal::SubscriptionToken>(
+        std::move(filtered_sub), id);
+  }
+
+  DeclareMessageStateAndOutputPort(params.lazy_deserialization);
+
+  if (params.qos_event_status_port) {
+    impl_->qos_event_status_state_index =
+        DeclareAbstractState(drake::Value<QosEventStatus>());
+    DeclareStateOutputPort("qos_event_status",
+                           impl_->qos_event_status_state_index);
+    DeclarePerStepUnrestrictedUpdateEvent(
+        &RosSubscriberSystem::LatchQosEventStatus);
+  }
+}
+
+RosSubscriberSystem::RosSubscriberSystem(
+    std::shared_ptr<const SerializerInterface> serializer,
+    std::shared_ptr<const InboundMessageLog> replay_log)
+    : impl_(new Impl()) {
+  DRAKE_THROW_UNLESS(replay_log != nullptr);
+  impl_->serializer = std::move(serializer);
+  impl_->replay_entries = replay_log->entries();
+  impl_->replay = true;
+
+  DeclareMessageStateAndOutputPort(false);
 }
 
 RosSubscriberSystem::~RosSubscriberSystem() {}
 
+void RosSubscriberSystem::DeclareMessageStateAndOutputPort(
+    bool lazy_deserialization) {
+  impl_->lazy_deserialization = lazy_deserialization;
+  if (!lazy_deserialization) {
+    impl_->message_state_index =
+        DeclareAbstractState(*(impl_->serializer->CreateDefaultValue()));
+    impl_->sequence_state_index =
+        DeclareAbstractState(drake::Value<uint64_t>(0u));
+    DeclareStateOutputPort(drake::systems::kUseDefaultName,
+                           impl_->message_state_index);
+    return;
+  }
+
+  // Keep the serialized message in state, and deserialize it on output
+  // evaluation. Output values are cached until the state changes, i.e.
+  // deserialization takes place at most once per message and context.
+  impl_->message_state_index = DeclareAbstractState(
+      drake::Value<std::shared_ptr<const rclcpp::SerializedMessage>>());
+  impl_->sequence_state_index =
+      DeclareAbstractState(drake::Value<uint64_t>(0u));
+  DeclareAbstractOutputPort(
+      drake::systems::kUseDefaultName,
+      [this]() { return impl_->serializer->CreateDefaultValue(); },
+      [this](const drake::systems::Context<double>& context,
+             drake::AbstractValue* output_value) {
+        const auto& message =
+            context.get_abstract_state<
+                std::shared_ptr<const rclcpp::SerializedMessage>>(
+                impl_->message_state_index);
+        if (message) {
+          internal::ScopedDelegateCall call;
+          impl_->serializer->Deserialize(*message, output_value);
+        } else {
+          output_value->SetFrom(*impl_->serializer->CreateDefaultValue());
+        }
+      },
+      {abstract_state_ticket(impl_->message_state_index)});
+}
+
+bool RosSubscriberSystem::is_content_filtered_by_middleware() const {
+  return impl_->content_filtered_by_middleware;
+}
+
+void RosSubscriberSystem::SetCaptureLog(
+    std::shared_ptr<InboundMessageLog> capture_log) {
+  if (impl_->replay) {
+    throw std::logic_error("cannot capture messages in replay mode");
+  }
+  impl_->capture_log = std::move(capture_log);
+}
+
+QosEventStatus RosSubscriberSystem::GetQosEventStatus() const {
+  return impl_->GetQosEventStatus();
+}
+
+drake::systems::EventStatus RosSubscriberSystem::LatchQosEventStatus(
+    const drake::systems::Context<double>& context,
+    drake::systems::State<double>* state) const {
+  internal::ScopedDrakeRosCall call;
+  const QosEventStatus status = impl_->GetQosEventStatus();
+  if (status == context.get_abstract_state<QosEventStatus>(
+                    impl_->qos_event_status_state_index)) {
+    return drake::systems::EventStatus::DidNothing();
+  }
+  state->get_mutable_abstract_state()
+      .get_mutable_value(impl_->qos_event_status_state_index)
+      .set_value<QosEventStatus>(status);
+  return drake::systems::EventStatus::Succeeded();
+}
+
 void RosSubscriberSystem::DoCalcNextUpdateTime(
     const drake::systems::Context<double>& context,
     drake::systems::CompositeEventCollection<double>* events,
@@ -78,28 +241,41 @@ void RosSubscriberSystem::DoCalcNextUpdateTime(
   DRAKE_THROW_UNLESS(events->HasEvents() == false);
   DRAKE_THROW_UNLESS(std::isinf(*time));
 
-  std::shared_ptr<rclcpp::SerializedMessage> message =
-      impl_->queue.TakeMessage();
+  internal::ScopedDrakeRosCall call;
+
+  const uint64_t last_sequence =
+      context.get_abstract_state<uint64_t>(impl_->sequence_state_index);
+  if (impl_->replay) {
+    ScheduleReplay(context, last_sequence, events, time);
+    return;
+  }
 
-  // Do nothing unless we have a new message.
-  if (!message) {
+  // Do nothing unless there is a message this context has not seen yet.
+  if (impl_->slot.sequence() == last_sequence) {
     return;
   }
 
   // Create a unrestricted event and tie the handler to the corresponding
-  // function.
-  auto callback = [this, serialized_message{std::move(message)}](
-                      const drake::systems::System<double>&,
-                      const drake::systems::Context<double>&,
-                      const drake::systems::UnrestrictedUpdateEvent<double>&,
-                      drake::systems::State<double>* state) {
-    // Deserialize the message and store it in the abstract state on the
-    // context
+  // function. The latest message is fetched when the event is handled, as
+  // newer messages may have arrived in between.
+  auto callback = [this](const drake::systems::System<double>&,
+                         const drake::systems::Context<double>& event_context,
+                         const drake::systems::UnrestrictedUpdateEvent<double>&,
+                         drake::systems::State<double>* state) {
+    internal::ScopedDrakeRosCall call;
+    auto [serialized_message, sequence] = impl_->slot.Get();
+    if (!serialized_message) {
+      return drake::systems::EventStatus::DidNothing();
+    }
+    if (impl_->capture_log) {
+      impl_->capture_log->Append(event_context.get_time(), serialized_message);
+    }
+    // Store the message in the abstract state on the context
     drake::systems::AbstractValues& abstract_state =
         state->get_mutable_abstract_state();
-    auto& abstract_value =
-        abstract_state.get_mutable_value(impl_->message_state_index);
-    impl_->serializer->Deserialize(*serialized_message, &abstract_value);
+    impl_->StoreMessage(serialized_message, &abstract_state);
+    abstract_state.get_mutable_value(impl_->sequence_state_index)
+        .set_value<uint64_t>(sequence);
     return drake::systems::EventStatus::Succeeded();
   };
 
@@ -111,5 +287,66 @@ void RosSubscriberSystem::DoCalcNextUpdateTime(
   uu_events.AddEvent(drake::systems::UnrestrictedUpdateEvent<double>(
       drake::systems::TriggerType::kTimed, callback));
 }
+
+void RosSubscriberSystem::ScheduleReplay(
+    const drake::systems::Context<double>& context, uint64_t num_applied,
+    drake::systems::CompositeEventCollection<double>* events,
+    double* time) const {
+  if (num_applied >= impl_->replay_entries.size()) {
+    return;
+  }
+
+  drake::systems::EventCollection<
+      drake::systems::UnrestrictedUpdateEvent<double>>& uu_events =
+      events->get_mutable_unrestricted_update_events();
+  const double next_time = impl_->replay_entries[num_applied].time;
+  if (next_time > context.get_time()) {
+    // Stop at the time the next entry is due first, doing nothing. Once
+    // there, the entry is applied right away like messages are in capture,
+    // i.e. after all other updates due at that time. Otherwise, it would be
+    // applied along with them, and e.g. seen by discrete controllers one
+    // step earlier than in capture.
+    *time = next_time;
+    uu_events.AddEvent(drake::systems::UnrestrictedUpdateEvent<double>(
+        drake::systems::TriggerType::kTimed,
+        [](const drake::systems::System<double>&,
+           const drake::systems::Context<double>&,
+           const drake::systems::UnrestrictedUpdateEvent<double>&,
+           drake::systems::State<double>*) {
+          return drake::systems::EventStatus::DidNothing();
+        }));
+    return;
+  }
+
+  // Apply the latest of all entries due by the time the event is handled,
+  // as earlier ones would be overwritten anyways.
+  auto callback = [this](const drake::systems::System<double>&,
+                         const drake::systems::Context<double>& event_context,
+                         const drake::systems::UnrestrictedUpdateEvent<double>&,
+                         drake::systems::State<double>* state) {
+    const uint64_t first_index = event_context.get_abstract_state<uint64_t>(
+        impl_->sequence_state_index);
+    uint64_t next_index = first_index;
+    while (next_index < impl_->replay_entries.size() &&
+           impl_->replay_entries[next_index].time <= event_context.get_time()) {
+      ++next_index;
+    }
+    if (next_index == first_index) {
+      return drake::systems::EventStatus::DidNothing();
+    }
+    drake::systems::AbstractValues& abstract_state =
+        state->get_mutable_abstract_state();
+    impl_->StoreMessage(impl_->replay_entries[next_index - 1].message,
+                        &abstract_state);
+    abstract_state.get_mutable_value(impl_->sequence_state_index)
+        .set_value<uint64_t>(next_index);
+    return drake::systems::EventStatus::Succeeded();
+  };
+
+  // Schedule an update event at the current time, as entries are due.
+  *time = context.get_time();
+  uu_events.AddEvent(drake::systems::UnrestrictedUpdateEvent<double>(
+      drake::systems::TriggerType::kTimed, callback));
+}
 }  // namespace core
 }  // namespace drake_ros
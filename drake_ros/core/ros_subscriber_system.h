@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <utility>
@@ -7,15 +9,63 @@
 #include <drake/systems/framework/leaf_system.h>
 #include <rosidl_typesupport_cpp/message_type_support.hpp>
 
+#include "drake_ros/core/content_filter.h"
 #include "drake_ros/core/drake_ros.h"
+#include "drake_ros/core/inbound_message_log.h"
+#include "drake_ros/core/qos_event_status.h"
+#include "drake_ros/core/serialized_message_serializer.h"
 #include "drake_ros/core/serializer.h"
 #include "drake_ros/core/serializer_interface.h"
 
 namespace drake_ros {
 namespace core {
+
+/** Set of parameters that configure a RosSubscriberSystem. */
+struct RosSubscriberParams {
+  /** Filter for incoming messages. See ContentFilter documentation for
+   further reference. */
+  ContentFilter content_filter{};
+
+  /** Whether to defer message deserialization until the output port is
+   evaluated. If so, only the latest serialized message is kept in state,
+   and it is deserialized on demand, once per message. Messages superseded
+   before the output port is evaluated are never deserialized. */
+  bool lazy_deserialization{false};
+
+  /** Number of serialized messages to keep around for reuse as messages
+   are received, instead of allocating one per message. Two suffice to
+   receive messages without allocations when the latest message is held by
+   no one else, plus one per context holding on to a message if
+   deserialization is lazy. If zero (the default), no messages are kept. */
+  size_t message_pool_size{0};
+
+  /** Whether to declare a `qos_event_status` output port, providing the
+   QosEventStatus of the underlying ROS subscription (e.g. to fall back to a
+   safe behavior when the requested deadline is missed, instead of acting
+   on stale messages). Its value is latched into state by a per-step
+   unrestricted update event, and thus only changes at step boundaries. */
+  bool qos_event_status_port{false};
+
+  /** Priority to service the underlying ROS subscription with. High
+   priority subscriptions (e.g. to command topics) are serviced as soon as
+   messages arrive by a dedicated thread, and are thus not delayed by any
+   other ROS traffic (e.g. visualization) nor by DrakeRos::Spin() pacing.
+   Either way, messages are only applied at step boundaries. See
+   DrakeRos::GetCallbackGroup() documentation for further reference. */
+  CallbackPriority priority{CallbackPriority::kNormal};
+};
+
 /** A system that can subscribe to ROS messages.
  It subscribes to a ROS topic and makes ROS messages available on
- its sole output port.
+ its sole output port (besides a QoS event status port, if enabled).
+
+ Which simulation step a message is applied in depends on when it arrives,
+ and thus closed-loop simulations are not reproducible in general. To
+ reproduce them, a subscriber system can be set to capture every message
+ it applies along with the exact simulation time it applied it at (see
+ SetCaptureLog()). Another subscriber system can then be constructed to
+ replay that log instead of subscribing to a ROS topic, applying the very
+ same messages at the very same simulation times, without ROS.
  */
 class RosSubscriberSystem : public drake::systems::LeafSystem<double> {
  public:
@@ -32,6 +82,20 @@ class RosSubscriberSystem : public drake::systems::LeafSystem<double> {
         std::make_shared<Serializer<MessageT>>(), std::forward<ArgsT>(args)...);
   }
 
+  /** Instantiates a ROS subscriber system for a given ROS message type,
+   that outputs serialized messages (i.e. `rclcpp::SerializedMessage`
+   values) as received. See `RosSubscriberSystem::RosSubscriberSystem`
+   documentation for further reference on function arguments.
+
+   @tparam MessageT C++ ROS message type.
+   */
+  template <typename MessageT, typename... ArgsT>
+  static std::unique_ptr<RosSubscriberSystem> MakeSerialized(ArgsT&&... args) {
+    return std::make_unique<RosSubscriberSystem>(
+        SerializedMessageSerializer::Make<MessageT>(),
+        std::forward<ArgsT>(args)...);
+  }
+
   /** A constructor for the ROS subscriber system.
    It takes a `serializer` to deal with incoming messages.
 
@@ -40,19 +104,65 @@ class RosSubscriberSystem : public drake::systems::LeafSystem<double> {
    @param[in] topic_name Name of the ROS topic to subscribe to.
    @param[in] qos QoS profile for the underlying ROS subscription.
    @param[in] ros interface to a live ROS node to publish from.
+   @param[in] params optional subscriber configuration.
    */
   RosSubscriberSystem(std::shared_ptr<const SerializerInterface> serializer,
                       const std::string& topic_name, const rclcpp::QoS& qos,
-                      DrakeRos* ros);
+                      DrakeRos* ros, const RosSubscriberParams& params = {});
+
+  /** A constructor for a ROS subscriber system in replay mode.
+   It applies messages in `replay_log` at the simulation times they
+   were logged at. If simulation starts later than some of those times,
+   the latest of the corresponding messages is applied on start.
+
+   @param[in] serializer a (de)serialization interface for the
+     expected ROS message type.
+   @param[in] replay_log log of messages to replay. Entries appended
+     after construction are ignored.
+   */
+  RosSubscriberSystem(std::shared_ptr<const SerializerInterface> serializer,
+                      std::shared_ptr<const InboundMessageLog> replay_log);
 
   ~RosSubscriberSystem() override;
 
+  /** Returns true if content filtering is done by the RMW implementation,
+   false if it is done by the prefilter or not at all. */
+  bool is_content_filtered_by_middleware() const;
+
+  /** Sets a log to capture every message applied to this system (and the
+   simulation time it was applied at) into, or clears it if null.
+   Capturing is meant for simulations with a single context.
+   @throws std::logic_error if this system is in replay mode.
+   */
+  void SetCaptureLog(std::shared_ptr<InboundMessageLog> capture_log);
+
+  /** Returns counts of QoS events (e.g. requested deadlines missed) on the
+   underlying ROS subscription so far, or no events if in replay mode. These
+   are updated as the ROS node spins, regardless of simulation. If the
+   subscription is shared with other systems, so are these counts. */
+  QosEventStatus GetQosEventStatus() const;
+
  protected:
   void DoCalcNextUpdateTime(const drake::systems::Context<double>&,
                             drake::systems::CompositeEventCollection<double>*,
                             double*) const override;
 
  private:
+  // Declares message state and output port.
+  void DeclareMessageStateAndOutputPort(bool lazy_deserialization);
+
+  // Latches QoS event counts into state, if they changed.
+  drake::systems::EventStatus LatchQosEventStatus(
+      const drake::systems::Context<double>& context,
+      drake::systems::State<double>* state) const;
+
+  // Schedules the next replay event, if any, given the number of log entries
+  // applied so far.
+  void ScheduleReplay(const drake::systems::Context<double>& context,
+                      uint64_t num_applied,
+                      drake::systems::CompositeEventCollection<double>* events,
+                      double* time) const;
+
   struct Impl;
   std::unique_ptr<Impl> impl_;
 };
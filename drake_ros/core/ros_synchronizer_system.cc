@@ -0,0 +1,161 @@
+#include "drake_ros/core/ros_synchronizer_system.h"
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "approximate_time_policy.h"  // NOLINT(build/include)
+#include "entity_pool.h"              // NOLINT(build/include)
+#include "message_slot.h"             // NOLINT(build/include)
+#include "realtime_audit.h"           // NOLINT(build/include)
+#include <drake/systems/framework/abstract_values.h>
+#include <rclcpp/time.hpp>
+
+#include "drake_ros/core/serialized_header.h"
+
+namespace drake_ros {
+namespace core {
+namespace {
+using SerializedMessagePtr = std::shared_ptr<rclcpp::SerializedMessage>;
+using MessageSet = std::vector<SerializedMessagePtr>;
+}  // namespace
+
+struct RosSynchronizerSystem::Impl {
+  // Interfaces for message (de)serialization, one per topic.
+  std::vector<std::shared_ptr<const SerializerInterface>> serializers;
+  // Mutex to synchronize access to the synchronization policy.
+  internal::AuditedMutex policy_mutex;
+  // Synchronization policy, fed on message reception.
+  std::unique_ptr<internal::ApproximateTimePolicy<SerializedMessagePtr>>
+      policy;
+  // Latest matched set, shared by all contexts.
+  internal::MessageSlot<MessageSet> slot;
+  // AbstractState indices where messages are stored, one per topic.
+  std::vector<drake::systems::AbstractStateIndex> message_state_indices;
+  // AbstractState index where the sequence number of the stored set is kept.
+  drake::systems::AbstractStateIndex sequence_state_index;
+  // Tokens for shared subscriptions to serialized messages, one per topic.
+  // Declared last so that they are destroyed first.
+  std::vector<std::unique_ptr<internal::SubscriptionToken>> tokens;
+
+  // Feeds a message to the policy, matching sets as they complete.
+  void HandleMessage(size_t topic_index, SerializedMessagePtr message) {
+    internal::ScopedDrakeRosCall call;
+    const std::optional<builtin_interfaces::msg::Time> stamp =
+        PeekHeaderStamp(*message);
+    if (!stamp) {
+      return;
+    }
+    std::lock_guard<internal::AuditedMutex> lock(policy_mutex);
+    policy->add(topic_index, rclcpp::Time(*stamp).nanoseconds(),
+                std::move(message));
+  }
+};
+
+RosSynchronizerSystem::RosSynchronizerSystem(
+    std::vector<std::shared_ptr<const SerializerInterface>> serializers,
+    const std::vector<std::string>& topic_names, const rclcpp::QoS& qos,
+    DrakeRos* ros, const RosSynchronizerParams& params)
+    : impl_(new Impl()) {
+  if (topic_names.size() < 2) {
+    throw std::invalid_argument("at least 2 topics are required");
+  }
+  if (serializers.size() != topic_names.size()) {
+    throw std::invalid_argument("serializers and topics do not match");
+  }
+  if (!(params.max_interval_duration >= 0.0)) {
+    throw std::invalid_argument("max_interval_duration must be non-negative");
+  }
+  impl_->serializers = std::move(serializers);
+
+  const int64_t max_interval_duration =
+      std::isinf(params.max_interval_duration)
+          ? std::numeric_limits<int64_t>::max()
+          : static_cast<int64_t>(
+                std::llround(params.max_interval_duration * 1e9));
+  Impl* impl = impl_.get();
+  impl_->policy =
+      std::make_unique<internal::ApproximateTimePolicy<SerializedMessagePtr>>(
+          topic_names.size(), params.queue_size, max_interval_duration,
+          params.age_penalty, [impl](MessageSet matched_set) {
+            impl->slot.Put(
+                std::make_shared<MessageSet>(std::move(matched_set)));
+          });
+
+  internal::EntityPool* entity_pool = ros->get_mutable_entity_pool();
+  for (size_t i = 0; i < topic_names.size(); ++i) {
+    impl_->tokens.push_back(entity_pool->subscribe(
+        *impl_->serializers[i]->GetTypeSupport(), topic_names[i], qos,
+        [impl, i](SerializedMessagePtr message) {
+          impl->HandleMessage(i, std::move(message));
+        }));
+
+    impl_->message_state_indices.push_back(
+        DeclareAbstractState(*(impl_->serializers[i]->CreateDefaultValue())));
+    DeclareStateOutputPort(drake::systems::kUseDefaultName,
+                           impl_->message_state_indices.back());
+  }
+  impl_->sequence_state_index =
+      DeclareAbstractState(drake::Value<uint64_t>(0u));
+}
+
+RosSynchronizerSystem::~RosSynchronizerSystem() {}
+
+uint64_t RosSynchronizerSystem::num_matched_sets() const {
+  return impl_->slot.sequence();
+}
+
+void RosSynchronizerSystem::DoCalcNextUpdateTime(
+    const drake::systems::Context<double>& context,
+    drake::systems::CompositeEventCollection<double>* events,
+    double* time) const {
+  // We do not support events other than our own message timing events.
+  LeafSystem<double>::DoCalcNextUpdateTime(context, events, time);
+  DRAKE_THROW_UNLESS(events->HasEvents() == false);
+  DRAKE_THROW_UNLESS(std::isinf(*time));
+
+  // Do nothing unless there is a set this context has not seen yet.
+  const uint64_t last_sequence =
+      context.get_abstract_state<uint64_t>(impl_->sequence_state_index);
+  if (impl_->slot.sequence() == last_sequence) {
+    return;
+  }
+
+  // Apply the latest matched set as a whole when the event is handled.
+  auto callback = [this](const drake::systems::System<double>&,
+                         const drake::systems::Context<double>&,
+                         const drake::systems::UnrestrictedUpdateEvent<double>&,
+                         drake::systems::State<double>* state) {
+    internal::ScopedDrakeRosCall call;
+    auto [matched_set, sequence] = impl_->slot.Get();
+    if (!matched_set) {
+      return drake::systems::EventStatus::DidNothing();
+    }
+    drake::systems::AbstractValues& abstract_state =
+        state->get_mutable_abstract_state();
+    for (size_t i = 0; i < matched_set->size(); ++i) {
+      internal::ScopedDelegateCall delegate_call;
+      impl_->serializers[i]->Deserialize(
+          *(*matched_set)[i],
+          &abstract_state.get_mutable_value(impl_->message_state_indices[i]));
+    }
+    abstract_state.get_mutable_value(impl_->sequence_state_index)
+        .set_value<uint64_t>(sequence);
+    return drake::systems::EventStatus::Succeeded();
+  };
+
+  // Schedule an update event at the current time.
+  *time = context.get_time();
+  events->get_mutable_unrestricted_update_events().AddEvent(
+      drake::systems::UnrestrictedUpdateEvent<double>(
+          drake::systems::TriggerType::kTimed, callback));
+}
+}  // namespace core
+}  // namespace drake_ros
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <drake/systems/framework/leaf_system.h>
+#include <rclcpp/qos.hpp>
+
+#include "drake_ros/core/drake_ros.h"
+#include "drake_ros/core/serializer.h"
+#include "drake_ros/core/serializer_interface.h"
+
+namespace drake_ros {
+namespace core {
+
+/** Set of parameters that configure a RosSynchronizerSystem. */
+struct RosSynchronizerParams {
+  /** Maximum number of messages buffered per topic. */
+  size_t queue_size{10};
+
+  /** Maximum time spread of a matched set of messages, in seconds. */
+  double max_interval_duration{std::numeric_limits<double>::infinity()};
+
+  /** Penalty applied to sets of older messages over sets of newer ones,
+   as a fraction of their time spread. Higher values favor newer sets. */
+  double age_penalty{0.1};
+};
+
+/** A system that subscribes to multiple ROS topics and outputs sets of
+ messages matched by their header stamps.
+
+ Messages are matched according to the approximate time policy of the
+ ROS `message_filters` package: among the messages buffered in bounded
+ per-topic queues, it matches sets (one message per topic) that minimize
+ time spread. Matching takes place as messages are received, when the
+ underlying ROS node is spun. The latest matched set is applied on
+ simulation steps, making all messages in the set available on their
+ output ports at once. Output ports are in the same order as topics.
+
+ All message types must have a `std_msgs/msg/Header` as their first
+ field, as most stamped ROS message types do. Messages that are too
+ short to have a header are ignored.
+ */
+class RosSynchronizerSystem : public drake::systems::LeafSystem<double> {
+ public:
+  /** Instantiates a ROS synchronizer system for the given ROS message types,
+   one per topic. See `RosSynchronizerSystem::RosSynchronizerSystem`
+   documentation for further reference on function arguments.
+
+   @tparam MessageTs C++ ROS message types.
+   */
+  template <typename... MessageTs>
+  static std::unique_ptr<RosSynchronizerSystem> Make(
+      const std::vector<std::string>& topic_names, const rclcpp::QoS& qos,
+      DrakeRos* ros, const RosSynchronizerParams& params = {}) {
+    // Assume C++ typesupport since this is a C++ template function
+    return std::make_unique<RosSynchronizerSystem>(
+        std::vector<std::shared_ptr<const SerializerInterface>>{
+            std::make_shared<Serializer<MessageTs>>()...},
+        topic_names, qos, ros, params);
+  }
+
+  /** A constructor for the ROS synchronizer system.
+
+   @param[in] serializers (de)serialization interfaces for the
+     expected ROS message types, one per topic.
+   @param[in] topic_names Names of the ROS topics to subscribe to.
+   @param[in] qos QoS profile for the underlying ROS subscriptions.
+   @param[in] ros interface to a live ROS node to subscribe from.
+   @param[in] params optional synchronizer configuration.
+   @throws std::invalid_argument if there are fewer than two topics,
+     if there are not as many serializers as topics, or if any of the
+     `params` is out of range.
+   */
+  RosSynchronizerSystem(
+      std::vector<std::shared_ptr<const SerializerInterface>> serializers,
+      const std::vector<std::string>& topic_names, const rclcpp::QoS& qos,
+      DrakeRos* ros, const RosSynchronizerParams& params = {});
+
+  ~RosSynchronizerSystem() override;
+
+  /** Returns the number of sets matched so far. */
+  uint64_t num_matched_sets() const;
+
+ protected:
+  void DoCalcNextUpdateTime(const drake::systems::Context<double>&,
+                            drake::systems::CompositeEventCollection<double>*,
+                            double*) const override;
+
+ private:
+  struct Impl;
+  std::unique_ptr<Impl> impl_;
+};
+}  // namespace core
+}  // namespace drake_ros
@@ -0,0 +1,111 @@
+#include "drake_ros/core/serialized_header.h"
+
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+#include <drake/common/drake_throw.h>
+
+namespace drake_ros {
+namespace core {
+namespace {
+// Size of the CDR encapsulation header that precedes the payload.
+constexpr size_t kEncapsulationSize = 4;
+
+// Reads a 32 bits unsigned integer at `offset` bytes into the payload of a
+// CDR-serialized message. Returns nothing if out of bounds or not CDR.
+std::optional<uint32_t> ReadUint32(const rcl_serialized_message_t& message,
+                                   size_t offset) {
+  if (message.buffer_length < kEncapsulationSize + offset + sizeof(uint32_t)) {
+    return std::nullopt;
+  }
+  // Second byte of the encapsulation header tells endianness apart:
+  // 0x00 for CDR_BE, 0x01 for CDR_LE.
+  const uint8_t encapsulation = message.buffer[1];
+  if (encapsulation > 0x01) {
+    return std::nullopt;
+  }
+  const uint8_t* bytes = message.buffer + kEncapsulationSize + offset;
+  if (encapsulation == 0x01) {
+    return static_cast<uint32_t>(bytes[0]) |
+           static_cast<uint32_t>(bytes[1]) << 8 |
+           static_cast<uint32_t>(bytes[2]) << 16 |
+           static_cast<uint32_t>(bytes[3]) << 24;
+  }
+  return static_cast<uint32_t>(bytes[3]) |
+         static_cast<uint32_t>(bytes[2]) << 8 |
+         static_cast<uint32_t>(bytes[1]) << 16 |
+         static_cast<uint32_t>(bytes[0]) << 24;
+}
+
+// Writes a 32 bits unsigned integer at `offset` bytes into the payload of a
+// CDR-serialized message. Returns false if out of bounds or not CDR.
+bool WriteUint32(uint32_t value, size_t offset,
+                 rcl_serialized_message_t* message) {
+  if (message->buffer_length < kEncapsulationSize + offset + sizeof(uint32_t)) {
+    return false;
+  }
+  const uint8_t encapsulation = message->buffer[1];
+  if (encapsulation > 0x01) {
+    return false;
+  }
+  uint8_t* bytes = message->buffer + kEncapsulationSize + offset;
+  for (size_t i = 0; i < sizeof(uint32_t); ++i) {
+    const size_t shift = 8 * (encapsulation == 0x01 ? i : 3 - i);
+    bytes[i] = static_cast<uint8_t>(value >> shift);
+  }
+  return true;
+}
+}  // namespace
+
+std::optional<builtin_interfaces::msg::Time> PeekHeaderStamp(
+    const rclcpp::SerializedMessage& message) {
+  const rcl_serialized_message_t& rcl_serialized_message =
+      message.get_rcl_serialized_message();
+  // std_msgs/msg/Header starts with a builtin_interfaces/msg/Time stamp,
+  // i.e. an int32 sec followed by an uint32 nanosec.
+  const std::optional<uint32_t> sec = ReadUint32(rcl_serialized_message, 0);
+  const std::optional<uint32_t> nanosec = ReadUint32(rcl_serialized_message, 4);
+  if (!sec || !nanosec) {
+    return std::nullopt;
+  }
+  builtin_interfaces::msg::Time stamp;
+  stamp.sec = static_cast<int32_t>(*sec);
+  stamp.nanosec = *nanosec;
+  return stamp;
+}
+
+std::optional<std::string_view> PeekHeaderFrameId(
+    const rclcpp::SerializedMessage& message) {
+  const rcl_serialized_message_t& rcl_serialized_message =
+      message.get_rcl_serialized_message();
+  // std_msgs/msg/Header frame ID follows its stamp, as an uint32 length
+  // (including the null terminator) followed by characters.
+  constexpr size_t kFrameIdOffset = 8;
+  const std::optional<uint32_t> length =
+      ReadUint32(rcl_serialized_message, kFrameIdOffset);
+  if (!length) {
+    return std::nullopt;
+  }
+  const size_t data_offset =
+      kEncapsulationSize + kFrameIdOffset + sizeof(uint32_t);
+  if (rcl_serialized_message.buffer_length < data_offset + *length) {
+    return std::nullopt;
+  }
+  const char* data =
+      reinterpret_cast<const char*>(rcl_serialized_message.buffer) +
+      data_offset;
+  return std::string_view(data, *length > 0 ? *length - 1 : 0);
+}
+
+bool SetHeaderStamp(const builtin_interfaces::msg::Time& stamp,
+                    rclcpp::SerializedMessage* message) {
+  DRAKE_THROW_UNLESS(message != nullptr);
+  rcl_serialized_message_t& rcl_serialized_message =
+      message->get_rcl_serialized_message();
+  return WriteUint32(static_cast<uint32_t>(stamp.sec), 0,
+                     &rcl_serialized_message) &&
+         WriteUint32(stamp.nanosec, 4, &rcl_serialized_message);
+}
+}  // namespace core
+}  // namespace drake_ros
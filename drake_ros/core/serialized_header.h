@@ -0,0 +1,53 @@
+#pragma once
+
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include <builtin_interfaces/msg/time.hpp>
+#include <rclcpp/serialized_message.hpp>
+
+namespace drake_ros {
+namespace core {
+/** Peeks the header stamp of a CDR-serialized ROS message, without
+ deserializing it.
+
+ The message type must have a `std_msgs/msg/Header` as its first field,
+ as most stamped ROS message types do. This cannot be checked.
+
+ @param[in] message the serialized ROS message.
+ @returns the header stamp, or nothing if `message` is too short to
+   hold a header or is not CDR-encoded.
+ */
+std::optional<builtin_interfaces::msg::Time> PeekHeaderStamp(
+    const rclcpp::SerializedMessage& message);
+
+/** Peeks the header frame ID of a CDR-serialized ROS message, without
+ deserializing it.
+
+ The message type must have a `std_msgs/msg/Header` as its first field,
+ as most stamped ROS message types do. This cannot be checked.
+
+ @param[in] message the serialized ROS message.
+ @returns a view of the header frame ID, valid as long as `message` is,
+   or nothing if `message` is too short to hold a header or is not
+   CDR-encoded.
+ */
+std::optional<std::string_view> PeekHeaderFrameId(
+    const rclcpp::SerializedMessage& message);
+
+/** Overwrites the header stamp of a CDR-serialized ROS message in place,
+ e.g. to restamp messages being relayed without deserializing them.
+
+ The message type must have a `std_msgs/msg/Header` as its first field,
+ as most stamped ROS message types do. This cannot be checked.
+
+ @param[in] stamp the new header stamp.
+ @param[inout] message the serialized ROS message.
+ @returns true if the stamp was overwritten, false if `message` is too
+   short to hold a header or is not CDR-encoded.
+ */
+bool SetHeaderStamp(const builtin_interfaces::msg::Time& stamp,
+                    rclcpp::SerializedMessage* message);
+}  // namespace core
+}  // namespace drake_ros
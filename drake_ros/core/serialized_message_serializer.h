@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstring>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include <drake/common/value.h>
+#include <rclcpp/serialized_message.hpp>
+#include <rosidl_runtime_cpp/traits.hpp>
+#include <rosidl_typesupport_cpp/message_type_support.hpp>
+
+#include "drake_ros/core/serializer_interface.h"
+
+namespace drake_ros {
+namespace core {
+/** A (de)serialization interface implementation that passes serialized
+ ROS messages through, as `rclcpp::SerializedMessage` values.
+
+ Systems using it carry serialized messages as abstract values, and thus
+ (de)serialization is reduced to a byte copy regardless of message type.
+ This is useful for systems that only route messages (e.g. relays and
+ multiplexers). Messages with a `std_msgs/msg/Header` may still be
+ inspected via PeekHeaderStamp() and PeekHeaderFrameId().
+ */
+class SerializedMessageSerializer : public SerializerInterface {
+ public:
+  /** Makes a passthrough serializer for C++ ROS messages of `MessageT`
+   type. */
+  template <typename MessageT>
+  static std::shared_ptr<SerializedMessageSerializer> Make() {
+    return std::make_shared<SerializedMessageSerializer>(
+        rosidl_typesupport_cpp::get_message_type_support_handle<MessageT>(),
+        rosidl_generator_traits::name<MessageT>());
+  }
+
+  /** A constructor for a passthrough serializer.
+   @param[in] type_support ROS message typesupport.
+   @param[in] type_name ROS message type name e.g. "std_msgs/msg/String",
+     if known.
+   */
+  explicit SerializedMessageSerializer(
+      const rosidl_message_type_support_t* type_support,
+      std::string type_name = {})
+      : type_support_(type_support), type_name_(std::move(type_name)) {}
+
+  rclcpp::SerializedMessage Serialize(
+      const drake::AbstractValue& abstract_value) const override {
+    return abstract_value.get_value<rclcpp::SerializedMessage>();
+  }
+
+  void SerializeInto(const drake::AbstractValue& abstract_value,
+                     rclcpp::SerializedMessage* message) const override {
+    const rcl_serialized_message_t& source =
+        abstract_value.get_value<rclcpp::SerializedMessage>()
+            .get_rcl_serialized_message();
+    if (message->capacity() < source.buffer_length) {
+      message->reserve(source.buffer_length);
+    }
+    rcl_serialized_message_t& target = message->get_rcl_serialized_message();
+    if (source.buffer_length > 0) {
+      std::memcpy(target.buffer, source.buffer, source.buffer_length);
+    }
+    target.buffer_length = source.buffer_length;
+  }
+
+  void Deserialize(const rclcpp::SerializedMessage& serialized_message,
+                   drake::AbstractValue* abstract_value) const override {
+    abstract_value->get_mutable_value<rclcpp::SerializedMessage>() =
+        serialized_message;
+  }
+
+  std::unique_ptr<drake::AbstractValue> CreateDefaultValue() const override {
+    return std::make_unique<drake::Value<rclcpp::SerializedMessage>>();
+  }
+
+  const rosidl_message_type_support_t* GetTypeSupport() const override {
+    return type_support_;
+  }
+
+  std::string GetTypeName() const override { return type_name_; }
+
+ private:
+  const rosidl_message_type_support_t* type_support_;
+  std::string type_name_;
+};
+}  // namespace core
+}  // namespace drake_ros
@@ -1,10 +1,12 @@
 #pragma once
 
 #include <memory>
+#include <string>
 
 #include <drake/common/value.h>
 #include <rclcpp/serialization.hpp>
 #include <rclcpp/serialized_message.hpp>
+#include <rosidl_runtime_cpp/traits.hpp>
 #include <rosidl_typesupport_cpp/message_type_support.hpp>
 
 #include "drake_ros/core/serializer_interface.h"
@@ -12,18 +14,26 @@
 namespace drake_ros {
 namespace core {
 /** A (de)serialization interface implementation that is
- bound to C++ ROS messages of `MessageT` type. */
+ bound to C++ ROS messages of `MessageT` type.
+
+ Messages are (de)serialized with rclcpp::Serialization. See CdrSerializer
+ for messages with a CdrCodec. */
 template <typename MessageT>
 class Serializer : public SerializerInterface {
  public:
   rclcpp::SerializedMessage Serialize(
       const drake::AbstractValue& abstract_value) const override {
     rclcpp::SerializedMessage serialized_message;
-    protocol_.serialize_message(&abstract_value.get_value<MessageT>(),
-                                &serialized_message);
+    SerializeInto(abstract_value, &serialized_message);
     return serialized_message;
   }
 
+  void SerializeInto(const drake::AbstractValue& abstract_value,
+                     rclcpp::SerializedMessage* message) const override {
+    protocol_.serialize_message(&abstract_value.get_value<MessageT>(),
+                                message);
+  }
+
   void Deserialize(const rclcpp::SerializedMessage& serialized_message,
                    drake::AbstractValue* abstract_value) const override {
     protocol_.deserialize_message(
@@ -38,6 +48,10 @@ class Serializer : public SerializerInterface {
     return rosidl_typesupport_cpp::get_message_type_support_handle<MessageT>();
   }
 
+  std::string GetTypeName() const override {
+    return rosidl_generator_traits::name<MessageT>();
+  }
+
  private:
   rclcpp::Serialization<MessageT> protocol_;
 };
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <string>
 
 #include <drake/common/value.h>
 #include <rclcpp/serialized_message.hpp>
@@ -28,6 +29,18 @@ class SerializerInterface {
   virtual rclcpp::SerializedMessage Serialize(
       const drake::AbstractValue& abstract_value) const = 0;
 
+  /** Serializes a ROS message of a given type into an existing serialized
+   message, reusing its buffer whenever it is large enough. The default
+   implementation falls back to Serialize().
+   @param[in] abstract_value type-erased value
+     wrapping the ROS message to be serialized.
+   @param[inout] message the serialized ROS message.
+   */
+  virtual void SerializeInto(const drake::AbstractValue& abstract_value,
+                             rclcpp::SerializedMessage* message) const {
+    *message = Serialize(abstract_value);
+  }
+
   /** Deserializes a ROS message of a given type.
    @param[in] message the serialized ROS message.
    @param[inout] abstract_value type-erased value wrapping
@@ -42,6 +55,10 @@ class SerializerInterface {
 
   /** Returns a reference to the ROS message typesupport. */
   virtual const rosidl_message_type_support_t* GetTypeSupport() const = 0;
+
+  /** Returns the name of the ROS message type e.g. "std_msgs/msg/String",
+   or an empty string if unknown. */
+  virtual std::string GetTypeName() const { return {}; }
 };
 }  // namespace core
 }  // namespace drake_ros
@@ -0,0 +1,203 @@
+#include "drake_ros/core/simulation_server.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <rclcpp/logging.hpp>
+#include <rclcpp/node.hpp>
+#include <std_msgs/msg/u_int32.hpp>
+#include <std_msgs/msg/u_int32_multi_array.hpp>
+
+namespace drake_ros {
+namespace core {
+namespace {
+// A request to the simulation server.
+struct Request {
+  // Whether to reset the simulation.
+  bool reset{false};
+  // Number of steps to take, if not resetting.
+  int num_steps{0};
+  // Client-supplied sequence number, echoed in the reply.
+  uint32_t sequence_number{0};
+};
+}  // namespace
+
+struct SimulationServer::Impl {
+  // Diagram being simulated.
+  std::unique_ptr<drake::systems::Diagram<double>> diagram;
+  // Simulator for the diagram.
+  std::unique_ptr<drake::systems::Simulator<double>> simulator;
+  // Server configuration.
+  SimulationServerParams params;
+  // Interface to the ROS node serving requests.
+  DrakeRos* ros{nullptr};
+  // Output ports to observe, in order.
+  std::vector<const drake::systems::OutputPort<double>*> observation_ports;
+
+  rclcpp::Subscription<std_msgs::msg::UInt32MultiArray>::SharedPtr step_sub;
+  rclcpp::Subscription<std_msgs::msg::UInt32>::SharedPtr reset_sub;
+  rclcpp::Publisher<std_msgs::msg::Float64MultiArray>::SharedPtr
+      observation_pub;
+
+  // Requests received but not yet served, in order of arrival.
+  std::mutex requests_mutex;
+  std::deque<Request> pending_requests;
+
+  void Enqueue(Request request) {
+    std::lock_guard<std::mutex> lock(requests_mutex);
+    pending_requests.push_back(request);
+  }
+};
+
+SimulationServer::SimulationServer(
+    std::unique_ptr<drake::systems::Diagram<double>> diagram, DrakeRos* ros,
+    SimulationServerParams params)
+    : impl_(new Impl()) {
+  DRAKE_THROW_UNLESS(diagram != nullptr);
+  DRAKE_THROW_UNLESS(ros != nullptr);
+  if (!(params.time_step > 0.0)) {
+    throw std::invalid_argument("time_step must be positive");
+  }
+  impl_->diagram = std::move(diagram);
+  impl_->params = std::move(params);
+  impl_->ros = ros;
+
+  for (const std::string& port_name : impl_->params.observation_port_names) {
+    const drake::systems::OutputPort<double>& port =
+        impl_->diagram->GetOutputPort(port_name);
+    if (port.get_data_type() != drake::systems::kVectorValued) {
+      throw std::invalid_argument("observation port '" + port_name +
+                                  "' is not vector-valued");
+    }
+    impl_->observation_ports.push_back(&port);
+  }
+
+  impl_->simulator =
+      std::make_unique<drake::systems::Simulator<double>>(*impl_->diagram);
+  // Serve requests as fast as possible.
+  impl_->simulator->set_target_realtime_rate(0.0);
+  Reset();
+
+  rclcpp::Node* node = ros->get_mutable_node();
+  Impl* impl = impl_.get();
+  impl_->step_sub =
+      node->create_subscription<std_msgs::msg::UInt32MultiArray>(
+          impl_->params.step_topic_name, impl_->params.qos,
+          [impl](const std_msgs::msg::UInt32MultiArray& msg) {
+            if (msg.data.size() != 2u) {
+              RCLCPP_WARN(impl->ros->get_node().get_logger(),
+                          "Ignoring malformed step request");
+              return;
+            }
+            Request request;
+            request.sequence_number = msg.data[0];
+            request.num_steps = static_cast<int>(std::min<uint32_t>(
+                msg.data[1], std::numeric_limits<int>::max()));
+            impl->Enqueue(request);
+          });
+  impl_->reset_sub = node->create_subscription<std_msgs::msg::UInt32>(
+      impl_->params.reset_topic_name, impl_->params.qos,
+      [impl](const std_msgs::msg::UInt32& msg) {
+        Request request;
+        request.reset = true;
+        request.sequence_number = msg.data;
+        impl->Enqueue(request);
+      });
+  impl_->observation_pub =
+      node->create_publisher<std_msgs::msg::Float64MultiArray>(
+          impl_->params.observation_topic_name, impl_->params.qos);
+}
+
+SimulationServer::~SimulationServer() {}
+
+const drake::systems::Simulator<double>& SimulationServer::get_simulator()
+    const {
+  return *impl_->simulator;
+}
+
+drake::systems::Simulator<double>* SimulationServer::get_mutable_simulator() {
+  return impl_->simulator.get();
+}
+
+void SimulationServer::Reset() {
+  drake::systems::Context<double>& context =
+      impl_->simulator->get_mutable_context();
+  impl_->diagram->SetDefaultContext(&context);
+  context.SetTime(0.0);
+  if (impl_->params.reset_function) {
+    impl_->params.reset_function(&context);
+  }
+  impl_->simulator->Initialize();
+}
+
+void SimulationServer::Step(int num_steps) {
+  DRAKE_THROW_UNLESS(num_steps >= 0);
+  if (num_steps == 0) {
+    return;
+  }
+  const double start_time = impl_->simulator->get_context().get_time();
+  // Compute the target time from the start time to avoid accumulating
+  // round-off errors across steps.
+  impl_->simulator->AdvanceTo(start_time +
+                              num_steps * impl_->params.time_step);
+}
+
+std_msgs::msg::Float64MultiArray SimulationServer::CalcObservation(
+    uint32_t sequence_number) const {
+  const drake::systems::Context<double>& context =
+      impl_->simulator->get_context();
+
+  std_msgs::msg::Float64MultiArray observation;
+  auto add_segment = [&observation](const std::string& label, size_t size) {
+    std_msgs::msg::MultiArrayDimension dim;
+    dim.label = label;
+    dim.size = static_cast<uint32_t>(size);
+    dim.stride = static_cast<uint32_t>(size);
+    observation.layout.dim.push_back(dim);
+  };
+
+  add_segment("sequence", 1);
+  observation.data.push_back(sequence_number);
+  add_segment("time", 1);
+  observation.data.push_back(context.get_time());
+  for (const drake::systems::OutputPort<double>* port :
+       impl_->observation_ports) {
+    const drake::VectorX<double>& value = port->Eval(context);
+    add_segment(port->get_name(), value.size());
+    observation.data.insert(observation.data.end(), value.data(),
+                            value.data() + value.size());
+  }
+  return observation;
+}
+
+int SimulationServer::HandleRequests(int timeout_millis) {
+  impl_->ros->Spin(timeout_millis);
+
+  // Take all pending requests at once. Requests arriving while serving
+  // (e.g. when the diagram spins the node) are left for the next call.
+  std::deque<Request> requests;
+  {
+    std::lock_guard<std::mutex> lock(impl_->requests_mutex);
+    requests.swap(impl_->pending_requests);
+  }
+  for (const Request& request : requests) {
+    if (request.reset) {
+      Reset();
+    } else {
+      Step(request.num_steps);
+    }
+    impl_->observation_pub->publish(CalcObservation(request.sequence_number));
+  }
+  return static_cast<int>(requests.size());
+}
+
+}  // namespace core
+}  // namespace drake_ros
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <drake/systems/analysis/simulator.h>
+#include <drake/systems/framework/diagram.h>
+#include <rclcpp/qos.hpp>
+#include <std_msgs/msg/float64_multi_array.hpp>
+
+#include "drake_ros/core/drake_ros.h"
+
+namespace drake_ros {
+namespace core {
+
+/** Set of parameters that configure a SimulationServer. */
+struct SimulationServerParams {
+  /** Names of the diagram output ports to pack into observations, in order.
+   Only vector-valued ports are supported. */
+  std::vector<std::string> observation_port_names;
+
+  /** Simulated time to advance per step, in seconds. */
+  double time_step{0.01};
+
+  /** Optional function to (re)set the simulation context upon reset, after
+   it has been set to its default values. Useful to randomize initial
+   conditions. */
+  std::function<void(drake::systems::Context<double>*)> reset_function;
+
+  /** Topic name for step requests, carrying a sequence number and the
+   number of steps to take. A request for zero steps simply asks for an
+   observation. */
+  std::string step_topic_name{"~/step"};
+
+  /** Topic name for reset requests, carrying a sequence number. */
+  std::string reset_topic_name{"~/reset"};
+
+  /** Topic name for observations. */
+  std::string observation_topic_name{"~/observation"};
+
+  /** QoS profile for request and observation topics. */
+  rclcpp::QoS qos{rclcpp::QoS(10).reliable()};
+};
+
+/** A server to drive a simulation remotely over ROS.
+
+ The server owns a simulator for a given diagram, which it runs as fast as
+ possible (i.e. without realtime pacing), and exposes reset, step and
+ observation operations through the following ROS topics:
+
+ - *step* (`std_msgs/msg/UInt32MultiArray`): requests to advance the
+   simulation, carrying a client-supplied sequence number and the number
+   of steps to take, in that order. Steps are taken in a single batch. If
+   zero steps are requested, an observation is simply reported.
+ - *reset* (`std_msgs/msg/UInt32`): requests to reset the simulation,
+   carrying a client-supplied sequence number.
+ - *observation* (`std_msgs/msg/Float64MultiArray`): an observation, sent
+   in reply to each and every request, carrying the sequence number of the
+   request it answers.
+
+ Observations are packed as the concatenation of the sequence number, the
+ simulation time, and the values of all configured output ports, in order.
+ The layout has one dimension per segment, labeled after it ("sequence" for
+ the sequence number, "time" for the simulation time, port names otherwise)
+ and sized accordingly. Sequence numbers are 32-bit, and thus represented
+ exactly as doubles. Step requests not carrying two numbers are ignored.
+
+ Requests are received when spinning the given ROS interface, but they are
+ only served by HandleRequests(), on the calling thread.
+ */
+class SimulationServer final {
+ public:
+  /** A constructor for the simulation server.
+   @param[in] diagram diagram to simulate.
+   @param[in] ros interface to a live ROS node to serve requests from.
+     Typically, the same node that `diagram` uses.
+   @param[in] params server configuration.
+   @throws std::invalid_argument if `params.time_step` is not positive or
+     any of the observation ports is not vector-valued.
+   */
+  SimulationServer(std::unique_ptr<drake::systems::Diagram<double>> diagram,
+                   DrakeRos* ros, SimulationServerParams params);
+
+  ~SimulationServer();
+
+  /** Returns a constant reference to the underlying simulator. */
+  const drake::systems::Simulator<double>& get_simulator() const;
+
+  /** Returns a mutable reference to the underlying simulator. */
+  drake::systems::Simulator<double>* get_mutable_simulator();
+
+  /** Resets the simulation to its initial conditions. */
+  void Reset();
+
+  /** Advances the simulation by `num_steps` steps. */
+  void Step(int num_steps);
+
+  /** Computes an observation for the current simulation state.
+   @param[in] sequence_number sequence number of the request the
+     observation answers, if any.
+   */
+  std_msgs::msg::Float64MultiArray CalcObservation(
+      uint32_t sequence_number = 0) const;
+
+  /** Spins the ROS interface and serves all pending requests, if any.
+   @param[in] timeout_millis Timeout, in milliseconds, when spinning.
+     See DrakeRos::Spin() for further reference.
+   @returns the number of requests served.
+   */
+  int HandleRequests(int timeout_millis = 0);
+
+ private:
+  struct Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace core
+}  // namespace drake_ros
@@ -1,8 +1,16 @@
 #include "subscription.h"  // NOLINT(build/include)
 
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <utility>
+#include <vector>
 
+#include "qos_event_counters.h"  // NOLINT(build/include)
+#include "realtime_audit.h"      // NOLINT(build/include)
+#include <rcl/subscription.h>
+#include <rclcpp/exceptions.hpp>
 #include <rclcpp/version.h>
 
 namespace drake_ros {
@@ -10,9 +18,26 @@ namespace core {
 namespace internal {
 namespace {
 // Copied from rosbag2_transport rosbag2_get_subscription_options
-rcl_subscription_options_t subscription_options(const rclcpp::QoS& qos) {
+// Content filter options are set as rclcpp::SubscriptionOptions would.
+rcl_subscription_options_t subscription_options(
+    const rclcpp::QoS& qos,
+    const rclcpp::ContentFilterOptions& content_filter_options) {
   auto options = rcl_subscription_get_default_options();
   options.qos = qos.get_rmw_qos_profile();
+  if (!content_filter_options.filter_expression.empty()) {
+    std::vector<const char*> parameters;
+    for (const std::string& parameter :
+         content_filter_options.expression_parameters) {
+      parameters.push_back(parameter.c_str());
+    }
+    const rcl_ret_t ret = rcl_subscription_options_set_content_filter_options(
+        content_filter_options.filter_expression.c_str(), parameters.size(),
+        parameters.data(), &options);
+    if (RCL_RET_OK != ret) {
+      rclcpp::exceptions::throw_from_rcl_error(
+          ret, "failed to set content filter options");
+    }
+  }
   return options;
 }
 }  // namespace
@@ -21,24 +46,76 @@ Subscription::Subscription(
     rclcpp::node_interfaces::NodeBaseInterface* node_base,
     const rosidl_message_type_support_t& ts, const std::string& topic_name,
     const rclcpp::QoS& qos,
-    std::function<void(std::shared_ptr<rclcpp::SerializedMessage>)> callback)
+    std::function<void(std::shared_ptr<rclcpp::SerializedMessage>)> callback,
+    size_t message_pool_size,
+    const rclcpp::ContentFilterOptions& content_filter_options)
+    : Subscription(node_base, ts, topic_name, qos, std::move(callback),
+                   message_pool_size, content_filter_options,
+                   std::make_shared<QosEventCounters>()) {}
+
+Subscription::Subscription(
+    rclcpp::node_interfaces::NodeBaseInterface* node_base,
+    const rosidl_message_type_support_t& ts, const std::string& topic_name,
+    const rclcpp::QoS& qos,
+    std::function<void(std::shared_ptr<rclcpp::SerializedMessage>)> callback,
+    size_t message_pool_size,
+    const rclcpp::ContentFilterOptions& content_filter_options,
+    std::shared_ptr<QosEventCounters> event_counters)
 #if RCLCPP_VERSION_GTE(18, 0, 0)
     : rclcpp::SubscriptionBase(
-          node_base, ts, topic_name, subscription_options(qos),
-          /* event_callbacks */ {},
+          node_base, ts, topic_name,
+          subscription_options(qos, content_filter_options),
+          QosEventCounters::make_subscription_callbacks(event_counters,
+                                                        topic_name),
           /* use_default_callbacks */ true,
           /* delivered_message_kind */
           rclcpp::DeliveredMessageKind::SERIALIZED_MESSAGE),
 #else
-    : rclcpp::SubscriptionBase(node_base, ts, topic_name,
-                               subscription_options(qos),
-                               /* is_serialized */ true),
+    : rclcpp::SubscriptionBase(
+          node_base, ts, topic_name,
+          subscription_options(qos, content_filter_options),
+          /* is_serialized */ true),
+#endif
+      callback_(callback),
+      message_pool_size_(message_pool_size),
+      event_counters_(std::move(event_counters)) {
+  message_pool_.reserve(message_pool_size_);
+#if !RCLCPP_VERSION_GTE(18, 0, 0)
+  // Bind event callbacks as rclcpp::Subscription would.
+  const rclcpp::SubscriptionEventCallbacks callbacks =
+      QosEventCounters::make_subscription_callbacks(event_counters_,
+                                                    topic_name);
+  auto try_add_event_handler =
+      [this](const auto& callback, rcl_subscription_event_type_t event_type) {
+        try {
+          add_event_handler(callback, event_type);
+        } catch (const rclcpp::UnsupportedEventTypeException&) {
+          // Not all RMW implementations support all events.
+        }
+      };
+  try_add_event_handler(callbacks.deadline_callback,
+                        RCL_SUBSCRIPTION_REQUESTED_DEADLINE_MISSED);
+  try_add_event_handler(callbacks.liveliness_callback,
+                        RCL_SUBSCRIPTION_LIVELINESS_CHANGED);
+  try_add_event_handler(callbacks.incompatible_qos_callback,
+                        RCL_SUBSCRIPTION_REQUESTED_INCOMPATIBLE_QOS);
+  try_add_event_handler(callbacks.message_lost_callback,
+                        RCL_SUBSCRIPTION_MESSAGE_LOST);
 #endif
-      callback_(callback) {
 }
 
 Subscription::~Subscription() {}
 
+void Subscription::grow_message_pool(size_t size) {
+  std::lock_guard<AuditedMutex> lock(message_pool_mutex_);
+  message_pool_size_ += size;
+  message_pool_.reserve(message_pool_size_);
+}
+
+QosEventStatus Subscription::get_qos_event_status() const {
+  return event_counters_->get_status();
+}
+
 std::shared_ptr<void> Subscription::create_message() {
   // Subscriber only does serialized messages
   return create_serialized_message();
@@ -46,7 +123,22 @@ std::shared_ptr<void> Subscription::create_message() {
 
 std::shared_ptr<rclcpp::SerializedMessage>
 Subscription::create_serialized_message() {
-  return std::make_shared<rclcpp::SerializedMessage>();
+  ScopedDrakeRosCall call;
+  std::lock_guard<AuditedMutex> lock(message_pool_mutex_);
+  for (const auto& message : message_pool_) {
+    // Messages only held by the pool can be reused. No one else can get
+    // hold of them in the meantime.
+    if (message.use_count() == 1) {
+      // Synchronize with the last release, if it happened elsewhere.
+      std::atomic_thread_fence(std::memory_order_acquire);
+      return message;
+    }
+  }
+  auto message = std::make_shared<rclcpp::SerializedMessage>();
+  if (message_pool_.size() < message_pool_size_) {
+    message_pool_.push_back(message);
+  }
+  return message;
 }
 
 void Subscription::handle_message(std::shared_ptr<void>& message,
@@ -68,6 +160,7 @@ void Subscription::handle_serialized_message(
     const std::shared_ptr<rclcpp::SerializedMessage>& message,
     const rclcpp::MessageInfo& message_info) {
   (void)message_info;
+  ScopedDrakeRosCall call;
   callback_(message);
 }
 
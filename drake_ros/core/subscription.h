@@ -2,28 +2,45 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
+#include "realtime_audit.h"  // NOLINT(build/include)
 #include <rclcpp/qos.hpp>
 #include <rclcpp/subscription_base.hpp>
+#include <rclcpp/subscription_content_filter_options.hpp>
 #include <rclcpp/version.h>
 #include <rmw/serialized_message.h>
 #include <rosidl_runtime_c/message_type_support_struct.h>
 
+#include "drake_ros/core/qos_event_status.h"
+
 namespace drake_ros {
 namespace core {
 namespace internal {
+class QosEventCounters;
+
 // A type-erased version of rclcpp:::Subscription<Message>.
 // This class conforms to the ROS 2 C++ style for consistency.
 class Subscription final : public rclcpp::SubscriptionBase {
  public:
+  // Content filter options, if any, are handed over to the middleware on
+  // creation. Throws if the middleware rejects them.
   Subscription(
       rclcpp::node_interfaces::NodeBaseInterface* node_base,
       const rosidl_message_type_support_t& ts, const std::string& topic_name,
       const rclcpp::QoS& qos,
-      std::function<void(std::shared_ptr<rclcpp::SerializedMessage>)> callback);
+      std::function<void(std::shared_ptr<rclcpp::SerializedMessage>)> callback,
+      size_t message_pool_size = 0u,
+      const rclcpp::ContentFilterOptions& content_filter_options = {});
 
   ~Subscription();
 
+  // Grows the pool of serialized messages to reuse by `size` messages.
+  void grow_message_pool(size_t size);
+
+  // Returns counts of QoS events on this subscription so far.
+  QosEventStatus get_qos_event_status() const;
+
 #if RCLCPP_VERSION_GTE(18, 0, 0)
   rclcpp::dynamic_typesupport::DynamicMessageType::SharedPtr
   get_shared_dynamic_message_type() override {
@@ -103,7 +120,22 @@ class Subscription final : public rclcpp::SubscriptionBase {
       std::shared_ptr<rclcpp::SerializedMessage>& message) override;
 
  private:
+  Subscription(
+      rclcpp::node_interfaces::NodeBaseInterface* node_base,
+      const rosidl_message_type_support_t& ts, const std::string& topic_name,
+      const rclcpp::QoS& qos,
+      std::function<void(std::shared_ptr<rclcpp::SerializedMessage>)> callback,
+      size_t message_pool_size,
+      const rclcpp::ContentFilterOptions& content_filter_options,
+      std::shared_ptr<QosEventCounters> event_counters);
+
   std::function<void(std::shared_ptr<rclcpp::SerializedMessage>)> callback_;
+  // Mutex to synchronize access to the message pool.
+  AuditedMutex message_pool_mutex_;
+  // Serialized messages to reuse, once no one else holds on to them.
+  std::vector<std::shared_ptr<rclcpp::SerializedMessage>> message_pool_;
+  size_t message_pool_size_;
+  std::shared_ptr<QosEventCounters> event_counters_;
 };
 }  // namespace internal
 }  // namespace core
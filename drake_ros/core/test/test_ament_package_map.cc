@@ -0,0 +1,189 @@
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <drake/multibody/parsing/package_map.h>
+#include <gtest/gtest.h>
+
+#include "drake_ros/core/ament_package_map.h"
+#include "internal_ament_package_map.h"  // NOLINT(build/include)
+
+using drake_ros::core::GetAmentPackageDirectories;
+using drake_ros::core::GetAmentPackageUri;
+using drake_ros::core::PopulatePackageMapFromAmentIndex;
+using drake_ros::core::internal::LoadAmentPackageDirectories;
+
+namespace fs = std::filesystem;
+
+namespace {
+using Directories = std::map<std::string, std::string>;
+
+fs::path MakeTestRoot(const std::string& name) {
+  const char* test_tmpdir = std::getenv("TEST_TMPDIR");
+  return (test_tmpdir != nullptr ? fs::path(test_tmpdir)
+                                 : fs::temp_directory_path()) /
+         (name + "_" + std::to_string(getpid()));
+}
+
+// Installs (empty) packages with the given names in an ament `prefix`.
+void InstallPackages(const fs::path& prefix,
+                     const std::vector<std::string>& names) {
+  const fs::path index = prefix / "share/ament_index/resource_index/packages";
+  fs::create_directories(index);
+  for (const std::string& name : names) {
+    std::ofstream(index / name).close();
+    fs::create_directories(prefix / "share" / name);
+  }
+}
+
+std::string ReadFile(const fs::path& path) {
+  std::ifstream file(path);
+  return {std::istreambuf_iterator<char>(file),
+          std::istreambuf_iterator<char>()};
+}
+
+void WriteFile(const fs::path& path, const std::string& content) {
+  std::ofstream(path) << content;
+}
+
+std::vector<fs::path> ListDirectory(const fs::path& path) {
+  return {fs::directory_iterator(path), fs::directory_iterator()};
+}
+}  // namespace
+
+TEST(AmentPackageMap, NominalCase) {
+  const fs::path root = MakeTestRoot("test_ament_package_map");
+  const fs::path prefix = root / "install";
+  const fs::path index = prefix / "share/ament_index/resource_index/packages";
+  fs::create_directories(index);
+  for (const char* name : {"foo", "bar"}) {
+    std::ofstream(index / name).close();
+  }
+  fs::create_directories(prefix / "share/foo/meshes");
+  fs::create_directories(prefix / "share/bar");
+  fs::create_directories(root / "elsewhere");
+
+  // N.B. The ament index is crawled once per process, on first use.
+  setenv("AMENT_PREFIX_PATH", prefix.c_str(), 1);
+  setenv("XDG_CACHE_HOME", (root / "cache").c_str(), 1);
+
+  const std::map<std::string, std::string>& directories =
+      GetAmentPackageDirectories();
+  EXPECT_EQ(directories.size(), 2u);
+  ASSERT_EQ(directories.count("foo"), 1u);
+  EXPECT_EQ(directories.at("foo"), (prefix / "share/foo").string());
+  ASSERT_EQ(directories.count("bar"), 1u);
+  EXPECT_EQ(directories.at("bar"), (prefix / "share/bar").string());
+
+  // Crawl results are cached on disk.
+  ASSERT_TRUE(fs::is_directory(root / "cache/drake_ros"));
+  EXPECT_FALSE(fs::is_empty(root / "cache/drake_ros"));
+
+  EXPECT_EQ(
+      GetAmentPackageUri((prefix / "share/foo/meshes/box.obj").string()),
+      "package://foo/meshes/box.obj");
+  EXPECT_EQ(GetAmentPackageUri((prefix / "share/bar/../foo/box.obj").string()),
+            "package://foo/box.obj");
+  EXPECT_EQ(GetAmentPackageUri((root / "elsewhere/box.obj").string()),
+            std::nullopt);
+  EXPECT_EQ(GetAmentPackageUri("share/foo/box.obj"), std::nullopt);
+
+  // Packages already in the map are left as-is.
+  drake::multibody::PackageMap package_map =
+      drake::multibody::PackageMap::MakeEmpty();
+  package_map.Add("bar", root / "elsewhere");
+  PopulatePackageMapFromAmentIndex(&package_map);
+  ASSERT_TRUE(package_map.Contains("foo"));
+  EXPECT_EQ(fs::path(package_map.GetPath("foo")), prefix / "share/foo");
+  ASSERT_TRUE(package_map.Contains("bar"));
+  EXPECT_EQ(fs::path(package_map.GetPath("bar")), root / "elsewhere");
+
+  fs::remove_all(root);
+}
+
+TEST(AmentPackageMap, Precedence) {
+  const fs::path root = MakeTestRoot("test_ament_package_precedence");
+  InstallPackages(root / "overlay", {"foo"});
+  InstallPackages(root / "underlay", {"foo", "bar"});
+
+  // Earlier prefixes take precedence, and prefixes that are not ament
+  // prefixes are skipped.
+  const Directories expected{
+      {"foo", (root / "overlay/share/foo").string()},
+      {"bar", (root / "underlay/share/bar").string()}};
+  EXPECT_EQ(LoadAmentPackageDirectories(
+                {(root / "overlay").string(), (root / "missing").string(),
+                 (root / "underlay").string()},
+                std::nullopt),
+            expected);
+
+  fs::remove_all(root);
+}
+
+TEST(AmentPackageMap, Cache) {
+  const fs::path root = MakeTestRoot("test_ament_package_cache");
+  const fs::path prefix = root / "install";
+  InstallPackages(prefix, {"foo"});
+  const fs::path cache_directory = root / "cache";
+  const std::vector<std::string> prefixes{prefix.string()};
+  const Directories expected{{"foo", (prefix / "share/foo").string()}};
+
+  // The first load crawls the index and writes a cache file.
+  EXPECT_EQ(LoadAmentPackageDirectories(prefixes, cache_directory), expected);
+  std::vector<fs::path> cache_files = ListDirectory(cache_directory);
+  ASSERT_EQ(cache_files.size(), 1u);
+  const fs::path cache_file = cache_files[0];
+  const std::string content = ReadFile(cache_file);
+  const size_t end_of_key = content.find("\n\n");
+  ASSERT_NE(end_of_key, std::string::npos);
+  const std::string header = content.substr(0, end_of_key + 2);
+  EXPECT_EQ(content.substr(header.size()),
+            "foo\t" + (prefix / "share/foo").string() + "\n");
+
+  // Later loads use the cache file, without crawling the index.
+  WriteFile(cache_file, header + "bar\t/nowhere/bar\n");
+  EXPECT_EQ(LoadAmentPackageDirectories(prefixes, cache_directory),
+            (Directories{{"bar", "/nowhere/bar"}}));
+
+  // Malformed cache files are ignored and rewritten.
+  WriteFile(cache_file, header + "bar /nowhere/bar\n");
+  EXPECT_EQ(LoadAmentPackageDirectories(prefixes, cache_directory), expected);
+  EXPECT_EQ(ReadFile(cache_file), content);
+
+  WriteFile(cache_file, header.substr(0, header.size() / 2));
+  EXPECT_EQ(LoadAmentPackageDirectories(prefixes, cache_directory), expected);
+  EXPECT_EQ(ReadFile(cache_file), content);
+
+  WriteFile(cache_file, "");
+  EXPECT_EQ(LoadAmentPackageDirectories(prefixes, cache_directory), expected);
+  EXPECT_EQ(ReadFile(cache_file), content);
+
+  // (Un)installing packages invalidates the cache, even if a stale file
+  // is left behind.
+  WriteFile(cache_file, header + "bar\t/nowhere/bar\n");
+  const fs::path index = prefix / "share/ament_index/resource_index/packages";
+  fs::last_write_time(index,
+                      fs::last_write_time(index) + std::chrono::seconds(10));
+  EXPECT_EQ(LoadAmentPackageDirectories(prefixes, cache_directory), expected);
+  EXPECT_EQ(ListDirectory(cache_directory).size(), 2u);
+
+  InstallPackages(prefix, {"bar"});
+  fs::last_write_time(index,
+                      fs::last_write_time(index) + std::chrono::seconds(20));
+  EXPECT_EQ(LoadAmentPackageDirectories(prefixes, cache_directory),
+            (Directories{{"foo", (prefix / "share/foo").string()},
+                         {"bar", (prefix / "share/bar").string()}}));
+
+  // Without a cache directory, the index is crawled every time.
+  EXPECT_EQ(LoadAmentPackageDirectories(prefixes, std::nullopt).size(), 2u);
+
+  fs::remove_all(root);
+}
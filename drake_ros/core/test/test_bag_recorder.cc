@@ -0,0 +1,114 @@
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <drake/systems/analysis/simulator.h>
+#include <drake/systems/framework/diagram_builder.h>
+#include <gtest/gtest.h>
+#include <rclcpp/serialization.hpp>
+#include <rosbag2_cpp/reader.hpp>
+#include <test_msgs/msg/basic_types.hpp>
+
+#include "drake_ros/core/bag_recorder.h"
+#include "drake_ros/core/drake_ros.h"
+#include "drake_ros/core/ros_interface_system.h"
+#include "drake_ros/core/ros_publisher_system.h"
+
+using drake_ros::core::BagRecorder;
+using drake_ros::core::BagRecorderParams;
+using drake_ros::core::DrakeRos;
+using drake_ros::core::RosInterfaceSystem;
+using drake_ros::core::RosPublisherSystem;
+
+namespace {
+std::string MakeBagUri(const std::string& name) {
+  const char* test_tmpdir = std::getenv("TEST_TMPDIR");
+  const std::filesystem::path base_path =
+      test_tmpdir != nullptr ? std::filesystem::path(test_tmpdir)
+                             : std::filesystem::temp_directory_path();
+  const std::filesystem::path bag_path = base_path / name;
+  std::filesystem::remove_all(bag_path);
+  return bag_path.string();
+}
+}  // namespace
+
+TEST(BagRecorder, record_from_publisher) {
+  drake_ros::core::init(0, nullptr);
+
+  const std::string uri = MakeBagUri("test_bag_recorder");
+  {
+    auto recorder = std::make_shared<BagRecorder>(uri);
+
+    drake::systems::DiagramBuilder<double> builder;
+    auto ros_interface_system = builder.AddSystem<RosInterfaceSystem>(
+        std::make_unique<DrakeRos>("bag_recorder"));
+    auto publisher_system = builder.AddSystem(
+        RosPublisherSystem::Make<test_msgs::msg::BasicTypes>(
+            "recorded", rclcpp::QoS(10),
+            ros_interface_system->get_ros_interface(),
+            {drake::systems::TriggerType::kPeriodic}, 0.1));
+    publisher_system->AddMessageSink(recorder);
+    builder.ExportInput(publisher_system->get_input_port(), "message");
+    auto diagram = builder.Build();
+
+    drake::systems::Simulator<double> simulator(*diagram);
+    test_msgs::msg::BasicTypes message;
+    message.int32_value = 42;
+    diagram->get_input_port().FixValue(&simulator.get_mutable_context(),
+                                       message);
+    simulator.AdvanceTo(0.25);
+    recorder->Flush();
+    // The bag is closed once the recorder goes out of scope, along with the
+    // publisher system that shares it.
+  }
+
+  rosbag2_cpp::Reader reader;
+  reader.open(uri);
+  // Bags are written with the default storage plugin.
+  EXPECT_EQ(reader.get_metadata().storage_identifier,
+            BagRecorderParams{}.storage_id);
+  const std::vector<rosbag2_storage::TopicMetadata> topics =
+      reader.get_all_topics_and_types();
+  ASSERT_EQ(topics.size(), 1u);
+  EXPECT_EQ(topics[0].name, "/recorded");
+  EXPECT_EQ(topics[0].type, "test_msgs/msg/BasicTypes");
+
+  rclcpp::Serialization<test_msgs::msg::BasicTypes> protocol;
+  std::vector<int64_t> stamps;
+  while (reader.has_next()) {
+    auto bag_message = reader.read_next();
+    EXPECT_EQ(bag_message->topic_name, "/recorded");
+    stamps.push_back(bag_message->time_stamp);
+
+    rclcpp::SerializedMessage serialized_message(
+        *bag_message->serialized_data);
+    test_msgs::msg::BasicTypes recorded_message;
+    protocol.deserialize_message(&serialized_message, &recorded_message);
+    EXPECT_EQ(recorded_message.int32_value, 42);
+  }
+  // Messages are stamped with simulation time.
+  const std::vector<int64_t> expected_stamps{0, 100000000, 200000000};
+  EXPECT_EQ(stamps, expected_stamps);
+
+  drake_ros::core::shutdown();
+}
+
+// Only available in Bazel.
+#ifndef _TEST_DISABLE_RMW_ISOLATION
+#include "rmw_isolation/rmw_isolation.h"
+
+int main(int argc, char* argv[]) {
+  const char* TEST_TMPDIR = std::getenv("TEST_TMPDIR");
+  if (TEST_TMPDIR != nullptr) {
+    std::string ros_home = std::string(TEST_TMPDIR) + "/.ros";
+    setenv("ROS_HOME", ros_home.c_str(), 1);
+    ros2::isolate_rmw_by_path(argv[0], TEST_TMPDIR);
+  }
+
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
+#endif
@@ -0,0 +1,186 @@
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <drake/common/value.h>
+#include <gtest/gtest.h>
+#include <rclcpp/serialization.hpp>
+#include <rclcpp/serialized_message.hpp>
+#include <sensor_msgs/msg/image.hpp>
+#include <sensor_msgs/msg/joint_state.hpp>
+#include <sensor_msgs/msg/point_cloud2.hpp>
+#include <std_msgs/msg/float64_multi_array.hpp>
+#include <visualization_msgs/msg/marker_array.hpp>
+
+#include "drake_ros/core/cdr_codec.h"
+#include "drake_ros/core/cdr_message_codecs.h"
+#include "drake_ros/core/cdr_serializer.h"
+
+namespace drake_ros {
+namespace core {
+namespace {
+
+std::vector<uint8_t> GetBytes(const rclcpp::SerializedMessage& message) {
+  const rcl_serialized_message_t& rcl_message =
+      message.get_rcl_serialized_message();
+  return std::vector<uint8_t>(rcl_message.buffer,
+                              rcl_message.buffer + rcl_message.buffer_length);
+}
+
+// Checks that `message` is serialized by its CdrCodec exactly as it is by
+// rclcpp::Serialization, and that it is deserialized back from both.
+template <typename MessageT>
+void CheckAgainstDefault(const MessageT& message) {
+  static_assert(kHasCdrCodec<MessageT>);
+  rclcpp::Serialization<MessageT> protocol;
+  rclcpp::SerializedMessage expected_message;
+  protocol.serialize_message(&message, &expected_message);
+  std::vector<uint8_t> expected = GetBytes(expected_message);
+
+  rclcpp::SerializedMessage actual_message;
+  EncodeCdr(message, &actual_message);
+  const std::vector<uint8_t> actual = GetBytes(actual_message);
+
+  // Some middlewares pad serialized data to a multiple of 4 bytes, and
+  // flag it in the encapsulation options. Discard that padding.
+  ASSERT_GE(expected.size(), 4u);
+  ASSERT_GE(expected.size(), actual.size());
+  const size_t padding = expected[3] & 0x03;
+  ASSERT_EQ(expected.size() - padding, actual.size());
+  expected.resize(actual.size());
+  expected[3] &= ~0x03;
+  EXPECT_EQ(expected, actual);
+
+  MessageT decoded_message;
+  ASSERT_TRUE(DecodeCdr(expected_message, &decoded_message));
+  EXPECT_EQ(decoded_message, message);
+
+  decoded_message = MessageT();
+  protocol.deserialize_message(&actual_message, &decoded_message);
+  EXPECT_EQ(decoded_message, message);
+
+  // CDR serializers use codecs too.
+  const CdrSerializer<MessageT> serializer;
+  const drake::Value<MessageT> value(message);
+  EXPECT_EQ(GetBytes(serializer.Serialize(value)), actual);
+  std::unique_ptr<drake::AbstractValue> decoded_value =
+      serializer.CreateDefaultValue();
+  serializer.Deserialize(expected_message, decoded_value.get());
+  EXPECT_EQ(decoded_value->get_value<MessageT>(), message);
+}
+
+TEST(CdrCodec, JointState) {
+  sensor_msgs::msg::JointState message;
+  CheckAgainstDefault(message);
+
+  message.header.stamp.sec = 42;
+  message.header.stamp.nanosec = 7;
+  message.header.frame_id = "base";
+  message.name = {"shoulder", "elbow", "wrist"};
+  message.position = {0.1, -0.2, 0.3};
+  message.velocity = {1.0, 2.0, 3.0};
+  // Effort is left empty on purpose.
+  CheckAgainstDefault(message);
+}
+
+TEST(CdrCodec, Float64MultiArray) {
+  std_msgs::msg::Float64MultiArray message;
+  CheckAgainstDefault(message);
+
+  message.layout.dim.resize(2);
+  message.layout.dim[0].label = "rows";
+  message.layout.dim[0].size = 2;
+  message.layout.dim[0].stride = 6;
+  message.layout.dim[1].label = "columns";
+  message.layout.dim[1].size = 3;
+  message.layout.dim[1].stride = 3;
+  message.layout.data_offset = 1;
+  message.data = {0., 1., 2., 3., 4., 5., 6.};
+  CheckAgainstDefault(message);
+}
+
+TEST(CdrCodec, PointCloud2) {
+  sensor_msgs::msg::PointCloud2 message;
+  message.header.frame_id = "camera";
+  message.height = 1;
+  message.width = 3;
+  message.fields.resize(2);
+  message.fields[0].name = "x";
+  message.fields[0].offset = 0;
+  message.fields[0].datatype = sensor_msgs::msg::PointField::FLOAT32;
+  message.fields[0].count = 1;
+  message.fields[1].name = "rgb";
+  message.fields[1].offset = 4;
+  message.fields[1].datatype = sensor_msgs::msg::PointField::UINT8;
+  message.fields[1].count = 3;
+  message.is_bigendian = false;
+  message.point_step = 7;
+  message.row_step = 21;
+  for (int i = 0; i < 21; ++i) {
+    message.data.push_back(static_cast<uint8_t>(i * 11));
+  }
+  message.is_dense = true;
+  CheckAgainstDefault(message);
+}
+
+TEST(CdrCodec, Image) {
+  sensor_msgs::msg::Image message;
+  message.header.frame_id = "camera";
+  message.height = 3;
+  message.width = 5;
+  message.encoding = "mono8";
+  message.is_bigendian = 0;
+  message.step = 5;
+  message.data.assign(15, 0xAB);
+  CheckAgainstDefault(message);
+}
+
+TEST(CdrCodec, MarkerArray) {
+  visualization_msgs::msg::MarkerArray message;
+  CheckAgainstDefault(message);
+
+  visualization_msgs::msg::Marker marker;
+  marker.header.frame_id = "world";
+  marker.ns = "contacts";
+  marker.id = 3;
+  marker.type = visualization_msgs::msg::Marker::LINE_LIST;
+  marker.pose.position.x = 1.0;
+  marker.pose.orientation.w = 1.0;
+  marker.scale.x = 0.01;
+  marker.color.r = 1.0f;
+  marker.color.a = 0.5f;
+  marker.lifetime.sec = 1;
+  marker.frame_locked = true;
+  marker.points.resize(4);
+  for (size_t i = 0; i < marker.points.size(); ++i) {
+    marker.points[i].x = 0.1 * i;
+    marker.points[i].y = -0.2 * i;
+    marker.points[i].z = 0.3 * i;
+  }
+  marker.colors.resize(4, marker.color);
+  message.markers.push_back(marker);
+
+  marker.id = 4;
+  marker.type = visualization_msgs::msg::Marker::TEXT_VIEW_FACING;
+  marker.points.clear();
+  marker.colors.clear();
+  marker.text = "odd";
+  message.markers.push_back(marker);
+  CheckAgainstDefault(message);
+}
+
+TEST(CdrCodec, TruncatedData) {
+  sensor_msgs::msg::JointState message;
+  message.name = {"joint"};
+  message.position = {1.0};
+  rclcpp::SerializedMessage serialized_message;
+  EncodeCdr(message, &serialized_message);
+  serialized_message.get_rcl_serialized_message().buffer_length -= 1;
+  EXPECT_THROW(DecodeCdr(serialized_message, &message), std::runtime_error);
+}
+
+}  // namespace
+}  // namespace core
+}  // namespace drake_ros
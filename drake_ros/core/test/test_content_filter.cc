@@ -0,0 +1,67 @@
+#include <string>
+
+#include <geometry_msgs/msg/pose_stamped.hpp>
+#include <gtest/gtest.h>
+#include <rclcpp/serialization.hpp>
+#include <rclcpp/serialized_message.hpp>
+
+#include "drake_ros/core/content_filter.h"
+#include "drake_ros/core/serialized_header.h"
+
+using drake_ros::core::ContentFilter;
+using drake_ros::core::MakeHeaderFrameIdFilter;
+using drake_ros::core::PeekHeaderFrameId;
+using geometry_msgs::msg::PoseStamped;
+
+namespace {
+rclcpp::SerializedMessage MakeMessage(const std::string& frame_id) {
+  PoseStamped message;
+  message.header.frame_id = frame_id;
+  rclcpp::Serialization<PoseStamped> protocol;
+  rclcpp::SerializedMessage serialized_message;
+  protocol.serialize_message(&message, &serialized_message);
+  return serialized_message;
+}
+}  // namespace
+
+TEST(ContentFilter, peek_frame_id) {
+  const rclcpp::SerializedMessage message = MakeMessage("world");
+  auto frame_id = PeekHeaderFrameId(message);
+  ASSERT_TRUE(frame_id.has_value());
+  EXPECT_EQ(*frame_id, "world");
+
+  const rclcpp::SerializedMessage empty_message = MakeMessage("");
+  frame_id = PeekHeaderFrameId(empty_message);
+  ASSERT_TRUE(frame_id.has_value());
+  EXPECT_TRUE(frame_id->empty());
+
+  rclcpp::SerializedMessage short_message(4u);
+  short_message.get_rcl_serialized_message().buffer_length = 4u;
+  EXPECT_FALSE(PeekHeaderFrameId(short_message).has_value());
+}
+
+TEST(ContentFilter, header_frame_id_filter) {
+  const ContentFilter filter = MakeHeaderFrameIdFilter({"world"});
+  EXPECT_EQ(filter.expression, "header.frame_id = %0");
+  ASSERT_EQ(filter.expression_parameters.size(), 1u);
+  EXPECT_EQ(filter.expression_parameters[0], "'world'");
+
+  ASSERT_TRUE(filter.prefilter);
+  EXPECT_TRUE(filter.prefilter(MakeMessage("world")));
+  EXPECT_FALSE(filter.prefilter(MakeMessage("base_link")));
+  EXPECT_FALSE(filter.prefilter(MakeMessage("worl")));
+  rclcpp::SerializedMessage short_message(4u);
+  short_message.get_rcl_serialized_message().buffer_length = 4u;
+  EXPECT_FALSE(filter.prefilter(short_message));
+}
+
+TEST(ContentFilter, header_frame_id_filter_quoting) {
+  const ContentFilter filter = MakeHeaderFrameIdFilter({"robot's_base"});
+  // DDS string literals have no escape sequences for single quotes.
+  EXPECT_TRUE(filter.expression.empty());
+  EXPECT_TRUE(filter.expression_parameters.empty());
+  // Prefilters match frame IDs as-is.
+  ASSERT_TRUE(filter.prefilter);
+  EXPECT_TRUE(filter.prefilter(MakeMessage("robot's_base")));
+  EXPECT_FALSE(filter.prefilter(MakeMessage("robot''s_base")));
+}
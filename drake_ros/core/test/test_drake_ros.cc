@@ -1,5 +1,7 @@
+#include <chrono>
 #include <cstdlib>
 #include <memory>
+#include <stdexcept>
 #include <utility>
 #include <vector>
 
@@ -28,6 +30,33 @@ TEST(DrakeRos, local_context) {
   context->shutdown("done");
 }
 
+TEST(DrakeRos, external_node) {
+  drake_ros::core::init();
+  auto node = std::make_shared<rclcpp::Node>("external_node");
+  EXPECT_THROW(DrakeRos(rclcpp::Node::SharedPtr{}), std::invalid_argument);
+
+  // Without an executor, the node is assumed to be spun elsewhere.
+  {
+    DrakeRos drake_ros(node);
+    EXPECT_EQ(&drake_ros.get_node(), node.get());
+    EXPECT_NO_THROW(drake_ros.Spin());
+  }
+
+  // With an executor, it is spun by Spin().
+  auto executor = std::make_shared<rclcpp::executors::SingleThreadedExecutor>();
+  executor->add_node(node);
+  DrakeRos drake_ros(node, executor);
+  bool fired = false;
+  auto timer = node->create_wall_timer(std::chrono::milliseconds(1),
+                                       [&fired]() { fired = true; });
+  constexpr int kMaxAttempts = 100;
+  for (int attempt = 0; attempt < kMaxAttempts && !fired; ++attempt) {
+    drake_ros.Spin(10);
+  }
+  EXPECT_TRUE(fired);
+  EXPECT_TRUE(drake_ros::core::shutdown());
+}
+
 TEST(DrakeRos, environment) {
   // The unit testing environment should always be shimmed to have proper
   // environment variables. Check that at least this one test case is shimmed.
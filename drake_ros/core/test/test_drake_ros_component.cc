@@ -0,0 +1,98 @@
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include <drake/systems/framework/diagram_builder.h>
+#include <gtest/gtest.h>
+#include <rclcpp/rclcpp.hpp>
+#include <test_msgs/msg/basic_types.hpp>
+
+#include "drake_ros/core/drake_ros.h"
+#include "drake_ros/core/drake_ros_component.h"
+#include "drake_ros/core/ros_publisher_system.h"
+
+using drake_ros::core::DrakeRos;
+using drake_ros::core::DrakeRosComponent;
+using drake_ros::core::DrakeRosComponentParams;
+using drake_ros::core::RosPublisherSystem;
+
+namespace {
+// A component, as it would be registered with rclcpp_components.
+class PublisherComponent : public DrakeRosComponent {
+ public:
+  explicit PublisherComponent(const rclcpp::NodeOptions& options)
+      : DrakeRosComponent(
+            "publisher_component", options,
+            [](drake::systems::DiagramBuilder<double>* builder, DrakeRos* ros) {
+              builder->AddSystem(
+                  RosPublisherSystem::Make<test_msgs::msg::BasicTypes>(
+                      "out", rclcpp::QoS(10).reliable(), ros,
+                      {drake::systems::TriggerType::kPerStep}));
+            }) {}
+};
+}  // namespace
+
+TEST(DrakeRosComponent, colocated) {
+  drake_ros::core::init(0, nullptr);
+
+  // Load the component and a co-located node into the same executor,
+  // as a component container would.
+  rclcpp::NodeOptions options;
+  PublisherComponent component(options);
+  auto colocated_node = rclcpp::Node::make_shared("colocated", options);
+  int num_received = 0;
+  auto sub = colocated_node->create_subscription<test_msgs::msg::BasicTypes>(
+      "out", rclcpp::QoS(10).reliable(),
+      [&num_received](const test_msgs::msg::BasicTypes&) { ++num_received; });
+
+  rclcpp::executors::SingleThreadedExecutor executor;
+  executor.add_node(component.get_node_base_interface());
+  executor.add_node(colocated_node);
+
+  // Simulation advances and publishes as the executor spins.
+  constexpr int kMaxAttempts = 200;
+  for (int attempt = 0; attempt < kMaxAttempts && num_received < 3;
+       ++attempt) {
+    executor.spin_some(std::chrono::milliseconds(10));
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  EXPECT_GE(num_received, 3);
+  EXPECT_GT(component.get_simulator().get_context().get_time(), 0.0);
+  EXPECT_EQ(component.get_ros_interface()->get_node().get_name(),
+            std::string("publisher_component"));
+
+  drake_ros::core::shutdown();
+}
+
+TEST(DrakeRosComponent, invalid_time_step) {
+  drake_ros::core::init(0, nullptr);
+
+  DrakeRosComponentParams params;
+  params.time_step = 0.0;
+  EXPECT_THROW(DrakeRosComponent("invalid_component", rclcpp::NodeOptions(),
+                                 [](drake::systems::DiagramBuilder<double>*,
+                                    DrakeRos*) {},
+                                 params),
+               std::invalid_argument);
+
+  drake_ros::core::shutdown();
+}
+
+// Only available in Bazel.
+#ifndef _TEST_DISABLE_RMW_ISOLATION
+#include "rmw_isolation/rmw_isolation.h"
+
+int main(int argc, char* argv[]) {
+  const char* TEST_TMPDIR = std::getenv("TEST_TMPDIR");
+  if (TEST_TMPDIR != nullptr) {
+    std::string ros_home = std::string(TEST_TMPDIR) + "/.ros";
+    setenv("ROS_HOME", ros_home.c_str(), 1);
+    ros2::isolate_rmw_by_path(argv[0], TEST_TMPDIR);
+  }
+
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
+#endif
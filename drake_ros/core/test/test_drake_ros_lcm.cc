@@ -0,0 +1,116 @@
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <rclcpp/rclcpp.hpp>
+#include <std_msgs/msg/u_int8_multi_array.hpp>
+
+#include "drake_ros/core/drake_ros.h"
+#include "drake_ros/core/drake_ros_lcm.h"
+
+using drake_ros::core::DrakeRos;
+using drake_ros::core::DrakeRosLcm;
+using drake_ros::core::DrakeRosLcmParams;
+
+TEST(DrakeRosLcm, topic_names) {
+  drake_ros::core::init(0, nullptr);
+  DrakeRos ros("drake_ros_lcm_topic_names");
+  DrakeRosLcm lcm(&ros);
+  EXPECT_EQ(lcm.GetTopicName("DRAKE_VIEWER_DRAW"), "lcm/DRAKE_VIEWER_DRAW");
+  EXPECT_EQ(lcm.GetTopicName("robot.state-1"), "lcm/robot_state_1");
+  EXPECT_EQ(lcm.GetTopicName("0"), "lcm/_0");
+  drake_ros::core::shutdown();
+}
+
+TEST(DrakeRosLcm, publish_and_subscribe) {
+  drake_ros::core::init(0, nullptr);
+  DrakeRos ros("drake_ros_lcm");
+  DrakeRosLcmParams params;
+  params.discovery_period = 0.0;
+  DrakeRosLcm lcm(&ros, params);
+
+  std::vector<uint8_t> received;
+  auto subscription =
+      lcm.Subscribe("FOO", [&received](const void* data, int size) {
+        const auto* bytes = static_cast<const uint8_t*>(data);
+        received.assign(bytes, bytes + size);
+      });
+  std::vector<std::string> received_channels;
+  lcm.SubscribeAllChannels(
+      [&received_channels](std::string_view channel, const void*, int) {
+        received_channels.emplace_back(channel);
+      });
+
+  // Plain ROS subscribers see a 1-D layout labeled after the channel.
+  std_msgs::msg::UInt8MultiArray::SharedPtr ros_message;
+  auto ros_subscription =
+      ros.get_mutable_node()->create_subscription<
+          std_msgs::msg::UInt8MultiArray>(
+          lcm.GetTopicName("BAR.BAZ"), DrakeRosLcmParams{}.qos,
+          [&ros_message](std_msgs::msg::UInt8MultiArray::SharedPtr message) {
+            ros_message = message;
+          });
+
+  const auto has_received = [&received_channels](const std::string& channel) {
+    return std::find(received_channels.begin(), received_channels.end(),
+                     channel) != received_channels.end();
+  };
+
+  // Keep publishing until subscriptions are matched.
+  const std::vector<uint8_t> payload{1, 2, 3, 4};
+  constexpr int kMaxAttempts = 200;
+  for (int attempt = 0;
+       attempt < kMaxAttempts &&
+       (received.empty() || !has_received("FOO") ||
+        !has_received("BAR.BAZ") || !ros_message);
+       ++attempt) {
+    lcm.Publish("FOO", payload.data(), payload.size(), std::nullopt);
+    lcm.Publish("BAR.BAZ", payload.data(), payload.size(), std::nullopt);
+    lcm.HandleSubscriptions(10);
+  }
+  EXPECT_EQ(received, payload);
+  // Channel names survive topic name sanitization.
+  EXPECT_TRUE(has_received("FOO"));
+  EXPECT_TRUE(has_received("BAR.BAZ"));
+
+  ASSERT_NE(ros_message, nullptr);
+  EXPECT_EQ(ros_message->data, payload);
+  EXPECT_EQ(ros_message->layout.data_offset, 0u);
+  ASSERT_EQ(ros_message->layout.dim.size(), 1u);
+  EXPECT_EQ(ros_message->layout.dim[0].label, "BAR.BAZ");
+  EXPECT_EQ(ros_message->layout.dim[0].size, payload.size());
+  EXPECT_EQ(ros_message->layout.dim[0].stride, payload.size());
+
+  // Unsubscribe on deletion.
+  subscription->set_unsubscribe_on_delete(true);
+  subscription.reset();
+  received.clear();
+  for (int attempt = 0; attempt < 10; ++attempt) {
+    lcm.Publish("FOO", payload.data(), payload.size(), std::nullopt);
+    lcm.HandleSubscriptions(10);
+  }
+  EXPECT_TRUE(received.empty());
+
+  drake_ros::core::shutdown();
+}
+
+// Only available in Bazel.
+#ifndef _TEST_DISABLE_RMW_ISOLATION
+#include "rmw_isolation/rmw_isolation.h"
+
+int main(int argc, char* argv[]) {
+  const char* TEST_TMPDIR = std::getenv("TEST_TMPDIR");
+  if (TEST_TMPDIR != nullptr) {
+    std::string ros_home = std::string(TEST_TMPDIR) + "/.ros";
+    setenv("ROS_HOME", ros_home.c_str(), 1);
+    ros2::isolate_rmw_by_path(argv[0], TEST_TMPDIR);
+  }
+
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
+#endif
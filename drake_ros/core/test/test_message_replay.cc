@@ -0,0 +1,244 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <drake/systems/analysis/simulator.h>
+#include <drake/systems/framework/diagram_builder.h>
+#include <drake/systems/framework/leaf_system.h>
+#include <gtest/gtest.h>
+#include <rclcpp/rclcpp.hpp>
+#include <test_msgs/msg/basic_types.hpp>
+
+#include "drake_ros/core/drake_ros.h"
+#include "drake_ros/core/inbound_message_log.h"
+#include "drake_ros/core/ros_interface_system.h"
+#include "drake_ros/core/ros_publisher_system.h"
+#include "drake_ros/core/ros_subscriber_system.h"
+
+using drake_ros::core::DrakeRos;
+using drake_ros::core::InboundMessageLog;
+using drake_ros::core::RosInterfaceSystem;
+using drake_ros::core::RosPublisherSystem;
+using drake_ros::core::RosSubscriberSystem;
+using test_msgs::msg::BasicTypes;
+
+namespace {
+constexpr int kNumSteps = 100;
+constexpr double kTimeStep = 0.01;
+
+// Advances the simulation step by step, calling `on_step` before each step,
+// and returns the value observed on `output_port` after each step.
+template <typename StepFunction>
+std::vector<uint64_t> Simulate(
+    const drake::systems::Diagram<double>& diagram,
+    const drake::systems::OutputPort<double>& output_port,
+    StepFunction on_step) {
+  drake::systems::Simulator<double> simulator(diagram);
+  const auto& port_context =
+      output_port.get_system().GetMyContextFromRoot(simulator.get_context());
+  std::vector<uint64_t> values;
+  for (int i = 1; i <= kNumSteps; ++i) {
+    on_step(i);
+    simulator.AdvanceTo(i * kTimeStep);
+    values.push_back(output_port.Eval<BasicTypes>(port_context).uint64_value);
+  }
+  return values;
+}
+
+// A discrete controller that accumulates the values it receives, once per
+// time step, so that its output depends on the step each message is seen.
+class Accumulator final : public drake::systems::LeafSystem<double> {
+ public:
+  Accumulator() {
+    DeclareAbstractInputPort("in", drake::Value<BasicTypes>());
+    const drake::systems::DiscreteStateIndex state_index =
+        DeclareDiscreteState(1);
+    DeclarePeriodicDiscreteUpdateEvent(kTimeStep, 0.0, &Accumulator::Update);
+    DeclareAbstractOutputPort("out", &Accumulator::CalcOutput,
+                              {discrete_state_ticket(state_index)});
+  }
+
+ private:
+  drake::systems::EventStatus Update(
+      const drake::systems::Context<double>& context,
+      drake::systems::DiscreteValues<double>* state) const {
+    const BasicTypes& message = get_input_port().Eval<BasicTypes>(context);
+    (*state)[0] = context.get_discrete_state_vector()[0] +
+                  static_cast<double>(message.uint64_value);
+    return drake::systems::EventStatus::Succeeded();
+  }
+
+  void CalcOutput(const drake::systems::Context<double>& context,
+                  BasicTypes* output) const {
+    output->uint64_value =
+        static_cast<uint64_t>(context.get_discrete_state_vector()[0]);
+  }
+};
+
+// Publishes a message every 10 steps, giving it some time to arrive.
+void PublishEveryTenSteps(rclcpp::Publisher<BasicTypes>* publisher, int step) {
+  if (step % 10 == 0) {
+    BasicTypes message;
+    message.uint64_value = step;
+    publisher->publish(message);
+    // Give the message some time to arrive, but not too much.
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+}
+
+// Waits for `publisher` to discover a subscription.
+bool WaitForDiscovery(const rclcpp::Publisher<BasicTypes>& publisher) {
+  for (int i = 0; i < 500 && publisher.get_subscription_count() == 0; ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  return publisher.get_subscription_count() > 0;
+}
+}  // namespace
+
+TEST(MessageReplay, capture_and_replay) {
+  drake_ros::core::init(0, nullptr);
+
+  const char* test_tmpdir = std::getenv("TEST_TMPDIR");
+  const std::filesystem::path log_path =
+      (test_tmpdir != nullptr ? std::filesystem::path(test_tmpdir)
+                              : std::filesystem::temp_directory_path()) /
+      "test_message_replay.log";
+
+  auto capture_log = std::make_shared<InboundMessageLog>();
+  std::vector<uint64_t> captured_values;
+  {
+    drake::systems::DiagramBuilder<double> builder;
+    auto ros_interface_system = builder.AddSystem<RosInterfaceSystem>(
+        std::make_unique<DrakeRos>("capture_node"));
+    auto subscriber_system =
+        builder.AddSystem(RosSubscriberSystem::Make<BasicTypes>(
+            "inbound", rclcpp::QoS(10).reliable(),
+            ros_interface_system->get_ros_interface()));
+    subscriber_system->SetCaptureLog(capture_log);
+    auto diagram = builder.Build();
+
+    auto publisher_node = rclcpp::Node::make_shared("publisher_node");
+    auto publisher = publisher_node->create_publisher<BasicTypes>(
+        "inbound", rclcpp::QoS(10).reliable());
+    ASSERT_TRUE(WaitForDiscovery(*publisher));
+
+    captured_values =
+        Simulate(*diagram, subscriber_system->get_output_port(),
+                 [&](int step) {
+                   PublishEveryTenSteps(publisher.get(), step);
+                 });
+  }
+  ASSERT_GT(capture_log->size(), 0u);
+
+  capture_log->Save(log_path.string());
+  std::shared_ptr<const InboundMessageLog> replay_log =
+      InboundMessageLog::Load(log_path.string());
+  ASSERT_EQ(replay_log->size(), capture_log->size());
+  const std::vector<InboundMessageLog::Entry> captured_entries =
+      capture_log->entries();
+  const std::vector<InboundMessageLog::Entry> loaded_entries =
+      replay_log->entries();
+  for (size_t i = 0; i < captured_entries.size(); ++i) {
+    EXPECT_EQ(loaded_entries[i].time, captured_entries[i].time);
+  }
+
+  // Replay twice, without ROS, and check for identical outcomes.
+  for (int run = 0; run < 2; ++run) {
+    drake::systems::DiagramBuilder<double> builder;
+    auto subscriber_system = builder.AddSystem(
+        RosSubscriberSystem::Make<BasicTypes>(replay_log));
+    auto diagram = builder.Build();
+
+    const std::vector<uint64_t> replayed_values = Simulate(
+        *diagram, subscriber_system->get_output_port(), [](int) {});
+    EXPECT_EQ(replayed_values, captured_values);
+  }
+
+  drake_ros::core::shutdown();
+}
+
+TEST(MessageReplay, capture_and_replay_in_closed_loop) {
+  drake_ros::core::init(0, nullptr);
+
+  // Builds a subscriber -> discrete controller -> publisher loop, and
+  // returns the controller.
+  auto build_loop = [](drake::systems::DiagramBuilder<double>* builder,
+                       std::unique_ptr<RosSubscriberSystem> subscriber,
+                       DrakeRos* ros) {
+    auto subscriber_system = builder->AddSystem(std::move(subscriber));
+    auto controller = builder->AddSystem<Accumulator>();
+    auto publisher_system =
+        builder->AddSystem(RosPublisherSystem::Make<BasicTypes>(
+            "outbound", rclcpp::QoS(10).reliable(), ros,
+            {drake::systems::TriggerType::kPeriodic}, kTimeStep));
+    builder->Connect(subscriber_system->get_output_port(),
+                     controller->get_input_port());
+    builder->Connect(controller->get_output_port(),
+                     publisher_system->get_input_port());
+    return controller;
+  };
+
+  auto capture_log = std::make_shared<InboundMessageLog>();
+  std::vector<uint64_t> captured_values;
+  {
+    drake::systems::DiagramBuilder<double> builder;
+    auto ros_interface_system = builder.AddSystem<RosInterfaceSystem>(
+        std::make_unique<DrakeRos>("closed_loop_capture_node"));
+    DrakeRos* ros = ros_interface_system->get_ros_interface();
+    auto subscriber = RosSubscriberSystem::Make<BasicTypes>(
+        "closed_loop_inbound", rclcpp::QoS(10).reliable(), ros);
+    subscriber->SetCaptureLog(capture_log);
+    auto controller = build_loop(&builder, std::move(subscriber), ros);
+    auto diagram = builder.Build();
+
+    auto publisher_node = rclcpp::Node::make_shared("closed_loop_publisher");
+    auto publisher = publisher_node->create_publisher<BasicTypes>(
+        "closed_loop_inbound", rclcpp::QoS(10).reliable());
+    ASSERT_TRUE(WaitForDiscovery(*publisher));
+
+    captured_values =
+        Simulate(*diagram, controller->get_output_port(),
+                 [&](int step) {
+                   PublishEveryTenSteps(publisher.get(), step);
+                 });
+  }
+  ASSERT_GT(capture_log->size(), 0u);
+
+  // Controller outputs are identical in replay, step by step.
+  std::shared_ptr<const InboundMessageLog> replay_log = capture_log;
+  drake::systems::DiagramBuilder<double> builder;
+  auto ros_interface_system = builder.AddSystem<RosInterfaceSystem>(
+      std::make_unique<DrakeRos>("closed_loop_replay_node"));
+  auto controller =
+      build_loop(&builder, RosSubscriberSystem::Make<BasicTypes>(replay_log),
+                 ros_interface_system->get_ros_interface());
+  auto diagram = builder.Build();
+  const std::vector<uint64_t> replayed_values =
+      Simulate(*diagram, controller->get_output_port(), [](int) {});
+  EXPECT_EQ(replayed_values, captured_values);
+
+  drake_ros::core::shutdown();
+}
+
+// Only available in Bazel.
+#ifndef _TEST_DISABLE_RMW_ISOLATION
+#include "rmw_isolation/rmw_isolation.h"
+
+int main(int argc, char* argv[]) {
+  const char* TEST_TMPDIR = std::getenv("TEST_TMPDIR");
+  if (TEST_TMPDIR != nullptr) {
+    std::string ros_home = std::string(TEST_TMPDIR) + "/.ros";
+    setenv("ROS_HOME", ros_home.c_str(), 1);
+    ros2::isolate_rmw_by_path(argv[0], TEST_TMPDIR);
+  }
+
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
+#endif
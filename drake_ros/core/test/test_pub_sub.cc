@@ -1,22 +1,90 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
 #include <drake/systems/analysis/simulator.h>
 #include <drake/systems/framework/diagram_builder.h>
+#include <geometry_msgs/msg/pose_stamped.hpp>
 #include <gtest/gtest.h>
 #include <rclcpp/rclcpp.hpp>
+#include <rclcpp/serialization.hpp>
 #include <test_msgs/msg/basic_types.hpp>
 
+#include "drake_ros/core/content_filter.h"
 #include "drake_ros/core/drake_ros.h"
+#include "drake_ros/core/message_sink_interface.h"
 #include "drake_ros/core/ros_interface_system.h"
 #include "drake_ros/core/ros_publisher_system.h"
 #include "drake_ros/core/ros_subscriber_system.h"
 
+using drake_ros::core::CallbackPriority;
 using drake_ros::core::DrakeRos;
+using drake_ros::core::MakeHeaderFrameIdFilter;
+using drake_ros::core::MessageSinkInterface;
+using drake_ros::core::QosEventStatus;
 using drake_ros::core::RosInterfaceSystem;
+using drake_ros::core::RosPublisherParams;
 using drake_ros::core::RosPublisherSystem;
+using drake_ros::core::RosSubscriberParams;
 using drake_ros::core::RosSubscriberSystem;
+using drake_ros::core::Serializer;
+
+namespace {
+// A serializer that counts deserializations.
+class CountingSerializer final
+    : public Serializer<test_msgs::msg::BasicTypes> {
+ public:
+  void Deserialize(const rclcpp::SerializedMessage& serialized_message,
+                   drake::AbstractValue* abstract_value) const override {
+    ++num_deserializations_;
+    Serializer<test_msgs::msg::BasicTypes>::Deserialize(serialized_message,
+                                                        abstract_value);
+  }
+
+  int num_deserializations() const { return num_deserializations_.load(); }
+
+ private:
+  mutable std::atomic<int> num_deserializations_{0};
+};
+
+// A message sink that records the messages written to it, optionally
+// holding on to them.
+class RecordingSink final : public MessageSinkInterface {
+ public:
+  explicit RecordingSink(bool hold) : hold_(hold) {}
+
+  void Write(const std::string& topic_name, const std::string& type_name,
+             std::shared_ptr<const rclcpp::SerializedMessage> message,
+             const rclcpp::Time&) override {
+    topic_names.push_back(topic_name);
+    type_names.push_back(type_name);
+    addresses.push_back(message.get());
+    test_msgs::msg::BasicTypes value;
+    rclcpp::Serialization<test_msgs::msg::BasicTypes>().deserialize_message(
+        message.get(), &value);
+    values.push_back(value);
+    if (hold_) {
+      held.push_back(std::move(message));
+    }
+  }
+
+  std::vector<std::string> topic_names;
+  std::vector<std::string> type_names;
+  std::vector<const rclcpp::SerializedMessage*> addresses;
+  std::vector<test_msgs::msg::BasicTypes> values;
+  std::vector<std::shared_ptr<const rclcpp::SerializedMessage>> held;
+
+ private:
+  bool hold_;
+};
+}  // namespace
 
 TEST(Integration, sub_to_pub) {
   drake_ros::core::init(0, nullptr);
@@ -93,6 +161,633 @@ TEST(Integration, sub_to_pub) {
   drake_ros::core::shutdown();
 }
 
+TEST(Integration, multiple_contexts) {
+  drake_ros::core::init(0, nullptr);
+
+  drake::systems::DiagramBuilder<double> builder;
+
+  const auto qos = rclcpp::QoS{rclcpp::KeepLast(10)}.reliable();
+
+  auto system_ros = builder.AddSystem<RosInterfaceSystem>(
+      std::make_unique<DrakeRos>("multiple_contexts"));
+  auto system_sub_in =
+      builder.AddSystem(RosSubscriberSystem::Make<test_msgs::msg::BasicTypes>(
+          "in", qos, system_ros->get_ros_interface()));
+
+  auto diagram = builder.Build();
+
+  // Simulate the same diagram twice, each with its own context.
+  constexpr size_t kNumSimulators = 2;
+  std::vector<std::unique_ptr<drake::systems::Simulator<double>>> simulators;
+  for (size_t i = 0; i < kNumSimulators; ++i) {
+    simulators.push_back(
+        std::make_unique<drake::systems::Simulator<double>>(*diagram));
+    simulators.back()->Initialize();
+  }
+
+  auto direct_ros_node = rclcpp::Node::make_shared("multiple_contexts_pub");
+  auto direct_pub_in =
+      direct_ros_node->create_publisher<test_msgs::msg::BasicTypes>("in", qos);
+
+  auto message = std::make_unique<test_msgs::msg::BasicTypes>();
+  message->uint64_value = 42u;
+  direct_pub_in->publish(std::move(message));
+
+  // Every context must observe the message, regardless of which simulator
+  // happened to spin the node when the message arrived.
+  constexpr double kTimeStep = 0.1;
+  constexpr size_t kMaxAttempts = 50;
+  for (auto& simulator : simulators) {
+    const auto& sub_context =
+        system_sub_in->GetMyContextFromRoot(simulator->get_context());
+    for (size_t attempt = 0; attempt < kMaxAttempts; ++attempt) {
+      if (system_sub_in->get_output_port(0)
+              .Eval<test_msgs::msg::BasicTypes>(sub_context)
+              .uint64_value == 42u) {
+        break;
+      }
+      rclcpp::spin_some(direct_ros_node);
+      simulator->AdvanceTo(simulator->get_context().get_time() + kTimeStep);
+    }
+    EXPECT_EQ(system_sub_in->get_output_port(0)
+                  .Eval<test_msgs::msg::BasicTypes>(sub_context)
+                  .uint64_value,
+              42u);
+  }
+
+  drake_ros::core::shutdown();
+}
+
+TEST(Integration, shared_entities) {
+  drake_ros::core::init(0, nullptr);
+
+  drake::systems::DiagramBuilder<double> builder;
+
+  const auto qos = rclcpp::QoS{rclcpp::KeepLast(10)}.reliable();
+
+  auto system_ros = builder.AddSystem<RosInterfaceSystem>(
+      std::make_unique<DrakeRos>("shared_entities"));
+  // Systems using the same topic, type, and QoS share middleware entities.
+  constexpr size_t kNumSystems = 3;
+  std::vector<RosSubscriberSystem*> systems_sub_in;
+  for (size_t i = 0; i < kNumSystems; ++i) {
+    systems_sub_in.push_back(
+        builder.AddSystem(RosSubscriberSystem::Make<test_msgs::msg::BasicTypes>(
+            "in", qos, system_ros->get_ros_interface())));
+    builder.AddSystem(RosPublisherSystem::Make<test_msgs::msg::BasicTypes>(
+        "out", qos, system_ros->get_ros_interface()));
+  }
+
+  auto diagram = builder.Build();
+  drake::systems::Simulator<double> simulator(*diagram);
+  simulator.Initialize();
+
+  auto direct_ros_node = rclcpp::Node::make_shared("shared_entities_direct");
+  auto direct_pub_in =
+      direct_ros_node->create_publisher<test_msgs::msg::BasicTypes>("in", qos);
+  auto direct_sub_out =
+      direct_ros_node->create_subscription<test_msgs::msg::BasicTypes>(
+          "out", qos, [](const test_msgs::msg::BasicTypes&) {});
+
+  // Wait for discovery, and then some more for stragglers.
+  constexpr size_t kMaxAttempts = 50;
+  auto discovered = [&]() {
+    return direct_pub_in->get_subscription_count() > 0 &&
+           direct_sub_out->get_publisher_count() > 0;
+  };
+  for (size_t attempt = 0; attempt < kMaxAttempts && !discovered();
+       ++attempt) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  EXPECT_EQ(direct_pub_in->get_subscription_count(), 1u);
+  EXPECT_EQ(direct_sub_out->get_publisher_count(), 1u);
+
+  // Messages taken once are fanned out to every subscriber system.
+  test_msgs::msg::BasicTypes message;
+  message.uint64_value = 42u;
+  direct_pub_in->publish(message);
+
+  constexpr double kTimeStep = 0.1;
+  auto all_received = [&]() {
+    for (const RosSubscriberSystem* system_sub_in : systems_sub_in) {
+      const auto& sub_context =
+          system_sub_in->GetMyContextFromRoot(simulator.get_context());
+      if (system_sub_in->get_output_port(0)
+              .Eval<test_msgs::msg::BasicTypes>(sub_context)
+              .uint64_value != 42u) {
+        return false;
+      }
+    }
+    return true;
+  };
+  for (size_t attempt = 0; attempt < kMaxAttempts && !all_received();
+       ++attempt) {
+    simulator.AdvanceTo(simulator.get_context().get_time() + kTimeStep);
+  }
+  EXPECT_TRUE(all_received());
+
+  drake_ros::core::shutdown();
+}
+
+TEST(Integration, serialized_relay) {
+  drake_ros::core::init(0, nullptr);
+
+  drake::systems::DiagramBuilder<double> builder;
+
+  const auto qos = rclcpp::QoS{rclcpp::KeepLast(10)}.reliable();
+
+  auto system_ros = builder.AddSystem<RosInterfaceSystem>(
+      std::make_unique<DrakeRos>("serialized_relay"));
+  auto system_sub_in = builder.AddSystem(
+      RosSubscriberSystem::MakeSerialized<test_msgs::msg::BasicTypes>(
+          "in", qos, system_ros->get_ros_interface()));
+  auto system_pub_out = builder.AddSystem(
+      RosPublisherSystem::MakeSerialized<test_msgs::msg::BasicTypes>(
+          "out", qos, system_ros->get_ros_interface(),
+          {drake::systems::TriggerType::kPerStep}));
+  builder.Connect(system_sub_in->get_output_port(0),
+                  system_pub_out->get_input_port(0));
+
+  auto diagram = builder.Build();
+  drake::systems::Simulator<double> simulator(*diagram);
+
+  auto direct_ros_node = rclcpp::Node::make_shared("serialized_relay_direct");
+  auto direct_pub_in =
+      direct_ros_node->create_publisher<test_msgs::msg::BasicTypes>("in", qos);
+  std::vector<test_msgs::msg::BasicTypes> rx_msgs_direct_sub_out;
+  auto direct_sub_out =
+      direct_ros_node->create_subscription<test_msgs::msg::BasicTypes>(
+          "out", qos, [&](const test_msgs::msg::BasicTypes& message) {
+            rx_msgs_direct_sub_out.push_back(message);
+          });
+
+  // Nothing is relayed until a message is received.
+  constexpr double kTimeStep = 0.1;
+  simulator.AdvanceTo(kTimeStep);
+  rclcpp::spin_some(direct_ros_node);
+  EXPECT_TRUE(rx_msgs_direct_sub_out.empty());
+
+  test_msgs::msg::BasicTypes message;
+  message.int64_value = 1234;
+  message.float64_value = 0.5;
+  direct_pub_in->publish(message);
+
+  constexpr size_t kMaxAttempts = 50;
+  for (size_t attempt = 0;
+       attempt < kMaxAttempts && rx_msgs_direct_sub_out.empty(); ++attempt) {
+    simulator.AdvanceTo(simulator.get_context().get_time() + kTimeStep);
+    rclcpp::spin_some(direct_ros_node);
+  }
+  ASSERT_FALSE(rx_msgs_direct_sub_out.empty());
+  EXPECT_EQ(rx_msgs_direct_sub_out.back(), message);
+
+  drake_ros::core::shutdown();
+}
+
+TEST(Integration, lazy_deserialization) {
+  drake_ros::core::init(0, nullptr);
+
+  drake::systems::DiagramBuilder<double> builder;
+
+  const auto qos = rclcpp::QoS{rclcpp::KeepLast(10)}.reliable();
+
+  auto system_ros = builder.AddSystem<RosInterfaceSystem>(
+      std::make_unique<DrakeRos>("lazy_deserialization"));
+  auto serializer = std::make_shared<CountingSerializer>();
+  RosSubscriberParams params;
+  params.lazy_deserialization = true;
+  auto system_sub_in = builder.AddSystem<RosSubscriberSystem>(
+      serializer, "in", qos, system_ros->get_ros_interface(), params);
+
+  auto diagram = builder.Build();
+  drake::systems::Simulator<double> simulator(*diagram);
+  const auto& sub_context =
+      system_sub_in->GetMyContextFromRoot(simulator.get_context());
+
+  // Outputs a default message until a message is received.
+  EXPECT_EQ(system_sub_in->get_output_port(0)
+                .Eval<test_msgs::msg::BasicTypes>(sub_context)
+                .uint64_value,
+            0u);
+
+  auto direct_ros_node = rclcpp::Node::make_shared("lazy_deserialization_pub");
+  auto direct_pub_in =
+      direct_ros_node->create_publisher<test_msgs::msg::BasicTypes>("in", qos);
+  for (uint64_t value = 1; value <= 3; ++value) {
+    test_msgs::msg::BasicTypes message;
+    message.uint64_value = value;
+    direct_pub_in->publish(message);
+  }
+
+  // Simulate until the last message is applied, without evaluating outputs.
+  // Peek into state to tell, deserializing behind the system's back.
+  rclcpp::Serialization<test_msgs::msg::BasicTypes> protocol;
+  auto get_last_value = [&]() -> uint64_t {
+    const auto& serialized_message = sub_context.get_abstract_state<
+        std::shared_ptr<const rclcpp::SerializedMessage>>(0);
+    if (!serialized_message) {
+      return 0u;
+    }
+    test_msgs::msg::BasicTypes message;
+    protocol.deserialize_message(serialized_message.get(), &message);
+    return message.uint64_value;
+  };
+  constexpr double kTimeStep = 0.1;
+  constexpr size_t kMaxAttempts = 50;
+  for (size_t attempt = 0; attempt < kMaxAttempts && get_last_value() != 3u;
+       ++attempt) {
+    simulator.AdvanceTo(simulator.get_context().get_time() + kTimeStep);
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  ASSERT_EQ(get_last_value(), 3u);
+  EXPECT_EQ(serializer->num_deserializations(), 0);
+
+  // Deserialization happens once, on demand.
+  for (int i = 0; i < 2; ++i) {
+    EXPECT_EQ(system_sub_in->get_output_port(0)
+                  .Eval<test_msgs::msg::BasicTypes>(sub_context)
+                  .uint64_value,
+              3u);
+  }
+  EXPECT_EQ(serializer->num_deserializations(), 1);
+
+  drake_ros::core::shutdown();
+}
+
+namespace {
+// Publishes messages with `frame_id` and others in between, and checks that
+// only the former go through a subscriber filtering on `frame_id`.
+void CheckHeaderFrameIdFilter(const std::string& node_name,
+                              const std::string& frame_id) {
+  drake_ros::core::init(0, nullptr);
+
+  drake::systems::DiagramBuilder<double> builder;
+
+  const auto qos = rclcpp::QoS{rclcpp::KeepLast(10)}.reliable();
+
+  auto system_ros = builder.AddSystem<RosInterfaceSystem>(
+      std::make_unique<DrakeRos>(node_name));
+  RosSubscriberParams params;
+  params.content_filter = MakeHeaderFrameIdFilter({frame_id});
+  auto system_sub_in = builder.AddSystem(
+      RosSubscriberSystem::Make<geometry_msgs::msg::PoseStamped>(
+          "in", qos, system_ros->get_ros_interface(), params));
+
+  auto diagram = builder.Build();
+  drake::systems::Simulator<double> simulator(*diagram);
+  const auto& sub_context =
+      system_sub_in->GetMyContextFromRoot(simulator.get_context());
+
+  auto direct_ros_node = rclcpp::Node::make_shared(node_name + "_pub");
+  auto direct_pub_in =
+      direct_ros_node->create_publisher<geometry_msgs::msg::PoseStamped>("in",
+                                                                         qos);
+
+  // Messages are received in order, so only the one in the middle must
+  // be kept, whether filtered by the middleware or by the prefilter.
+  const std::vector<std::string> frame_ids{"robot_0", frame_id, "robot_0"};
+  for (size_t i = 0; i < frame_ids.size(); ++i) {
+    geometry_msgs::msg::PoseStamped message;
+    message.header.frame_id = frame_ids[i];
+    message.pose.position.x = static_cast<double>(i);
+    direct_pub_in->publish(message);
+  }
+
+  constexpr double kTimeStep = 0.1;
+  constexpr size_t kMaxAttempts = 50;
+  for (size_t attempt = 0; attempt < kMaxAttempts; ++attempt) {
+    if (system_sub_in->get_output_port(0)
+            .Eval<geometry_msgs::msg::PoseStamped>(sub_context)
+            .header.frame_id == frame_id) {
+      break;
+    }
+    simulator.AdvanceTo(simulator.get_context().get_time() + kTimeStep);
+  }
+  // Give the last message a chance to arrive.
+  for (size_t attempt = 0; attempt < 10; ++attempt) {
+    simulator.AdvanceTo(simulator.get_context().get_time() + kTimeStep);
+  }
+  const auto& message = system_sub_in->get_output_port(0)
+                            .Eval<geometry_msgs::msg::PoseStamped>(sub_context);
+  EXPECT_EQ(message.header.frame_id, frame_id);
+  EXPECT_EQ(message.pose.position.x, 1.0);
+
+  drake_ros::core::shutdown();
+}
+}  // namespace
+
+TEST(Integration, content_filter) {
+  CheckHeaderFrameIdFilter("content_filter", "robot 1");
+}
+
+// Frame IDs with single quotes cannot be handed over to the middleware.
+TEST(Integration, content_filter_quoted) {
+  CheckHeaderFrameIdFilter("content_filter_quoted", "robot's base");
+}
+
+TEST(Integration, wall_clock_publishing) {
+  drake_ros::core::init(0, nullptr);
+
+  const auto qos = rclcpp::QoS{rclcpp::KeepLast(10)}.reliable();
+
+  DrakeRos ros("wall_clock_publishing");
+  RosPublisherParams params;
+  params.wall_clock_publish_period = 0.05;
+  auto system_pub_out = RosPublisherSystem::Make<test_msgs::msg::BasicTypes>(
+      "out", qos, &ros, {drake::systems::TriggerType::kForced}, 0.0, params);
+
+  auto direct_ros_node =
+      rclcpp::Node::make_shared("wall_clock_publishing_direct");
+  std::vector<test_msgs::msg::BasicTypes> rx_msgs_direct_sub_out;
+  auto direct_sub_out =
+      direct_ros_node->create_subscription<test_msgs::msg::BasicTypes>(
+          "out", qos, [&](const test_msgs::msg::BasicTypes& message) {
+            rx_msgs_direct_sub_out.push_back(message);
+          });
+
+  // Publish once, as if simulation had taken a single step.
+  test_msgs::msg::BasicTypes message;
+  message.int64_value = 42;
+  auto context = system_pub_out->CreateDefaultContext();
+  system_pub_out->get_input_port().FixValue(context.get(), message);
+  system_pub_out->ForcedPublish(*context);
+
+  // Messages keep coming while simulation stays idle.
+  constexpr size_t kMaxAttempts = 100;
+  constexpr size_t kMinMessages = 3;
+  for (size_t attempt = 0; attempt < kMaxAttempts &&
+                           rx_msgs_direct_sub_out.size() < kMinMessages;
+       ++attempt) {
+    rclcpp::spin_some(direct_ros_node);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  }
+  ASSERT_GE(rx_msgs_direct_sub_out.size(), kMinMessages);
+  for (const auto& rx_message : rx_msgs_direct_sub_out) {
+    EXPECT_EQ(rx_message, message);
+  }
+
+  params.wall_clock_publish_period = -1.0;
+  EXPECT_THROW(RosPublisherSystem::Make<test_msgs::msg::BasicTypes>(
+                   "out", qos, &ros, {drake::systems::TriggerType::kForced},
+                   0.0, params),
+               std::invalid_argument);
+
+  drake_ros::core::shutdown();
+}
+
+TEST(Integration, message_sinks) {
+  drake_ros::core::init(0, nullptr);
+
+  const auto qos = rclcpp::QoS{rclcpp::KeepLast(10)}.reliable();
+
+  DrakeRos ros("message_sinks");
+  auto system_pub_out = RosPublisherSystem::Make<test_msgs::msg::BasicTypes>(
+      "out", qos, &ros, {drake::systems::TriggerType::kForced});
+  auto sink = std::make_shared<RecordingSink>(false);
+  auto holding_sink = std::make_shared<RecordingSink>(true);
+  system_pub_out->AddMessageSink(sink);
+
+  auto context = system_pub_out->CreateDefaultContext();
+  test_msgs::msg::BasicTypes message;
+  for (int64_t i = 1; i <= 3; ++i) {
+    message.int64_value = i;
+    system_pub_out->get_input_port().FixValue(context.get(), message);
+    system_pub_out->ForcedPublish(*context);
+  }
+  ASSERT_EQ(sink->values.size(), 3u);
+  for (size_t i = 0; i < sink->values.size(); ++i) {
+    EXPECT_EQ(sink->values[i].int64_value, static_cast<int64_t>(i + 1));
+    EXPECT_EQ(sink->topic_names[i], "/out");
+    EXPECT_EQ(sink->type_names[i], "test_msgs/msg/BasicTypes");
+  }
+  // Messages no sink holds are reused.
+  EXPECT_EQ(sink->addresses[1], sink->addresses[0]);
+  EXPECT_EQ(sink->addresses[2], sink->addresses[0]);
+
+  // Messages held by any sink are shared, not reused.
+  system_pub_out->AddMessageSink(holding_sink);
+  for (int64_t i = 4; i <= 5; ++i) {
+    message.int64_value = i;
+    system_pub_out->get_input_port().FixValue(context.get(), message);
+    system_pub_out->ForcedPublish(*context);
+  }
+  ASSERT_EQ(holding_sink->values.size(), 2u);
+  EXPECT_NE(holding_sink->addresses[1], holding_sink->addresses[0]);
+  EXPECT_EQ(sink->addresses[3], holding_sink->addresses[0]);
+  EXPECT_EQ(sink->addresses[4], holding_sink->addresses[1]);
+  EXPECT_EQ(holding_sink->values[0].int64_value, 4);
+  EXPECT_EQ(holding_sink->values[1].int64_value, 5);
+
+  drake_ros::core::shutdown();
+}
+
+TEST(Integration, qos_events) {
+  drake_ros::core::init(0, nullptr);
+
+  constexpr double kDeadline = 0.05;
+  const auto qos = rclcpp::QoS{rclcpp::KeepLast(10)}.reliable().deadline(
+      rclcpp::Duration::from_seconds(kDeadline));
+
+  DrakeRos ros("qos_events");
+  RosPublisherParams pub_params;
+  pub_params.qos_event_status_port = true;
+  auto system_pub_out = RosPublisherSystem::Make<test_msgs::msg::BasicTypes>(
+      "out", qos, &ros, {drake::systems::TriggerType::kForced}, 0.0,
+      pub_params);
+  RosSubscriberParams sub_params;
+  sub_params.qos_event_status_port = true;
+  auto system_sub_in = RosSubscriberSystem::Make<test_msgs::msg::BasicTypes>(
+      "out", qos, &ros, sub_params);
+
+  // Publish once, then let deadlines go by.
+  auto pub_context = system_pub_out->CreateDefaultContext();
+  system_pub_out->get_input_port().FixValue(pub_context.get(),
+                                            test_msgs::msg::BasicTypes{});
+  system_pub_out->ForcedPublish(*pub_context);
+  constexpr int kMaxAttempts = 100;
+  for (int attempt = 0;
+       attempt < kMaxAttempts &&
+       (system_pub_out->GetQosEventStatus().deadline_missed == 0 ||
+        system_sub_in->GetQosEventStatus().deadline_missed == 0);
+       ++attempt) {
+    ros.Spin(static_cast<int>(kDeadline * 1000));
+  }
+  EXPECT_GT(system_pub_out->GetQosEventStatus().deadline_missed, 0);
+  EXPECT_GT(system_sub_in->GetQosEventStatus().deadline_missed, 0);
+  EXPECT_EQ(system_sub_in->GetQosEventStatus().incompatible_qos, 0);
+
+  // Counts are latched into state as simulation steps.
+  drake::systems::Simulator<double> simulator(*system_sub_in);
+  const auto& status_port = system_sub_in->GetOutputPort("qos_event_status");
+  EXPECT_EQ(status_port.Eval<QosEventStatus>(simulator.get_context()),
+            QosEventStatus{});
+  simulator.AdvanceTo(0.1);
+  EXPECT_GT(
+      status_port.Eval<QosEventStatus>(simulator.get_context()).deadline_missed,
+      0);
+
+  drake_ros::core::shutdown();
+}
+
+TEST(Integration, high_priority) {
+  drake_ros::core::init(0, nullptr);
+
+  const auto qos = rclcpp::QoS{rclcpp::KeepLast(10)}.reliable();
+
+  DrakeRos ros("high_priority");
+  EXPECT_EQ(ros.GetCallbackGroup(CallbackPriority::kNormal), nullptr);
+  auto group = ros.GetCallbackGroup(CallbackPriority::kHigh);
+  ASSERT_NE(group, nullptr);
+  EXPECT_EQ(ros.GetCallbackGroup(CallbackPriority::kHigh), group);
+
+  RosSubscriberParams params;
+  params.priority = CallbackPriority::kHigh;
+  auto system_sub_high = RosSubscriberSystem::Make<test_msgs::msg::BasicTypes>(
+      "in", qos, &ros, params);
+  auto system_sub_normal =
+      RosSubscriberSystem::Make<test_msgs::msg::BasicTypes>("in", qos, &ros);
+
+  auto direct_ros_node = rclcpp::Node::make_shared("high_priority_direct");
+  auto direct_pub_in =
+      direct_ros_node->create_publisher<test_msgs::msg::BasicTypes>("in", qos);
+
+  // High priority messages are received without ever spinning.
+  drake::systems::Simulator<double> simulator_high(*system_sub_high);
+  drake::systems::Simulator<double> simulator_normal(*system_sub_normal);
+  test_msgs::msg::BasicTypes message;
+  message.uint64_value = 42u;
+  auto received = [&]() {
+    return system_sub_high->get_output_port(0)
+               .Eval<test_msgs::msg::BasicTypes>(simulator_high.get_context())
+               .uint64_value == 42u;
+  };
+  constexpr size_t kMaxAttempts = 50;
+  constexpr double kTimeStep = 0.1;
+  for (size_t attempt = 0; attempt < kMaxAttempts && !received();
+       ++attempt) {
+    direct_pub_in->publish(message);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    simulator_high.AdvanceTo(simulator_high.get_context().get_time() +
+                             kTimeStep);
+  }
+  EXPECT_TRUE(received());
+
+  // Normal priority messages wait for DrakeRos::Spin().
+  auto received_normal = [&]() {
+    return system_sub_normal->get_output_port(0)
+               .Eval<test_msgs::msg::BasicTypes>(
+                   simulator_normal.get_context())
+               .uint64_value == 42u;
+  };
+  simulator_normal.AdvanceTo(kTimeStep);
+  EXPECT_FALSE(received_normal());
+  for (size_t attempt = 0; attempt < kMaxAttempts && !received_normal();
+       ++attempt) {
+    ros.Spin(100);
+    simulator_normal.AdvanceTo(simulator_normal.get_context().get_time() +
+                               kTimeStep);
+  }
+  EXPECT_TRUE(received_normal());
+
+  drake_ros::core::shutdown();
+}
+
+TEST(Integration, high_priority_under_load) {
+  drake_ros::core::init(0, nullptr);
+
+  const auto qos = rclcpp::QoS{rclcpp::KeepLast(100)}.reliable();
+
+  DrakeRos ros("high_priority_under_load");
+  RosSubscriberParams params;
+  params.priority = CallbackPriority::kHigh;
+  auto system_sub_control =
+      RosSubscriberSystem::Make<test_msgs::msg::BasicTypes>("control", qos,
+                                                            &ros, params);
+  // Normal priority work that takes long to service (e.g. visualization).
+  constexpr auto kWorkDuration = std::chrono::milliseconds(20);
+  std::atomic<int> num_flood_messages_serviced{0};
+  auto flood_sub =
+      ros.get_mutable_node()->create_subscription<test_msgs::msg::BasicTypes>(
+          "flood", qos, [&](const test_msgs::msg::BasicTypes&) {
+            std::this_thread::sleep_for(kWorkDuration);
+            ++num_flood_messages_serviced;
+          });
+
+  auto direct_ros_node =
+      rclcpp::Node::make_shared("high_priority_under_load_direct");
+  auto control_pub = direct_ros_node->create_publisher<
+      test_msgs::msg::BasicTypes>("control", qos);
+  auto flood_pub =
+      direct_ros_node->create_publisher<test_msgs::msg::BasicTypes>("flood",
+                                                                    qos);
+  for (int i = 0; i < 500 && (control_pub->get_subscription_count() == 0 ||
+                              flood_pub->get_subscription_count() == 0);
+       ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  ASSERT_GT(control_pub->get_subscription_count(), 0u);
+  ASSERT_GT(flood_pub->get_subscription_count(), 0u);
+
+  // Flood normal priority work, much faster than it can be serviced, while
+  // spinning concurrently.
+  std::atomic<bool> done{false};
+  std::atomic<int> num_flood_messages_published{0};
+  std::thread spinner([&]() {
+    while (!done) {
+      ros.Spin(10);
+    }
+  });
+  std::thread flooder([&]() {
+    const test_msgs::msg::BasicTypes message;
+    while (!done) {
+      flood_pub->publish(message);
+      ++num_flood_messages_published;
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+  // Control messages are applied in bounded time all the same.
+  drake::systems::Simulator<double> simulator(*system_sub_control);
+  auto received = [&](uint64_t value) {
+    return system_sub_control->get_output_port(0)
+               .Eval<test_msgs::msg::BasicTypes>(simulator.get_context())
+               .uint64_value == value;
+  };
+  constexpr uint64_t kNumControlMessages = 10u;
+  constexpr double kTimeStep = 0.001;
+  constexpr auto kTimeout = std::chrono::seconds(5);
+  std::chrono::steady_clock::duration max_latency{0};
+  for (uint64_t value = 1u; value <= kNumControlMessages; ++value) {
+    test_msgs::msg::BasicTypes message;
+    message.uint64_value = value;
+    const auto start = std::chrono::steady_clock::now();
+    control_pub->publish(message);
+    while (!received(value) &&
+           std::chrono::steady_clock::now() - start < kTimeout) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      simulator.AdvanceTo(simulator.get_context().get_time() + kTimeStep);
+    }
+    ASSERT_TRUE(received(value));
+    max_latency =
+        std::max(max_latency, std::chrono::steady_clock::now() - start);
+  }
+  done = true;
+  flooder.join();
+  spinner.join();
+
+  // Normal priority work was backlogged by far more than the latency bound
+  // meanwhile, i.e. control messages did not wait for it.
+  constexpr auto kMaxLatency = std::chrono::milliseconds(500);
+  EXPECT_GT((num_flood_messages_published - num_flood_messages_serviced) *
+                kWorkDuration,
+            2 * kMaxLatency);
+  EXPECT_LT(max_latency, kMaxLatency);
+
+  drake_ros::core::shutdown();
+}
+
 // Only available in Bazel.
 #ifndef _TEST_DISABLE_RMW_ISOLATION
 #include "rmw_isolation/rmw_isolation.h"
@@ -0,0 +1,245 @@
+#include <sched.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <drake/systems/analysis/simulator.h>
+#include <drake/systems/framework/diagram_builder.h>
+#include <gtest/gtest.h>
+#include <rclcpp/rclcpp.hpp>
+#include <test_msgs/msg/basic_types.hpp>
+
+#include "drake_ros/core/drake_ros.h"
+#include "drake_ros/core/realtime.h"
+#include "drake_ros/core/realtime_pacer.h"
+#include "drake_ros/core/ros_interface_system.h"
+#include "drake_ros/core/ros_publisher_system.h"
+#include "drake_ros/core/ros_subscriber_system.h"
+
+using drake_ros::core::DrakeRos;
+using drake_ros::core::RealtimePacer;
+using drake_ros::core::RealtimeParams;
+using drake_ros::core::RosInterfaceSystem;
+using drake_ros::core::RosPublisherSystem;
+using drake_ros::core::RosSubscriberParams;
+using drake_ros::core::RosSubscriberSystem;
+
+namespace {
+// Number of heap allocations made by drake_ros code so far, excluding code
+// it delegates to.
+std::atomic<uint64_t> g_num_drake_ros_allocations{0};
+}  // namespace
+
+// Count heap allocations made by drake_ros code, process-wide.
+void* operator new(std::size_t size) {
+  if (drake_ros::core::IsInDrakeRosCall()) {
+    g_num_drake_ros_allocations.fetch_add(1, std::memory_order_relaxed);
+  }
+  void* ptr = std::malloc(size == 0 ? 1 : size);
+  if (ptr == nullptr) {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+// N.B. Only drake_ros code is audited. Allocations in the rclcpp executor,
+// the ROS middleware, and message (de)serialization are not counted.
+TEST(Realtime, drake_ros_code_does_not_allocate_in_steady_state) {
+  drake_ros::core::init(0, nullptr);
+
+  drake::systems::DiagramBuilder<double> builder;
+
+  const auto qos = rclcpp::QoS{rclcpp::KeepLast(10)}.reliable();
+
+  auto system_ros = builder.AddSystem<RosInterfaceSystem>(
+      std::make_unique<DrakeRos>("realtime"));
+  RosSubscriberParams params;
+  params.message_pool_size = 4;
+  auto system_sub_in =
+      builder.AddSystem(RosSubscriberSystem::Make<test_msgs::msg::BasicTypes>(
+          "in", qos, system_ros->get_ros_interface(), params));
+  auto system_pub_out =
+      builder.AddSystem(RosPublisherSystem::Make<test_msgs::msg::BasicTypes>(
+          "out", qos, system_ros->get_ros_interface(),
+          {drake::systems::TriggerType::kPerStep}));
+  builder.Connect(system_sub_in->get_output_port(0),
+                  system_pub_out->get_input_port(0));
+
+  auto diagram = builder.Build();
+  drake::systems::Simulator<double> simulator(*diagram);
+  simulator.Initialize();
+
+  auto direct_ros_node = rclcpp::Node::make_shared("realtime_direct");
+  auto direct_pub_in =
+      direct_ros_node->create_publisher<test_msgs::msg::BasicTypes>("in", qos);
+  size_t num_rx_msgs_direct_sub_out = 0;
+  auto direct_sub_out =
+      direct_ros_node->create_subscription<test_msgs::msg::BasicTypes>(
+          "out", qos, [&](const test_msgs::msg::BasicTypes& message) {
+            (void)message;
+            ++num_rx_msgs_direct_sub_out;
+          });
+
+  constexpr double kTimeStep = 0.01;
+  test_msgs::msg::BasicTypes message;
+  auto step = [&]() {
+    ++message.uint64_value;
+    direct_pub_in->publish(message);
+    // Give messages some time to go through.
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    simulator.AdvanceTo(simulator.get_context().get_time() + kTimeStep);
+    rclcpp::spin_some(direct_ros_node);
+  };
+
+  // Warm up until messages are relayed, and then some more so that all
+  // buffers reach their steady state size.
+  constexpr size_t kMaxWarmUpSteps = 500;
+  for (size_t i = 0; i < kMaxWarmUpSteps && num_rx_msgs_direct_sub_out == 0;
+       ++i) {
+    step();
+  }
+  ASSERT_GT(num_rx_msgs_direct_sub_out, 0u);
+  constexpr size_t kExtraWarmUpSteps = 20;
+  for (size_t i = 0; i < kExtraWarmUpSteps; ++i) {
+    step();
+  }
+
+  // Audit steady state, step by step.
+  constexpr size_t kSteadyStateSteps = 100;
+  std::vector<uint64_t> num_allocations_per_step(kSteadyStateSteps);
+  std::vector<uint64_t> num_lock_contentions_per_step(kSteadyStateSteps);
+  const size_t num_rx_msgs_before = num_rx_msgs_direct_sub_out;
+  for (size_t i = 0; i < kSteadyStateSteps; ++i) {
+    const uint64_t num_allocations_before =
+        g_num_drake_ros_allocations.load();
+    const uint64_t num_lock_contentions_before =
+        drake_ros::core::GetLockContentionCount();
+    step();
+    num_allocations_per_step[i] =
+        g_num_drake_ros_allocations.load() - num_allocations_before;
+    num_lock_contentions_per_step[i] =
+        drake_ros::core::GetLockContentionCount() -
+        num_lock_contentions_before;
+  }
+  // Messages must have gone through while auditing.
+  EXPECT_GT(num_rx_msgs_direct_sub_out, num_rx_msgs_before);
+  for (size_t i = 0; i < kSteadyStateSteps; ++i) {
+    EXPECT_EQ(num_allocations_per_step[i], 0u) << "at step " << i;
+    // Simulation and ROS are serviced by this thread alone.
+    EXPECT_EQ(num_lock_contentions_per_step[i], 0u) << "at step " << i;
+  }
+
+  drake_ros::core::shutdown();
+}
+
+TEST(Realtime, configure) {
+  // Default parameters leave everything as-is.
+  EXPECT_NO_THROW(drake_ros::core::ConfigureRealtime(RealtimeParams{}));
+
+  RealtimeParams params;
+  params.thread_priority = 1000;
+  EXPECT_THROW(drake_ros::core::ConfigureRealtime(params),
+               std::invalid_argument);
+
+  params = RealtimeParams{};
+  params.cpu_affinity = {-1};
+  EXPECT_THROW(drake_ros::core::ConfigureRealtime(params),
+               std::invalid_argument);
+
+  // Pinning to a CPU this thread may already run on is always allowed.
+  cpu_set_t cpu_set;
+  ASSERT_EQ(sched_getaffinity(0, sizeof(cpu_set), &cpu_set), 0);
+  params = RealtimeParams{};
+  for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+    if (CPU_ISSET(cpu, &cpu_set)) {
+      params.cpu_affinity.push_back(cpu);
+      break;
+    }
+  }
+  ASSERT_FALSE(params.cpu_affinity.empty());
+  EXPECT_NO_THROW(drake_ros::core::ConfigureRealtime(params));
+  // Restore the original affinity.
+  ASSERT_EQ(sched_setaffinity(0, sizeof(cpu_set), &cpu_set), 0);
+}
+
+TEST(Realtime, pacing) {
+  drake_ros::core::init(0, nullptr);
+
+  EXPECT_THROW(RealtimePacer(nullptr), std::invalid_argument);
+
+  drake::systems::DiagramBuilder<double> builder;
+  auto system_ros = builder.AddSystem<RosInterfaceSystem>(
+      std::make_unique<DrakeRos>("pacing"));
+  DrakeRos* ros = system_ros->get_ros_interface();
+  EXPECT_THROW(RealtimePacer(ros, 0.0), std::invalid_argument);
+
+  const auto qos = rclcpp::QoS{rclcpp::KeepLast(10)}.reliable();
+  std::atomic<size_t> num_rx_msgs{0};
+  auto sub = ros->get_mutable_node()->create_subscription<
+      test_msgs::msg::BasicTypes>(
+      "paced", qos,
+      [&](const test_msgs::msg::BasicTypes&) { ++num_rx_msgs; });
+
+  auto diagram = builder.Build();
+  drake::systems::Simulator<double> simulator(*diagram);
+  simulator.set_target_realtime_rate(1.0);
+  drake_ros::core::EnableRealtimePacing(&simulator, ros, 2.0);
+  EXPECT_EQ(simulator.get_target_realtime_rate(), 0.0);
+  simulator.Initialize();
+
+  auto direct_ros_node = rclcpp::Node::make_shared("pacing_direct");
+  auto direct_pub =
+      direct_ros_node->create_publisher<test_msgs::msg::BasicTypes>("paced",
+                                                                    qos);
+  std::atomic<bool> stop{false};
+  std::thread publisher_thread([&]() {
+    while (!stop) {
+      direct_pub->publish(test_msgs::msg::BasicTypes{});
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+  });
+
+  // Without events, simulation advances in a single step, and thus
+  // messages can only be received while pacing.
+  constexpr double kSimTime = 1.0;
+  const auto start = std::chrono::steady_clock::now();
+  simulator.AdvanceTo(kSimTime);
+  const std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+  stop = true;
+  publisher_thread.join();
+
+  EXPECT_GE(elapsed.count(), 0.99 * kSimTime / 2.0);
+  EXPECT_GT(num_rx_msgs.load(), 0u);
+
+  drake_ros::core::shutdown();
+}
+
+// Only available in Bazel.
+#ifndef _TEST_DISABLE_RMW_ISOLATION
+#include "rmw_isolation/rmw_isolation.h"
+
+int main(int argc, char* argv[]) {
+  const char* TEST_TMPDIR = std::getenv("TEST_TMPDIR");
+  if (TEST_TMPDIR != nullptr) {
+    std::string ros_home = std::string(TEST_TMPDIR) + "/.ros";
+    setenv("ROS_HOME", ros_home.c_str(), 1);
+    ros2::isolate_rmw_by_path(argv[0], TEST_TMPDIR);
+  }
+
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
+#endif
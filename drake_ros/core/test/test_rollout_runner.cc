@@ -0,0 +1,162 @@
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <drake/systems/analysis/simulator.h>
+#include <drake/systems/framework/diagram_builder.h>
+#include <gtest/gtest.h>
+#include <rclcpp/rclcpp.hpp>
+#include <test_msgs/msg/basic_types.hpp>
+
+#include "drake_ros/core/drake_ros.h"
+#include "drake_ros/core/rollout_runner.h"
+#include "drake_ros/core/ros_publisher_system.h"
+
+using drake_ros::core::DrakeRos;
+using drake_ros::core::RolloutRunner;
+using drake_ros::core::RolloutRunnerParams;
+using drake_ros::core::RosPublisherSystem;
+
+TEST(RolloutRunner, concurrent_rollouts) {
+  constexpr int kNumWorkers = 2;
+  constexpr int kNumRollouts = 6;
+
+  RolloutRunnerParams params;
+  params.num_workers = kNumWorkers;
+
+  std::mutex mutex;
+  std::multiset<int> rollout_indices;
+  RolloutRunner runner(
+      [](drake::systems::DiagramBuilder<double>* builder, DrakeRos* ros,
+         int) {
+        builder->AddSystem(
+            RosPublisherSystem::Make<test_msgs::msg::BasicTypes>(
+                "out", rclcpp::QoS(1), ros,
+                {drake::systems::TriggerType::kForced}));
+      },
+      [&](int rollout_index, drake::systems::Simulator<double>* simulator) {
+        simulator->Initialize();
+        simulator->AdvanceTo(0.1);
+        std::lock_guard<std::mutex> lock(mutex);
+        rollout_indices.insert(rollout_index);
+      },
+      params);
+
+  ASSERT_EQ(runner.num_workers(), kNumWorkers);
+  std::set<std::string> namespaces;
+  for (int i = 0; i < kNumWorkers; ++i) {
+    namespaces.insert(
+        runner.get_mutable_ros_interface(i)->get_node().get_namespace());
+  }
+  EXPECT_EQ(namespaces.size(), static_cast<size_t>(kNumWorkers));
+  EXPECT_EQ(namespaces.count("/worker_0"), 1u);
+
+  // Workers are reused across runs.
+  for (int run = 0; run < 2; ++run) {
+    rollout_indices.clear();
+    runner.Run(kNumRollouts);
+    ASSERT_EQ(rollout_indices.size(), static_cast<size_t>(kNumRollouts));
+    for (int i = 0; i < kNumRollouts; ++i) {
+      EXPECT_EQ(rollout_indices.count(i), 1u);
+    }
+  }
+
+  // Worker contexts are isolated from the global context.
+  EXPECT_FALSE(rclcpp::contexts::get_global_default_context()->is_valid());
+}
+
+TEST(RolloutRunner, rollout_failure) {
+  RolloutRunnerParams params;
+  params.num_workers = 1;
+
+  std::mutex mutex;
+  std::set<int> rollouts_started;
+  RolloutRunner runner(
+      [](drake::systems::DiagramBuilder<double>*, DrakeRos*, int) {},
+      [&](int rollout_index, drake::systems::Simulator<double>*) {
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          rollouts_started.insert(rollout_index);
+        }
+        if (rollout_index == 2) {
+          throw std::runtime_error("rollout 2 failed");
+        }
+      },
+      params);
+
+  // The error is propagated as-is, and rollouts still pending when it
+  // happened are skipped.
+  constexpr int kNumRollouts = 10;
+  try {
+    runner.Run(kNumRollouts);
+    ADD_FAILURE() << "rollout failure not propagated";
+  } catch (const std::runtime_error& e) {
+    EXPECT_STREQ(e.what(), "rollout 2 failed");
+  }
+  EXPECT_EQ(rollouts_started, (std::set<int>{0, 1, 2}));
+
+  // Runs after a failure start afresh.
+  rollouts_started.clear();
+  EXPECT_THROW(runner.Run(kNumRollouts), std::runtime_error);
+  EXPECT_EQ(rollouts_started, (std::set<int>{0, 1, 2}));
+}
+
+TEST(RolloutRunner, rollout_failure_while_others_ongoing) {
+  RolloutRunnerParams params;
+  params.num_workers = 2;
+
+  std::mutex mutex;
+  std::condition_variable cv;
+  bool rollout_1_started{false};
+  bool rollout_0_failed{false};
+  bool rollout_1_done{false};
+  RolloutRunner runner(
+      [](drake::systems::DiagramBuilder<double>*, DrakeRos*, int) {},
+      [&](int rollout_index, drake::systems::Simulator<double>*) {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (rollout_index == 0) {
+          // Fail while rollout 1 is ongoing.
+          cv.wait(lock, [&]() { return rollout_1_started; });
+          rollout_0_failed = true;
+          cv.notify_all();
+          throw std::runtime_error("rollout 0 failed");
+        }
+        if (rollout_index == 1) {
+          rollout_1_started = true;
+          cv.notify_all();
+          cv.wait(lock, [&]() { return rollout_0_failed; });
+          rollout_1_done = true;
+        }
+      },
+      params);
+
+  // Ongoing rollouts are waited on, and the first error is propagated.
+  try {
+    runner.Run(100);
+    ADD_FAILURE() << "rollout failure not propagated";
+  } catch (const std::runtime_error& e) {
+    EXPECT_STREQ(e.what(), "rollout 0 failed");
+  }
+  EXPECT_TRUE(rollout_1_done);
+}
+
+// Only available in Bazel.
+#ifndef _TEST_DISABLE_RMW_ISOLATION
+#include "rmw_isolation/rmw_isolation.h"
+
+int main(int argc, char* argv[]) {
+  const char* TEST_TMPDIR = std::getenv("TEST_TMPDIR");
+  if (TEST_TMPDIR != nullptr) {
+    std::string ros_home = std::string(TEST_TMPDIR) + "/.ros";
+    setenv("ROS_HOME", ros_home.c_str(), 1);
+    ros2::isolate_rmw_by_path(argv[0], TEST_TMPDIR);
+  }
+
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
+#endif
@@ -0,0 +1,142 @@
+#include <chrono>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include <drake/systems/analysis/simulator.h>
+#include <drake/systems/framework/diagram_builder.h>
+#include <geometry_msgs/msg/pose_stamped.hpp>
+#include <geometry_msgs/msg/twist_stamped.hpp>
+#include <gtest/gtest.h>
+#include <rclcpp/rclcpp.hpp>
+#include <rclcpp/serialization.hpp>
+
+#include "drake_ros/core/drake_ros.h"
+#include "drake_ros/core/ros_interface_system.h"
+#include "drake_ros/core/ros_synchronizer_system.h"
+#include "drake_ros/core/serialized_header.h"
+
+using drake_ros::core::DrakeRos;
+using drake_ros::core::PeekHeaderStamp;
+using drake_ros::core::RosInterfaceSystem;
+using drake_ros::core::RosSynchronizerSystem;
+using drake_ros::core::SetHeaderStamp;
+using geometry_msgs::msg::PoseStamped;
+using geometry_msgs::msg::TwistStamped;
+
+TEST(SerializedHeader, peek_stamp) {
+  PoseStamped message;
+  message.header.stamp.sec = 1234;
+  message.header.stamp.nanosec = 5678;
+  message.header.frame_id = "world";
+
+  rclcpp::Serialization<PoseStamped> protocol;
+  rclcpp::SerializedMessage serialized_message;
+  protocol.serialize_message(&message, &serialized_message);
+
+  auto stamp = PeekHeaderStamp(serialized_message);
+  ASSERT_TRUE(stamp.has_value());
+  EXPECT_EQ(stamp->sec, 1234);
+  EXPECT_EQ(stamp->nanosec, 5678u);
+
+  builtin_interfaces::msg::Time new_stamp;
+  new_stamp.sec = 42;
+  new_stamp.nanosec = 24;
+  ASSERT_TRUE(SetHeaderStamp(new_stamp, &serialized_message));
+  PoseStamped restamped_message;
+  protocol.deserialize_message(&serialized_message, &restamped_message);
+  EXPECT_EQ(restamped_message.header.stamp, new_stamp);
+  EXPECT_EQ(restamped_message.header.frame_id, "world");
+
+  rclcpp::SerializedMessage short_message(4u);
+  short_message.get_rcl_serialized_message().buffer_length = 4u;
+  EXPECT_FALSE(PeekHeaderStamp(short_message).has_value());
+  EXPECT_FALSE(SetHeaderStamp(new_stamp, &short_message));
+}
+
+TEST(RosSynchronizerSystem, approximate_time_matching) {
+  drake_ros::core::init(0, nullptr);
+
+  drake::systems::DiagramBuilder<double> builder;
+  auto ros_interface_system = builder.AddSystem<RosInterfaceSystem>(
+      std::make_unique<DrakeRos>("synchronizer_node"));
+  const auto qos = rclcpp::QoS(10).reliable();
+  auto synchronizer_system =
+      builder.AddSystem(RosSynchronizerSystem::Make<PoseStamped, TwistStamped>(
+          {"pose", "twist"}, qos, ros_interface_system->get_ros_interface()));
+  ASSERT_EQ(synchronizer_system->num_output_ports(), 2);
+  auto diagram = builder.Build();
+
+  auto publisher_node = rclcpp::Node::make_shared("publisher_node");
+  auto pose_publisher =
+      publisher_node->create_publisher<PoseStamped>("pose", qos);
+  auto twist_publisher =
+      publisher_node->create_publisher<TwistStamped>("twist", qos);
+  // Wait for discovery.
+  for (int i = 0; i < 500 && (pose_publisher->get_subscription_count() == 0 ||
+                              twist_publisher->get_subscription_count() == 0);
+       ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+
+  // Publish poses at 10 Hz and twists at 10 Hz with an offset, plus an
+  // extra twist that should never be matched.
+  for (int i = 1; i <= 5; ++i) {
+    PoseStamped pose;
+    pose.header.stamp = rclcpp::Time(i, 0);
+    pose.pose.position.x = i;
+    pose_publisher->publish(pose);
+
+    TwistStamped twist;
+    twist.header.stamp = rclcpp::Time(i, 20000000);
+    twist.twist.linear.x = i;
+    twist_publisher->publish(twist);
+    if (i == 3) {
+      twist.header.stamp = rclcpp::Time(i, 500000000);
+      twist.twist.linear.x = -1.0;
+      twist_publisher->publish(twist);
+    }
+  }
+
+  drake::systems::Simulator<double> simulator(*diagram);
+  const auto& synchronizer_context =
+      synchronizer_system->GetMyContextFromRoot(simulator.get_context());
+  constexpr int kMaxIterations = 500;
+  for (int i = 0; i < kMaxIterations &&
+                  synchronizer_system->num_matched_sets() < 4u;
+       ++i) {
+    simulator.AdvanceTo(simulator.get_context().get_time() + 0.01);
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  // The last set can only be matched when newer messages arrive.
+  ASSERT_EQ(synchronizer_system->num_matched_sets(), 4u);
+  simulator.AdvanceTo(simulator.get_context().get_time() + 0.01);
+
+  // Outputs come from the same, latest matched set.
+  const auto& pose = synchronizer_system->get_output_port(0)
+                         .Eval<PoseStamped>(synchronizer_context);
+  const auto& twist = synchronizer_system->get_output_port(1)
+                          .Eval<TwistStamped>(synchronizer_context);
+  EXPECT_EQ(pose.pose.position.x, 4.0);
+  EXPECT_EQ(twist.twist.linear.x, 4.0);
+
+  drake_ros::core::shutdown();
+}
+
+// Only available in Bazel.
+#ifndef _TEST_DISABLE_RMW_ISOLATION
+#include "rmw_isolation/rmw_isolation.h"
+
+int main(int argc, char* argv[]) {
+  const char* TEST_TMPDIR = std::getenv("TEST_TMPDIR");
+  if (TEST_TMPDIR != nullptr) {
+    std::string ros_home = std::string(TEST_TMPDIR) + "/.ros";
+    setenv("ROS_HOME", ros_home.c_str(), 1);
+    ros2::isolate_rmw_by_path(argv[0], TEST_TMPDIR);
+  }
+
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
+#endif
@@ -0,0 +1,163 @@
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include <drake/systems/framework/diagram_builder.h>
+#include <drake/systems/primitives/constant_vector_source.h>
+#include <drake/systems/primitives/integrator.h>
+#include <gtest/gtest.h>
+#include <rclcpp/rclcpp.hpp>
+#include <std_msgs/msg/float64_multi_array.hpp>
+#include <std_msgs/msg/u_int32.hpp>
+#include <std_msgs/msg/u_int32_multi_array.hpp>
+
+#include "drake_ros/core/drake_ros.h"
+#include "drake_ros/core/ros_interface_system.h"
+#include "drake_ros/core/simulation_server.h"
+
+using drake_ros::core::DrakeRos;
+using drake_ros::core::RosInterfaceSystem;
+using drake_ros::core::SimulationServer;
+using drake_ros::core::SimulationServerParams;
+
+TEST(SimulationServer, step_and_reset) {
+  drake_ros::core::init(0, nullptr);
+
+  drake::systems::DiagramBuilder<double> builder;
+  auto ros_interface_system = builder.AddSystem<RosInterfaceSystem>(
+      std::make_unique<DrakeRos>("simulation_server"));
+  auto source =
+      builder.AddSystem<drake::systems::ConstantVectorSource<double>>(1.0);
+  auto integrator = builder.AddSystem<drake::systems::Integrator<double>>(1);
+  builder.Connect(source->get_output_port(), integrator->get_input_port());
+  builder.ExportOutput(integrator->get_output_port(), "x");
+
+  DrakeRos* ros = ros_interface_system->get_ros_interface();
+  SimulationServerParams params;
+  params.observation_port_names = {"x"};
+  params.time_step = 0.01;
+  SimulationServer server(builder.Build(), ros, params);
+
+  // Serve requests made directly.
+  server.Step(10);
+  std_msgs::msg::Float64MultiArray observation = server.CalcObservation(7);
+  ASSERT_EQ(observation.layout.dim.size(), 3u);
+  EXPECT_EQ(observation.layout.dim[0].label, "sequence");
+  EXPECT_EQ(observation.layout.dim[1].label, "time");
+  EXPECT_EQ(observation.layout.dim[2].label, "x");
+  EXPECT_EQ(observation.layout.dim[2].size, 1u);
+  ASSERT_EQ(observation.data.size(), 3u);
+  EXPECT_EQ(observation.data[0], 7.0);
+  EXPECT_NEAR(observation.data[1], 0.1, 1e-9);
+  EXPECT_NEAR(observation.data[2], 0.1, 1e-9);
+
+  server.Reset();
+  observation = server.CalcObservation();
+  EXPECT_EQ(observation.data[0], 0.0);
+  EXPECT_EQ(observation.data[1], 0.0);
+  EXPECT_EQ(observation.data[2], 0.0);
+
+  // Serve requests made over ROS.
+  auto client_node = rclcpp::Node::make_shared("simulation_client");
+  auto qos = rclcpp::QoS(10).reliable();
+  std_msgs::msg::Float64MultiArray::SharedPtr last_observation;
+  int num_observations = 0;
+  auto observation_sub =
+      client_node->create_subscription<std_msgs::msg::Float64MultiArray>(
+          "/simulation_server/observation", qos,
+          [&](std_msgs::msg::Float64MultiArray::SharedPtr msg) {
+            last_observation = msg;
+            ++num_observations;
+          });
+  auto step_pub =
+      client_node->create_publisher<std_msgs::msg::UInt32MultiArray>(
+          "/simulation_server/step", qos);
+  auto reset_pub = client_node->create_publisher<std_msgs::msg::UInt32>(
+      "/simulation_server/reset", qos);
+
+  auto wait_for_observations = [&](int count) {
+    constexpr int kMaxIterations = 200;
+    for (int i = 0; i < kMaxIterations && num_observations < count; ++i) {
+      server.HandleRequests(10);
+      rclcpp::spin_some(client_node);
+    }
+    return num_observations >= count;
+  };
+
+  // Wait for discovery before sending requests.
+  constexpr int kMaxDiscoveryIterations = 200;
+  for (int i = 0; i < kMaxDiscoveryIterations &&
+                  (step_pub->get_subscription_count() == 0 ||
+                   reset_pub->get_subscription_count() == 0 ||
+                   observation_sub->get_publisher_count() == 0);
+       ++i) {
+    server.HandleRequests(10);
+  }
+
+  // Replies carry the sequence number of the request they answer.
+  std_msgs::msg::UInt32MultiArray step_request;
+  step_request.data = {1u, 25u};
+  step_pub->publish(step_request);
+  ASSERT_TRUE(wait_for_observations(1));
+  ASSERT_EQ(last_observation->data.size(), 3u);
+  EXPECT_EQ(last_observation->data[0], 1.0);
+  EXPECT_NEAR(last_observation->data[1], 0.25, 1e-9);
+  EXPECT_NEAR(last_observation->data[2], 0.25, 1e-9);
+
+  // A request for zero steps only reports an observation.
+  step_request.data = {2u, 0u};
+  step_pub->publish(step_request);
+  ASSERT_TRUE(wait_for_observations(2));
+  EXPECT_EQ(last_observation->data[0], 2.0);
+  EXPECT_NEAR(last_observation->data[1], 0.25, 1e-9);
+
+  // Malformed step requests are ignored.
+  step_request.data = {3u};
+  step_pub->publish(step_request);
+
+  std_msgs::msg::UInt32 reset_request;
+  reset_request.data = 4u;
+  reset_pub->publish(reset_request);
+  ASSERT_TRUE(wait_for_observations(3));
+  EXPECT_EQ(last_observation->data[0], 4.0);
+  EXPECT_EQ(last_observation->data[1], 0.0);
+  EXPECT_EQ(last_observation->data[2], 0.0);
+  EXPECT_EQ(num_observations, 3);
+
+  drake_ros::core::shutdown();
+}
+
+TEST(SimulationServer, invalid_params) {
+  drake_ros::core::init(0, nullptr);
+
+  drake::systems::DiagramBuilder<double> builder;
+  auto ros_interface_system = builder.AddSystem<RosInterfaceSystem>(
+      std::make_unique<DrakeRos>("simulation_server"));
+  builder.AddSystem<drake::systems::ConstantVectorSource<double>>(1.0);
+  DrakeRos* ros = ros_interface_system->get_ros_interface();
+
+  SimulationServerParams params;
+  params.time_step = 0.0;
+  EXPECT_THROW(SimulationServer(builder.Build(), ros, params),
+               std::invalid_argument);
+
+  drake_ros::core::shutdown();
+}
+
+// Only available in Bazel.
+#ifndef _TEST_DISABLE_RMW_ISOLATION
+#include "rmw_isolation/rmw_isolation.h"
+
+int main(int argc, char* argv[]) {
+  const char* TEST_TMPDIR = std::getenv("TEST_TMPDIR");
+  if (TEST_TMPDIR != nullptr) {
+    std::string ros_home = std::string(TEST_TMPDIR) + "/.ros";
+    setenv("ROS_HOME", ros_home.c_str(), 1);
+    ros2::isolate_rmw_by_path(argv[0], TEST_TMPDIR);
+  }
+
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
+#endif
@@ -66,6 +66,10 @@ class PySerializer(SerializerInterface):
     def GetTypeSupport(self):
         return self._message_type._TYPE_SUPPORT
 
+    def GetTypeName(self):
+        package_name = self._message_type.__module__.split('.')[0]
+        return f'{package_name}/msg/{self._message_type.__name__}'
+
     def CreateDefaultValue(self):
         return AbstractValue.Make(self._message_type())
 
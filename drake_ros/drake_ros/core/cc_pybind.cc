@@ -1,4 +1,5 @@
 #include <memory>
+#include <string>
 #include <unordered_set>
 
 #include <drake/systems/framework/leaf_system.h>
@@ -49,6 +50,10 @@ class PySerializerInterface : public SerializerInterface {
     return static_cast<rosidl_message_type_support_t*>(overload());
   }
 
+  std::string GetTypeName() const override {
+    PYBIND11_OVERLOAD(std::string, SerializerInterface, GetTypeName);
+  }
+
   std::unique_ptr<drake::AbstractValue> CreateDefaultValue() const override {
     // Our required unique_ptr return type cannot be directly fulfilled by a
     // Python override, so we only ask the Python override for a py::object and
@@ -231,6 +236,7 @@ void DefCore(py::module m) {
            [](const SerializerInterface& self) {
              return py::capsule(self.GetTypeSupport());
            })
+      .def("GetTypeName", &SerializerInterface::GetTypeName)
       .def("Serialize",
            [](const SerializerInterface& self,
               const drake::AbstractValue& abstract_value) {
@@ -1,16 +1,28 @@
 DRAKE_ROS_REQUIRED_PACKAGES = [
+    "ament_index_cpp",
     "geometry_msgs",
+    "nav_msgs",
     "rclpy",
     "rclcpp",
     "rosidl_runtime_c",
     "rosidl_typesupport_cpp",
+    "sensor_msgs",
+    "std_msgs",
     "tf2_eigen",
     "tf2_ros",
     "visualization_msgs",
     "rmw_cyclonedds_cpp",
 ]
 
+# Only needed by optional targets, e.g. //core:bag_recorder.
+DRAKE_ROS_OPTIONAL_PACKAGES = [
+    "rosbag2_compression",
+    "rosbag2_cpp",
+    "rosbag2_storage",
+]
+
 DRAKE_ROS_TEST_DEPENDENCIES = [
+    "rosbag2_storage_default_plugins",
     "test_msgs",
     "tf2_ros_py",
 ]
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <drake/common/parallelism.h>
+
+namespace drake_ros {
+namespace scene {
+namespace internal {
+
+/* Calls `func` for each index in [0, `num_items`), using as many threads
+  as `parallelism` allows. Items are handed out to threads one at a time.
+  If any call throws, the first exception is rethrown once all threads
+  are done.
+  @param[in] num_items number of items to process.
+  @param[in] parallelism how many threads to use, at most.
+  @param[in] func function to call with each item index.
+ */
+inline void ParallelFor(int num_items, drake::Parallelism parallelism,
+                        const std::function<void(int)>& func) {
+  const int num_threads = std::min(parallelism.num_threads(), num_items);
+  if (num_threads <= 1) {
+    for (int i = 0; i < num_items; ++i) {
+      func(i);
+    }
+    return;
+  }
+  std::atomic<int> next_item{0};
+  std::mutex mutex;
+  std::exception_ptr exception;
+  auto worker = [&]() {
+    for (int i = next_item++; i < num_items; i = next_item++) {
+      try {
+        func(i);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!exception) {
+          exception = std::current_exception();
+        }
+        // Stop handing out items.
+        next_item = num_items;
+      }
+    }
+  };
+  std::vector<std::thread> threads;
+  threads.reserve(num_threads - 1);
+  for (int i = 1; i < num_threads; ++i) {
+    threads.emplace_back(worker);
+  }
+  // Work on this thread too.
+  worker();
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  if (exception) {
+    std::rethrow_exception(exception);
+  }
+}
+
+/* Calls `func` for each index in [0, `num_items`) like ParallelFor(), but
+  calls it for index 0 on this thread before any other thread starts.
+
+  This is how scene systems query a shared QueryObject from many threads,
+  as SceneGraph offers no other way to query the same Context concurrently.
+  The first query brings every SceneGraph cache entry that queries depend
+  on up to date. From then on, queries only read those cache entries and
+  the proximity engine, neither of which is modified, and thus they may run
+  concurrently.
+  @param[in] num_items number of items to process.
+  @param[in] parallelism how many threads to use, at most.
+  @param[in] func function to call with each item index. Calls must only
+    query the QueryObject and write to disjoint outputs.
+ */
+inline void WarmUpThenParallelFor(int num_items,
+                                  drake::Parallelism parallelism,
+                                  const std::function<void(int)>& func) {
+  if (num_items <= 0) {
+    return;
+  }
+  func(0);
+  ParallelFor(num_items - 1, parallelism, [&func](int i) { func(i + 1); });
+}
+
+}  // namespace internal
+}  // namespace scene
+}  // namespace drake_ros
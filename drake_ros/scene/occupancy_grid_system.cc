@@ -0,0 +1,394 @@
+#include "drake_ros/scene/occupancy_grid_system.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <builtin_interfaces/msg/time.hpp>
+#include <drake/geometry/geometry_roles.h>
+#include <drake/geometry/geometry_version.h>
+#include <drake/geometry/proximity/polygon_surface_mesh.h>
+#include <drake/geometry/query_object.h>
+#include <drake/geometry/scene_graph_inspector.h>
+#include <drake/geometry/shape_specification.h>
+#include <drake/math/rigid_transform.h>
+#include <rclcpp/duration.hpp>
+#include <rclcpp/time.hpp>
+
+#include "internal_parallel_for.h"  // NOLINT(build/include)
+
+namespace drake_ros {
+namespace scene {
+namespace {
+// Computes the radius of a sphere, centered at the origin of a shape frame,
+// that bounds the shape. It is infinite for unbounded shapes.
+class BoundingRadiusCalculator final : public drake::geometry::ShapeReifier {
+ public:
+  double Calc(const drake::geometry::Shape& shape) {
+    shape.Reify(this);
+    return radius_;
+  }
+
+ private:
+  using ShapeReifier::ImplementGeometry;
+
+  void ImplementGeometry(const drake::geometry::Box& box, void*) override {
+    radius_ = box.size().norm() / 2.0;
+  }
+
+  void ImplementGeometry(const drake::geometry::Capsule& capsule,
+                         void*) override {
+    radius_ = capsule.radius() + capsule.length() / 2.0;
+  }
+
+  void ImplementGeometry(const drake::geometry::Convex& convex,
+                         void*) override {
+    CalcFromConvexHull(convex.GetConvexHull());
+  }
+
+  void ImplementGeometry(const drake::geometry::Cylinder& cylinder,
+                         void*) override {
+    radius_ = std::hypot(cylinder.radius(), cylinder.length() / 2.0);
+  }
+
+  void ImplementGeometry(const drake::geometry::Ellipsoid& ellipsoid,
+                         void*) override {
+    radius_ = std::max({ellipsoid.a(), ellipsoid.b(), ellipsoid.c()});
+  }
+
+  void ImplementGeometry(const drake::geometry::HalfSpace&, void*) override {
+    radius_ = std::numeric_limits<double>::infinity();
+  }
+
+  void ImplementGeometry(const drake::geometry::Mesh& mesh, void*) override {
+    CalcFromConvexHull(mesh.GetConvexHull());
+  }
+
+  void ImplementGeometry(const drake::geometry::MeshcatCone& cone,
+                         void*) override {
+    radius_ = std::hypot(cone.height(), std::max(cone.a(), cone.b()));
+  }
+
+  void ImplementGeometry(const drake::geometry::Sphere& sphere,
+                         void*) override {
+    radius_ = sphere.radius();
+  }
+
+  void CalcFromConvexHull(
+      const drake::geometry::PolygonSurfaceMesh<double>& hull) {
+    radius_ = 0.0;
+    for (int i = 0; i < hull.num_vertices(); ++i) {
+      radius_ = std::max(radius_, hull.vertex(i).norm());
+    }
+  }
+
+  double radius_{std::numeric_limits<double>::infinity()};
+};
+}  // namespace
+
+struct OccupancyGridSystem::Raster {
+  // Proximity geometry rasterized last.
+  struct Geometry {
+    drake::math::RigidTransformd X_WG;
+    double radius;
+  };
+
+  // Version of the scene rasterized last, if any.
+  std::optional<drake::geometry::GeometryVersion> version;
+  std::unordered_map<drake::geometry::GeometryId, Geometry> geometries;
+  // Cell heights, NaN if free.
+  Eigen::MatrixXd heights;
+};
+
+struct OccupancyGridSystem::Impl {
+  OccupancyGridParams params;
+  // Number of samples along the world Z axis, per cell.
+  int num_samples{0};
+  // Distance between samples along the world Z axis.
+  double sample_spacing{0.0};
+  // Distance to samples below which geometries occupy them.
+  double occupancy_threshold{0.0};
+  int num_tiles_x{0};
+  int num_tiles_y{0};
+  drake::systems::InputPortIndex graph_query_port_index;
+  drake::systems::OutputPortIndex occupancy_grid_port_index;
+  drake::systems::OutputPortIndex height_map_port_index;
+  drake::systems::CacheIndex raster_cache_index;
+  // Number of tiles rasterized so far.
+  std::atomic<int64_t> num_tiles_rasterized{0};
+
+  // Marks tiles that `geometry` may occupy as dirty. Returns false if
+  // all tiles may be occupied.
+  bool MarkTiles(const Raster::Geometry& geometry,
+                 std::vector<bool>* dirty) const {
+    if (std::isinf(geometry.radius)) {
+      return false;
+    }
+    const Eigen::Vector3d& p_WG = geometry.X_WG.translation();
+    const double reach = geometry.radius + occupancy_threshold;
+    if (p_WG.z() + reach < params.min_z || p_WG.z() - reach > params.max_z) {
+      return true;
+    }
+    const double cell_size = params.resolution;
+    const int tile_size = params.tile_size;
+    const auto cell_range = [cell_size](double lower, double upper,
+                                        int num_cells) {
+      const int first = static_cast<int>(std::floor(lower / cell_size));
+      const int last = static_cast<int>(std::floor(upper / cell_size));
+      return std::make_pair(std::max(first, 0), std::min(last, num_cells - 1));
+    };
+    const auto [first_x, last_x] =
+        cell_range(p_WG.x() - params.origin.x() - reach,
+                   p_WG.x() - params.origin.x() + reach, params.width);
+    const auto [first_y, last_y] =
+        cell_range(p_WG.y() - params.origin.y() - reach,
+                   p_WG.y() - params.origin.y() + reach, params.height);
+    if (first_x > last_x || first_y > last_y) {
+      // Out of the grid.
+      return true;
+    }
+    for (int tile_y = first_y / tile_size; tile_y <= last_y / tile_size;
+         ++tile_y) {
+      for (int tile_x = first_x / tile_size; tile_x <= last_x / tile_size;
+           ++tile_x) {
+        (*dirty)[tile_y * num_tiles_x + tile_x] = true;
+      }
+    }
+    return true;
+  }
+
+  // Rasterizes the given tile into `heights`.
+  void RasterizeTile(const drake::geometry::QueryObject<double>& query_object,
+                     int tile, Eigen::MatrixXd* heights) const {
+    const int tile_size = params.tile_size;
+    const int first_x = (tile % num_tiles_x) * tile_size;
+    const int first_y = (tile / num_tiles_x) * tile_size;
+    const int last_x = std::min(first_x + tile_size, params.width);
+    const int last_y = std::min(first_y + tile_size, params.height);
+    for (int y = first_y; y < last_y; ++y) {
+      for (int x = first_x; x < last_x; ++x) {
+        const Eigen::Vector2d p_WC =
+            params.origin +
+            params.resolution * Eigen::Vector2d(x + 0.5, y + 0.5);
+        double height = std::numeric_limits<double>::quiet_NaN();
+        // Search top-down for the highest occupied sample.
+        for (int k = num_samples - 1; k >= 0; --k) {
+          const double z = params.min_z + (k + 0.5) * sample_spacing;
+          const Eigen::Vector3d p_WQ(p_WC.x(), p_WC.y(), z);
+          if (!query_object
+                   .ComputeSignedDistanceToPoint(p_WQ, occupancy_threshold)
+                   .empty()) {
+            height = z + sample_spacing / 2.0;
+            break;
+          }
+        }
+        (*heights)(y, x) = height;
+      }
+    }
+  }
+};
+
+OccupancyGridSystem::OccupancyGridSystem(const OccupancyGridParams& params)
+    : impl_(new Impl()) {
+  if (!(params.resolution > 0.0)) {
+    throw std::invalid_argument("resolution must be positive");
+  }
+  if (params.width <= 0 || params.height <= 0) {
+    throw std::invalid_argument("width and height must be positive");
+  }
+  if (!(params.max_z > params.min_z)) {
+    throw std::invalid_argument("max_z must be greater than min_z");
+  }
+  if (params.tile_size <= 0) {
+    throw std::invalid_argument("tile_size must be positive");
+  }
+  impl_->params = params;
+  const double z_range = params.max_z - params.min_z;
+  impl_->num_samples =
+      std::max(1, static_cast<int>(std::ceil(z_range / params.resolution)));
+  impl_->sample_spacing = z_range / impl_->num_samples;
+  // Half the diagonal of the box around each sample.
+  impl_->occupancy_threshold =
+      std::sqrt(2.0 * params.resolution * params.resolution +
+                impl_->sample_spacing * impl_->sample_spacing) /
+      2.0;
+  impl_->num_tiles_x = (params.width + params.tile_size - 1) / params.tile_size;
+  impl_->num_tiles_y =
+      (params.height + params.tile_size - 1) / params.tile_size;
+
+  impl_->graph_query_port_index =
+      DeclareAbstractInputPort(
+          "graph_query", drake::Value<drake::geometry::QueryObject<double>>{})
+          .get_index();
+
+  const drake::systems::CacheEntry& raster_cache_entry = DeclareCacheEntry(
+      "raster", Raster{}, &OccupancyGridSystem::CalcRaster,
+      {input_port_ticket(impl_->graph_query_port_index)});
+  impl_->raster_cache_index = raster_cache_entry.cache_index();
+
+  impl_->occupancy_grid_port_index =
+      DeclareAbstractOutputPort("occupancy_grid",
+                                &OccupancyGridSystem::CalcOccupancyGrid,
+                                {time_ticket(), raster_cache_entry.ticket()})
+          .get_index();
+
+  impl_->height_map_port_index =
+      DeclareAbstractOutputPort("height_map",
+                                &OccupancyGridSystem::CalcHeightMap,
+                                {raster_cache_entry.ticket()})
+          .get_index();
+}
+
+OccupancyGridSystem::~OccupancyGridSystem() {}
+
+std::tuple<OccupancyGridSystem*, core::RosPublisherSystem*>
+OccupancyGridSystem::AddToBuilder(
+    drake::systems::DiagramBuilder<double>* builder, core::DrakeRos* ros,
+    const OccupancyGridParams& params, const std::string& topic_name,
+    const rclcpp::QoS& qos,
+    const std::unordered_set<drake::systems::TriggerType>& publish_triggers,
+    double publish_period) {
+  auto* grid_system = builder->AddSystem<OccupancyGridSystem>(params);
+
+  auto* pub_system = builder->AddSystem(
+      core::RosPublisherSystem::Make<nav_msgs::msg::OccupancyGrid>(
+          topic_name, qos, ros, publish_triggers, publish_period));
+
+  builder->Connect(grid_system->get_occupancy_grid_output_port(),
+                   pub_system->get_input_port());
+
+  return {grid_system, pub_system};
+}
+
+const OccupancyGridParams& OccupancyGridSystem::params() const {
+  return impl_->params;
+}
+
+int64_t OccupancyGridSystem::num_tiles_rasterized() const {
+  return impl_->num_tiles_rasterized.load();
+}
+
+const drake::systems::InputPort<double>&
+OccupancyGridSystem::get_graph_query_input_port() const {
+  return get_input_port(impl_->graph_query_port_index);
+}
+
+const drake::systems::OutputPort<double>&
+OccupancyGridSystem::get_occupancy_grid_output_port() const {
+  return get_output_port(impl_->occupancy_grid_port_index);
+}
+
+const drake::systems::OutputPort<double>&
+OccupancyGridSystem::get_height_map_output_port() const {
+  return get_output_port(impl_->height_map_port_index);
+}
+
+void OccupancyGridSystem::CalcRaster(
+    const drake::systems::Context<double>& context, Raster* raster) const {
+  const drake::geometry::QueryObject<double>& query_object =
+      get_graph_query_input_port().Eval<drake::geometry::QueryObject<double>>(
+          context);
+  const drake::geometry::SceneGraphInspector<double>& inspector =
+      query_object.inspector();
+  const OccupancyGridParams& params = impl_->params;
+
+  // N.B. The raster carries what it was computed from, so it can be
+  // updated incrementally if it is a previous value, and it is rasterized
+  // from scratch if it is not.
+  bool all_dirty =
+      !raster->version ||
+      !raster->version->IsSameAs(inspector.geometry_version(),
+                                 drake::geometry::Role::kProximity) ||
+      raster->heights.rows() != params.height ||
+      raster->heights.cols() != params.width;
+  std::vector<bool> dirty(impl_->num_tiles_x * impl_->num_tiles_y, false);
+  std::unordered_map<drake::geometry::GeometryId, Raster::Geometry> geometries;
+  // N.B. Poses are evaluated here, once, to find dirty tiles.
+  for (const drake::geometry::GeometryId& geometry_id :
+       inspector.GetAllGeometryIds()) {
+    if (inspector.GetProximityProperties(geometry_id) == nullptr) {
+      continue;
+    }
+    Raster::Geometry geometry{query_object.GetPoseInWorld(geometry_id), 0.0};
+    auto it = raster->geometries.find(geometry_id);
+    if (!all_dirty && it != raster->geometries.end()) {
+      geometry.radius = it->second.radius;
+      if (!geometry.X_WG.IsExactlyEqualTo(it->second.X_WG)) {
+        // Tiles at both the former and the current pose are affected.
+        all_dirty = !impl_->MarkTiles(it->second, &dirty) ||
+                    !impl_->MarkTiles(geometry, &dirty);
+      }
+    } else {
+      geometry.radius = BoundingRadiusCalculator().Calc(
+          inspector.GetShape(geometry_id));
+    }
+    geometries.emplace(geometry_id, geometry);
+  }
+
+  std::vector<int> tiles;
+  for (int tile = 0; tile < static_cast<int>(dirty.size()); ++tile) {
+    if (all_dirty || dirty[tile]) {
+      tiles.push_back(tile);
+    }
+  }
+  if (all_dirty) {
+    raster->heights.resize(params.height, params.width);
+  }
+  Eigen::MatrixXd* heights = &raster->heights;
+  // N.B. Threads share the QueryObject, see WarmUpThenParallelFor().
+  internal::WarmUpThenParallelFor(
+      static_cast<int>(tiles.size()), params.parallelism,
+      [this, &query_object, &tiles, heights](int i) {
+        impl_->RasterizeTile(query_object, tiles[i], heights);
+      });
+  impl_->num_tiles_rasterized += static_cast<int64_t>(tiles.size());
+  raster->version = inspector.geometry_version();
+  raster->geometries = std::move(geometries);
+}
+
+void OccupancyGridSystem::CalcOccupancyGrid(
+    const drake::systems::Context<double>& context,
+    nav_msgs::msg::OccupancyGrid* output_value) const {
+  const Raster& raster =
+      get_cache_entry(impl_->raster_cache_index).Eval<Raster>(context);
+  const OccupancyGridParams& params = impl_->params;
+
+  const builtin_interfaces::msg::Time stamp =
+      rclcpp::Time() + rclcpp::Duration::from_seconds(context.get_time());
+  output_value->header.stamp = stamp;
+  output_value->header.frame_id = params.frame_id;
+  output_value->info.map_load_time = stamp;
+  output_value->info.resolution = static_cast<float>(params.resolution);
+  output_value->info.width = static_cast<uint32_t>(params.width);
+  output_value->info.height = static_cast<uint32_t>(params.height);
+  output_value->info.origin.position.x = params.origin.x();
+  output_value->info.origin.position.y = params.origin.y();
+  output_value->info.origin.position.z = params.min_z;
+  output_value->info.origin.orientation.w = 1.0;
+  output_value->data.resize(params.width * params.height);
+  for (int y = 0; y < params.height; ++y) {
+    for (int x = 0; x < params.width; ++x) {
+      output_value->data[y * params.width + x] =
+          std::isnan(raster.heights(y, x)) ? 0 : 100;
+    }
+  }
+}
+
+void OccupancyGridSystem::CalcHeightMap(
+    const drake::systems::Context<double>& context,
+    Eigen::MatrixXd* output_value) const {
+  *output_value =
+      get_cache_entry(impl_->raster_cache_index).Eval<Raster>(context).heights;
+}
+}  // namespace scene
+}  // namespace drake_ros
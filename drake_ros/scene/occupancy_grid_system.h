@@ -0,0 +1,140 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <unordered_set>
+
+#include <Eigen/Core>
+#include <drake/common/parallelism.h>
+#include <drake/systems/framework/diagram_builder.h>
+#include <drake/systems/framework/leaf_system.h>
+#include <drake_ros/core/drake_ros.h>
+#include <drake_ros/core/ros_publisher_system.h>
+#include <nav_msgs/msg/occupancy_grid.hpp>
+#include <rclcpp/qos.hpp>
+
+namespace drake_ros {
+namespace scene {
+
+/** Set of parameters that configure an OccupancyGridSystem. */
+struct OccupancyGridParams {
+  /** Frame ID of the grid, which must match the world frame. */
+  std::string frame_id{"world"};
+
+  /** Side length of each (square) grid cell, in meters. */
+  double resolution{0.05};
+
+  /** Number of grid cells along the world X axis. */
+  int width{200};
+
+  /** Number of grid cells along the world Y axis. */
+  int height{200};
+
+  /** Position of the outer corner of the first grid cell on the world XY
+   plane, in meters. */
+  Eigen::Vector2d origin{-5.0, -5.0};
+
+  /** Lower bound of the world Z range to rasterize, in meters. */
+  double min_z{0.0};
+
+  /** Upper bound of the world Z range to rasterize, in meters. */
+  double max_z{2.0};
+
+  /** Side length of each (square) grid tile, in cells. Tiles are the unit
+   of work for parallelization and incremental updates. */
+  int tile_size{16};
+
+  /** How many threads to rasterize grid tiles with. Threads share the
+   QueryObject, see OccupancyGridSystem documentation for details. */
+  drake::Parallelism parallelism{drake::Parallelism::None()};
+};
+
+/** System for SceneGraph rasterization as an occupancy grid and height map.
+
+ This system samples the world Z range above each grid cell, top-down, and
+ deems the cell occupied if any proximity geometry lies within half a cell
+ diagonal of any sample, using signed distance queries. This errs on the side
+ of occupancy. The height of a cell is that of the top of its highest
+ occupied sample.
+
+ Grids are rasterized per tile. Only tiles that may be affected by a change
+ in geometry poses since the last evaluation are rasterized again, unless
+ proximity geometries are added, removed or modified, in which case all
+ tiles are. Supported shapes are those of
+ QueryObject::ComputeSignedDistanceToPoint().
+
+ Tiles may be rasterized in parallel. Threads then share the QueryObject,
+ as SceneGraph offers no other way to query the same Context concurrently,
+ and the first tile is always rasterized alone so that every SceneGraph
+ cache entry is up to date before other threads only read them.
+
+ It has one input port:
+ - *graph_query* (abstract): expects a QueryObject from the SceneGraph.
+
+ It has two output ports:
+ - *occupancy_grid* (abstract): occupied cells, as a
+   nav_msgs::msg::OccupancyGrid message timestamped with Context time.
+   Occupied cells are 100, free cells are 0.
+ - *height_map* (abstract): cell heights w.r.t. the world frame, as an
+   Eigen::MatrixXd with one row per cell along the Y axis and one column per
+   cell along the X axis. Free cells are NaN.
+ */
+class OccupancyGridSystem : public drake::systems::LeafSystem<double> {
+ public:
+  /** A constructor for the occupancy grid system.
+   @throws std::invalid_argument if `params` are not valid.
+   */
+  explicit OccupancyGridSystem(const OccupancyGridParams& params = {});
+
+  ~OccupancyGridSystem() override;
+
+  /** Add an OccupancyGridSystem and a RosPublisherSystem to a diagram
+   builder.
+
+   This adds both an OccupancyGridSystem and a RosPublisherSystem that
+   publishes the occupancy grid to a `/map` topic. The graph query input
+   port must still be connected.
+   */
+  static std::tuple<OccupancyGridSystem*, core::RosPublisherSystem*>
+  AddToBuilder(
+      drake::systems::DiagramBuilder<double>* builder, core::DrakeRos* ros,
+      const OccupancyGridParams& params = {},
+      const std::string& topic_name = "/map",
+      const rclcpp::QoS& qos = rclcpp::QoS(1).transient_local().reliable(),
+      const std::unordered_set<drake::systems::TriggerType>& publish_triggers =
+          core::RosPublisherSystem::kDefaultTriggerTypes,
+      double publish_period = 0.0);
+
+  const OccupancyGridParams& params() const;
+
+  /** Returns the number of tiles rasterized so far, across all contexts.
+   Useful to diagnose how incremental updates are. */
+  int64_t num_tiles_rasterized() const;
+
+  const drake::systems::InputPort<double>& get_graph_query_input_port() const;
+
+  const drake::systems::OutputPort<double>& get_occupancy_grid_output_port()
+      const;
+
+  const drake::systems::OutputPort<double>& get_height_map_output_port() const;
+
+ private:
+  struct Raster;
+
+  // Rasterizes (dirty) grid tiles.
+  void CalcRaster(const drake::systems::Context<double>& context,
+                  Raster* raster) const;
+
+  void CalcOccupancyGrid(const drake::systems::Context<double>& context,
+                         nav_msgs::msg::OccupancyGrid* output_value) const;
+
+  void CalcHeightMap(const drake::systems::Context<double>& context,
+                     Eigen::MatrixXd* output_value) const;
+
+  struct Impl;
+  std::unique_ptr<Impl> impl_;
+};
+}  // namespace scene
+}  // namespace drake_ros
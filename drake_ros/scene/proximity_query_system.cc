@@ -0,0 +1,336 @@
+#include "drake_ros/scene/proximity_query_system.h"
+
+#include <atomic>
+#include <cstdint>
+#include <optional>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <drake/geometry/geometry_roles.h>
+#include <drake/geometry/geometry_version.h>
+#include <drake/geometry/query_object.h>
+#include <drake/geometry/scene_graph_inspector.h>
+#include <drake/math/rigid_transform.h>
+#include <rclcpp/logger.hpp>
+#include <rclcpp/logging.hpp>
+#include <std_msgs/msg/multi_array_dimension.hpp>
+
+#include "internal_parallel_for.h"  // NOLINT(build/include)
+
+namespace drake_ros {
+namespace scene {
+namespace {
+using GeometryPair = drake::SortedPair<drake::geometry::GeometryId>;
+using GeometryPoses = std::unordered_map<drake::geometry::GeometryId,
+                                         drake::math::RigidTransformd>;
+
+// Returns whether `geometry_id` has the same pose in both pose maps.
+bool HasSamePose(const GeometryPoses& poses, const GeometryPoses& other_poses,
+                 drake::geometry::GeometryId geometry_id) {
+  auto it = other_poses.find(geometry_id);
+  return it != other_poses.end() &&
+         it->second.IsExactlyEqualTo(poses.at(geometry_id));
+}
+
+// Returns a multi-array dimension.
+std_msgs::msg::MultiArrayDimension MakeDimension(const std::string& label,
+                                                 size_t size, size_t stride) {
+  std_msgs::msg::MultiArrayDimension dimension;
+  dimension.label = label;
+  dimension.size = static_cast<uint32_t>(size);
+  dimension.stride = static_cast<uint32_t>(stride);
+  return dimension;
+}
+
+// Column groups of signed distance rows.
+constexpr char kSignedDistanceColumns[] =
+    "id_A,id_B,distance,p_WCa[3],p_WCb[3],nhat_BA_W[3]";
+constexpr size_t kNumSignedDistanceColumns = 12;
+// Column groups of collision candidate rows.
+constexpr char kCollisionCandidateColumns[] = "id_A,id_B";
+constexpr size_t kNumCollisionCandidateColumns = 2;
+}  // namespace
+
+struct ProximityQuerySystem::Results {
+  // Version of the scene queried last, if any.
+  std::optional<drake::geometry::GeometryVersion> version;
+  // Poses of all queried geometries.
+  GeometryPoses poses;
+  // Queried pairs, or candidate pairs found.
+  std::vector<GeometryPair> pairs;
+  // Signed distances, one per queried pair, if applicable.
+  std::vector<drake::geometry::SignedDistancePair<double>> distances;
+};
+
+struct ProximityQuerySystem::Impl {
+  ProximityQueryParams params;
+  drake::systems::InputPortIndex graph_query_port_index;
+  drake::systems::OutputPortIndex signed_distances_port_index;
+  drake::systems::OutputPortIndex proximity_port_index;
+  drake::systems::CacheIndex results_cache_index;
+  // Number of signed distances computed so far.
+  std::atomic<int64_t> num_signed_distances_computed{0};
+};
+
+ProximityQuerySystem::ProximityQuerySystem(const ProximityQueryParams& params)
+    : impl_(new Impl()) {
+  impl_->params = params;
+
+  impl_->graph_query_port_index =
+      DeclareAbstractInputPort(
+          "graph_query", drake::Value<drake::geometry::QueryObject<double>>{})
+          .get_index();
+
+  const drake::systems::CacheEntry& results_cache_entry = DeclareCacheEntry(
+      "results", Results{}, &ProximityQuerySystem::CalcResults,
+      {input_port_ticket(impl_->graph_query_port_index)});
+  impl_->results_cache_index = results_cache_entry.cache_index();
+
+  impl_->signed_distances_port_index =
+      DeclareAbstractOutputPort("signed_distances",
+                                &ProximityQuerySystem::CalcSignedDistances,
+                                {results_cache_entry.ticket()})
+          .get_index();
+
+  impl_->proximity_port_index =
+      DeclareAbstractOutputPort("proximity",
+                                &ProximityQuerySystem::CalcProximity,
+                                {results_cache_entry.ticket()})
+          .get_index();
+}
+
+ProximityQuerySystem::~ProximityQuerySystem() {}
+
+std::tuple<ProximityQuerySystem*, core::RosPublisherSystem*>
+ProximityQuerySystem::AddToBuilder(
+    drake::systems::DiagramBuilder<double>* builder, core::DrakeRos* ros,
+    const ProximityQueryParams& params, const std::string& topic_name,
+    const rclcpp::QoS& qos,
+    const std::unordered_set<drake::systems::TriggerType>& publish_triggers,
+    double publish_period) {
+  auto* query_system = builder->AddSystem<ProximityQuerySystem>(params);
+
+  auto* pub_system = builder->AddSystem(
+      core::RosPublisherSystem::Make<std_msgs::msg::Float64MultiArray>(
+          topic_name, qos, ros, publish_triggers, publish_period));
+
+  builder->Connect(query_system->get_proximity_output_port(),
+                   pub_system->get_input_port());
+
+  return {query_system, pub_system};
+}
+
+const ProximityQueryParams& ProximityQuerySystem::params() const {
+  return impl_->params;
+}
+
+int64_t ProximityQuerySystem::num_signed_distances_computed() const {
+  return impl_->num_signed_distances_computed.load();
+}
+
+const drake::systems::InputPort<double>&
+ProximityQuerySystem::get_graph_query_input_port() const {
+  return get_input_port(impl_->graph_query_port_index);
+}
+
+const drake::systems::OutputPort<double>&
+ProximityQuerySystem::get_signed_distances_output_port() const {
+  return get_output_port(impl_->signed_distances_port_index);
+}
+
+const drake::systems::OutputPort<double>&
+ProximityQuerySystem::get_proximity_output_port() const {
+  return get_output_port(impl_->proximity_port_index);
+}
+
+void ProximityQuerySystem::CalcResults(
+    const drake::systems::Context<double>& context, Results* results) const {
+  const drake::geometry::QueryObject<double>& query_object =
+      get_graph_query_input_port().Eval<drake::geometry::QueryObject<double>>(
+          context);
+  const drake::geometry::SceneGraphInspector<double>& inspector =
+      query_object.inspector();
+  const ProximityQueryParams& params = impl_->params;
+
+  // N.B. Results carry what they were computed from, so they can be reused
+  // if they are previous values, and they are computed from scratch if they
+  // are not.
+  const bool same_version =
+      results->version &&
+      results->version->IsSameAs(inspector.geometry_version(),
+                                 drake::geometry::Role::kProximity);
+
+  std::vector<GeometryPair> pairs;
+  if (params.query_type == ProximityQueryType::kSignedDistance) {
+    if (!params.geometry_pairs.empty()) {
+      pairs = params.geometry_pairs;
+    } else if (same_version) {
+      pairs = results->pairs;
+    } else {
+      const std::set<GeometryPair> candidates =
+          inspector.GetCollisionCandidates();
+      pairs.assign(candidates.begin(), candidates.end());
+    }
+  }
+
+  // N.B. Poses are evaluated here, once, to find what moved.
+  GeometryPoses poses;
+  bool any_moved = !same_version;
+  if (params.query_type == ProximityQueryType::kSignedDistance) {
+    for (const GeometryPair& pair : pairs) {
+      for (drake::geometry::GeometryId geometry_id :
+           {pair.first(), pair.second()}) {
+        if (poses.count(geometry_id) == 0) {
+          poses.emplace(geometry_id,
+                        query_object.GetPoseInWorld(geometry_id));
+        }
+      }
+    }
+  } else {
+    for (const drake::geometry::GeometryId& geometry_id :
+         inspector.GetAllGeometryIds()) {
+      if (inspector.GetProximityProperties(geometry_id) == nullptr) {
+        continue;
+      }
+      const drake::math::RigidTransformd& X_WG =
+          query_object.GetPoseInWorld(geometry_id);
+      poses.emplace(geometry_id, X_WG);
+      any_moved =
+          any_moved || !HasSamePose(poses, results->poses, geometry_id);
+    }
+  }
+
+  if (params.query_type == ProximityQueryType::kCollisionCandidates) {
+    if (any_moved) {
+      results->pairs = query_object.FindCollisionCandidates();
+    }
+    results->distances.clear();
+  } else {
+    // Reuse distances for pairs that did not move, if any.
+    std::unordered_map<GeometryPair,
+                       const drake::geometry::SignedDistancePair<double>*>
+        previous_distances;
+    if (same_version) {
+      for (const auto& distance : results->distances) {
+        previous_distances.emplace(GeometryPair(distance.id_A, distance.id_B),
+                                   &distance);
+      }
+    }
+    std::vector<drake::geometry::SignedDistancePair<double>> distances(
+        pairs.size());
+    std::vector<int> pending;
+    for (int i = 0; i < static_cast<int>(pairs.size()); ++i) {
+      auto it = previous_distances.find(pairs[i]);
+      if (it != previous_distances.end() &&
+          HasSamePose(poses, results->poses, pairs[i].first()) &&
+          HasSamePose(poses, results->poses, pairs[i].second())) {
+        distances[i] = *it->second;
+      } else {
+        pending.push_back(i);
+      }
+    }
+    // N.B. Only pairs from all those not filtered out may be skipped.
+    const bool skip_unsupported = params.geometry_pairs.empty();
+    std::vector<uint8_t> unsupported(pairs.size(), 0);
+    auto compute = [&query_object, &pairs, &pending, &distances, &unsupported,
+                    skip_unsupported](int j) {
+      const GeometryPair& pair = pairs[pending[j]];
+      try {
+        distances[pending[j]] =
+            query_object.ComputeSignedDistancePairClosestPoints(
+                pair.first(), pair.second());
+      } catch (const std::logic_error&) {
+        // Drake throws std::logic_error for unsupported shape pairs.
+        if (!skip_unsupported) {
+          throw;
+        }
+        unsupported[pending[j]] = 1;
+      }
+    };
+    // N.B. Threads share the QueryObject, see WarmUpThenParallelFor().
+    internal::WarmUpThenParallelFor(static_cast<int>(pending.size()),
+                                    params.parallelism, compute);
+    // Drop unsupported pairs. These are only ever found when the scene
+    // changes, as results from then on only hold supported pairs.
+    size_t num_supported = 0;
+    for (size_t i = 0; i < pairs.size(); ++i) {
+      if (!unsupported[i]) {
+        pairs[num_supported] = pairs[i];
+        distances[num_supported] = std::move(distances[i]);
+        ++num_supported;
+      }
+    }
+    if (num_supported < pairs.size()) {
+      RCLCPP_WARN(rclcpp::get_logger("drake_ros"),
+                  "Skipped %zu geometry pairs with shapes that signed "
+                  "distance queries do not support",
+                  pairs.size() - num_supported);
+      pairs.resize(num_supported);
+      distances.resize(num_supported);
+    }
+    impl_->num_signed_distances_computed +=
+        static_cast<int64_t>(pending.size());
+    results->pairs = std::move(pairs);
+    results->distances = std::move(distances);
+  }
+  results->version = inspector.geometry_version();
+  results->poses = std::move(poses);
+}
+
+void ProximityQuerySystem::CalcSignedDistances(
+    const drake::systems::Context<double>& context,
+    std::vector<drake::geometry::SignedDistancePair<double>>* output_value)
+    const {
+  *output_value = get_cache_entry(impl_->results_cache_index)
+                      .Eval<Results>(context)
+                      .distances;
+}
+
+void ProximityQuerySystem::CalcProximity(
+    const drake::systems::Context<double>& context,
+    std_msgs::msg::Float64MultiArray* output_value) const {
+  const Results& results =
+      get_cache_entry(impl_->results_cache_index).Eval<Results>(context);
+  const bool signed_distance =
+      impl_->params.query_type == ProximityQueryType::kSignedDistance;
+  const size_t num_rows = results.pairs.size();
+  const size_t num_columns = signed_distance ? kNumSignedDistanceColumns
+                                             : kNumCollisionCandidateColumns;
+  output_value->layout.dim.clear();
+  output_value->layout.dim.push_back(
+      MakeDimension("pairs", num_rows, num_rows * num_columns));
+  output_value->layout.dim.push_back(MakeDimension(
+      signed_distance ? kSignedDistanceColumns : kCollisionCandidateColumns,
+      num_columns, num_columns));
+  output_value->layout.data_offset = 0;
+  output_value->data.clear();
+  output_value->data.reserve(num_rows * num_columns);
+  if (!signed_distance) {
+    for (const GeometryPair& pair : results.pairs) {
+      output_value->data.push_back(pair.first().get_value());
+      output_value->data.push_back(pair.second().get_value());
+    }
+    return;
+  }
+  for (const auto& distance : results.distances) {
+    output_value->data.push_back(distance.id_A.get_value());
+    output_value->data.push_back(distance.id_B.get_value());
+    output_value->data.push_back(distance.distance);
+    const Eigen::Vector3d p_WCa =
+        results.poses.at(distance.id_A) * distance.p_ACa;
+    const Eigen::Vector3d p_WCb =
+        results.poses.at(distance.id_B) * distance.p_BCb;
+    for (const Eigen::Vector3d& vector : {p_WCa, p_WCb, distance.nhat_BA_W}) {
+      output_value->data.insert(output_value->data.end(), vector.data(),
+                                vector.data() + 3);
+    }
+  }
+}
+}  // namespace scene
+}  // namespace drake_ros
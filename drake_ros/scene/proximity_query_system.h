@@ -0,0 +1,143 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <unordered_set>
+#include <vector>
+
+#include <drake/common/parallelism.h>
+#include <drake/common/sorted_pair.h>
+#include <drake/geometry/geometry_ids.h>
+#include <drake/geometry/query_results/signed_distance_pair.h>
+#include <drake/systems/framework/diagram_builder.h>
+#include <drake/systems/framework/leaf_system.h>
+#include <drake_ros/core/drake_ros.h>
+#include <drake_ros/core/ros_publisher_system.h>
+#include <rclcpp/qos.hpp>
+#include <std_msgs/msg/float64_multi_array.hpp>
+
+namespace drake_ros {
+namespace scene {
+
+/** Types of proximity queries. */
+enum class ProximityQueryType {
+  /** Signed distances between pairs of geometries, along with their nearest
+   points and distance gradients. */
+  kSignedDistance,
+  /** Pairs of geometries whose bounding volumes overlap, i.e. candidates for
+   collision. */
+  kCollisionCandidates,
+};
+
+/** Set of parameters that configure a ProximityQuerySystem. */
+struct ProximityQueryParams {
+  /** Type of query to evaluate. */
+  ProximityQueryType query_type{ProximityQueryType::kSignedDistance};
+
+  /** Pairs of proximity geometries to compute signed distances for.
+   If empty, all pairs that are not filtered out are. Only applicable to
+   signed distance queries. */
+  std::vector<drake::SortedPair<drake::geometry::GeometryId>> geometry_pairs;
+
+  /** How many threads to compute signed distances with. Threads share the
+   QueryObject, see ProximityQuerySystem documentation for details. */
+  drake::Parallelism parallelism{drake::Parallelism::None()};
+};
+
+/** System for SceneGraph proximity queries on behalf of ROS applications.
+
+ This system evaluates proximity queries on a QueryObject, so that external
+ applications (e.g. motion planners) get collision margins without running
+ a geometry engine of their own.
+
+ Signed distances are computed per pair, across threads if so configured.
+ Results for pairs whose geometries have not moved since the last
+ evaluation are reused, as long as no proximity geometries have been added,
+ removed or modified. Collision candidates are only found again if any
+ geometry moved.
+
+ Threads computing signed distances share the QueryObject, as SceneGraph
+ offers no other way to query the same Context concurrently, and the first
+ signed distance is always computed alone so that every SceneGraph cache
+ entry is up to date before other threads only read them.
+
+ When querying all pairs, pairs of shapes that signed distance queries do
+ not support (e.g. a HalfSpace and a Box) are skipped, and thus absent from
+ results, and a warning is logged whenever the set of proximity geometries
+ changes and some are. Explicitly requested pairs are not skipped, and
+ queries on unsupported pairs throw.
+
+ It has one input port:
+ - *graph_query* (abstract): expects a QueryObject from the SceneGraph.
+
+ It has two output ports:
+ - *signed_distances* (abstract): signed distance query results, as a
+   std::vector<drake::geometry::SignedDistancePair<double>>. Empty for
+   collision candidate queries.
+ - *proximity* (abstract): query results, as a
+   std_msgs::msg::Float64MultiArray message with one row per geometry
+   pair. For signed distance queries, each row holds geometry A and B IDs,
+   the signed distance, the nearest points on A and on B and the distance
+   gradient w.r.t. A's position (all expressed in the world frame), in that
+   order. For collision candidate queries, each row only holds geometry A
+   and B IDs. The layout labels each dimension and column group.
+ */
+class ProximityQuerySystem : public drake::systems::LeafSystem<double> {
+ public:
+  /** A constructor for the proximity query system. */
+  explicit ProximityQuerySystem(const ProximityQueryParams& params = {});
+
+  ~ProximityQuerySystem() override;
+
+  /** Add a ProximityQuerySystem and a RosPublisherSystem to a diagram
+   builder.
+
+   This adds both a ProximityQuerySystem and a RosPublisherSystem that
+   publishes query results to a `proximity` topic, periodically by default.
+   The graph query input port must still be connected.
+   */
+  static std::tuple<ProximityQuerySystem*, core::RosPublisherSystem*>
+  AddToBuilder(
+      drake::systems::DiagramBuilder<double>* builder, core::DrakeRos* ros,
+      const ProximityQueryParams& params = {},
+      const std::string& topic_name = "proximity",
+      const rclcpp::QoS& qos = rclcpp::QoS(1),
+      const std::unordered_set<drake::systems::TriggerType>& publish_triggers =
+          {drake::systems::TriggerType::kPeriodic},
+      double publish_period = 0.1);
+
+  const ProximityQueryParams& params() const;
+
+  /** Returns the number of signed distances computed so far, across all
+   contexts. Useful to diagnose how many results are reused. */
+  int64_t num_signed_distances_computed() const;
+
+  const drake::systems::InputPort<double>& get_graph_query_input_port() const;
+
+  const drake::systems::OutputPort<double>& get_signed_distances_output_port()
+      const;
+
+  const drake::systems::OutputPort<double>& get_proximity_output_port() const;
+
+ private:
+  struct Results;
+
+  // Evaluates queries, reusing still valid results.
+  void CalcResults(const drake::systems::Context<double>& context,
+                   Results* results) const;
+
+  void CalcSignedDistances(
+      const drake::systems::Context<double>& context,
+      std::vector<drake::geometry::SignedDistancePair<double>>* output_value)
+      const;
+
+  void CalcProximity(const drake::systems::Context<double>& context,
+                     std_msgs::msg::Float64MultiArray* output_value) const;
+
+  struct Impl;
+  std::unique_ptr<Impl> impl_;
+};
+}  // namespace scene
+}  // namespace drake_ros
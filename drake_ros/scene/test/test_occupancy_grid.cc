@@ -0,0 +1,196 @@
+#include <cmath>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include <drake/common/value.h>
+#include <drake/geometry/geometry_frame.h>
+#include <drake/geometry/geometry_instance.h>
+#include <drake/geometry/geometry_roles.h>
+#include <drake/geometry/scene_graph.h>
+#include <drake/geometry/shape_specification.h>
+#include <drake/math/rigid_transform.h>
+#include <drake/systems/framework/diagram_builder.h>
+#include <gtest/gtest.h>
+#include <nav_msgs/msg/occupancy_grid.hpp>
+
+#include "drake_ros/scene/occupancy_grid_system.h"
+
+using drake_ros::scene::OccupancyGridParams;
+using drake_ros::scene::OccupancyGridSystem;
+
+namespace {
+// Returns whether the cell containing the given world XY point is occupied.
+bool IsOccupied(const nav_msgs::msg::OccupancyGrid& grid, double x,
+                double y) {
+  const int i = static_cast<int>(
+      std::floor((x - grid.info.origin.position.x) / grid.info.resolution));
+  const int j = static_cast<int>(
+      std::floor((y - grid.info.origin.position.y) / grid.info.resolution));
+  return grid.data[j * grid.info.width + i] == 100;
+}
+}  // namespace
+
+TEST(OccupancyGrid, NominalCase) {
+  drake::systems::DiagramBuilder<double> builder;
+
+  auto scene_graph = builder.AddSystem<drake::geometry::SceneGraph>();
+  const drake::geometry::SourceId source_id =
+      scene_graph->RegisterSource("test_source");
+  const drake::geometry::FrameId box_frame = scene_graph->RegisterFrame(
+      source_id, drake::geometry::GeometryFrame("box"));
+  const drake::geometry::GeometryId box_id = scene_graph->RegisterGeometry(
+      source_id, box_frame,
+      std::make_unique<drake::geometry::GeometryInstance>(
+          drake::math::RigidTransformd(), drake::geometry::Box(0.4, 0.4, 0.5),
+          "box"));
+  scene_graph->AssignRole(source_id, box_id,
+                          drake::geometry::ProximityProperties());
+
+  OccupancyGridParams params;
+  params.resolution = 0.1;
+  params.width = 40;
+  params.height = 20;
+  params.origin = Eigen::Vector2d(-2.0, -1.0);
+  params.min_z = 0.0;
+  params.max_z = 1.0;
+  params.tile_size = 8;
+  params.parallelism = drake::Parallelism(2);
+  auto grid_system = builder.AddSystem<OccupancyGridSystem>(params);
+  builder.Connect(scene_graph->get_query_output_port(),
+                  grid_system->get_graph_query_input_port());
+
+  auto diagram = builder.Build();
+  auto context = diagram->CreateDefaultContext();
+  auto& scene_graph_context =
+      scene_graph->GetMyMutableContextFromRoot(context.get());
+  const auto& grid_context = grid_system->GetMyContextFromRoot(*context);
+
+  // Rest the box on the ground, to the left.
+  scene_graph->get_source_pose_port(source_id).FixValue(
+      &scene_graph_context,
+      drake::geometry::FramePoseVector<double>{
+          {box_frame, drake::math::RigidTransformd(
+                          Eigen::Vector3d(-1.0, 0.0, 0.25))}});
+  const auto& grid =
+      grid_system->get_occupancy_grid_output_port()
+          .Eval<nav_msgs::msg::OccupancyGrid>(grid_context);
+  ASSERT_EQ(grid.info.width, 40u);
+  ASSERT_EQ(grid.info.height, 20u);
+  ASSERT_EQ(grid.data.size(), 800u);
+  EXPECT_EQ(grid.header.frame_id, "world");
+  EXPECT_TRUE(IsOccupied(grid, -1.0, 0.0));
+  EXPECT_FALSE(IsOccupied(grid, 1.0, 0.0));
+  const auto& heights = grid_system->get_height_map_output_port()
+                            .Eval<Eigen::MatrixXd>(grid_context);
+  ASSERT_EQ(heights.rows(), 20);
+  ASSERT_EQ(heights.cols(), 40);
+  // Box top at 0.5m, up to sampling resolution.
+  EXPECT_NEAR(heights(10, 10), 0.5, 0.15);
+  EXPECT_TRUE(std::isnan(heights(10, 30)));
+
+  // Move the box to the right.
+  scene_graph->get_source_pose_port(source_id).FixValue(
+      &scene_graph_context,
+      drake::geometry::FramePoseVector<double>{
+          {box_frame,
+           drake::math::RigidTransformd(Eigen::Vector3d(1.0, 0.0, 0.25))}});
+  const auto& moved_grid =
+      grid_system->get_occupancy_grid_output_port()
+          .Eval<nav_msgs::msg::OccupancyGrid>(grid_context);
+  EXPECT_FALSE(IsOccupied(moved_grid, -1.0, 0.0));
+  EXPECT_TRUE(IsOccupied(moved_grid, 1.0, 0.0));
+  // Far away cells stay free.
+  EXPECT_FALSE(IsOccupied(moved_grid, -1.9, -0.9));
+}
+
+TEST(OccupancyGrid, IncrementalUpdates) {
+  drake::systems::DiagramBuilder<double> builder;
+
+  auto scene_graph = builder.AddSystem<drake::geometry::SceneGraph>();
+  const drake::geometry::SourceId source_id =
+      scene_graph->RegisterSource("test_source");
+  auto add_box = [&](const std::string& name) {
+    const drake::geometry::FrameId frame_id = scene_graph->RegisterFrame(
+        source_id, drake::geometry::GeometryFrame(name));
+    const drake::geometry::GeometryId geometry_id =
+        scene_graph->RegisterGeometry(
+            source_id, frame_id,
+            std::make_unique<drake::geometry::GeometryInstance>(
+                drake::math::RigidTransformd(),
+                drake::geometry::Box(0.4, 0.4, 0.5), name));
+    scene_graph->AssignRole(source_id, geometry_id,
+                            drake::geometry::ProximityProperties());
+    return frame_id;
+  };
+  const drake::geometry::FrameId moving_frame = add_box("moving_box");
+  const drake::geometry::FrameId still_frame = add_box("still_box");
+
+  // A 5x3 tile grid.
+  OccupancyGridParams params;
+  params.resolution = 0.1;
+  params.width = 40;
+  params.height = 20;
+  params.origin = Eigen::Vector2d(-2.0, -1.0);
+  params.min_z = 0.0;
+  params.max_z = 1.0;
+  params.tile_size = 8;
+  params.parallelism = drake::Parallelism(2);
+  constexpr int kNumTiles = 15;
+  auto grid_system = builder.AddSystem<OccupancyGridSystem>(params);
+  builder.Connect(scene_graph->get_query_output_port(),
+                  grid_system->get_graph_query_input_port());
+
+  auto diagram = builder.Build();
+  auto context = diagram->CreateDefaultContext();
+  auto& scene_graph_context =
+      scene_graph->GetMyMutableContextFromRoot(context.get());
+  const auto& grid_context = grid_system->GetMyContextFromRoot(*context);
+  auto set_moving_box_x = [&](double x) {
+    scene_graph->get_source_pose_port(source_id).FixValue(
+        &scene_graph_context,
+        drake::geometry::FramePoseVector<double>{
+            {moving_frame,
+             drake::math::RigidTransformd(Eigen::Vector3d(x, 0.0, 0.25))},
+            {still_frame,
+             drake::math::RigidTransformd(Eigen::Vector3d(1.5, 0.0, 0.25))}});
+  };
+  auto eval_grid = [&]() -> const nav_msgs::msg::OccupancyGrid& {
+    return grid_system->get_occupancy_grid_output_port()
+        .Eval<nav_msgs::msg::OccupancyGrid>(grid_context);
+  };
+
+  // All tiles are rasterized first.
+  set_moving_box_x(-1.0);
+  EXPECT_TRUE(IsOccupied(eval_grid(), -1.0, 0.0));
+  EXPECT_TRUE(IsOccupied(eval_grid(), 1.5, 0.0));
+  EXPECT_EQ(grid_system->num_tiles_rasterized(), kNumTiles);
+
+  // No tile is rasterized again if nothing moved.
+  set_moving_box_x(-1.0);
+  EXPECT_TRUE(IsOccupied(eval_grid(), -1.0, 0.0));
+  EXPECT_EQ(grid_system->num_tiles_rasterized(), kNumTiles);
+
+  // Only the 2x2 tiles the moving box spans, before and after moving, are
+  // rasterized again. Tiles the still box spans are reused.
+  set_moving_box_x(-1.2);
+  const nav_msgs::msg::OccupancyGrid& grid = eval_grid();
+  EXPECT_EQ(grid_system->num_tiles_rasterized(), kNumTiles + 4);
+  EXPECT_TRUE(IsOccupied(grid, -1.2, 0.0));
+  EXPECT_FALSE(IsOccupied(grid, -0.85, 0.0));
+  EXPECT_TRUE(IsOccupied(grid, 1.5, 0.0));
+  EXPECT_FALSE(IsOccupied(grid, 0.5, 0.0));
+}
+
+TEST(OccupancyGrid, InvalidParams) {
+  OccupancyGridParams params;
+  params.resolution = 0.0;
+  EXPECT_THROW(OccupancyGridSystem{params}, std::invalid_argument);
+  params = OccupancyGridParams{};
+  params.max_z = params.min_z;
+  EXPECT_THROW(OccupancyGridSystem{params}, std::invalid_argument);
+  params = OccupancyGridParams{};
+  params.tile_size = 0;
+  EXPECT_THROW(OccupancyGridSystem{params}, std::invalid_argument);
+}
@@ -0,0 +1,298 @@
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <drake/common/value.h>
+#include <drake/geometry/geometry_frame.h>
+#include <drake/geometry/geometry_instance.h>
+#include <drake/geometry/geometry_roles.h>
+#include <drake/geometry/scene_graph.h>
+#include <drake/geometry/shape_specification.h>
+#include <drake/math/rigid_transform.h>
+#include <drake/systems/framework/diagram_builder.h>
+#include <gtest/gtest.h>
+#include <std_msgs/msg/float64_multi_array.hpp>
+
+#include "drake_ros/scene/proximity_query_system.h"
+
+using drake_ros::scene::ProximityQueryParams;
+using drake_ros::scene::ProximityQuerySystem;
+using drake_ros::scene::ProximityQueryType;
+
+namespace {
+// Registers a sphere with a proximity role in a frame of its own.
+drake::geometry::FrameId AddSphere(drake::geometry::SceneGraph<double>* graph,
+                                   drake::geometry::SourceId source_id,
+                                   const std::string& name) {
+  const drake::geometry::FrameId frame_id =
+      graph->RegisterFrame(source_id, drake::geometry::GeometryFrame(name));
+  const drake::geometry::GeometryId geometry_id = graph->RegisterGeometry(
+      source_id, frame_id,
+      std::make_unique<drake::geometry::GeometryInstance>(
+          drake::math::RigidTransformd(), drake::geometry::Sphere(0.5),
+          name));
+  graph->AssignRole(source_id, geometry_id,
+                    drake::geometry::ProximityProperties());
+  return frame_id;
+}
+
+// Returns poses for two frames, along the world X axis.
+drake::geometry::FramePoseVector<double> MakePoses(
+    drake::geometry::FrameId frame_a, double x_a,
+    drake::geometry::FrameId frame_b, double x_b) {
+  return drake::geometry::FramePoseVector<double>{
+      {frame_a, drake::math::RigidTransformd(Eigen::Vector3d(x_a, 0.0, 0.0))},
+      {frame_b, drake::math::RigidTransformd(Eigen::Vector3d(x_b, 0.0, 0.0))}};
+}
+}  // namespace
+
+TEST(ProximityQuery, SignedDistance) {
+  drake::systems::DiagramBuilder<double> builder;
+
+  auto scene_graph = builder.AddSystem<drake::geometry::SceneGraph>();
+  const drake::geometry::SourceId source_id =
+      scene_graph->RegisterSource("test_source");
+  const drake::geometry::FrameId frame_a =
+      AddSphere(scene_graph, source_id, "a");
+  const drake::geometry::FrameId frame_b =
+      AddSphere(scene_graph, source_id, "b");
+
+  ProximityQueryParams params;
+  params.parallelism = drake::Parallelism(2);
+  auto query_system = builder.AddSystem<ProximityQuerySystem>(params);
+  builder.Connect(scene_graph->get_query_output_port(),
+                  query_system->get_graph_query_input_port());
+
+  auto diagram = builder.Build();
+  auto context = diagram->CreateDefaultContext();
+  auto& scene_graph_context =
+      scene_graph->GetMyMutableContextFromRoot(context.get());
+  const auto& query_context = query_system->GetMyContextFromRoot(*context);
+
+  // Place spheres 2m apart, i.e. 1m away from each other.
+  scene_graph->get_source_pose_port(source_id).FixValue(
+      &scene_graph_context, MakePoses(frame_a, 0.0, frame_b, 2.0));
+  const auto& distances =
+      query_system->get_signed_distances_output_port()
+          .Eval<std::vector<drake::geometry::SignedDistancePair<double>>>(
+              query_context);
+  ASSERT_EQ(distances.size(), 1u);
+  EXPECT_NEAR(distances[0].distance, 1.0, 1e-6);
+
+  const auto& message =
+      query_system->get_proximity_output_port()
+          .Eval<std_msgs::msg::Float64MultiArray>(query_context);
+  ASSERT_EQ(message.layout.dim.size(), 2u);
+  EXPECT_EQ(message.layout.dim[0].label, "pairs");
+  EXPECT_EQ(message.layout.dim[0].size, 1u);
+  EXPECT_EQ(message.layout.dim[1].size, 12u);
+  ASSERT_EQ(message.data.size(), 12u);
+  EXPECT_NEAR(message.data[2], 1.0, 1e-6);
+  // Nearest points lie in between spheres, in the world frame.
+  const double x_WCa = message.data[3];
+  const double x_WCb = message.data[6];
+  EXPECT_NEAR(std::min(x_WCa, x_WCb), 0.5, 1e-6);
+  EXPECT_NEAR(std::max(x_WCa, x_WCb), 1.5, 1e-6);
+
+  // Bring spheres into contact.
+  scene_graph->get_source_pose_port(source_id).FixValue(
+      &scene_graph_context, MakePoses(frame_a, 0.0, frame_b, 0.8));
+  const auto& moved_distances =
+      query_system->get_signed_distances_output_port()
+          .Eval<std::vector<drake::geometry::SignedDistancePair<double>>>(
+              query_context);
+  ASSERT_EQ(moved_distances.size(), 1u);
+  EXPECT_NEAR(moved_distances[0].distance, -0.2, 1e-6);
+}
+
+TEST(ProximityQuery, ReusedSignedDistances) {
+  drake::systems::DiagramBuilder<double> builder;
+
+  auto scene_graph = builder.AddSystem<drake::geometry::SceneGraph>();
+  const drake::geometry::SourceId source_id =
+      scene_graph->RegisterSource("test_source");
+  const drake::geometry::FrameId frame_a =
+      AddSphere(scene_graph, source_id, "a");
+  const drake::geometry::FrameId frame_b =
+      AddSphere(scene_graph, source_id, "b");
+  const drake::geometry::FrameId frame_c =
+      AddSphere(scene_graph, source_id, "c");
+
+  ProximityQueryParams params;
+  params.parallelism = drake::Parallelism(2);
+  auto query_system = builder.AddSystem<ProximityQuerySystem>(params);
+  builder.Connect(scene_graph->get_query_output_port(),
+                  query_system->get_graph_query_input_port());
+
+  auto diagram = builder.Build();
+  auto context = diagram->CreateDefaultContext();
+  auto& scene_graph_context =
+      scene_graph->GetMyMutableContextFromRoot(context.get());
+  const auto& query_context = query_system->GetMyContextFromRoot(*context);
+  auto set_poses = [&](double x_c) {
+    drake::geometry::FramePoseVector<double> poses =
+        MakePoses(frame_a, 0.0, frame_b, 2.0);
+    poses.set_value(frame_c,
+                    drake::math::RigidTransformd(Eigen::Vector3d(x_c, 0., 0.)));
+    scene_graph->get_source_pose_port(source_id).FixValue(
+        &scene_graph_context, poses);
+  };
+  // Returns the signed distance between the spheres in the given frames.
+  auto eval_distance = [&](drake::geometry::FrameId frame_1,
+                           drake::geometry::FrameId frame_2) {
+    const auto& inspector = scene_graph->model_inspector();
+    const drake::SortedPair<drake::geometry::GeometryId> pair(
+        inspector.GetGeometries(frame_1)[0],
+        inspector.GetGeometries(frame_2)[0]);
+    const auto& distances =
+        query_system->get_signed_distances_output_port()
+            .Eval<std::vector<drake::geometry::SignedDistancePair<double>>>(
+                query_context);
+    for (const auto& distance : distances) {
+      if (pair == drake::SortedPair(distance.id_A, distance.id_B)) {
+        return distance.distance;
+      }
+    }
+    ADD_FAILURE() << "pair not found";
+    return 0.0;
+  };
+
+  // All pairs are computed first.
+  set_poses(5.0);
+  EXPECT_NEAR(eval_distance(frame_a, frame_b), 1.0, 1e-6);
+  EXPECT_EQ(query_system->num_signed_distances_computed(), 3);
+
+  // No pair is computed again if nothing moved.
+  set_poses(5.0);
+  EXPECT_NEAR(eval_distance(frame_a, frame_b), 1.0, 1e-6);
+  EXPECT_EQ(query_system->num_signed_distances_computed(), 3);
+
+  // Only pairs involving the moved sphere are computed again.
+  set_poses(4.0);
+  EXPECT_NEAR(eval_distance(frame_a, frame_b), 1.0, 1e-6);
+  EXPECT_NEAR(eval_distance(frame_a, frame_c), 3.0, 1e-6);
+  EXPECT_NEAR(eval_distance(frame_b, frame_c), 1.0, 1e-6);
+  EXPECT_EQ(query_system->num_signed_distances_computed(), 5);
+}
+
+TEST(ProximityQuery, CollisionCandidates) {
+  drake::systems::DiagramBuilder<double> builder;
+
+  auto scene_graph = builder.AddSystem<drake::geometry::SceneGraph>();
+  const drake::geometry::SourceId source_id =
+      scene_graph->RegisterSource("test_source");
+  const drake::geometry::FrameId frame_a =
+      AddSphere(scene_graph, source_id, "a");
+  const drake::geometry::FrameId frame_b =
+      AddSphere(scene_graph, source_id, "b");
+
+  ProximityQueryParams params;
+  params.query_type = ProximityQueryType::kCollisionCandidates;
+  auto query_system = builder.AddSystem<ProximityQuerySystem>(params);
+  builder.Connect(scene_graph->get_query_output_port(),
+                  query_system->get_graph_query_input_port());
+
+  auto diagram = builder.Build();
+  auto context = diagram->CreateDefaultContext();
+  auto& scene_graph_context =
+      scene_graph->GetMyMutableContextFromRoot(context.get());
+  const auto& query_context = query_system->GetMyContextFromRoot(*context);
+
+  // Far apart spheres are no candidates.
+  scene_graph->get_source_pose_port(source_id).FixValue(
+      &scene_graph_context, MakePoses(frame_a, 0.0, frame_b, 5.0));
+  const auto& message =
+      query_system->get_proximity_output_port()
+          .Eval<std_msgs::msg::Float64MultiArray>(query_context);
+  ASSERT_EQ(message.layout.dim.size(), 2u);
+  EXPECT_EQ(message.layout.dim[1].size, 2u);
+  EXPECT_TRUE(message.data.empty());
+
+  // Overlapping spheres are.
+  scene_graph->get_source_pose_port(source_id).FixValue(
+      &scene_graph_context, MakePoses(frame_a, 0.0, frame_b, 0.5));
+  const auto& moved_message =
+      query_system->get_proximity_output_port()
+          .Eval<std_msgs::msg::Float64MultiArray>(query_context);
+  EXPECT_EQ(moved_message.data.size(), 2u);
+  const auto& distances =
+      query_system->get_signed_distances_output_port()
+          .Eval<std::vector<drake::geometry::SignedDistancePair<double>>>(
+              query_context);
+  EXPECT_TRUE(distances.empty());
+}
+
+TEST(ProximityQuery, UnsupportedPairs) {
+  drake::systems::DiagramBuilder<double> builder;
+
+  auto scene_graph = builder.AddSystem<drake::geometry::SceneGraph>();
+  const drake::geometry::SourceId source_id =
+      scene_graph->RegisterSource("test_source");
+  const drake::geometry::FrameId frame_a =
+      AddSphere(scene_graph, source_id, "a");
+  // Signed distances between half spaces and boxes are not supported.
+  const drake::geometry::GeometryId ground_id =
+      scene_graph->RegisterAnchoredGeometry(
+          source_id, std::make_unique<drake::geometry::GeometryInstance>(
+                         drake::math::RigidTransformd(
+                             Eigen::Vector3d(0.0, 0.0, -2.0)),
+                         drake::geometry::HalfSpace(), "ground"));
+  scene_graph->AssignRole(source_id, ground_id,
+                          drake::geometry::ProximityProperties());
+  const drake::geometry::FrameId frame_b = scene_graph->RegisterFrame(
+      source_id, drake::geometry::GeometryFrame("b"));
+  const drake::geometry::GeometryId box_id = scene_graph->RegisterGeometry(
+      source_id, frame_b,
+      std::make_unique<drake::geometry::GeometryInstance>(
+          drake::math::RigidTransformd(), drake::geometry::Box(1.0, 1.0, 1.0),
+          "box"));
+  scene_graph->AssignRole(source_id, box_id,
+                          drake::geometry::ProximityProperties());
+
+  ProximityQueryParams params;
+  params.parallelism = drake::Parallelism(2);
+  auto query_system = builder.AddSystem<ProximityQuerySystem>(params);
+  ProximityQueryParams explicit_params;
+  explicit_params.geometry_pairs = {{ground_id, box_id}};
+  auto explicit_query_system =
+      builder.AddSystem<ProximityQuerySystem>(explicit_params);
+  builder.Connect(scene_graph->get_query_output_port(),
+                  query_system->get_graph_query_input_port());
+  builder.Connect(scene_graph->get_query_output_port(),
+                  explicit_query_system->get_graph_query_input_port());
+
+  auto diagram = builder.Build();
+  auto context = diagram->CreateDefaultContext();
+  auto& scene_graph_context =
+      scene_graph->GetMyMutableContextFromRoot(context.get());
+  const auto& query_context = query_system->GetMyContextFromRoot(*context);
+  scene_graph->get_source_pose_port(source_id).FixValue(
+      &scene_graph_context, MakePoses(frame_a, 0.0, frame_b, 2.0));
+
+  // All pairs but the unsupported one are queried.
+  const auto& distances =
+      query_system->get_signed_distances_output_port()
+          .Eval<std::vector<drake::geometry::SignedDistancePair<double>>>(
+              query_context);
+  ASSERT_EQ(distances.size(), 2u);
+  for (const auto& distance : distances) {
+    EXPECT_FALSE(drake::SortedPair(distance.id_A, distance.id_B) ==
+                 drake::SortedPair(ground_id, box_id));
+  }
+  const auto& message =
+      query_system->get_proximity_output_port()
+          .Eval<std_msgs::msg::Float64MultiArray>(query_context);
+  EXPECT_EQ(message.layout.dim[0].size, 2u);
+  EXPECT_EQ(message.data.size(), 2u * 12u);
+
+  // Explicitly requested unsupported pairs are not skipped.
+  const auto& explicit_query_context =
+      explicit_query_system->GetMyContextFromRoot(*context);
+  EXPECT_THROW(
+      explicit_query_system->get_signed_distances_output_port()
+          .Eval<std::vector<drake::geometry::SignedDistancePair<double>>>(
+              explicit_query_context),
+      std::logic_error);
+}
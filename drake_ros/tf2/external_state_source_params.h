@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstddef>
+
+namespace drake_ros {
+namespace tf2 {
+
+/** Set of parameters that configure a JointStateSourceSystem or a
+ TfPoseSourceSystem. */
+struct ExternalStateSourceParams {
+  /** Delay w.r.t. the current time at which external state is sampled, in
+   seconds. Samples are interpolated, so a delay of about one message period
+   trades latency for smooth motion. If zero, the latest samples are used
+   as-is. */
+  double interpolation_delay{0.0};
+
+  /** Whether the current time is Context time, for simulations that track
+   ROS time (e.g. with a ClockSystem), or the ROS node clock time, which is
+   what live systems stamp external state with. If the latter, the clock is
+   read when samples are latched, i.e. once per step. */
+  bool use_context_time{false};
+
+  /** Maximum number of samples to buffer per joint or frame. */
+  size_t max_samples{32};
+};
+
+}  // namespace tf2
+}  // namespace drake_ros
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <stdexcept>
+#include <string>
+
+#include <drake/multibody/tree/joint.h>
+#include <drake/multibody/tree/prismatic_joint.h>
+#include <drake/multibody/tree/quaternion_floating_joint.h>
+#include <drake/multibody/tree/revolute_joint.h>
+#include <drake/multibody/tree/rpy_floating_joint.h>
+#include <drake/multibody/tree/weld_joint.h>
+
+namespace drake_ros {
+namespace tf2 {
+namespace internal {
+
+/* How a MultibodyPlant joint is exported to robot descriptions and
+ joint states. */
+enum class ExportedJointType {
+  // Exported as a fixed joint.
+  kFixed,
+  // Exported as a revolute (or continuous) joint, with a joint state.
+  kRevolute,
+  // Exported as a prismatic joint, with a joint state.
+  kPrismatic,
+  // Left out, its child body pose is broadcast as a transform instead.
+  kFloating,
+};
+
+/* Returns how `joint` is exported.
+ @throws std::runtime_error if `joint` type cannot be exported. */
+inline ExportedJointType GetExportedJointType(
+    const drake::multibody::Joint<double>& joint) {
+  const std::string& type_name = joint.type_name();
+  if (type_name == drake::multibody::WeldJoint<double>::kTypeName) {
+    return ExportedJointType::kFixed;
+  }
+  if (type_name == drake::multibody::RevoluteJoint<double>::kTypeName) {
+    return ExportedJointType::kRevolute;
+  }
+  if (type_name == drake::multibody::PrismaticJoint<double>::kTypeName) {
+    return ExportedJointType::kPrismatic;
+  }
+  if (type_name ==
+          drake::multibody::QuaternionFloatingJoint<double>::kTypeName ||
+      type_name == drake::multibody::RpyFloatingJoint<double>::kTypeName) {
+    return ExportedJointType::kFloating;
+  }
+  throw std::runtime_error("cannot export joint '" + joint.name() +
+                           "' of type '" + type_name + "'");
+}
+
+}  // namespace internal
+}  // namespace tf2
+}  // namespace drake_ros
@@ -0,0 +1,226 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <iterator>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <drake/common/drake_throw.h>
+#include <drake/math/rigid_transform.h>
+
+namespace drake_ros {
+namespace tf2 {
+namespace internal {
+
+inline double Interpolate(double a, double b, double s) {
+  return a + s * (b - a);
+}
+
+inline drake::math::RigidTransform<double> Interpolate(
+    const drake::math::RigidTransform<double>& a,
+    const drake::math::RigidTransform<double>& b, double s) {
+  return drake::math::RigidTransform<double>(
+      a.rotation().ToQuaternion().slerp(s, b.rotation().ToQuaternion()),
+      a.translation() + s * (b.translation() - a.translation()));
+}
+
+/* A bounded, time ordered buffer of timestamped samples of a value, that
+ can be sampled at any time by (linear) interpolation. */
+template <typename T>
+class SampleBuffer {
+ public:
+  explicit SampleBuffer(size_t max_size) : max_size_(max_size) {
+    DRAKE_THROW_UNLESS(max_size > 0);
+  }
+
+  bool empty() const { return samples_.empty(); }
+
+  /* Inserts a sample. Samples older than all buffered samples are dropped
+   if the buffer is full, and samples with the same timestamp as a buffered
+   one replace it. */
+  void Insert(int64_t stamp, const T& value) {
+    auto it = std::lower_bound(
+        samples_.begin(), samples_.end(), stamp,
+        [](const auto& sample, int64_t t) { return sample.first < t; });
+    if (it != samples_.end() && it->first == stamp) {
+      it->second = value;
+      return;
+    }
+    if (it == samples_.begin() && samples_.size() == max_size_) {
+      return;
+    }
+    samples_.insert(it, {stamp, value});
+    if (samples_.size() > max_size_) {
+      samples_.pop_front();
+    }
+  }
+
+  /* Returns the latest buffered value.
+   @pre buffer is not empty. */
+  const T& latest() const { return samples_.back().second; }
+
+  /* Samples the buffered value at `stamp`, interpolating between the
+   closest samples before and after it. Outside the buffered time span, the
+   closest sample is held.
+   @pre buffer is not empty. */
+  T Sample(int64_t stamp) const {
+    auto it = std::lower_bound(
+        samples_.begin(), samples_.end(), stamp,
+        [](const auto& sample, int64_t t) { return sample.first < t; });
+    if (it == samples_.begin()) {
+      return it->second;
+    }
+    if (it == samples_.end()) {
+      return samples_.back().second;
+    }
+    const auto& [stamp_before, value_before] = *std::prev(it);
+    const auto& [stamp_after, value_after] = *it;
+    const double s = static_cast<double>(stamp - stamp_before) /
+                     static_cast<double>(stamp_after - stamp_before);
+    return Interpolate(value_before, value_after, s);
+  }
+
+ private:
+  size_t max_size_;
+  std::deque<std::pair<int64_t, T>> samples_;
+};
+
+/* Sample buffers, one per joint or frame, as latched into a Context. */
+template <typename T>
+struct LatchedSamples {
+  std::vector<SampleBuffer<T>> buffers;
+  // Sequence number of the last sample latched.
+  uint64_t sequence{0};
+  // Time at which to sample buffers, if not Context time.
+  int64_t now{0};
+};
+
+/* A synchronized, bounded log of the latest samples received, for joints
+ or frames identified by slot index. Samples are tagged with monotonically
+ increasing sequence numbers, so that any number of readers (e.g. one per
+ Context) can latch the samples they have not seen yet. */
+template <typename T>
+class SampleLog {
+ public:
+  struct Sample {
+    int slot;
+    // Sample timestamp, or zero if unknown.
+    int64_t stamp;
+    T value;
+  };
+
+  explicit SampleLog(size_t max_size) : max_size_(max_size) {
+    DRAKE_THROW_UNLESS(max_size > 0);
+  }
+
+  /* Appends `samples`, dropping the oldest samples if the log is full. */
+  void Append(const std::vector<Sample>& samples) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const Sample& sample : samples) {
+      samples_.push_back(sample);
+      if (samples_.size() > max_size_) {
+        samples_.pop_front();
+      }
+    }
+    sequence_.fetch_add(samples.size(), std::memory_order_release);
+  }
+
+  /* Returns the sequence number of the latest sample, without locking. */
+  uint64_t sequence() const {
+    return sequence_.load(std::memory_order_acquire);
+  }
+
+  /* Inserts the samples `latched` has not seen yet into its buffers, and
+   updates its sequence number. Samples without timestamps are timestamped
+   at `now`. Returns false if there were no such samples. */
+  bool Latch(int64_t now, LatchedSamples<T>* latched) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const uint64_t sequence = sequence_.load(std::memory_order_relaxed);
+    if (sequence == latched->sequence) {
+      return false;
+    }
+    // N.B. Samples dropped from the log before they were latched are lost.
+    const uint64_t unseen = std::min<uint64_t>(
+        sequence - latched->sequence, samples_.size());
+    for (auto it = samples_.end() - unseen; it != samples_.end(); ++it) {
+      latched->buffers[it->slot].Insert(it->stamp != 0 ? it->stamp : now,
+                                        it->value);
+    }
+    latched->sequence = sequence;
+    return true;
+  }
+
+ private:
+  size_t max_size_;
+  // Mutex to synchronize access to samples.
+  mutable std::mutex mutex_;
+  std::deque<Sample> samples_;
+  // Number of samples appended so far.
+  std::atomic<uint64_t> sequence_{0};
+};
+
+/* Maps sequences of names in messages to slot indices. The last few name
+ sequences seen are remembered along with their mappings, so that names in
+ messages with a known layout (which publishers tend to keep) are compared
+ in order instead of being looked up. Unknown names map to -1. */
+class NameLayoutCache {
+ public:
+  explicit NameLayoutCache(std::unordered_map<std::string, int> slots)
+      : slots_(std::move(slots)) {}
+
+  /* Returns slot indices for the names of `items`, as per `get_name`. */
+  template <typename Items, typename GetName>
+  const std::vector<int>& Resolve(const Items& items, GetName get_name) {
+    for (size_t i = 0; i < layouts_.size(); ++i) {
+      Layout& layout = layouts_[(newest_ + layouts_.size() - i) %
+                                layouts_.size()];
+      if (layout.names.size() != items.size()) {
+        continue;
+      }
+      bool match = true;
+      for (size_t j = 0; match && j < items.size(); ++j) {
+        match = layout.names[j] == get_name(items[j]);
+      }
+      if (match) {
+        return layout.slots;
+      }
+    }
+    Layout layout;
+    for (const auto& item : items) {
+      const std::string& name = get_name(item);
+      auto it = slots_.find(name);
+      layout.names.push_back(name);
+      layout.slots.push_back(it != slots_.end() ? it->second : -1);
+    }
+    if (layouts_.size() < kMaxLayouts) {
+      layouts_.push_back(std::move(layout));
+      newest_ = layouts_.size() - 1;
+    } else {
+      newest_ = (newest_ + 1) % kMaxLayouts;
+      layouts_[newest_] = std::move(layout);
+    }
+    return layouts_[newest_].slots;
+  }
+
+ private:
+  static constexpr size_t kMaxLayouts = 8;
+
+  struct Layout {
+    std::vector<std::string> names;
+    std::vector<int> slots;
+  };
+
+  std::unordered_map<std::string, int> slots_;
+  std::vector<Layout> layouts_;
+  size_t newest_{0};
+};
+
+}  // namespace internal
+}  // namespace tf2
+}  // namespace drake_ros
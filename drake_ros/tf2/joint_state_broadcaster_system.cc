@@ -0,0 +1,148 @@
+#include "drake_ros/tf2/joint_state_broadcaster_system.h"
+
+#include <cctype>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <drake/common/drake_throw.h>
+#include <drake/systems/framework/diagram_builder.h>
+#include <drake_ros/core/ros_publisher_system.h>
+#include <rclcpp/publisher.hpp>
+#include <rclcpp/qos.hpp>
+#include <sensor_msgs/msg/joint_state.hpp>
+#include <std_msgs/msg/string.hpp>
+#include <tf2_msgs/msg/tf_message.hpp>
+#include <tf2_ros/qos.hpp>
+
+#include "drake_ros/tf2/joint_state_system.h"
+#include "drake_ros/tf2/robot_description.h"
+
+namespace drake_ros {
+namespace tf2 {
+namespace {
+
+// Turns a model instance name into a valid ROS namespace, replacing any
+// character that is not allowed with an underscore.
+std::string GetNamespace(const std::string& model_instance_name) {
+  std::string ns;
+  bool token_start = true;
+  for (size_t i = 0; i < model_instance_name.size(); ++i) {
+    const char c = model_instance_name[i];
+    if (c == ':' && i + 1 < model_instance_name.size() &&
+        model_instance_name[i + 1] == ':') {
+      ns += '/';
+      token_start = true;
+      ++i;
+      continue;
+    }
+    // N.B. Tokens may not start with a digit.
+    if (token_start && std::isdigit(static_cast<unsigned char>(c))) {
+      ns += '_';
+    }
+    ns += std::isalnum(static_cast<unsigned char>(c)) ? c : '_';
+    token_start = false;
+  }
+  return "/" + ns;
+}
+
+}  // namespace
+
+class JointStateBroadcasterSystem::Impl {
+ public:
+  std::map<drake::multibody::ModelInstanceIndex, std::string>
+      robot_descriptions;
+  // N.B. Publishers are kept alive for late subscribers to get latched
+  // robot descriptions.
+  std::vector<rclcpp::Publisher<std_msgs::msg::String>::SharedPtr>
+      robot_description_publishers;
+  std::vector<drake_ros::core::RosPublisherSystem*> publishers;
+  drake::systems::InputPortIndex state_port_index;
+  drake::systems::InputPortIndex body_poses_port_index;
+};
+
+JointStateBroadcasterSystem::JointStateBroadcasterSystem(
+    drake_ros::core::DrakeRos* ros,
+    const drake::multibody::MultibodyPlant<double>* plant,
+    JointStateBroadcasterParams params)
+    : impl_(new Impl()) {
+  DRAKE_THROW_UNLESS(ros != nullptr);
+  DRAKE_THROW_UNLESS(plant != nullptr);
+
+  drake::systems::DiagramBuilder<double> builder;
+
+  auto joint_state =
+      builder.AddSystem<JointStateSystem>(plant, params.model_instances);
+
+  using drake_ros::core::RosPublisherSystem;
+  auto joint_states_publisher = builder.AddSystem(
+      RosPublisherSystem::Make<sensor_msgs::msg::JointState>(
+          params.joint_states_topic_name, rclcpp::QoS(10), ros,
+          params.publish_triggers, params.publish_period));
+  builder.Connect(joint_state->get_joint_states_output_port(),
+                  joint_states_publisher->get_input_port());
+  impl_->publishers.push_back(joint_states_publisher);
+
+  if (joint_state->has_floating_joints()) {
+    auto floating_tf_publisher =
+        builder.AddSystem(RosPublisherSystem::Make<tf2_msgs::msg::TFMessage>(
+            params.tf_topic_name, tf2_ros::DynamicBroadcasterQoS(), ros,
+            params.publish_triggers, params.publish_period));
+    builder.Connect(joint_state->get_floating_tf_output_port(),
+                    floating_tf_publisher->get_input_port());
+    impl_->publishers.push_back(floating_tf_publisher);
+  }
+
+  impl_->state_port_index =
+      builder.ExportInput(joint_state->get_state_input_port(), "state");
+  impl_->body_poses_port_index = builder.ExportInput(
+      joint_state->get_body_poses_input_port(), "body_poses");
+
+  builder.BuildInto(this);
+
+  // Robot descriptions do not change, so they are published just once.
+  for (const drake::multibody::ModelInstanceIndex& model_instance :
+       params.model_instances) {
+    std::string robot_description =
+        drake_ros::tf2::GetRobotDescription(*plant, model_instance);
+    auto publisher =
+        ros->get_mutable_node()->create_publisher<std_msgs::msg::String>(
+            GetNamespace(plant->GetModelInstanceName(model_instance)) + "/" +
+                params.robot_description_topic_name,
+            rclcpp::QoS(1).transient_local().reliable());
+    std_msgs::msg::String message;
+    message.data = robot_description;
+    publisher->publish(message);
+    impl_->robot_description_publishers.push_back(std::move(publisher));
+    impl_->robot_descriptions[model_instance] = std::move(robot_description);
+  }
+}
+
+JointStateBroadcasterSystem::~JointStateBroadcasterSystem() {}
+
+const std::string& JointStateBroadcasterSystem::GetRobotDescription(
+    drake::multibody::ModelInstanceIndex model_instance) const {
+  return impl_->robot_descriptions.at(model_instance);
+}
+
+void JointStateBroadcasterSystem::AddMessageSink(
+    std::shared_ptr<drake_ros::core::MessageSinkInterface> sink) {
+  for (drake_ros::core::RosPublisherSystem* publisher : impl_->publishers) {
+    publisher->AddMessageSink(sink);
+  }
+}
+
+const drake::systems::InputPort<double>&
+JointStateBroadcasterSystem::get_state_input_port() const {
+  return get_input_port(impl_->state_port_index);
+}
+
+const drake::systems::InputPort<double>&
+JointStateBroadcasterSystem::get_body_poses_input_port() const {
+  return get_input_port(impl_->body_poses_port_index);
+}
+
+}  // namespace tf2
+}  // namespace drake_ros
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include <drake/multibody/plant/multibody_plant.h>
+#include <drake/systems/framework/diagram.h>
+#include <drake_ros/core/drake_ros.h>
+#include <drake_ros/core/message_sink_interface.h>
+
+namespace drake_ros {
+namespace tf2 {
+
+/** Set of parameters that configure a JointStateBroadcasterSystem. */
+struct JointStateBroadcasterParams {
+  /** Model instances to broadcast robot descriptions and joint states for.
+   */
+  std::vector<drake::multibody::ModelInstanceIndex> model_instances;
+
+  /** Publish triggers for joint state broadcasting. */
+  std::unordered_set<drake::systems::TriggerType> publish_triggers{
+      drake::systems::TriggerType::kForced,
+      drake::systems::TriggerType::kPerStep};
+
+  /** Period for periodic joint state broadcasting. */
+  double publish_period{0.0};
+
+  /** Topic name to be used for joint states. */
+  std::string joint_states_topic_name{"/joint_states"};
+
+  /** Topic name to be used for robot descriptions, relative to a namespace
+   named after each model instance. */
+  std::string robot_description_topic_name{"robot_description"};
+
+  /** Topic name to be used for the transforms of floating bodies. */
+  std::string tf_topic_name{"/tf"};
+};
+
+/** System for robot description and joint state broadcasting.
+
+ This system is a bandwidth-friendly alternative to SceneTfBroadcasterSystem
+ for articulated robots. On construction, it exports each model instance as
+ a URDF robot description (see GetRobotDescription()) and publishes it once
+ to a `/<model_instance_name>/robot_description` ROS topic, using latched
+ (transient local) QoS so that late subscribers get it too. From then on,
+ only joint states are published, to the `/joint_states` ROS topic, and tf2
+ transforms are left to downstream consumers (e.g. `robot_state_publisher`).
+ Floating bodies, which robot descriptions leave out, have their transforms
+ published to the `/tf` ROS topic instead.
+
+ It is a subdiagram aggregating a JointStateSystem and RosPublisherSystems.
+
+ It exports two input ports:
+ - *state* (vector): expects the state of the MultibodyPlant.
+ - *body_poses* (abstract): expects the poses of all bodies in the
+   MultibodyPlant. Only evaluated if any model instance has floating
+   joints.
+*/
+class JointStateBroadcasterSystem : public drake::systems::Diagram<double> {
+ public:
+  /** A constructor for the joint state broadcaster system.
+   @param[in] ros interface to a live ROS node to publish from.
+   @param[in] plant finalized MultibodyPlant instance, registered with a
+     SceneGraph. It must outlive this system.
+   @param[in] params broadcasting configuration.
+   @throws std::runtime_error if any model instance cannot be exported.
+   */
+  JointStateBroadcasterSystem(
+      drake_ros::core::DrakeRos* ros,
+      const drake::multibody::MultibodyPlant<double>* plant,
+      JointStateBroadcasterParams params);
+
+  ~JointStateBroadcasterSystem() override;
+
+  /** Returns the robot description published for a model instance.
+   @pre `model_instance` is one of those broadcast. */
+  const std::string& GetRobotDescription(
+      drake::multibody::ModelInstanceIndex model_instance) const;
+
+  /** Forwarded to RosPublisherSystem::AddMessageSink(), for the publishers
+   of joint states and of floating body transforms. */
+  void AddMessageSink(
+      std::shared_ptr<drake_ros::core::MessageSinkInterface> sink);
+
+  const drake::systems::InputPort<double>& get_state_input_port() const;
+
+  const drake::systems::InputPort<double>& get_body_poses_input_port() const;
+
+ private:
+  class Impl;
+
+  std::unique_ptr<Impl> impl_;
+};
+}  // namespace tf2
+}  // namespace drake_ros
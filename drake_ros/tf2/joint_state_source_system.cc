@@ -0,0 +1,220 @@
+#include "drake_ros/tf2/joint_state_source_system.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <drake/common/drake_throw.h>
+#include <drake/multibody/tree/prismatic_joint.h>
+#include <drake/multibody/tree/revolute_joint.h>
+#include <rclcpp/clock.hpp>
+#include <rclcpp/subscription.hpp>
+#include <rclcpp/time.hpp>
+#include <sensor_msgs/msg/joint_state.hpp>
+
+#include "drake_ros/tf2/name_conventions.h"
+#include "internal_sample_buffer.h"  // NOLINT(build/include)
+
+namespace drake_ros {
+namespace tf2 {
+
+namespace {
+
+// Receives joint state messages. It is shared with the subscription
+// callback, and thus outlives any callback in flight.
+struct Receiver {
+  explicit Receiver(size_t max_log_size) : log(max_log_size) {}
+
+  // Logs the positions of a joint state message.
+  void HandleMessage(const sensor_msgs::msg::JointState& message) {
+    // N.B. Messages without timestamps are timestamped once latched.
+    const int64_t stamp = rclcpp::Time(message.header.stamp).nanoseconds();
+    std::lock_guard<std::mutex> lock(mutex);
+    const std::vector<int>& slots = layout_cache.Resolve(
+        message.name, [](const std::string& name) -> const std::string& {
+          return name;
+        });
+    const size_t size = std::min(slots.size(), message.position.size());
+    samples.clear();
+    for (size_t i = 0; i < size; ++i) {
+      if (slots[i] >= 0) {
+        samples.push_back({slots[i], stamp, message.position[i]});
+      }
+    }
+    log.Append(samples);
+    ++num_messages_received;
+  }
+
+  internal::SampleLog<double> log;
+  std::atomic<int64_t> num_messages_received{0};
+
+  // Guards everything below.
+  std::mutex mutex;
+  internal::NameLayoutCache layout_cache{{}};
+  std::vector<internal::SampleLog<double>::Sample> samples;
+};
+
+}  // namespace
+
+struct JointStateSourceSystem::Impl {
+  ExternalStateSourceParams params;
+  rclcpp::Clock::SharedPtr clock;
+  Eigen::VectorXd default_positions;
+  // Position index of each joint, by slot.
+  std::vector<int> position_indices;
+  drake::systems::AbstractStateIndex samples_state_index;
+  drake::systems::OutputPortIndex positions_port_index;
+  drake::systems::OutputPortIndex received_port_index;
+
+  std::shared_ptr<Receiver> receiver;
+  rclcpp::Subscription<sensor_msgs::msg::JointState>::SharedPtr sub;
+};
+
+JointStateSourceSystem::JointStateSourceSystem(
+    drake_ros::core::DrakeRos* ros,
+    const drake::multibody::MultibodyPlant<double>* plant,
+    const std::string& topic_name, ExternalStateSourceParams params)
+    : impl_(new Impl()) {
+  DRAKE_THROW_UNLESS(ros != nullptr);
+  DRAKE_THROW_UNLESS(plant != nullptr);
+  DRAKE_THROW_UNLESS(plant->is_finalized());
+  DRAKE_THROW_UNLESS(params.interpolation_delay >= 0.0);
+  DRAKE_THROW_UNLESS(params.max_samples > 0);
+  impl_->params = params;
+  impl_->default_positions = plant->GetDefaultPositions();
+
+  // Map joint names to slots once and for all.
+  std::unordered_map<std::string, int> slots;
+  for (int i = 0; i < plant->num_joints(); ++i) {
+    const drake::multibody::Joint<double>& joint =
+        plant->get_joint(drake::multibody::JointIndex(i));
+    if (joint.num_positions() != 1) {
+      continue;
+    }
+    const std::string& type_name = joint.type_name();
+    if (type_name != drake::multibody::RevoluteJoint<double>::kTypeName &&
+        type_name != drake::multibody::PrismaticJoint<double>::kTypeName) {
+      continue;
+    }
+    slots[GetJointName(joint, plant)] = impl_->position_indices.size();
+    impl_->position_indices.push_back(joint.position_start());
+  }
+  const size_t num_slots = impl_->position_indices.size();
+  impl_->receiver = std::make_shared<Receiver>(
+      params.max_samples * std::max<size_t>(num_slots, 1));
+  impl_->receiver->layout_cache = internal::NameLayoutCache(std::move(slots));
+
+  internal::LatchedSamples<double> samples;
+  samples.buffers.assign(num_slots,
+                         internal::SampleBuffer<double>(params.max_samples));
+  impl_->samples_state_index = DeclareAbstractState(
+      drake::Value<internal::LatchedSamples<double>>(std::move(samples)));
+  DeclarePerStepUnrestrictedUpdateEvent(
+      &JointStateSourceSystem::LatchSamples);
+
+  impl_->positions_port_index =
+      this->DeclareVectorOutputPort("positions", plant->num_positions(),
+                                    &JointStateSourceSystem::CalcPositions)
+          .get_index();
+  impl_->received_port_index =
+      this->DeclareVectorOutputPort(
+              "received", plant->num_positions(),
+              &JointStateSourceSystem::CalcReceived,
+              {abstract_state_ticket(impl_->samples_state_index)})
+          .get_index();
+
+  rclcpp::Node* node = ros->get_mutable_node();
+  impl_->clock = node->get_clock();
+  std::shared_ptr<Receiver> receiver = impl_->receiver;
+  impl_->sub = node->create_subscription<sensor_msgs::msg::JointState>(
+      topic_name, rclcpp::SensorDataQoS(),
+      [receiver](const sensor_msgs::msg::JointState& message) {
+        receiver->HandleMessage(message);
+      });
+}
+
+JointStateSourceSystem::~JointStateSourceSystem() {}
+
+int64_t JointStateSourceSystem::num_messages_received() const {
+  return impl_->receiver->num_messages_received;
+}
+
+const drake::systems::OutputPort<double>&
+JointStateSourceSystem::get_positions_output_port() const {
+  return get_output_port(impl_->positions_port_index);
+}
+
+const drake::systems::OutputPort<double>&
+JointStateSourceSystem::get_received_output_port() const {
+  return get_output_port(impl_->received_port_index);
+}
+
+drake::systems::EventStatus JointStateSourceSystem::LatchSamples(
+    const drake::systems::Context<double>& context,
+    drake::systems::State<double>* state) const {
+  const auto& samples =
+      context.get_abstract_state<internal::LatchedSamples<double>>(
+          impl_->samples_state_index);
+  const bool use_context_time = impl_->params.use_context_time;
+  if (use_context_time &&
+      impl_->receiver->log.sequence() == samples.sequence) {
+    return drake::systems::EventStatus::DidNothing();
+  }
+  auto& latched = state->get_mutable_abstract_state()
+                      .get_mutable_value(impl_->samples_state_index)
+                      .get_mutable_value<internal::LatchedSamples<double>>();
+  latched.now = use_context_time
+                    ? static_cast<int64_t>(context.get_time() * 1e9)
+                    : impl_->clock->now().nanoseconds();
+  impl_->receiver->log.Latch(latched.now, &latched);
+  return drake::systems::EventStatus::Succeeded();
+}
+
+void JointStateSourceSystem::CalcPositions(
+    const drake::systems::Context<double>& context,
+    drake::systems::BasicVector<double>* output_value) const {
+  const auto& samples =
+      context.get_abstract_state<internal::LatchedSamples<double>>(
+          impl_->samples_state_index);
+  // Without delay, the latest samples are used as-is, whatever their
+  // timestamps are w.r.t. the current time.
+  const bool use_latest = impl_->params.interpolation_delay == 0.0;
+  const int64_t stamp =
+      (impl_->params.use_context_time
+           ? static_cast<int64_t>(context.get_time() * 1e9)
+           : samples.now) -
+      static_cast<int64_t>(impl_->params.interpolation_delay * 1e9);
+  auto positions = output_value->get_mutable_value();
+  positions = impl_->default_positions;
+  for (size_t i = 0; i < samples.buffers.size(); ++i) {
+    const internal::SampleBuffer<double>& buffer = samples.buffers[i];
+    if (!buffer.empty()) {
+      positions[impl_->position_indices[i]] =
+          use_latest ? buffer.latest() : buffer.Sample(stamp);
+    }
+  }
+}
+
+void JointStateSourceSystem::CalcReceived(
+    const drake::systems::Context<double>& context,
+    drake::systems::BasicVector<double>* output_value) const {
+  const auto& samples =
+      context.get_abstract_state<internal::LatchedSamples<double>>(
+          impl_->samples_state_index);
+  auto received = output_value->get_mutable_value();
+  received.setZero();
+  for (size_t i = 0; i < samples.buffers.size(); ++i) {
+    if (!samples.buffers[i].empty()) {
+      received[impl_->position_indices[i]] = 1.0;
+    }
+  }
+}
+
+}  // namespace tf2
+}  // namespace drake_ros
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include <drake/multibody/plant/multibody_plant.h>
+#include <drake/systems/framework/context.h>
+#include <drake/systems/framework/leaf_system.h>
+#include <drake_ros/core/drake_ros.h>
+
+#include "drake_ros/tf2/external_state_source_params.h"
+
+namespace drake_ros {
+namespace tf2 {
+
+/** System for driving MultibodyPlant positions from external joint states.
+
+ This system is the digital twin counterpart of JointStateSystem. It
+ subscribes to a `sensor_msgs/msg/JointState` ROS topic, `/joint_states` by
+ default, and outputs plant positions sampled from the joint states
+ received. Joints are matched by name, as per GetJointName(). Names are
+ mapped to joints once per message layout and not once per message.
+ Messages without timestamps are timestamped when latched.
+
+ Positions for joints that have not been received, or that are not
+ revolute or prismatic, are the plant default positions. Feed them to a
+ `drake::systems::rendering::MultibodyPositionToGeometryPose` system to
+ drive SceneGraph frame poses, for geometry queries and visualization.
+
+ External state arrives asynchronously. Samples received are latched into
+ state by a per-step unrestricted update event, and thus only change at
+ step boundaries. Output values are a function of Context alone.
+
+ It has no input ports.
+
+ It has two output ports:
+ - *positions* (vector): MultibodyPlant positions.
+ - *received* (vector): for each MultibodyPlant position, 1 if it has
+   been received, 0 if it is a default position (i.e. no data yet).
+*/
+class JointStateSourceSystem : public drake::systems::LeafSystem<double> {
+ public:
+  /** A constructor for the joint state source system.
+   @param[in] ros interface to a live ROS node to subscribe from.
+   @param[in] plant finalized MultibodyPlant instance. It must outlive this
+     system.
+   @param[in] topic_name name of the joint states ROS topic.
+   @param[in] params optional source configuration.
+   */
+  JointStateSourceSystem(drake_ros::core::DrakeRos* ros,
+                         const drake::multibody::MultibodyPlant<double>* plant,
+                         const std::string& topic_name = "/joint_states",
+                         ExternalStateSourceParams params = {});
+
+  ~JointStateSourceSystem() override;
+
+  /** Returns the number of joint states messages received so far. */
+  int64_t num_messages_received() const;
+
+  const drake::systems::OutputPort<double>& get_positions_output_port() const;
+
+  const drake::systems::OutputPort<double>& get_received_output_port() const;
+
+ private:
+  drake::systems::EventStatus LatchSamples(
+      const drake::systems::Context<double>& context,
+      drake::systems::State<double>* state) const;
+
+  void CalcPositions(const drake::systems::Context<double>& context,
+                     drake::systems::BasicVector<double>* output_value) const;
+
+  void CalcReceived(const drake::systems::Context<double>& context,
+                    drake::systems::BasicVector<double>* output_value) const;
+
+  struct Impl;
+  std::unique_ptr<Impl> impl_;
+};
+}  // namespace tf2
+}  // namespace drake_ros
@@ -0,0 +1,176 @@
+#include "drake_ros/tf2/joint_state_system.h"
+
+#include <string>
+#include <vector>
+
+#include <builtin_interfaces/msg/time.hpp>
+#include <drake/common/drake_throw.h>
+#include <drake/math/rigid_transform.h>
+#include <rclcpp/duration.hpp>
+#include <rclcpp/time.hpp>
+
+#include "drake_ros/core/geometry_conversions.h"
+#include "drake_ros/tf2/name_conventions.h"
+#include "internal_joint_export.h"  // NOLINT(build/include)
+
+namespace drake_ros {
+namespace tf2 {
+
+using drake_ros::core::RigidTransformToRosTransform;
+
+struct JointStateSystem::Impl {
+  const drake::multibody::MultibodyPlant<double>* plant;
+  drake::systems::InputPortIndex state_port_index;
+  drake::systems::InputPortIndex body_poses_port_index;
+  drake::systems::OutputPortIndex joint_states_port_index;
+  drake::systems::OutputPortIndex floating_tf_port_index;
+
+  // Pre-computed joint state information. Names are kept in the same order
+  // as position and velocity indices.
+  std::vector<std::string> joint_names;
+  std::vector<int> position_indices;
+  std::vector<int> velocity_indices;
+
+  // Pre-computed floating joint information.
+  struct FloatingJoint {
+    drake::multibody::BodyIndex parent_body_index;
+    drake::multibody::BodyIndex child_body_index;
+    geometry_msgs::msg::TransformStamped X_PC;
+  };
+  std::vector<FloatingJoint> floating_joints;
+};
+
+JointStateSystem::JointStateSystem(
+    const drake::multibody::MultibodyPlant<double>* plant,
+    const std::vector<drake::multibody::ModelInstanceIndex>& model_instances)
+    : impl_(new Impl()) {
+  DRAKE_THROW_UNLESS(plant != nullptr);
+  DRAKE_THROW_UNLESS(plant->is_finalized());
+  impl_->plant = plant;
+
+  using internal::ExportedJointType;
+  for (const drake::multibody::ModelInstanceIndex& model_instance :
+       model_instances) {
+    for (const drake::multibody::JointIndex& index :
+         plant->GetJointIndices(model_instance)) {
+      const drake::multibody::Joint<double>& joint = plant->get_joint(index);
+      switch (internal::GetExportedJointType(joint)) {
+        case ExportedJointType::kFixed:
+          break;
+        case ExportedJointType::kRevolute:
+        case ExportedJointType::kPrismatic:
+          impl_->joint_names.push_back(GetJointName(joint, plant));
+          // N.B. Positions precede velocities in plant state.
+          impl_->position_indices.push_back(joint.position_start());
+          impl_->velocity_indices.push_back(plant->num_positions() +
+                                            joint.velocity_start());
+          break;
+        case ExportedJointType::kFloating: {
+          Impl::FloatingJoint floating_joint;
+          floating_joint.parent_body_index = joint.parent_body().index();
+          floating_joint.child_body_index = joint.child_body().index();
+          floating_joint.X_PC.header.frame_id =
+              GetTfFrameName(joint.parent_body(), plant);
+          floating_joint.X_PC.child_frame_id =
+              GetTfFrameName(joint.child_body(), plant);
+          impl_->floating_joints.push_back(floating_joint);
+          break;
+        }
+      }
+    }
+  }
+
+  impl_->state_port_index =
+      this->DeclareVectorInputPort("state", plant->num_multibody_states())
+          .get_index();
+
+  impl_->body_poses_port_index =
+      this->DeclareAbstractInputPort(
+              "body_poses",
+              drake::Value<std::vector<drake::math::RigidTransform<double>>>{})
+          .get_index();
+
+  impl_->joint_states_port_index =
+      this->DeclareAbstractOutputPort("joint_states",
+                                      &JointStateSystem::CalcJointStates)
+          .get_index();
+
+  impl_->floating_tf_port_index =
+      this->DeclareAbstractOutputPort("floating_tf",
+                                      &JointStateSystem::CalcFloatingTf)
+          .get_index();
+}
+
+JointStateSystem::~JointStateSystem() {}
+
+bool JointStateSystem::has_floating_joints() const {
+  return !impl_->floating_joints.empty();
+}
+
+const drake::systems::InputPort<double>&
+JointStateSystem::get_state_input_port() const {
+  return get_input_port(impl_->state_port_index);
+}
+
+const drake::systems::InputPort<double>&
+JointStateSystem::get_body_poses_input_port() const {
+  return get_input_port(impl_->body_poses_port_index);
+}
+
+const drake::systems::OutputPort<double>&
+JointStateSystem::get_joint_states_output_port() const {
+  return get_output_port(impl_->joint_states_port_index);
+}
+
+const drake::systems::OutputPort<double>&
+JointStateSystem::get_floating_tf_output_port() const {
+  return get_output_port(impl_->floating_tf_port_index);
+}
+
+void JointStateSystem::CalcJointStates(
+    const drake::systems::Context<double>& context,
+    sensor_msgs::msg::JointState* output_value) const {
+  const auto& state = get_state_input_port().Eval(context);
+  output_value->header.stamp =
+      rclcpp::Time() + rclcpp::Duration::from_seconds(context.get_time());
+  // N.B. Names do not change, so they are only copied into fresh output
+  // values.
+  if (output_value->name.size() != impl_->joint_names.size()) {
+    output_value->name = impl_->joint_names;
+  }
+  const size_t num_joints = impl_->joint_names.size();
+  output_value->position.resize(num_joints);
+  output_value->velocity.resize(num_joints);
+  for (size_t i = 0; i < num_joints; ++i) {
+    output_value->position[i] = state[impl_->position_indices[i]];
+    output_value->velocity[i] = state[impl_->velocity_indices[i]];
+  }
+}
+
+void JointStateSystem::CalcFloatingTf(
+    const drake::systems::Context<double>& context,
+    tf2_msgs::msg::TFMessage* output_value) const {
+  output_value->transforms.clear();
+  if (impl_->floating_joints.empty()) {
+    return;
+  }
+  const auto& X_WB_all =
+      get_body_poses_input_port()
+          .Eval<std::vector<drake::math::RigidTransform<double>>>(context);
+  const builtin_interfaces::msg::Time stamp =
+      rclcpp::Time() + rclcpp::Duration::from_seconds(context.get_time());
+  for (const Impl::FloatingJoint& floating_joint : impl_->floating_joints) {
+    output_value->transforms.push_back(floating_joint.X_PC);
+    geometry_msgs::msg::TransformStamped& transform =
+        output_value->transforms.back();
+    transform.header.stamp = stamp;
+    const drake::math::RigidTransform<double>& X_WP =
+        X_WB_all[floating_joint.parent_body_index];
+    const drake::math::RigidTransform<double>& X_WC =
+        X_WB_all[floating_joint.child_body_index];
+    transform.transform = RigidTransformToRosTransform(X_WP.inverse() * X_WC);
+  }
+}
+
+}  // namespace tf2
+}  // namespace drake_ros
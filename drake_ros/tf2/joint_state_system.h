@@ -0,0 +1,80 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include <drake/multibody/plant/multibody_plant.h>
+#include <drake/systems/framework/context.h>
+#include <drake/systems/framework/leaf_system.h>
+#include <sensor_msgs/msg/joint_state.hpp>
+#include <tf2_msgs/msg/tf_message.hpp>
+
+namespace drake_ros {
+namespace tf2 {
+/** System for MultibodyPlant joint state aggregation as ROS messages.
+
+ This system is a compact alternative to SceneTfSystem for articulated
+ robots. Instead of a transform per frame, it outputs the state of each
+ revolute and prismatic joint of a given set of model instances, from which
+ transforms can be computed downstream (e.g. by a `robot_state_publisher`)
+ using the robot descriptions exported by GetRobotDescription(). Child
+ bodies of floating joints, which robot descriptions leave out, have their
+ poses output as transforms instead. Context time is used to timestamp
+ messages.
+
+ It has two input ports:
+ - *state* (vector): expects the state of the MultibodyPlant.
+ - *body_poses* (abstract): expects the poses of all bodies in the
+   MultibodyPlant w.r.t. the world frame, as a
+   std::vector<drake::math::RigidTransform<double>>. Only evaluated if any
+   model instance has floating joints.
+
+ It has two output ports:
+ - *joint_states* (abstract): joint positions and velocities, as a
+   sensor_msgs::msg::JointState message. Joints are named as per
+   GetJointName().
+ - *floating_tf* (abstract): rigid transforms of the child bodies of
+   floating joints w.r.t. their parent bodies, as a tf2_msgs::msg::TFMessage
+   message.
+*/
+class JointStateSystem : public drake::systems::LeafSystem<double> {
+ public:
+  /** A constructor for the joint state system.
+   @param[in] plant finalized MultibodyPlant instance, registered with a
+     SceneGraph. It must outlive this system.
+   @param[in] model_instances model instances to aggregate joint states for.
+   @throws std::runtime_error if any model instance has joints that cannot
+     be exported to a robot description.
+   */
+  JointStateSystem(
+      const drake::multibody::MultibodyPlant<double>* plant,
+      const std::vector<drake::multibody::ModelInstanceIndex>&
+          model_instances);
+
+  ~JointStateSystem() override;
+
+  /** Returns whether any model instance has floating joints. */
+  bool has_floating_joints() const;
+
+  const drake::systems::InputPort<double>& get_state_input_port() const;
+
+  const drake::systems::InputPort<double>& get_body_poses_input_port() const;
+
+  const drake::systems::OutputPort<double>& get_joint_states_output_port()
+      const;
+
+  const drake::systems::OutputPort<double>& get_floating_tf_output_port()
+      const;
+
+ private:
+  void CalcJointStates(const drake::systems::Context<double>& context,
+                       sensor_msgs::msg::JointState* output_value) const;
+
+  void CalcFloatingTf(const drake::systems::Context<double>& context,
+                      tf2_msgs::msg::TFMessage* output_value) const;
+
+  struct Impl;
+  std::unique_ptr<Impl> impl_;
+};
+}  // namespace tf2
+}  // namespace drake_ros
@@ -18,6 +18,24 @@ std::string GetTfFrameName(
       body.index(), frame_id.get_value());
 }
 
+std::string GetTfFrameName(
+    const drake::multibody::Body<double>& body,
+    const drake::multibody::MultibodyPlant<double>* plant) {
+  if (body.index() == plant->world_body().index()) {
+    return "world";
+  }
+  return GetTfFrameName(body, plant,
+                        plant->GetBodyFrameIdOrThrow(body.index()));
+}
+
+std::string GetJointName(
+    const drake::multibody::Joint<double>& joint,
+    const drake::multibody::MultibodyPlant<double>* plant) {
+  return internal::ReplaceAllOccurrences(
+             plant->GetModelInstanceName(joint.model_instance()), "::", "/") +
+         "/" + internal::ReplaceAllOccurrences(joint.name(), "::", "/");
+}
+
 std::string GetTfFrameName(
     const drake::geometry::SceneGraphInspector<double>& inspector,
     const std::unordered_set<const drake::multibody::MultibodyPlant<double>*>&
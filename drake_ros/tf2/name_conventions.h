@@ -48,6 +48,29 @@ std::string GetTfFrameName(
     const drake::multibody::Body<double>& body,
     const drake::multibody::MultibodyPlant<double>* plant,
     const drake::geometry::FrameId& frame_id);
+
+/** Retrieve conventional tf frame name for a given MultibodyPlant body.
+
+ @param[in] body target body.
+ @param[in] plant MultibodyPlant instance `body` belongs to.
+ @returns fully qualified tf frame name, "world" for the world body.
+ @throws std::exception if `plant` is not registered with a SceneGraph.
+ */
+std::string GetTfFrameName(
+    const drake::multibody::Body<double>& body,
+    const drake::multibody::MultibodyPlant<double>* plant);
+
+/** Retrieve conventional joint name for a given MultibodyPlant joint, as
+ used in `sensor_msgs/msg/JointState` messages and robot descriptions.
+
+ @param[in] joint target joint.
+ @param[in] plant MultibodyPlant instance `joint` belongs to.
+ @returns joint name, scoped by its model instance name
+   e.g. "model_name/joint_name".
+ */
+std::string GetJointName(
+    const drake::multibody::Joint<double>& joint,
+    const drake::multibody::MultibodyPlant<double>* plant);
 }  // namespace tf2
 }  // namespace drake_ros
 
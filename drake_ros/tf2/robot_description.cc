@@ -0,0 +1,213 @@
+#include "drake_ros/tf2/robot_description.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include <drake/common/drake_throw.h>
+#include <drake/math/rigid_transform.h>
+#include <drake/math/roll_pitch_yaw.h>
+
+#include "drake_ros/tf2/name_conventions.h"
+#include "internal_joint_export.h"  // NOLINT(build/include)
+
+namespace drake_ros {
+namespace tf2 {
+namespace {
+
+std::string EscapeXml(const std::string& text) {
+  std::string escaped_text;
+  escaped_text.reserve(text.size());
+  for (const char c : text) {
+    switch (c) {
+      case '&':
+        escaped_text += "&amp;";
+        break;
+      case '<':
+        escaped_text += "&lt;";
+        break;
+      case '>':
+        escaped_text += "&gt;";
+        break;
+      case '"':
+        escaped_text += "&quot;";
+        break;
+      case '\'':
+        escaped_text += "&apos;";
+        break;
+      default:
+        escaped_text += c;
+    }
+  }
+  return escaped_text;
+}
+
+// N.B. URDF parsers do not take infinities.
+double ClampToFinite(double value) {
+  return std::clamp(value, std::numeric_limits<double>::lowest(),
+                    std::numeric_limits<double>::max());
+}
+
+class UrdfWriter {
+ public:
+  explicit UrdfWriter(const std::string& robot_name) {
+    urdf_.precision(std::numeric_limits<double>::max_digits10);
+    urdf_ << "<?xml version=\"1.0\"?>\n"
+          << "<robot name=\"" << EscapeXml(robot_name) << "\">\n";
+  }
+
+  void AddLink(const std::string& name) {
+    if (links_.insert(name).second) {
+      link_order_.push_back(name);
+      urdf_ << "  <link name=\"" << EscapeXml(name) << "\"/>\n";
+    }
+  }
+
+  void AddJoint(const std::string& name, const std::string& type,
+                const std::string& parent_link, const std::string& child_link,
+                const drake::math::RigidTransform<double>& X_PC,
+                const std::string& extra_elements = "") {
+    AddLink(parent_link);
+    AddLink(child_link);
+    child_links_.insert(child_link);
+    const Eigen::Vector3d& p = X_PC.translation();
+    const Eigen::Vector3d rpy =
+        drake::math::RollPitchYaw<double>(X_PC.rotation()).vector();
+    urdf_ << "  <joint name=\"" << EscapeXml(name) << "\" type=\"" << type
+          << "\">\n"
+          << "    <parent link=\"" << EscapeXml(parent_link) << "\"/>\n"
+          << "    <child link=\"" << EscapeXml(child_link) << "\"/>\n"
+          << "    <origin xyz=\"" << p.x() << " " << p.y() << " " << p.z()
+          << "\" rpy=\"" << rpy.x() << " " << rpy.y() << " " << rpy.z()
+          << "\"/>\n"
+          << extra_elements << "  </joint>\n";
+  }
+
+  std::string Finish(const std::string& robot_name) {
+    std::vector<std::string> root_links;
+    for (const std::string& link : link_order_) {
+      if (child_links_.count(link) == 0) {
+        root_links.push_back(link);
+      }
+    }
+    if (root_links.size() != 1) {
+      std::stringstream message;
+      message << "cannot export '" << robot_name << "' with "
+              << root_links.size() << " root links";
+      for (const std::string& link : root_links) {
+        message << " '" << link << "'";
+      }
+      throw std::runtime_error(message.str());
+    }
+    urdf_ << "</robot>\n";
+    return urdf_.str();
+  }
+
+ private:
+  std::stringstream urdf_;
+  std::vector<std::string> link_order_;
+  std::unordered_set<std::string> links_;
+  std::unordered_set<std::string> child_links_;
+};
+
+// Returns URDF axis and limit elements for a single dof `joint`.
+std::string GetAxisAndLimits(
+    const drake::multibody::MultibodyPlant<double>& plant,
+    const drake::multibody::Joint<double>& joint,
+    const Eigen::Vector3d& axis) {
+  double effort_limit = std::numeric_limits<double>::infinity();
+  for (const drake::multibody::JointActuatorIndex& index :
+       plant.GetJointActuatorIndices(joint.model_instance())) {
+    const drake::multibody::JointActuator<double>& actuator =
+        plant.get_joint_actuator(index);
+    if (actuator.joint().index() == joint.index()) {
+      effort_limit = actuator.effort_limit();
+    }
+  }
+  std::stringstream elements;
+  elements.precision(std::numeric_limits<double>::max_digits10);
+  elements << "    <axis xyz=\"" << axis.x() << " " << axis.y() << " "
+           << axis.z() << "\"/>\n";
+  elements << "    <limit lower=\""
+           << ClampToFinite(joint.position_lower_limits()[0]) << "\" upper=\""
+           << ClampToFinite(joint.position_upper_limits()[0])
+           << "\" effort=\"" << ClampToFinite(effort_limit)
+           << "\" velocity=\""
+           << ClampToFinite(joint.velocity_upper_limits()[0]) << "\"/>\n";
+  return elements.str();
+}
+
+}  // namespace
+
+std::string GetRobotDescription(
+    const drake::multibody::MultibodyPlant<double>& plant,
+    drake::multibody::ModelInstanceIndex model_instance) {
+  DRAKE_THROW_UNLESS(plant.is_finalized());
+  DRAKE_THROW_UNLESS(model_instance.is_valid() &&
+                     model_instance < plant.num_model_instances());
+  using internal::ExportedJointType;
+
+  const std::string& robot_name = plant.GetModelInstanceName(model_instance);
+  UrdfWriter writer(robot_name);
+  for (const drake::multibody::BodyIndex& index :
+       plant.GetBodyIndices(model_instance)) {
+    writer.AddLink(GetTfFrameName(plant.get_body(index), &plant));
+  }
+  for (const drake::multibody::JointIndex& index :
+       plant.GetJointIndices(model_instance)) {
+    const drake::multibody::Joint<double>& joint = plant.get_joint(index);
+    const ExportedJointType type = internal::GetExportedJointType(joint);
+    if (type == ExportedJointType::kFloating) {
+      continue;
+    }
+    const std::string name = GetJointName(joint, &plant);
+    const std::string parent_link = GetTfFrameName(joint.parent_body(), &plant);
+    const std::string child_link = GetTfFrameName(joint.child_body(), &plant);
+    const drake::math::RigidTransform<double> X_PF =
+        joint.frame_on_parent().GetFixedPoseInBodyFrame();
+    const drake::math::RigidTransform<double> X_CM =
+        joint.frame_on_child().GetFixedPoseInBodyFrame();
+    if (type == ExportedJointType::kFixed) {
+      const auto& weld_joint =
+          dynamic_cast<const drake::multibody::WeldJoint<double>&>(joint);
+      writer.AddJoint(name, "fixed", parent_link, child_link,
+                      X_PF * weld_joint.X_FM() * X_CM.inverse());
+      continue;
+    }
+    std::string elements;
+    std::string urdf_type;
+    if (type == ExportedJointType::kRevolute) {
+      const auto& revolute_joint =
+          dynamic_cast<const drake::multibody::RevoluteJoint<double>&>(joint);
+      elements = GetAxisAndLimits(plant, joint, revolute_joint.revolute_axis());
+      urdf_type = std::isinf(joint.position_lower_limits()[0]) &&
+                          std::isinf(joint.position_upper_limits()[0])
+                      ? "continuous"
+                      : "revolute";
+    } else {
+      const auto& prismatic_joint =
+          dynamic_cast<const drake::multibody::PrismaticJoint<double>&>(joint);
+      elements =
+          GetAxisAndLimits(plant, joint, prismatic_joint.translation_axis());
+      urdf_type = "prismatic";
+    }
+    // N.B. URDF joint frames are child link frames.
+    if (X_CM.IsExactlyIdentity()) {
+      writer.AddJoint(name, urdf_type, parent_link, child_link, X_PF,
+                      elements);
+    } else {
+      writer.AddJoint(name, urdf_type, parent_link, name, X_PF, elements);
+      writer.AddJoint(name + "/child", "fixed", name, child_link,
+                      X_CM.inverse());
+    }
+  }
+  return writer.Finish(robot_name);
+}
+
+}  // namespace tf2
+}  // namespace drake_ros
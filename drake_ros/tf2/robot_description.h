@@ -0,0 +1,36 @@
+#pragma once
+
+#include <string>
+
+#include <drake/multibody/plant/multibody_plant.h>
+
+namespace drake_ros {
+namespace tf2 {
+
+/** Export a MultibodyPlant model instance as a URDF robot description.
+
+ Links are named after tf frames, as per GetTfFrameName(), and joints as per
+ GetJointName(), so that joint states and transforms computed from this
+ description (e.g. by a `robot_state_publisher`) are consistent with those
+ broadcast by SceneTfSystem and JointStateSystem.
+
+ Weld, revolute and prismatic joints are exported. Joints of the model
+ instance attached to bodies of other model instances bring the latter in as
+ bare links. Floating joints are left out, so their child bodies become root
+ links. Where a joint frame does not coincide with its child body frame, the
+ joint frame is exported as an additional link, named after the joint.
+ Geometries and inertias are not exported.
+
+ @param[in] plant finalized MultibodyPlant instance, registered with a
+   SceneGraph.
+ @param[in] model_instance model instance to be exported.
+ @returns URDF robot description.
+ @throws std::runtime_error if the model instance has joints of any other
+   type, or if it does not have a single root link.
+ */
+std::string GetRobotDescription(
+    const drake::multibody::MultibodyPlant<double>& plant,
+    drake::multibody::ModelInstanceIndex model_instance);
+
+}  // namespace tf2
+}  // namespace drake_ros
@@ -2,6 +2,7 @@
 
 #include <memory>
 #include <unordered_set>
+#include <utility>
 
 #include <drake/systems/framework/diagram_builder.h>
 #include <drake_ros/core/drake_ros.h>
@@ -17,6 +18,7 @@ namespace tf2 {
 class SceneTfBroadcasterSystem::Impl {
  public:
   SceneTfSystem* scene_tf;
+  drake_ros::core::RosPublisherSystem* scene_tf_publisher;
   drake::systems::InputPortIndex graph_query_port_index;
 };
 
@@ -35,6 +37,7 @@ SceneTfBroadcasterSystem::SceneTfBroadcasterSystem(
 
   builder.Connect(impl_->scene_tf->get_scene_tf_output_port(),
                   scene_tf_publisher->get_input_port());
+  impl_->scene_tf_publisher = scene_tf_publisher;
 
   impl_->graph_query_port_index = builder.ExportInput(
       impl_->scene_tf->get_graph_query_input_port(), "graph_query");
@@ -53,6 +56,11 @@ void SceneTfBroadcasterSystem::ComputeFrameHierarchy() {
   impl_->scene_tf->ComputeFrameHierarchy();
 }
 
+void SceneTfBroadcasterSystem::AddMessageSink(
+    std::shared_ptr<drake_ros::core::MessageSinkInterface> sink) {
+  impl_->scene_tf_publisher->AddMessageSink(std::move(sink));
+}
+
 const drake::systems::InputPort<double>&
 SceneTfBroadcasterSystem::get_graph_query_input_port() const {
   return get_input_port(impl_->graph_query_port_index);
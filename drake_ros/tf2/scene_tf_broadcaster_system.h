@@ -7,6 +7,7 @@
 #include <drake/multibody/plant/multibody_plant.h>
 #include <drake/systems/framework/leaf_system.h>
 #include <drake_ros/core/drake_ros.h>
+#include <drake_ros/core/message_sink_interface.h>
 
 namespace drake_ros {
 namespace tf2 {
@@ -51,6 +52,11 @@ class SceneTfBroadcasterSystem : public drake::systems::Diagram<double> {
   /** Forwarded to SceneTfSystem::ComputeFrameHierarchy(). */
   void ComputeFrameHierarchy();
 
+  /** Forwarded to RosPublisherSystem::AddMessageSink(), for the publisher
+   of tf2 transforms. */
+  void AddMessageSink(
+      std::shared_ptr<drake_ros::core::MessageSinkInterface> sink);
+
   const drake::systems::InputPort<double>& get_graph_query_input_port() const;
 
  private:
@@ -4,6 +4,7 @@
 #include <unordered_map>
 #include <unordered_set>
 
+#include <builtin_interfaces/msg/time.hpp>
 #include <drake/geometry/query_object.h>
 #include <drake/geometry/scene_graph_inspector.h>
 #include <rclcpp/duration.hpp>
@@ -119,25 +120,29 @@ void SceneTfSystem::CalcSceneTf(const drake::systems::Context<double>& context,
     output_value->transforms.clear();
     output_value->transforms.reserve(inspector.num_frames() - 1);
 
+    const builtin_interfaces::msg::Time stamp =
+        rclcpp::Time() + rclcpp::Duration::from_seconds(context.get_time());
     for (const drake::geometry::FrameId& frame_id :
          inspector.GetAllFrameIds()) {
       if (frame_id == inspector.world_frame_id()) {
         continue;
       }
-      if (impl_->parent_frames_map.find(frame_id) !=
-          impl_->parent_frames_map.end()) {
-        auto& parent_frame = impl_->parent_frames_map[frame_id];
-        parent_frame.X_PC.header.stamp =
-            rclcpp::Time() + rclcpp::Duration::from_seconds(context.get_time());
+      // N.B. The precomputed frame hierarchy is shared by all contexts and
+      // thus must not be modified here.
+      auto it = impl_->parent_frames_map.find(frame_id);
+      if (it != impl_->parent_frames_map.end()) {
+        const SceneTfSystem::Impl::Frame& parent_frame = it->second;
+        output_value->transforms.push_back(parent_frame.X_PC);
+        geometry_msgs::msg::TransformStamped& transform =
+            output_value->transforms.back();
+        transform.header.stamp = stamp;
         auto X_WP = query_object.GetPoseInParent(parent_frame.id);
         auto X_WC = query_object.GetPoseInParent(frame_id);
-        parent_frame.X_PC.transform =
+        transform.transform =
             RigidTransformToRosTransform(X_WP.inverse() * X_WC);
-        output_value->transforms.push_back(parent_frame.X_PC);
       } else {
         geometry_msgs::msg::TransformStamped transform;
-        transform.header.stamp =
-            rclcpp::Time() + rclcpp::Duration::from_seconds(context.get_time());
+        transform.header.stamp = stamp;
 
         transform.header.frame_id = GetTfFrameName(
             inspector, impl_->plants, inspector.GetParentFrame(frame_id));
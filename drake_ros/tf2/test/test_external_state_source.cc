@@ -0,0 +1,271 @@
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <drake/geometry/frame_kinematics_vector.h>
+#include <drake/geometry/geometry_frame.h>
+#include <drake/geometry/scene_graph.h>
+#include <drake/math/rigid_transform.h>
+#include <drake/multibody/plant/multibody_plant.h>
+#include <drake/multibody/tree/revolute_joint.h>
+#include <drake/systems/analysis/simulator.h>
+#include <drake/systems/framework/diagram_builder.h>
+#include <drake_ros/core/drake_ros.h>
+#include <drake_ros/core/ros_interface_system.h>
+#include <gtest/gtest.h>
+#include <rclcpp/rclcpp.hpp>
+#include <sensor_msgs/msg/joint_state.hpp>
+#include <tf2_msgs/msg/tf_message.hpp>
+#include <tf2_ros/qos.hpp>
+
+#include "drake_ros/tf2/joint_state_source_system.h"
+#include "drake_ros/tf2/name_conventions.h"
+#include "drake_ros/tf2/tf_pose_source_system.h"
+#include "test_utilities.h"  // NOLINT(build/include)
+
+using drake::math::RigidTransformd;
+using drake::multibody::MultibodyPlant;
+using drake::multibody::RevoluteJoint;
+using drake::multibody::SpatialInertia;
+using drake::systems::Simulator;
+using drake_ros::core::DrakeRos;
+using drake_ros::core::RosInterfaceSystem;
+using drake_ros::tf2::ExternalStateSourceParams;
+using drake_ros::tf2::GetJointName;
+using drake_ros::tf2::JointStateSourceSystem;
+using drake_ros::tf2::TfPoseSourceSystem;
+using drake_ros::tf2::test::PublishUntilReceived;
+
+namespace {
+
+builtin_interfaces::msg::Time ToStamp(double seconds) {
+  return rclcpp::Time(0, 0) + rclcpp::Duration::from_seconds(seconds);
+}
+
+TEST(ExternalStateSource, JointStates) {
+  drake_ros::core::init();
+
+  drake::systems::DiagramBuilder<double> builder;
+  auto system_ros = builder.AddSystem<RosInterfaceSystem>(
+      std::make_unique<DrakeRos>("joint_state_source"));
+
+  auto [plant, scene_graph] =
+      drake::multibody::AddMultibodyPlantSceneGraph(&builder, 0.0);
+  const auto M = SpatialInertia<double>::SolidCubeWithMass(1.0, 0.1);
+  const auto robot = plant.AddModelInstance("robot");
+  const auto& arm = plant.AddRigidBody("arm", robot, M);
+  const auto& forearm = plant.AddRigidBody("forearm", robot, M);
+  const auto& shoulder = plant.AddJoint<RevoluteJoint>(
+      "shoulder", plant.world_body(), {}, arm, {}, Eigen::Vector3d::UnitZ());
+  const auto& elbow = plant.AddJoint<RevoluteJoint>(
+      "elbow", arm, {}, forearm, {}, Eigen::Vector3d::UnitZ());
+  plant.Finalize();
+
+  // N.B. Messages are stamped w.r.t. simulation time below.
+  ExternalStateSourceParams params;
+  params.interpolation_delay = 0.5;
+  params.use_context_time = true;
+  auto source = builder.AddSystem<JointStateSourceSystem>(
+      system_ros->get_ros_interface(), &plant, "/test_joint_states", params);
+  EXPECT_EQ(source->get_positions_output_port().size(),
+            plant.num_positions());
+
+  auto diagram = builder.Build();
+  Simulator<double> simulator(*diagram);
+  const auto& source_context =
+      source->GetMyContextFromRoot(simulator.get_context());
+
+  // Nothing received, default positions.
+  EXPECT_TRUE(source->get_positions_output_port()
+                  .Eval(source_context)
+                  .isApprox(plant.GetDefaultPositions()));
+  EXPECT_TRUE(source->get_received_output_port().Eval(source_context).isZero());
+
+  auto node = rclcpp::Node::make_shared("joint_state_publisher");
+  auto pub = node->create_publisher<sensor_msgs::msg::JointState>(
+      "/test_joint_states", rclcpp::SensorDataQoS());
+  // N.B. Unknown joint names are ignored, and joint order varies.
+  auto make_message = [&](int i) {
+    sensor_msgs::msg::JointState message;
+    message.header.stamp = ToStamp(1.0 + i);
+    message.name = {"unknown", GetJointName(shoulder, &plant),
+                    GetJointName(elbow, &plant)};
+    message.position = {10.0, 1.0 + i, -1.0 - i};
+    if (i > 0) {
+      std::swap(message.name[1], message.name[2]);
+      std::swap(message.position[1], message.position[2]);
+    }
+    return message;
+  };
+  ASSERT_TRUE(PublishUntilReceived<sensor_msgs::msg::JointState>(
+      system_ros->get_ros_interface(), pub, make_message,
+      [&]() { return source->num_messages_received(); }, 2));
+
+  // Samples are only latched into state on step.
+  EXPECT_TRUE(source->get_positions_output_port()
+                  .Eval(source_context)
+                  .isApprox(plant.GetDefaultPositions()));
+
+  // Samples are at 1s and 2s, and are sampled 0.5s behind.
+  simulator.AdvanceTo(2.0);
+  const Eigen::VectorXd& positions =
+      source->get_positions_output_port().Eval(source_context);
+  EXPECT_DOUBLE_EQ(positions[shoulder.position_start()], 1.5);
+  EXPECT_DOUBLE_EQ(positions[elbow.position_start()], -1.5);
+  Eigen::VectorXd expected_received = Eigen::VectorXd::Zero(2);
+  expected_received[shoulder.position_start()] = 1.0;
+  expected_received[elbow.position_start()] = 1.0;
+  EXPECT_EQ(source->get_received_output_port().Eval(source_context),
+            expected_received);
+
+  // Past the last sample, it is held.
+  simulator.AdvanceTo(10.0);
+  EXPECT_DOUBLE_EQ(source->get_positions_output_port().Eval(
+                       source_context)[shoulder.position_start()],
+                   2.0);
+
+  EXPECT_TRUE(drake_ros::core::shutdown());
+}
+
+TEST(ExternalStateSource, TfPoses) {
+  drake_ros::core::init();
+
+  drake::systems::DiagramBuilder<double> builder;
+  auto system_ros = builder.AddSystem<RosInterfaceSystem>(
+      std::make_unique<DrakeRos>("tf_pose_source"));
+
+  auto scene_graph = builder.AddSystem<drake::geometry::SceneGraph>();
+  const drake::geometry::SourceId source_id =
+      scene_graph->RegisterSource("test_source");
+  const drake::geometry::FrameId odom_frame = scene_graph->RegisterFrame(
+      source_id, drake::geometry::GeometryFrame("odom"));
+  const drake::geometry::FrameId base_frame = scene_graph->RegisterFrame(
+      source_id, odom_frame, drake::geometry::GeometryFrame("base_link"));
+
+  // N.B. Messages are stamped w.r.t. simulation time below.
+  ExternalStateSourceParams params;
+  params.interpolation_delay = 0.25;
+  params.use_context_time = true;
+  auto source = builder.AddSystem<TfPoseSourceSystem>(
+      system_ros->get_ros_interface(), *scene_graph, source_id,
+      std::unordered_set<const MultibodyPlant<double>*>{}, "/test_tf",
+      params);
+  builder.Connect(source->get_frame_poses_output_port(),
+                  scene_graph->get_source_pose_port(source_id));
+
+  auto diagram = builder.Build();
+  Simulator<double> simulator(*diagram);
+  const auto& source_context =
+      source->GetMyContextFromRoot(simulator.get_context());
+
+  auto node = rclcpp::Node::make_shared("tf_publisher");
+  auto pub = node->create_publisher<tf2_msgs::msg::TFMessage>(
+      "/test_tf", tf2_ros::DynamicBroadcasterQoS());
+  auto make_message = [&](int i) {
+    tf2_msgs::msg::TFMessage message;
+    geometry_msgs::msg::TransformStamped transform;
+    transform.header.stamp = ToStamp(1.0 + i);
+    transform.header.frame_id = "world";
+    transform.child_frame_id = "odom";
+    transform.transform.translation.x = 1.0 + i;
+    transform.transform.rotation.w = 1.0;
+    message.transforms.push_back(transform);
+    // N.B. This is not the parent frame of base_link in the scene graph.
+    transform.header.frame_id = "world";
+    transform.child_frame_id = "base_link";
+    message.transforms.push_back(transform);
+    return message;
+  };
+  ASSERT_TRUE(PublishUntilReceived<tf2_msgs::msg::TFMessage>(
+      system_ros->get_ros_interface(), pub, make_message,
+      [&]() { return source->num_messages_received(); }, 2));
+
+  // Samples are at 1s and 2s, and are sampled 0.25s behind.
+  simulator.AdvanceTo(1.5);
+  const auto& poses =
+      source->get_frame_poses_output_port()
+          .Eval<drake::geometry::FramePoseVector<double>>(source_context);
+  ASSERT_TRUE(poses.has_id(odom_frame));
+  EXPECT_TRUE(poses.value(odom_frame).IsNearlyEqualTo(
+      RigidTransformd(Eigen::Vector3d(1.25, 0., 0.)), 1e-12));
+  // N.B. base_link has not been received, and has a placeholder pose.
+  ASSERT_TRUE(poses.has_id(base_frame));
+  EXPECT_TRUE(poses.value(base_frame).IsExactlyIdentity());
+  EXPECT_EQ(source->get_received_frames_output_port()
+                .Eval<std::vector<drake::geometry::FrameId>>(source_context),
+            std::vector<drake::geometry::FrameId>{odom_frame});
+
+  EXPECT_TRUE(drake_ros::core::shutdown());
+}
+
+TEST(ExternalStateSource, LiveJointStates) {
+  drake_ros::core::init();
+
+  drake::systems::DiagramBuilder<double> builder;
+  auto system_ros = builder.AddSystem<RosInterfaceSystem>(
+      std::make_unique<DrakeRos>("live_joint_state_source"));
+
+  auto [plant, scene_graph] =
+      drake::multibody::AddMultibodyPlantSceneGraph(&builder, 0.0);
+  const auto M = SpatialInertia<double>::SolidCubeWithMass(1.0, 0.1);
+  const auto& arm = plant.AddRigidBody("arm", M);
+  const auto& shoulder = plant.AddJoint<RevoluteJoint>(
+      "shoulder", plant.world_body(), {}, arm, {}, Eigen::Vector3d::UnitZ());
+  plant.Finalize();
+
+  // Default configuration, as for a digital twin of a live robot.
+  auto source = builder.AddSystem<JointStateSourceSystem>(
+      system_ros->get_ros_interface(), &plant, "/test_live_joint_states");
+
+  auto diagram = builder.Build();
+  Simulator<double> simulator(*diagram);
+  const auto& source_context =
+      source->GetMyContextFromRoot(simulator.get_context());
+
+  // N.B. Messages are stamped w.r.t. the ROS clock, as live robots do, way
+  // past simulation time.
+  auto node = rclcpp::Node::make_shared("live_joint_state_publisher");
+  auto pub = node->create_publisher<sensor_msgs::msg::JointState>(
+      "/test_live_joint_states", rclcpp::SensorDataQoS());
+  const rclcpp::Time now = node->now();
+  auto make_message = [&](int i) {
+    sensor_msgs::msg::JointState message;
+    message.header.stamp = now - rclcpp::Duration::from_seconds(1.0 - i);
+    message.name = {GetJointName(shoulder, &plant)};
+    message.position = {1.0 + i};
+    return message;
+  };
+  ASSERT_TRUE(PublishUntilReceived<sensor_msgs::msg::JointState>(
+      system_ros->get_ros_interface(), pub, make_message,
+      [&]() { return source->num_messages_received(); }, 2));
+
+  // The latest sample is used as-is.
+  simulator.AdvanceTo(0.1);
+  EXPECT_DOUBLE_EQ(source->get_positions_output_port().Eval(
+                       source_context)[shoulder.position_start()],
+                   2.0);
+
+  EXPECT_TRUE(drake_ros::core::shutdown());
+}
+
+}  // namespace
+
+// Only available in Bazel.
+#ifndef _TEST_DISABLE_RMW_ISOLATION
+#include "rmw_isolation/rmw_isolation.h"
+
+int main(int argc, char* argv[]) {
+  const char* TEST_TMPDIR = std::getenv("TEST_TMPDIR");
+  if (TEST_TMPDIR != nullptr) {
+    std::string ros_home = std::string(TEST_TMPDIR) + "/.ros";
+    setenv("ROS_HOME", ros_home.c_str(), 1);
+    ros2::isolate_rmw_by_path(argv[0], TEST_TMPDIR);
+  }
+
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
+#endif
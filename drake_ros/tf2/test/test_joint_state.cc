@@ -0,0 +1,172 @@
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <drake/geometry/scene_graph.h>
+#include <drake/math/rigid_transform.h>
+#include <drake/math/roll_pitch_yaw.h>
+#include <drake/multibody/plant/multibody_plant.h>
+#include <drake/multibody/tree/ball_rpy_joint.h>
+#include <drake/multibody/tree/prismatic_joint.h>
+#include <drake/multibody/tree/revolute_joint.h>
+#include <drake/multibody/tree/weld_joint.h>
+#include <drake/systems/framework/diagram_builder.h>
+#include <gtest/gtest.h>
+#include <sensor_msgs/msg/joint_state.hpp>
+#include <tf2_msgs/msg/tf_message.hpp>
+
+#include "drake_ros/tf2/joint_state_system.h"
+#include "drake_ros/tf2/name_conventions.h"
+#include "drake_ros/tf2/robot_description.h"
+
+using drake::math::RigidTransformd;
+using drake::math::RollPitchYawd;
+using drake::multibody::BallRpyJoint;
+using drake::multibody::ModelInstanceIndex;
+using drake::multibody::MultibodyPlant;
+using drake::multibody::PrismaticJoint;
+using drake::multibody::RevoluteJoint;
+using drake::multibody::RigidBody;
+using drake::multibody::SpatialInertia;
+using drake::multibody::WeldJoint;
+using drake::systems::DiagramBuilder;
+using drake_ros::tf2::GetJointName;
+using drake_ros::tf2::GetRobotDescription;
+using drake_ros::tf2::GetTfFrameName;
+using drake_ros::tf2::JointStateSystem;
+
+namespace {
+
+bool Contains(const std::string& text, const std::string& fragment) {
+  return text.find(fragment) != std::string::npos;
+}
+
+class JointStateTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    auto [plant, scene_graph] =
+        drake::multibody::AddMultibodyPlantSceneGraph(&builder_, 0.0);
+    plant_ = &plant;
+
+    const SpatialInertia<double> M = SpatialInertia<double>::SolidCubeWithMass(
+        1.0, 0.1);
+    robot_ = plant.AddModelInstance("robot");
+    const RigidBody<double>& base = plant.AddRigidBody("base", robot_, M);
+    const RigidBody<double>& arm = plant.AddRigidBody("arm", robot_, M);
+    const RigidBody<double>& slide = plant.AddRigidBody("slide", robot_, M);
+    plant.AddJoint<WeldJoint>("anchor", plant.world_body(),
+                              RigidTransformd(Eigen::Vector3d(0., 0., 1.)),
+                              base, {}, RigidTransformd::Identity());
+    shoulder_ = &plant.AddJoint<RevoluteJoint>(
+        "shoulder", base, RigidTransformd(Eigen::Vector3d(0., 0., 0.5)), arm,
+        {}, Eigen::Vector3d::UnitZ());
+    // N.B. The slider joint frame does not coincide with the slide body
+    // frame.
+    slider_ = &plant.AddJoint<PrismaticJoint>(
+        "slider", arm, {}, slide,
+        RigidTransformd(Eigen::Vector3d(0.1, 0., 0.)),
+        Eigen::Vector3d::UnitX(), -1.0, 1.0);
+
+    box_ = plant.AddModelInstance("box");
+    box_body_ = &plant.AddRigidBody("box", box_, M);
+
+    boxes_ = plant.AddModelInstance("boxes");
+    plant.AddRigidBody("first", boxes_, M);
+    plant.AddRigidBody("second", boxes_, M);
+
+    gimbal_ = plant.AddModelInstance("gimbal");
+    const RigidBody<double>& mount = plant.AddRigidBody("mount", gimbal_, M);
+    plant.AddJoint<BallRpyJoint>("ball", plant.world_body(), {}, mount, {});
+
+    plant.Finalize();
+  }
+
+  DiagramBuilder<double> builder_;
+  MultibodyPlant<double>* plant_{nullptr};
+  ModelInstanceIndex robot_;
+  ModelInstanceIndex box_;
+  ModelInstanceIndex boxes_;
+  ModelInstanceIndex gimbal_;
+  const RevoluteJoint<double>* shoulder_{nullptr};
+  const PrismaticJoint<double>* slider_{nullptr};
+  const RigidBody<double>* box_body_{nullptr};
+};
+
+TEST_F(JointStateTest, RobotDescription) {
+  const std::string urdf = GetRobotDescription(*plant_, robot_);
+  EXPECT_TRUE(Contains(urdf, "<robot name=\"robot\">"));
+  EXPECT_TRUE(Contains(urdf, "<link name=\"world\"/>"));
+  EXPECT_TRUE(
+      Contains(urdf, "<joint name=\"robot/anchor\" type=\"fixed\">"));
+  EXPECT_TRUE(
+      Contains(urdf, "<joint name=\"robot/shoulder\" type=\"continuous\">"));
+  EXPECT_TRUE(
+      Contains(urdf, "<joint name=\"robot/slider\" type=\"prismatic\">"));
+  // The slider joint frame is exported as a link of its own.
+  EXPECT_TRUE(Contains(urdf, "<link name=\"robot/slider\"/>"));
+  EXPECT_TRUE(
+      Contains(urdf, "<joint name=\"robot/slider/child\" type=\"fixed\">"));
+  EXPECT_TRUE(Contains(urdf, "<limit lower=\"-1\" upper=\"1\""));
+  const std::string arm_link =
+      GetTfFrameName(plant_->GetBodyByName("arm", robot_), plant_);
+  EXPECT_TRUE(Contains(urdf, "<link name=\"" + arm_link + "\"/>"));
+
+  // Floating bodies are root links.
+  const std::string box_urdf = GetRobotDescription(*plant_, box_);
+  EXPECT_TRUE(Contains(box_urdf,
+                       "<link name=\"" + GetTfFrameName(*box_body_, plant_) +
+                           "\"/>"));
+  EXPECT_FALSE(Contains(box_urdf, "<joint"));
+
+  EXPECT_THROW(GetRobotDescription(*plant_, boxes_), std::runtime_error);
+  EXPECT_THROW(GetRobotDescription(*plant_, gimbal_), std::runtime_error);
+}
+
+TEST_F(JointStateTest, JointStates) {
+  EXPECT_THROW(JointStateSystem(plant_, {gimbal_}), std::runtime_error);
+
+  auto joint_state =
+      builder_.AddSystem<JointStateSystem>(plant_, std::vector{robot_, box_});
+  EXPECT_TRUE(joint_state->has_floating_joints());
+  builder_.Connect(plant_->get_state_output_port(),
+                   joint_state->get_state_input_port());
+  builder_.Connect(plant_->get_body_poses_output_port(),
+                   joint_state->get_body_poses_input_port());
+  auto diagram = builder_.Build();
+  auto context = diagram->CreateDefaultContext();
+  context->SetTime(1.5);
+  auto& plant_context = plant_->GetMyMutableContextFromRoot(context.get());
+  shoulder_->set_angle(&plant_context, 0.25);
+  shoulder_->set_angular_rate(&plant_context, -1.0);
+  slider_->set_translation(&plant_context, 0.5);
+  const RigidTransformd X_WB(RollPitchYawd(0.1, 0.2, 0.3),
+                             Eigen::Vector3d(1., 2., 3.));
+  plant_->SetFreeBodyPose(&plant_context, *box_body_, X_WB);
+
+  const auto& joint_state_context =
+      joint_state->GetMyContextFromRoot(*context);
+  const auto& joint_states =
+      joint_state->get_joint_states_output_port()
+          .Eval<sensor_msgs::msg::JointState>(joint_state_context);
+  EXPECT_EQ(joint_states.header.stamp.sec, 1);
+  EXPECT_EQ(joint_states.header.stamp.nanosec, 500000000u);
+  ASSERT_EQ(joint_states.name.size(), 2u);
+  EXPECT_EQ(joint_states.name[0], GetJointName(*shoulder_, plant_));
+  EXPECT_EQ(joint_states.name[1], GetJointName(*slider_, plant_));
+  EXPECT_EQ(joint_states.position, (std::vector<double>{0.25, 0.5}));
+  EXPECT_EQ(joint_states.velocity, (std::vector<double>{-1.0, 0.0}));
+
+  const auto& floating_tf =
+      joint_state->get_floating_tf_output_port()
+          .Eval<tf2_msgs::msg::TFMessage>(joint_state_context);
+  ASSERT_EQ(floating_tf.transforms.size(), 1u);
+  const auto& transform = floating_tf.transforms[0];
+  EXPECT_EQ(transform.header.frame_id, "world");
+  EXPECT_EQ(transform.child_frame_id, GetTfFrameName(*box_body_, plant_));
+  EXPECT_NEAR(transform.transform.translation.x, 1., 1e-12);
+  EXPECT_NEAR(transform.transform.translation.y, 2., 1e-12);
+  EXPECT_NEAR(transform.transform.translation.z, 3., 1e-12);
+}
+
+}  // namespace
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <chrono>
+
+#include <drake/systems/framework/context.h>
+#include <drake/systems/framework/system.h>
+#include <drake_ros/core/drake_ros.h>
+#include <rclcpp/publisher.hpp>
+
+namespace drake_ros {
+namespace tf2 {
+namespace test {
+
+// Publishes `expected` messages from `make_message(i)` and spins `ros` until
+// `count()` of them are received, or gives up after a few seconds.
+template <typename MessageT, typename MakeMessage, typename Count>
+bool PublishUntilReceived(drake_ros::core::DrakeRos* ros,
+                          typename rclcpp::Publisher<MessageT>::SharedPtr pub,
+                          MakeMessage make_message, Count count,
+                          int expected) {
+  const auto deadline =
+      std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while (count() < expected) {
+    if (std::chrono::steady_clock::now() > deadline) {
+      return false;
+    }
+    // N.B. Publishing may race discovery, so messages are published again
+    // until received. Repeated samples replace each other.
+    for (int i = 0; i < expected; ++i) {
+      pub->publish(make_message(i));
+    }
+    ros->Spin(10);
+  }
+  return true;
+}
+
+// Applies the per-step unrestricted update events of `system` to `context`,
+// as a simulator does at the start of every step.
+inline void ApplyPerStepUpdates(const drake::systems::System<double>& system,
+                                drake::systems::Context<double>* context) {
+  auto events = system.AllocateCompositeEventCollection();
+  system.GetPerStepEvents(*context, events.get());
+  const auto& updates = events->get_unrestricted_update_events();
+  auto state = context->CloneState();
+  system.CalcUnrestrictedUpdate(*context, updates, state.get());
+  system.ApplyUnrestrictedUpdate(updates, state.get(), context);
+}
+
+}  // namespace test
+}  // namespace tf2
+}  // namespace drake_ros
@@ -0,0 +1,152 @@
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <drake/geometry/scene_graph.h>
+#include <drake/math/rigid_transform.h>
+#include <drake/math/roll_pitch_yaw.h>
+#include <drake/multibody/plant/externally_applied_spatial_force.h>
+#include <drake/multibody/plant/multibody_plant.h>
+#include <drake/systems/framework/diagram_builder.h>
+#include <drake_ros/core/drake_ros.h>
+#include <drake_ros/core/ros_interface_system.h>
+#include <geometry_msgs/msg/wrench_stamped.hpp>
+#include <gtest/gtest.h>
+#include <rclcpp/rclcpp.hpp>
+
+#include "drake_ros/tf2/name_conventions.h"
+#include "drake_ros/tf2/wrench_source_system.h"
+#include "test_utilities.h"  // NOLINT(build/include)
+
+using drake::math::RigidTransformd;
+using drake::math::RollPitchYawd;
+using drake::multibody::ExternallyAppliedSpatialForce;
+using drake::multibody::SpatialInertia;
+using drake_ros::core::DrakeRos;
+using drake_ros::core::RosInterfaceSystem;
+using drake_ros::tf2::GetTfFrameName;
+using drake_ros::tf2::WrenchSourceParams;
+using drake_ros::tf2::WrenchSourceSystem;
+using drake_ros::tf2::test::ApplyPerStepUpdates;
+using drake_ros::tf2::test::PublishUntilReceived;
+
+TEST(WrenchSource, NominalCase) {
+  drake_ros::core::init();
+
+  drake::systems::DiagramBuilder<double> builder;
+  auto system_ros = builder.AddSystem<RosInterfaceSystem>(
+      std::make_unique<DrakeRos>("wrench_source"));
+
+  auto [plant, scene_graph] =
+      drake::multibody::AddMultibodyPlantSceneGraph(&builder, 0.0);
+  const auto M = SpatialInertia<double>::SolidCubeWithMass(1.0, 0.1);
+  const auto& box = plant.AddRigidBody("box", plant.AddModelInstance("robot"),
+                                       M);
+  plant.AddRigidBody("ball", M);
+  plant.Finalize();
+
+  WrenchSourceParams params;
+  params.timeout = 0.5;
+  auto source = builder.AddSystem<WrenchSourceSystem>(
+      system_ros->get_ros_interface(), &plant, "/test_wrenches", params);
+  builder.Connect(plant.get_body_poses_output_port(),
+                  source->get_body_poses_input_port());
+  builder.Connect(source->get_applied_spatial_forces_output_port(),
+                  plant.get_applied_spatial_force_input_port());
+
+  auto diagram = builder.Build();
+  auto context = diagram->CreateDefaultContext();
+  auto& source_context = source->GetMyMutableContextFromRoot(context.get());
+  auto& plant_context = plant.GetMyMutableContextFromRoot(context.get());
+  const RigidTransformd X_WB(RollPitchYawd(0., 0., M_PI / 2.),
+                             Eigen::Vector3d(1., 2., 3.));
+  plant.SetFreeBodyPose(&plant_context, box, X_WB);
+
+  // Nothing received, no wrenches.
+  EXPECT_TRUE(source->get_applied_spatial_forces_output_port()
+                  .Eval<std::vector<ExternallyAppliedSpatialForce<double>>>(
+                      source_context)
+                  .empty());
+
+  auto node = rclcpp::Node::make_shared("wrench_publisher");
+  auto pub = node->create_publisher<geometry_msgs::msg::WrenchStamped>(
+      "/test_wrenches", rclcpp::QoS(10));
+  auto make_message = [&](int i) {
+    geometry_msgs::msg::WrenchStamped message;
+    if (i == 0) {
+      message.header.frame_id = "unknown";
+      message.wrench.force.x = 100.;
+    } else {
+      message.header.frame_id = GetTfFrameName(box, &plant);
+      message.wrench.force.x = 1.;
+      message.wrench.torque.y = 2.;
+    }
+    return message;
+  };
+  ASSERT_TRUE(PublishUntilReceived<geometry_msgs::msg::WrenchStamped>(
+      system_ros->get_ros_interface(), pub, make_message,
+      [&]() { return source->num_messages_received(); }, 2));
+
+  // Wrenches are only latched into state on step.
+  EXPECT_TRUE(source->get_applied_spatial_forces_output_port()
+                  .Eval<std::vector<ExternallyAppliedSpatialForce<double>>>(
+                      source_context)
+                  .empty());
+  ApplyPerStepUpdates(*source, &source_context);
+
+  // Wrenches are applied at the body origin, rotated into the world frame.
+  const auto& forces =
+      source->get_applied_spatial_forces_output_port()
+          .Eval<std::vector<ExternallyAppliedSpatialForce<double>>>(
+              source_context);
+  ASSERT_EQ(forces.size(), 1u);
+  EXPECT_EQ(forces[0].body_index, box.index());
+  EXPECT_TRUE(forces[0].p_BoBq_B.isZero());
+  EXPECT_TRUE(forces[0].F_Bq_W.translational().isApprox(
+      Eigen::Vector3d(0., 1., 0.)));
+  EXPECT_TRUE(forces[0].F_Bq_W.rotational().isApprox(
+      Eigen::Vector3d(-2., 0., 0.)));
+
+  // Forces feed the plant without algebraic loops.
+  EXPECT_NO_THROW(plant.EvalTimeDerivatives(plant_context));
+
+  // Wrenches time out as per Context time, at step boundaries.
+  context->SetTime(0.4);
+  ApplyPerStepUpdates(*source, &source_context);
+  EXPECT_EQ(source->get_applied_spatial_forces_output_port()
+                .Eval<std::vector<ExternallyAppliedSpatialForce<double>>>(
+                    source_context)
+                .size(),
+            1u);
+  context->SetTime(1.0);
+  EXPECT_EQ(source->get_applied_spatial_forces_output_port()
+                .Eval<std::vector<ExternallyAppliedSpatialForce<double>>>(
+                    source_context)
+                .size(),
+            1u);
+  ApplyPerStepUpdates(*source, &source_context);
+  EXPECT_TRUE(source->get_applied_spatial_forces_output_port()
+                  .Eval<std::vector<ExternallyAppliedSpatialForce<double>>>(
+                      source_context)
+                  .empty());
+
+  EXPECT_TRUE(drake_ros::core::shutdown());
+}
+
+// Only available in Bazel.
+#ifndef _TEST_DISABLE_RMW_ISOLATION
+#include "rmw_isolation/rmw_isolation.h"
+
+int main(int argc, char* argv[]) {
+  const char* TEST_TMPDIR = std::getenv("TEST_TMPDIR");
+  if (TEST_TMPDIR != nullptr) {
+    std::string ros_home = std::string(TEST_TMPDIR) + "/.ros";
+    setenv("ROS_HOME", ros_home.c_str(), 1);
+    ros2::isolate_rmw_by_path(argv[0], TEST_TMPDIR);
+  }
+
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
+#endif
@@ -0,0 +1,234 @@
+#include "drake_ros/tf2/tf_pose_source_system.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <drake/common/drake_throw.h>
+#include <drake/geometry/scene_graph_inspector.h>
+#include <drake/math/rigid_transform.h>
+#include <rclcpp/clock.hpp>
+#include <rclcpp/subscription.hpp>
+#include <rclcpp/time.hpp>
+#include <tf2_msgs/msg/tf_message.hpp>
+#include <tf2_ros/qos.hpp>
+
+#include "drake_ros/core/geometry_conversions.h"
+#include "drake_ros/tf2/name_conventions.h"
+#include "internal_sample_buffer.h"  // NOLINT(build/include)
+
+namespace drake_ros {
+namespace tf2 {
+
+using drake_ros::core::RosTransformToRigidTransform;
+
+namespace {
+
+using RigidTransformd = drake::math::RigidTransform<double>;
+
+// Receives tf2 messages. It is shared with the subscription callback, and
+// thus outlives any callback in flight.
+struct Receiver {
+  explicit Receiver(size_t max_log_size) : log(max_log_size) {}
+
+  // Logs the transforms of a tf2 message to known frames.
+  void HandleMessage(const tf2_msgs::msg::TFMessage& message) {
+    std::lock_guard<std::mutex> lock(mutex);
+    const std::vector<int>& slots = layout_cache.Resolve(
+        message.transforms,
+        [](const geometry_msgs::msg::TransformStamped& transform)
+            -> const std::string& { return transform.child_frame_id; });
+    samples.clear();
+    for (size_t i = 0; i < slots.size(); ++i) {
+      if (slots[i] < 0) {
+        continue;
+      }
+      const geometry_msgs::msg::TransformStamped& transform =
+          message.transforms[i];
+      if (transform.header.frame_id != parent_names[slots[i]]) {
+        continue;
+      }
+      // N.B. Transforms without timestamps are timestamped once latched.
+      samples.push_back({slots[i],
+                         rclcpp::Time(transform.header.stamp).nanoseconds(),
+                         RosTransformToRigidTransform(transform.transform)});
+    }
+    log.Append(samples);
+    ++num_messages_received;
+  }
+
+  internal::SampleLog<RigidTransformd> log;
+  std::atomic<int64_t> num_messages_received{0};
+  // Parent frame name of each frame, by slot.
+  std::vector<std::string> parent_names;
+
+  // Guards everything below.
+  std::mutex mutex;
+  internal::NameLayoutCache layout_cache{{}};
+  std::vector<internal::SampleLog<RigidTransformd>::Sample> samples;
+};
+
+}  // namespace
+
+struct TfPoseSourceSystem::Impl {
+  ExternalStateSourceParams params;
+  rclcpp::Clock::SharedPtr clock;
+  // ID of each frame, by slot.
+  std::vector<drake::geometry::FrameId> frame_ids;
+  drake::systems::AbstractStateIndex samples_state_index;
+  drake::systems::OutputPortIndex frame_poses_port_index;
+  drake::systems::OutputPortIndex received_frames_port_index;
+
+  std::shared_ptr<Receiver> receiver;
+  rclcpp::Subscription<tf2_msgs::msg::TFMessage>::SharedPtr sub;
+};
+
+TfPoseSourceSystem::TfPoseSourceSystem(
+    drake_ros::core::DrakeRos* ros,
+    const drake::geometry::SceneGraph<double>& scene_graph,
+    drake::geometry::SourceId source_id,
+    const std::unordered_set<const drake::multibody::MultibodyPlant<double>*>&
+        plants,
+    const std::string& topic_name, ExternalStateSourceParams params)
+    : impl_(new Impl()) {
+  DRAKE_THROW_UNLESS(ros != nullptr);
+  DRAKE_THROW_UNLESS(params.interpolation_delay >= 0.0);
+  DRAKE_THROW_UNLESS(params.max_samples > 0);
+  impl_->params = params;
+
+  // Map frame names to slots once and for all.
+  const drake::geometry::SceneGraphInspector<double>& inspector =
+      scene_graph.model_inspector();
+  DRAKE_THROW_UNLESS(inspector.SourceIsRegistered(source_id));
+  std::unordered_map<std::string, int> slots;
+  std::vector<std::string> parent_names;
+  for (const drake::geometry::FrameId& frame_id :
+       inspector.FramesForSource(source_id)) {
+    slots[GetTfFrameName(inspector, plants, frame_id)] =
+        impl_->frame_ids.size();
+    impl_->frame_ids.push_back(frame_id);
+    parent_names.push_back(
+        GetTfFrameName(inspector, plants, inspector.GetParentFrame(frame_id)));
+  }
+  const size_t num_slots = impl_->frame_ids.size();
+  impl_->receiver = std::make_shared<Receiver>(
+      params.max_samples * std::max<size_t>(num_slots, 1));
+  impl_->receiver->parent_names = std::move(parent_names);
+  impl_->receiver->layout_cache = internal::NameLayoutCache(std::move(slots));
+
+  internal::LatchedSamples<RigidTransformd> samples;
+  samples.buffers.assign(
+      num_slots, internal::SampleBuffer<RigidTransformd>(params.max_samples));
+  impl_->samples_state_index =
+      DeclareAbstractState(drake::Value<internal::LatchedSamples<
+                               RigidTransformd>>(std::move(samples)));
+  DeclarePerStepUnrestrictedUpdateEvent(&TfPoseSourceSystem::LatchSamples);
+
+  impl_->frame_poses_port_index =
+      this->DeclareAbstractOutputPort("frame_poses",
+                                      &TfPoseSourceSystem::CalcFramePoses)
+          .get_index();
+  impl_->received_frames_port_index =
+      this->DeclareAbstractOutputPort(
+              "received_frames", &TfPoseSourceSystem::CalcReceivedFrames,
+              {abstract_state_ticket(impl_->samples_state_index)})
+          .get_index();
+
+  rclcpp::Node* node = ros->get_mutable_node();
+  impl_->clock = node->get_clock();
+  std::shared_ptr<Receiver> receiver = impl_->receiver;
+  impl_->sub = node->create_subscription<tf2_msgs::msg::TFMessage>(
+      topic_name, tf2_ros::DynamicListenerQoS(),
+      [receiver](const tf2_msgs::msg::TFMessage& message) {
+        receiver->HandleMessage(message);
+      });
+}
+
+TfPoseSourceSystem::~TfPoseSourceSystem() {}
+
+int64_t TfPoseSourceSystem::num_messages_received() const {
+  return impl_->receiver->num_messages_received;
+}
+
+const drake::systems::OutputPort<double>&
+TfPoseSourceSystem::get_frame_poses_output_port() const {
+  return get_output_port(impl_->frame_poses_port_index);
+}
+
+const drake::systems::OutputPort<double>&
+TfPoseSourceSystem::get_received_frames_output_port() const {
+  return get_output_port(impl_->received_frames_port_index);
+}
+
+drake::systems::EventStatus TfPoseSourceSystem::LatchSamples(
+    const drake::systems::Context<double>& context,
+    drake::systems::State<double>* state) const {
+  const auto& samples =
+      context.get_abstract_state<internal::LatchedSamples<RigidTransformd>>(
+          impl_->samples_state_index);
+  const bool use_context_time = impl_->params.use_context_time;
+  if (use_context_time &&
+      impl_->receiver->log.sequence() == samples.sequence) {
+    return drake::systems::EventStatus::DidNothing();
+  }
+  auto& latched =
+      state->get_mutable_abstract_state()
+          .get_mutable_value(impl_->samples_state_index)
+          .get_mutable_value<internal::LatchedSamples<RigidTransformd>>();
+  latched.now = use_context_time
+                    ? static_cast<int64_t>(context.get_time() * 1e9)
+                    : impl_->clock->now().nanoseconds();
+  impl_->receiver->log.Latch(latched.now, &latched);
+  return drake::systems::EventStatus::Succeeded();
+}
+
+void TfPoseSourceSystem::CalcFramePoses(
+    const drake::systems::Context<double>& context,
+    drake::geometry::FramePoseVector<double>* output_value) const {
+  const auto& samples =
+      context.get_abstract_state<internal::LatchedSamples<RigidTransformd>>(
+          impl_->samples_state_index);
+  // Without delay, the latest samples are used as-is, whatever their
+  // timestamps are w.r.t. the current time.
+  const bool use_latest = impl_->params.interpolation_delay == 0.0;
+  const int64_t stamp =
+      (impl_->params.use_context_time
+           ? static_cast<int64_t>(context.get_time() * 1e9)
+           : samples.now) -
+      static_cast<int64_t>(impl_->params.interpolation_delay * 1e9);
+  output_value->clear();
+  for (size_t i = 0; i < samples.buffers.size(); ++i) {
+    const internal::SampleBuffer<RigidTransformd>& buffer = samples.buffers[i];
+    if (buffer.empty()) {
+      output_value->set_value(impl_->frame_ids[i],
+                              RigidTransformd::Identity());
+    } else if (use_latest) {
+      output_value->set_value(impl_->frame_ids[i], buffer.latest());
+    } else {
+      output_value->set_value(impl_->frame_ids[i], buffer.Sample(stamp));
+    }
+  }
+}
+
+void TfPoseSourceSystem::CalcReceivedFrames(
+    const drake::systems::Context<double>& context,
+    std::vector<drake::geometry::FrameId>* output_value) const {
+  const auto& samples =
+      context.get_abstract_state<internal::LatchedSamples<RigidTransformd>>(
+          impl_->samples_state_index);
+  output_value->clear();
+  for (size_t i = 0; i < samples.buffers.size(); ++i) {
+    if (!samples.buffers[i].empty()) {
+      output_value->push_back(impl_->frame_ids[i]);
+    }
+  }
+}
+
+}  // namespace tf2
+}  // namespace drake_ros
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include <drake/geometry/frame_kinematics_vector.h>
+#include <drake/geometry/scene_graph.h>
+#include <drake/multibody/plant/multibody_plant.h>
+#include <drake/systems/framework/context.h>
+#include <drake/systems/framework/leaf_system.h>
+#include <drake_ros/core/drake_ros.h>
+
+#include "drake_ros/tf2/external_state_source_params.h"
+
+namespace drake_ros {
+namespace tf2 {
+
+/** System for driving SceneGraph frame poses from external tf2 transforms.
+
+ This system is the digital twin counterpart of SceneTfSystem. It
+ subscribes to a `tf2_msgs/msg/TFMessage` ROS topic, `/tf` by default, and
+ outputs poses for all the frames of a SceneGraph geometry source, sampled
+ from the transforms received. Frames are matched by name, as per
+ GetTfFrameName(), both as child frames and as parent frames of transforms.
+ Transforms w.r.t. any other parent frame are ignored. Names are mapped to
+ frames once per message layout and not once per message. Messages without
+ timestamps are timestamped when latched.
+
+ Frames that have not been received yet are reported by the
+ *received_frames* output port, and have placeholder identity poses
+ meanwhile, as SceneGraph requires poses for all frames of a source. To
+ drive MultibodyPlant frames, whose parent is always the world frame in
+ SceneGraph, prefer a JointStateSourceSystem.
+
+ External state arrives asynchronously. Samples received are latched into
+ state by a per-step unrestricted update event, and thus only change at
+ step boundaries. Output values are a function of Context alone.
+
+ It has no input ports.
+
+ It has two output ports:
+ - *frame_poses* (abstract): poses of the geometry source frames w.r.t.
+   their parent frames, as a drake::geometry::FramePoseVector<double>.
+ - *received_frames* (abstract): IDs of the geometry source frames that
+   have been received, as a std::vector<drake::geometry::FrameId>.
+*/
+class TfPoseSourceSystem : public drake::systems::LeafSystem<double> {
+ public:
+  /** A constructor for the tf pose source system.
+   @param[in] ros interface to a live ROS node to subscribe from.
+   @param[in] scene_graph SceneGraph instance whose frames poses are
+     output for.
+   @param[in] source_id ID of the geometry source to output frame poses
+     for. All of its frames must be registered already.
+   @param[in] plants a set of MultibodyPlant instances from which to derive
+     tf frame names, as for GetTfFrameName().
+   @param[in] topic_name name of the tf2 transforms ROS topic.
+   @param[in] params optional source configuration.
+   */
+  TfPoseSourceSystem(
+      drake_ros::core::DrakeRos* ros,
+      const drake::geometry::SceneGraph<double>& scene_graph,
+      drake::geometry::SourceId source_id,
+      const std::unordered_set<const drake::multibody::MultibodyPlant<double>*>&
+          plants = {},
+      const std::string& topic_name = "/tf",
+      ExternalStateSourceParams params = {});
+
+  ~TfPoseSourceSystem() override;
+
+  /** Returns the number of tf2 messages received so far. */
+  int64_t num_messages_received() const;
+
+  const drake::systems::OutputPort<double>& get_frame_poses_output_port()
+      const;
+
+  const drake::systems::OutputPort<double>& get_received_frames_output_port()
+      const;
+
+ private:
+  drake::systems::EventStatus LatchSamples(
+      const drake::systems::Context<double>& context,
+      drake::systems::State<double>* state) const;
+
+  void CalcFramePoses(
+      const drake::systems::Context<double>& context,
+      drake::geometry::FramePoseVector<double>* output_value) const;
+
+  void CalcReceivedFrames(
+      const drake::systems::Context<double>& context,
+      std::vector<drake::geometry::FrameId>* output_value) const;
+
+  struct Impl;
+  std::unique_ptr<Impl> impl_;
+};
+}  // namespace tf2
+}  // namespace drake_ros
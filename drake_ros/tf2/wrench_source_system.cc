@@ -0,0 +1,263 @@
+#include "drake_ros/tf2/wrench_source_system.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <drake/common/drake_throw.h>
+#include <drake/math/rigid_transform.h>
+#include <geometry_msgs/msg/wrench_stamped.hpp>
+#include <rclcpp/message_memory_strategy.hpp>
+#include <rclcpp/subscription.hpp>
+#include <rclcpp/subscription_options.hpp>
+
+#include "drake_ros/core/geometry_conversions.h"
+#include "drake_ros/tf2/name_conventions.h"
+
+namespace drake_ros {
+namespace tf2 {
+namespace {
+
+using WrenchStamped = geometry_msgs::msg::WrenchStamped;
+
+// Recycles messages once subscription callbacks are done with them, so that
+// messages (and the strings within) are not allocated anew every time.
+class MessagePool
+    : public rclcpp::message_memory_strategy::MessageMemoryStrategy<
+          WrenchStamped> {
+ public:
+  std::shared_ptr<WrenchStamped> borrow_message() override {
+    for (const std::shared_ptr<WrenchStamped>& message : messages_) {
+      if (message.use_count() == 1) {
+        return message;
+      }
+    }
+    messages_.push_back(std::make_shared<WrenchStamped>());
+    return messages_.back();
+  }
+
+  void return_message(std::shared_ptr<WrenchStamped>& message) override {
+    message.reset();
+  }
+
+ private:
+  std::vector<std::shared_ptr<WrenchStamped>> messages_;
+};
+
+// Wrench applied to a body, as latched into a Context.
+struct LatchedWrench {
+  // Whether the wrench is applied, i.e. received and not timed out.
+  bool applied{false};
+  // Sequence number of the wrench message, or zero if none.
+  uint64_t sequence{0};
+  // Context time at which the wrench was latched, in seconds.
+  double time{0.0};
+  drake::multibody::SpatialForce<double> F_Bo_B;
+};
+
+// Wrenches applied to all bodies, by slot, as latched into a Context.
+struct LatchedWrenches {
+  std::vector<LatchedWrench> wrenches;
+  // Sequence number of the last wrench message latched.
+  uint64_t sequence{0};
+};
+
+// Receives wrench messages. It is shared with the subscription callback,
+// and thus outlives any callback in flight.
+class Receiver {
+ public:
+  Receiver(std::unordered_map<std::string, int> slots, size_t num_slots)
+      : slots_(std::move(slots)), wrenches_(num_slots) {}
+
+  // Stores the wrench of a message, if it is for a known body.
+  void HandleMessage(const WrenchStamped& message) {
+    auto it = slots_.find(message.header.frame_id);
+    if (it != slots_.end()) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      LatchedWrench& wrench = wrenches_[it->second];
+      wrench.F_Bo_B = drake_ros::core::RosWrenchToSpatialForce(message.wrench);
+      wrench.applied = true;
+      wrench.sequence = sequence_.load(std::memory_order_relaxed) + 1;
+      sequence_.store(wrench.sequence, std::memory_order_release);
+    }
+    ++num_messages_received_;
+  }
+
+  // Returns the sequence number of the latest wrench, without locking.
+  uint64_t sequence() const {
+    return sequence_.load(std::memory_order_acquire);
+  }
+
+  // Copies the wrenches `latched` has not seen yet into it, timestamped
+  // at Context `time`, and updates its sequence number.
+  void Latch(double time, LatchedWrenches* latched) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (size_t i = 0; i < wrenches_.size(); ++i) {
+      if (wrenches_[i].sequence > latched->sequence) {
+        latched->wrenches[i] = wrenches_[i];
+        latched->wrenches[i].time = time;
+      }
+    }
+    latched->sequence = sequence_.load(std::memory_order_relaxed);
+  }
+
+  int64_t num_messages_received() const { return num_messages_received_; }
+
+ private:
+  // Body slots, by tf frame name.
+  const std::unordered_map<std::string, int> slots_;
+  // Mutex to synchronize access to wrenches.
+  mutable std::mutex mutex_;
+  // Latest wrench received for each body, by slot.
+  std::vector<LatchedWrench> wrenches_;
+  // Number of wrench messages for known bodies received so far.
+  std::atomic<uint64_t> sequence_{0};
+  std::atomic<int64_t> num_messages_received_{0};
+};
+
+}  // namespace
+
+struct WrenchSourceSystem::Impl {
+  WrenchSourceParams params;
+  int num_plant_bodies;
+  // Body index of each body, by slot.
+  std::vector<drake::multibody::BodyIndex> body_indices;
+  drake::systems::AbstractStateIndex wrenches_state_index;
+  drake::systems::InputPortIndex body_poses_port_index;
+  drake::systems::OutputPortIndex applied_spatial_forces_port_index;
+
+  std::shared_ptr<Receiver> receiver;
+  rclcpp::Subscription<WrenchStamped>::SharedPtr sub;
+};
+
+WrenchSourceSystem::WrenchSourceSystem(
+    drake_ros::core::DrakeRos* ros,
+    const drake::multibody::MultibodyPlant<double>* plant,
+    const std::string& topic_name, WrenchSourceParams params)
+    : impl_(new Impl()) {
+  DRAKE_THROW_UNLESS(ros != nullptr);
+  DRAKE_THROW_UNLESS(plant != nullptr);
+  DRAKE_THROW_UNLESS(plant->is_finalized());
+  DRAKE_THROW_UNLESS(params.timeout >= 0.0);
+  impl_->params = params;
+  impl_->num_plant_bodies = plant->num_bodies();
+
+  // Map frame names to bodies once and for all.
+  std::unordered_map<std::string, int> slots;
+  for (int i = 0; i < plant->num_bodies(); ++i) {
+    const drake::multibody::BodyIndex index(i);
+    if (index == plant->world_body().index()) {
+      continue;
+    }
+    slots[GetTfFrameName(plant->get_body(index), plant)] =
+        impl_->body_indices.size();
+    impl_->body_indices.push_back(index);
+  }
+  impl_->receiver = std::make_shared<Receiver>(std::move(slots),
+                                               impl_->body_indices.size());
+
+  LatchedWrenches wrenches;
+  wrenches.wrenches.resize(impl_->body_indices.size());
+  impl_->wrenches_state_index =
+      DeclareAbstractState(drake::Value<LatchedWrenches>(std::move(wrenches)));
+  DeclarePerStepUnrestrictedUpdateEvent(&WrenchSourceSystem::LatchWrenches);
+
+  impl_->body_poses_port_index =
+      this->DeclareAbstractInputPort(
+              "body_poses",
+              drake::Value<std::vector<drake::math::RigidTransform<double>>>())
+          .get_index();
+
+  impl_->applied_spatial_forces_port_index =
+      this->DeclareAbstractOutputPort(
+              "applied_spatial_forces",
+              &WrenchSourceSystem::CalcAppliedSpatialForces)
+          .get_index();
+
+  rclcpp::Node* node = ros->get_mutable_node();
+  std::shared_ptr<Receiver> receiver = impl_->receiver;
+  impl_->sub = node->create_subscription<WrenchStamped>(
+      topic_name, rclcpp::QoS(10),
+      [receiver](const WrenchStamped& message) {
+        receiver->HandleMessage(message);
+      },
+      rclcpp::SubscriptionOptions(), std::make_shared<MessagePool>());
+}
+
+WrenchSourceSystem::~WrenchSourceSystem() {}
+
+int64_t WrenchSourceSystem::num_messages_received() const {
+  return impl_->receiver->num_messages_received();
+}
+
+const drake::systems::InputPort<double>&
+WrenchSourceSystem::get_body_poses_input_port() const {
+  return get_input_port(impl_->body_poses_port_index);
+}
+
+const drake::systems::OutputPort<double>&
+WrenchSourceSystem::get_applied_spatial_forces_output_port() const {
+  return get_output_port(impl_->applied_spatial_forces_port_index);
+}
+
+drake::systems::EventStatus WrenchSourceSystem::LatchWrenches(
+    const drake::systems::Context<double>& context,
+    drake::systems::State<double>* state) const {
+  const double time = context.get_time();
+  const double timeout = impl_->params.timeout;
+  auto timed_out = [time, timeout](const LatchedWrench& wrench) {
+    return wrench.applied && timeout > 0.0 && time - wrench.time > timeout;
+  };
+  const auto& current =
+      context.get_abstract_state<LatchedWrenches>(impl_->wrenches_state_index);
+  if (impl_->receiver->sequence() == current.sequence &&
+      std::none_of(current.wrenches.begin(), current.wrenches.end(),
+                   timed_out)) {
+    return drake::systems::EventStatus::DidNothing();
+  }
+  auto& latched = state->get_mutable_abstract_state()
+                      .get_mutable_value(impl_->wrenches_state_index)
+                      .get_mutable_value<LatchedWrenches>();
+  impl_->receiver->Latch(time, &latched);
+  for (LatchedWrench& wrench : latched.wrenches) {
+    if (timed_out(wrench)) {
+      wrench.applied = false;
+    }
+  }
+  return drake::systems::EventStatus::Succeeded();
+}
+
+void WrenchSourceSystem::CalcAppliedSpatialForces(
+    const drake::systems::Context<double>& context,
+    std::vector<drake::multibody::ExternallyAppliedSpatialForce<double>>*
+        output_value) const {
+  output_value->clear();
+  const auto& X_WB_all =
+      get_body_poses_input_port()
+          .Eval<std::vector<drake::math::RigidTransform<double>>>(context);
+  DRAKE_THROW_UNLESS(static_cast<int>(X_WB_all.size()) ==
+                     impl_->num_plant_bodies);
+  const auto& latched =
+      context.get_abstract_state<LatchedWrenches>(impl_->wrenches_state_index);
+  for (size_t i = 0; i < latched.wrenches.size(); ++i) {
+    const LatchedWrench& wrench = latched.wrenches[i];
+    if (!wrench.applied) {
+      continue;
+    }
+    const drake::multibody::BodyIndex index = impl_->body_indices[i];
+    drake::multibody::ExternallyAppliedSpatialForce<double>& force =
+        output_value->emplace_back();
+    force.body_index = index;
+    force.p_BoBq_B.setZero();
+    force.F_Bq_W = X_WB_all[index].rotation() * wrench.F_Bo_B;
+  }
+}
+
+}  // namespace tf2
+}  // namespace drake_ros
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <drake/multibody/plant/externally_applied_spatial_force.h>
+#include <drake/multibody/plant/multibody_plant.h>
+#include <drake/systems/framework/context.h>
+#include <drake/systems/framework/leaf_system.h>
+#include <drake_ros/core/drake_ros.h>
+
+namespace drake_ros {
+namespace tf2 {
+
+/** Set of parameters that configure a WrenchSourceSystem. */
+struct WrenchSourceParams {
+  /** How long, in seconds, a wrench is applied for once latched, as per
+   Context time. Wrenches time out at step boundaries, like they are
+   latched. If zero, wrenches are applied until replaced. */
+  double timeout{0.0};
+};
+
+/** System for applying external wrenches to MultibodyPlant bodies from ROS.
+
+ This system subscribes to a `geometry_msgs/msg/WrenchStamped` ROS topic,
+ `/applied_wrenches` by default, on which wrenches for any number of bodies
+ are published. Each wrench is applied to the body whose tf frame name, as
+ per GetTfFrameName(), is the wrench frame ID, at the body frame origin and
+ expressed in the body frame. Wrenches for other frames are ignored. Frame
+ names are resolved to bodies once, on construction, and the latest wrench
+ for each body is applied until it is replaced, or until it times out if
+ so configured. Publish a zero wrench to stop applying a wrench.
+
+ Output values are computed without heap allocations once their capacity
+ suffices for all bodies with wrenches applied. Received messages are
+ recycled too.
+
+ External wrenches arrive asynchronously. Wrenches received are latched
+ into state by a per-step unrestricted update event, and thus only change
+ at step boundaries, never within an integration step. Output values are a
+ function of Context alone.
+
+ It has one input port:
+ - *body_poses* (abstract): poses of all bodies in the world frame, as a
+   std::vector<drake::math::RigidTransform<double>> indexed by BodyIndex,
+   e.g. as output by MultibodyPlant::get_body_poses_output_port().
+
+ It has one output port:
+ - *applied_spatial_forces* (abstract): wrenches to apply, as a
+   std::vector<drake::multibody::ExternallyAppliedSpatialForce<double>>,
+   for MultibodyPlant::get_applied_spatial_force_input_port().
+*/
+class WrenchSourceSystem : public drake::systems::LeafSystem<double> {
+ public:
+  /** A constructor for the wrench source system.
+   @param[in] ros interface to a live ROS node to subscribe from.
+   @param[in] plant finalized MultibodyPlant instance, registered with a
+     SceneGraph. It must outlive this system.
+   @param[in] topic_name name of the wrenches ROS topic.
+   @param[in] params optional source configuration.
+   */
+  WrenchSourceSystem(drake_ros::core::DrakeRos* ros,
+                     const drake::multibody::MultibodyPlant<double>* plant,
+                     const std::string& topic_name = "/applied_wrenches",
+                     WrenchSourceParams params = {});
+
+  ~WrenchSourceSystem() override;
+
+  /** Returns the number of wrench messages received so far. */
+  int64_t num_messages_received() const;
+
+  const drake::systems::InputPort<double>& get_body_poses_input_port() const;
+
+  const drake::systems::OutputPort<double>&
+  get_applied_spatial_forces_output_port() const;
+
+ private:
+  drake::systems::EventStatus LatchWrenches(
+      const drake::systems::Context<double>& context,
+      drake::systems::State<double>* state) const;
+
+  void CalcAppliedSpatialForces(
+      const drake::systems::Context<double>& context,
+      std::vector<drake::multibody::ExternallyAppliedSpatialForce<double>>*
+          output_value) const;
+
+  struct Impl;
+  std::unique_ptr<Impl> impl_;
+};
+}  // namespace tf2
+}  // namespace drake_ros
@@ -3,6 +3,7 @@
 #include <algorithm>
 #include <cmath>
 #include <iostream>
+#include <memory>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -19,6 +20,7 @@
 #include <drake/geometry/shape_specification.h>
 #include <drake/math/rigid_transform.h>
 #include <drake/systems/framework/leaf_system.h>
+#include <drake_ros/core/cdr_serializer.h>
 #include <drake_ros/core/drake_ros.h>
 #include <drake_ros/core/geometry_conversions.h>
 #include <drake_ros/core/ros_publisher_system.h>
@@ -400,10 +402,11 @@ ContactMarkersSystem* ConnectContactResultsToRviz(
     const drake::geometry::SceneGraph<double>& scene_graph, core::DrakeRos* ros,
     ContactConnectionParams params) {
   // System that publishes ROS messages
-  auto* markers_publisher = builder->AddSystem(
-      core::RosPublisherSystem::Make<visualization_msgs::msg::MarkerArray>(
-          params.markers_topic, params.markers_qos, ros,
-          params.publish_triggers, params.publish_period));
+  auto* markers_publisher = builder->AddSystem<core::RosPublisherSystem>(
+      std::make_shared<
+          core::CdrSerializer<visualization_msgs::msg::MarkerArray>>(),
+      params.markers_topic, params.markers_qos, ros, params.publish_triggers,
+      params.publish_period);
 
   // System that turns contact results into ROS Messages
   ContactMarkersSystem* contact_markers =
@@ -0,0 +1,803 @@
+#include "drake_ros/viz/foxglove_server.h"
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <drake/common/drake_throw.h>
+#include <rclcpp/logger.hpp>
+#include <rclcpp/logging.hpp>
+
+#include "internal_json.h"                // NOLINT(build/include)
+#include "internal_message_definition.h"  // NOLINT(build/include)
+#include "internal_websocket.h"           // NOLINT(build/include)
+
+namespace drake_ros {
+namespace viz {
+namespace {
+using Clock = std::chrono::steady_clock;
+using internal::JsonValue;
+using internal::WebSocketMessage;
+using internal::WebSocketOpcode;
+
+// WebSocket subprotocol spoken by this server.
+constexpr char kSubprotocol[] = "foxglove.websocket.v1";
+// Largest client message to accept, in bytes.
+constexpr size_t kMaxClientMessageSize = 1024 * 1024;
+// Largest client handshake request to accept, in bytes.
+constexpr size_t kMaxHandshakeSize = 16 * 1024;
+// Most chunks to send at once.
+constexpr int kMaxChunksPerSend = 64;
+// Opcode of server message data, in binary messages.
+constexpr uint8_t kMessageDataOpcode = 0x01;
+// Foxglove status message levels.
+constexpr int kWarningLevel = 1;
+constexpr int kErrorLevel = 2;
+
+// Latest message written to a topic.
+struct Channel {
+  std::string topic_name;
+  std::string type_name;
+  std::shared_ptr<const rclcpp::SerializedMessage> message;
+  uint64_t timestamp{0};
+  // Number of messages written so far.
+  uint64_t sequence{0};
+};
+
+// A channel as advertised to clients.
+struct AdvertisedChannel {
+  std::string topic_name;
+  std::string type_name;
+  std::string schema;
+};
+
+struct Subscription {
+  uint32_t channel_id;
+  // Sequence number of the last message sent, if any.
+  uint64_t sequence{0};
+  // Earliest time at which a message may be sent again.
+  Clock::time_point next_send_time{Clock::time_point::min()};
+};
+
+// Bytes pending sending. Message payloads are shared, not copied.
+struct Chunk {
+  const uint8_t* data() const {
+    return message ? message->get_rcl_serialized_message().buffer
+                   : reinterpret_cast<const uint8_t*>(bytes.data());
+  }
+
+  size_t size() const {
+    return message ? message->get_rcl_serialized_message().buffer_length
+                   : bytes.size();
+  }
+
+  std::string bytes;
+  std::shared_ptr<const rclcpp::SerializedMessage> message;
+};
+
+struct Client {
+  explicit Client(int fd_in) : fd(fd_in), decoder(kMaxClientMessageSize) {}
+
+  int fd;
+  // Whether the WebSocket handshake is complete.
+  bool connected{false};
+  // Whether to disconnect once all pending bytes have been sent.
+  bool closing{false};
+  std::string handshake;
+  internal::WebSocketDecoder decoder;
+  std::deque<Chunk> outbound;
+  // Bytes already sent from the first outbound chunk.
+  size_t outbound_offset{0};
+  // Bytes pending sending, in total.
+  size_t outbound_size{0};
+  // Subscriptions by ID.
+  std::map<uint32_t, Subscription> subscriptions;
+};
+
+void SetNonBlocking(int fd) {
+  fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+}
+
+std::runtime_error MakeSystemError(const std::string& what) {
+  return std::runtime_error(what + ": " + std::strerror(errno));
+}
+
+// Appends `value` to `buffer`, little endian.
+template <typename T>
+void AppendLittleEndian(T value, std::string* buffer) {
+  for (size_t i = 0; i < sizeof(T); ++i) {
+    buffer->push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+  }
+}
+
+// Returns whether `value` is a non-negative integer that fits 32 bits.
+bool IsUint32(const JsonValue* value) {
+  return value != nullptr && value->type == JsonValue::Type::kNumber &&
+         value->number >= 0 && value->number <= 0xFFFFFFFF &&
+         value->number == static_cast<uint32_t>(value->number);
+}
+
+bool ContainsToken(const std::string& list, const std::string& token) {
+  size_t begin = 0;
+  while (begin <= list.size()) {
+    size_t end = list.find(',', begin);
+    if (end == std::string::npos) {
+      end = list.size();
+    }
+    std::string item = list.substr(begin, end - begin);
+    item.erase(0, item.find_first_not_of(" \t"));
+    item.erase(item.find_last_not_of(" \t") + 1);
+    if (item == token) {
+      return true;
+    }
+    begin = end + 1;
+  }
+  return false;
+}
+
+std::string ToLower(std::string string) {
+  std::transform(string.begin(), string.end(), string.begin(),
+                 [](unsigned char c) { return std::tolower(c); });
+  return string;
+}
+}  // namespace
+
+struct FoxgloveServer::Impl {
+  void Wake() {
+    if (!wake_pending.exchange(true)) {
+      const char byte = 0;
+      [[maybe_unused]] const ssize_t ret = write(wake_fds[1], &byte, 1);
+    }
+  }
+
+  void Run();
+
+  void Accept();
+
+  // Returns false if the client must be dropped.
+  bool Receive(Client* client);
+
+  void HandleHandshake(Client* client);
+
+  void HandleMessage(Client* client, const WebSocketMessage& message);
+
+  void HandleSubscribe(Client* client, const JsonValue& request);
+
+  void HandleUnsubscribe(Client* client, const JsonValue& request);
+
+  // Resolves schemas for and advertises new channels, if any.
+  void AdvertiseNewChannels();
+
+  std::string MakeAdvertisement(const std::vector<uint32_t>& channel_ids);
+
+  void SendText(Client* client, const std::string& text);
+
+  void SendStatus(Client* client, int level, const std::string& message);
+
+  // Queues latest messages for clients, within rate and buffer limits.
+  // Returns the earliest time at which rate limited messages may be sent,
+  // if any.
+  std::optional<Clock::time_point> Dispatch(Clock::time_point now);
+
+  // Returns false if the client must be dropped.
+  bool Flush(Client* client);
+
+  FoxgloveServerParams params;
+  Clock::duration min_send_period{Clock::duration::zero()};
+  std::string session_id;
+  int listen_fd{-1};
+  int wake_fds[2]{-1, -1};
+  uint16_t port{0};
+  std::atomic<bool> wake_pending{false};
+  std::atomic<bool> stop{false};
+  std::atomic<int> num_clients{0};
+  std::thread thread;
+
+  // Guards all channel state shared with writers.
+  std::mutex mutex;
+  // Channels by ID.
+  std::map<uint32_t, Channel> channels;
+  // Channel IDs by topic name.
+  std::unordered_map<std::string, uint32_t> channel_ids;
+  uint32_t next_channel_id{1};
+  bool has_new_channels{false};
+
+  // I/O thread state.
+  std::map<uint32_t, AdvertisedChannel> advertised_channels;
+  std::unordered_set<uint32_t> failed_channel_ids;
+  std::vector<std::unique_ptr<Client>> clients;
+};
+
+void FoxgloveServer::Impl::Run() {
+  std::vector<pollfd> poll_fds;
+  while (!stop) {
+    AdvertiseNewChannels();
+    const Clock::time_point now = Clock::now();
+    const std::optional<Clock::time_point> next_send_time = Dispatch(now);
+
+    // Send what can be sent, and drop clients that are gone.
+    for (auto it = clients.begin(); it != clients.end();) {
+      Client* client = it->get();
+      if (Flush(client) && !(client->closing && client->outbound.empty())) {
+        ++it;
+        continue;
+      }
+      close(client->fd);
+      if (client->connected) {
+        --num_clients;
+      }
+      it = clients.erase(it);
+    }
+
+    poll_fds.clear();
+    poll_fds.push_back({wake_fds[0], POLLIN, 0});
+    poll_fds.push_back({listen_fd, POLLIN, 0});
+    for (const auto& client : clients) {
+      const int16_t events =
+          client->outbound.empty() ? POLLIN : (POLLIN | POLLOUT);
+      poll_fds.push_back({client->fd, events, 0});
+    }
+    int timeout_ms = -1;
+    if (next_send_time) {
+      timeout_ms = static_cast<int>(
+          std::chrono::ceil<std::chrono::milliseconds>(*next_send_time - now)
+              .count());
+      timeout_ms = std::max(timeout_ms, 0);
+    }
+    if (poll(poll_fds.data(), poll_fds.size(), timeout_ms) < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      RCLCPP_ERROR(rclcpp::get_logger("drake_ros"),
+                   "Foxglove server poll failed: %s", std::strerror(errno));
+      break;
+    }
+    if ((poll_fds[0].revents & POLLIN) != 0) {
+      // N.B. Clear the flag first, so that no wake up is ever missed.
+      wake_pending = false;
+      char bytes[64];
+      while (read(wake_fds[0], bytes, sizeof(bytes)) > 0) {
+      }
+    }
+    // N.B. Clients accepted below are not in poll_fds yet.
+    const size_t num_polled_clients = poll_fds.size() - 2;
+    for (size_t i = 0; i < num_polled_clients; ++i) {
+      Client* client = clients[i].get();
+      if ((poll_fds[i + 2].revents & (POLLIN | POLLHUP | POLLERR)) != 0 &&
+          !Receive(client)) {
+        // Drop the client without sending anything else.
+        client->outbound.clear();
+        client->outbound_offset = 0;
+        client->outbound_size = 0;
+        client->closing = true;
+      }
+    }
+    if ((poll_fds[1].revents & POLLIN) != 0) {
+      Accept();
+    }
+  }
+
+  // Say goodbye (1001, going away) to all clients.
+  for (const auto& client : clients) {
+    if (client->connected && !client->closing) {
+      Chunk chunk;
+      internal::AppendWebSocketFrame(WebSocketOpcode::kClose,
+                                     std::string("\x03\xE9", 2),
+                                     &chunk.bytes);
+      client->outbound_size += chunk.size();
+      client->outbound.push_back(std::move(chunk));
+      Flush(client.get());
+    }
+    close(client->fd);
+  }
+  clients.clear();
+  num_clients = 0;
+}
+
+void FoxgloveServer::Impl::Accept() {
+  while (true) {
+    const int fd = accept(listen_fd, nullptr, nullptr);
+    if (fd < 0) {
+      if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+        RCLCPP_WARN(rclcpp::get_logger("drake_ros"),
+                    "Foxglove server failed to accept client: %s",
+                    std::strerror(errno));
+      }
+      if (errno != EINTR) {
+        return;
+      }
+      continue;
+    }
+    SetNonBlocking(fd);
+    clients.push_back(std::make_unique<Client>(fd));
+  }
+}
+
+bool FoxgloveServer::Impl::Receive(Client* client) {
+  char buffer[4096];
+  while (true) {
+    const ssize_t size = recv(client->fd, buffer, sizeof(buffer), 0);
+    if (size == 0) {
+      return false;  // client hung up
+    }
+    if (size < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      if (errno == EAGAIN || errno == EWOULDBLOCK) {
+        break;
+      }
+      return false;
+    }
+    if (client->closing) {
+      continue;  // discard anything else
+    }
+    if (client->connected) {
+      client->decoder.Feed(buffer, size);
+    } else {
+      client->handshake.append(buffer, size);
+    }
+  }
+  if (!client->connected && !client->closing) {
+    if (client->handshake.find("\r\n\r\n") == std::string::npos) {
+      return client->handshake.size() <= kMaxHandshakeSize;
+    }
+    HandleHandshake(client);
+  }
+  while (client->connected && !client->closing) {
+    std::optional<WebSocketMessage> message;
+    if (!client->decoder.Next(&message)) {
+      return false;
+    }
+    if (!message) {
+      break;
+    }
+    HandleMessage(client, *message);
+  }
+  return true;
+}
+
+void FoxgloveServer::Impl::HandleHandshake(Client* client) {
+  const size_t head_end = client->handshake.find("\r\n\r\n");
+  const std::optional<internal::HttpRequest> request =
+      internal::ParseHttpRequest(client->handshake.substr(0, head_end));
+  // Any bytes past the request are WebSocket frames.
+  client->decoder.Feed(client->handshake.data() + head_end + 4,
+                       client->handshake.size() - head_end - 4);
+  client->handshake.clear();
+
+  std::optional<std::string> key;
+  bool valid = false;
+  if (request && request->method == "GET") {
+    key = request->GetHeader("sec-websocket-key");
+    const std::optional<std::string> upgrade = request->GetHeader("upgrade");
+    const std::optional<std::string> protocols =
+        request->GetHeader("sec-websocket-protocol");
+    valid = key && upgrade && ToLower(*upgrade) == "websocket" &&
+            protocols && ContainsToken(*protocols, kSubprotocol);
+  }
+  Chunk chunk;
+  if (!valid) {
+    chunk.bytes =
+        "HTTP/1.1 400 Bad Request\r\n"
+        "Connection: close\r\n"
+        "Content-Length: 0\r\n\r\n";
+    client->outbound_size += chunk.size();
+    client->outbound.push_back(std::move(chunk));
+    client->closing = true;
+    return;
+  }
+  chunk.bytes = std::string(
+                    "HTTP/1.1 101 Switching Protocols\r\n"
+                    "Upgrade: websocket\r\n"
+                    "Connection: Upgrade\r\n"
+                    "Sec-WebSocket-Accept: ") +
+                internal::ComputeWebSocketAccept(*key) +
+                "\r\nSec-WebSocket-Protocol: " + kSubprotocol + "\r\n\r\n";
+  client->outbound_size += chunk.size();
+  client->outbound.push_back(std::move(chunk));
+  client->connected = true;
+  ++num_clients;
+
+  SendText(client, "{\"op\":\"serverInfo\",\"name\":" +
+                       internal::QuoteJsonString(params.name) +
+                       ",\"capabilities\":[],\"supportedEncodings\":[]"
+                       ",\"metadata\":{},\"sessionId\":" +
+                       internal::QuoteJsonString(session_id) + "}");
+  if (!advertised_channels.empty()) {
+    std::vector<uint32_t> channel_ids;
+    for (const auto& [channel_id, channel] : advertised_channels) {
+      channel_ids.push_back(channel_id);
+    }
+    SendText(client, MakeAdvertisement(channel_ids));
+  }
+}
+
+void FoxgloveServer::Impl::HandleMessage(Client* client,
+                                         const WebSocketMessage& message) {
+  switch (message.opcode) {
+    case WebSocketOpcode::kText: {
+      const std::optional<JsonValue> request =
+          internal::ParseJson(message.payload);
+      const JsonValue* op = request ? request->Find("op") : nullptr;
+      if (op == nullptr || op->type != JsonValue::Type::kString) {
+        SendStatus(client, kErrorLevel, "Malformed request");
+      } else if (op->string == "subscribe") {
+        HandleSubscribe(client, *request);
+      } else if (op->string == "unsubscribe") {
+        HandleUnsubscribe(client, *request);
+      } else {
+        SendStatus(client, kWarningLevel,
+                   "Unsupported operation '" + op->string + "'");
+      }
+      break;
+    }
+    case WebSocketOpcode::kBinary:
+      SendStatus(client, kWarningLevel, "Client messages are not supported");
+      break;
+    case WebSocketOpcode::kPing: {
+      Chunk chunk;
+      internal::AppendWebSocketFrame(WebSocketOpcode::kPong, message.payload,
+                                     &chunk.bytes);
+      client->outbound_size += chunk.size();
+      client->outbound.push_back(std::move(chunk));
+      break;
+    }
+    case WebSocketOpcode::kClose: {
+      // Echo the status code, if any, and disconnect.
+      Chunk chunk;
+      internal::AppendWebSocketFrame(WebSocketOpcode::kClose,
+                                     message.payload.substr(0, 2),
+                                     &chunk.bytes);
+      client->outbound_size += chunk.size();
+      client->outbound.push_back(std::move(chunk));
+      client->closing = true;
+      break;
+    }
+    default:
+      break;
+  }
+}
+
+void FoxgloveServer::Impl::HandleSubscribe(Client* client,
+                                           const JsonValue& request) {
+  const JsonValue* subscriptions = request.Find("subscriptions");
+  if (subscriptions == nullptr ||
+      subscriptions->type != JsonValue::Type::kArray) {
+    SendStatus(client, kErrorLevel, "Malformed subscribe request");
+    return;
+  }
+  for (const JsonValue& subscription : subscriptions->array) {
+    const JsonValue* id = subscription.Find("id");
+    const JsonValue* channel_id = subscription.Find("channelId");
+    if (!IsUint32(id) || !IsUint32(channel_id)) {
+      SendStatus(client, kErrorLevel, "Malformed subscription");
+      continue;
+    }
+    const uint32_t subscription_id = static_cast<uint32_t>(id->number);
+    const uint32_t subscribed_channel_id =
+        static_cast<uint32_t>(channel_id->number);
+    if (advertised_channels.count(subscribed_channel_id) == 0) {
+      SendStatus(client, kErrorLevel,
+                 "Unknown channel " + std::to_string(subscribed_channel_id));
+      continue;
+    }
+    if (client->subscriptions.count(subscription_id) > 0) {
+      SendStatus(client, kErrorLevel,
+                 "Subscription " + std::to_string(subscription_id) +
+                     " already exists");
+      continue;
+    }
+    client->subscriptions.emplace(subscription_id,
+                                  Subscription{subscribed_channel_id});
+  }
+}
+
+void FoxgloveServer::Impl::HandleUnsubscribe(Client* client,
+                                             const JsonValue& request) {
+  const JsonValue* subscription_ids = request.Find("subscriptionIds");
+  if (subscription_ids == nullptr ||
+      subscription_ids->type != JsonValue::Type::kArray) {
+    SendStatus(client, kErrorLevel, "Malformed unsubscribe request");
+    return;
+  }
+  for (const JsonValue& subscription_id : subscription_ids->array) {
+    if (IsUint32(&subscription_id)) {
+      client->subscriptions.erase(
+          static_cast<uint32_t>(subscription_id.number));
+    }
+  }
+}
+
+void FoxgloveServer::Impl::AdvertiseNewChannels() {
+  std::vector<std::pair<uint32_t, AdvertisedChannel>> new_channels;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!has_new_channels) {
+      return;
+    }
+    has_new_channels = false;
+    for (const auto& [channel_id, channel] : channels) {
+      if (advertised_channels.count(channel_id) == 0 &&
+          failed_channel_ids.count(channel_id) == 0) {
+        new_channels.emplace_back(
+            channel_id,
+            AdvertisedChannel{channel.topic_name, channel.type_name, {}});
+      }
+    }
+  }
+  // N.B. Schemas are resolved outside the lock, as this takes file I/O.
+  std::vector<uint32_t> new_channel_ids;
+  for (auto& [channel_id, channel] : new_channels) {
+    try {
+      channel.schema = internal::GetFullMessageDefinition(channel.type_name);
+    } catch (const std::runtime_error& e) {
+      RCLCPP_WARN(rclcpp::get_logger("drake_ros"),
+                  "Foxglove server cannot advertise %s: %s",
+                  channel.topic_name.c_str(), e.what());
+      failed_channel_ids.insert(channel_id);
+      continue;
+    }
+    advertised_channels.emplace(channel_id, std::move(channel));
+    new_channel_ids.push_back(channel_id);
+  }
+  if (new_channel_ids.empty()) {
+    return;
+  }
+  const std::string advertisement = MakeAdvertisement(new_channel_ids);
+  for (const auto& client : clients) {
+    if (client->connected && !client->closing) {
+      SendText(client.get(), advertisement);
+    }
+  }
+}
+
+std::string FoxgloveServer::Impl::MakeAdvertisement(
+    const std::vector<uint32_t>& channel_ids) {
+  std::string advertisement = "{\"op\":\"advertise\",\"channels\":[";
+  for (size_t i = 0; i < channel_ids.size(); ++i) {
+    const AdvertisedChannel& channel = advertised_channels.at(channel_ids[i]);
+    if (i > 0) {
+      advertisement += ",";
+    }
+    advertisement +=
+        "{\"id\":" + std::to_string(channel_ids[i]) +
+        ",\"topic\":" + internal::QuoteJsonString(channel.topic_name) +
+        ",\"encoding\":\"cdr\",\"schemaName\":" +
+        internal::QuoteJsonString(channel.type_name) +
+        ",\"schema\":" + internal::QuoteJsonString(channel.schema) +
+        ",\"schemaEncoding\":\"ros2msg\"}";
+  }
+  advertisement += "]}";
+  return advertisement;
+}
+
+void FoxgloveServer::Impl::SendText(Client* client, const std::string& text) {
+  Chunk chunk;
+  internal::AppendWebSocketFrame(WebSocketOpcode::kText, text, &chunk.bytes);
+  client->outbound_size += chunk.size();
+  client->outbound.push_back(std::move(chunk));
+}
+
+void FoxgloveServer::Impl::SendStatus(Client* client, int level,
+                                      const std::string& message) {
+  SendText(client, "{\"op\":\"status\",\"level\":" + std::to_string(level) +
+                       ",\"message\":" + internal::QuoteJsonString(message) +
+                       "}");
+}
+
+std::optional<Clock::time_point> FoxgloveServer::Impl::Dispatch(
+    Clock::time_point now) {
+  // Take the latest message on every advertised channel.
+  struct LatestMessage {
+    std::shared_ptr<const rclcpp::SerializedMessage> message;
+    uint64_t timestamp;
+    uint64_t sequence;
+  };
+  std::map<uint32_t, LatestMessage> latest;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const auto& [channel_id, channel] : channels) {
+      if (channel.message && advertised_channels.count(channel_id) > 0) {
+        latest.emplace(channel_id,
+                       LatestMessage{channel.message, channel.timestamp,
+                                     channel.sequence});
+      }
+    }
+  }
+  std::optional<Clock::time_point> next_send_time;
+  for (const auto& client : clients) {
+    if (!client->connected || client->closing) {
+      continue;
+    }
+    for (auto& [subscription_id, subscription] : client->subscriptions) {
+      auto it = latest.find(subscription.channel_id);
+      if (it == latest.end() || it->second.sequence == subscription.sequence) {
+        continue;  // nothing new
+      }
+      if (subscription.next_send_time > now) {
+        if (!next_send_time || subscription.next_send_time < *next_send_time) {
+          next_send_time = subscription.next_send_time;
+        }
+        continue;
+      }
+      if (client->outbound_size >= params.max_send_buffer_size) {
+        // Wait for the client to catch up.
+        break;
+      }
+      const LatestMessage& channel = it->second;
+      Chunk header;
+      const uint64_t payload_size =
+          13 + channel.message->get_rcl_serialized_message().buffer_length;
+      internal::AppendWebSocketFrameHeader(WebSocketOpcode::kBinary,
+                                           payload_size, &header.bytes);
+      header.bytes.push_back(static_cast<char>(kMessageDataOpcode));
+      AppendLittleEndian<uint32_t>(subscription_id, &header.bytes);
+      AppendLittleEndian<uint64_t>(channel.timestamp, &header.bytes);
+      Chunk payload;
+      payload.message = channel.message;
+      client->outbound_size += header.size() + payload.size();
+      client->outbound.push_back(std::move(header));
+      client->outbound.push_back(std::move(payload));
+      subscription.sequence = channel.sequence;
+      subscription.next_send_time = now + min_send_period;
+    }
+  }
+  return next_send_time;
+}
+
+bool FoxgloveServer::Impl::Flush(Client* client) {
+  while (!client->outbound.empty()) {
+    iovec chunks[kMaxChunksPerSend];
+    int num_chunks = 0;
+    for (const Chunk& chunk : client->outbound) {
+      if (num_chunks == kMaxChunksPerSend) {
+        break;
+      }
+      const size_t offset = num_chunks == 0 ? client->outbound_offset : 0;
+      chunks[num_chunks].iov_base =
+          const_cast<uint8_t*>(chunk.data()) + offset;
+      chunks[num_chunks].iov_len = chunk.size() - offset;
+      ++num_chunks;
+    }
+    msghdr header{};
+    header.msg_iov = chunks;
+    header.msg_iovlen = num_chunks;
+    const ssize_t size = sendmsg(client->fd, &header, MSG_NOSIGNAL);
+    if (size < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return errno == EAGAIN || errno == EWOULDBLOCK;
+    }
+    client->outbound_size -= size;
+    size_t remaining = size;
+    while (!client->outbound.empty()) {
+      const size_t left =
+          client->outbound.front().size() - client->outbound_offset;
+      if (remaining < left) {
+        client->outbound_offset += remaining;
+        break;
+      }
+      remaining -= left;
+      client->outbound.pop_front();
+      client->outbound_offset = 0;
+    }
+  }
+  return true;
+}
+
+FoxgloveServer::FoxgloveServer(FoxgloveServerParams params)
+    : impl_(new Impl()) {
+  DRAKE_THROW_UNLESS(params.max_rate_per_client >= 0.0);
+  impl_->params = std::move(params);
+  if (impl_->params.max_rate_per_client > 0.0) {
+    impl_->min_send_period = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>(1.0 /
+                                      impl_->params.max_rate_per_client));
+  }
+  impl_->session_id = std::to_string(
+      std::chrono::system_clock::now().time_since_epoch().count());
+
+  sockaddr_in address{};
+  address.sin_family = AF_INET;
+  address.sin_port = htons(impl_->params.port);
+  if (inet_pton(AF_INET, impl_->params.address.c_str(), &address.sin_addr) !=
+      1) {
+    throw std::runtime_error("invalid IPv4 address '" +
+                             impl_->params.address + "'");
+  }
+  impl_->listen_fd = socket(AF_INET, SOCK_STREAM, 0);
+  if (impl_->listen_fd < 0) {
+    throw MakeSystemError("cannot create socket");
+  }
+  const int enable = 1;
+  setsockopt(impl_->listen_fd, SOL_SOCKET, SO_REUSEADDR, &enable,
+             sizeof(enable));
+  if (bind(impl_->listen_fd, reinterpret_cast<sockaddr*>(&address),
+           sizeof(address)) < 0 ||
+      listen(impl_->listen_fd, SOMAXCONN) < 0) {
+    const std::runtime_error error = MakeSystemError(
+        "cannot listen on " + impl_->params.address + ":" +
+        std::to_string(impl_->params.port));
+    close(impl_->listen_fd);
+    throw error;
+  }
+  socklen_t address_size = sizeof(address);
+  getsockname(impl_->listen_fd, reinterpret_cast<sockaddr*>(&address),
+              &address_size);
+  impl_->port = ntohs(address.sin_port);
+  SetNonBlocking(impl_->listen_fd);
+
+  if (pipe(impl_->wake_fds) < 0) {
+    const std::runtime_error error = MakeSystemError("cannot create pipe");
+    close(impl_->listen_fd);
+    throw error;
+  }
+  SetNonBlocking(impl_->wake_fds[0]);
+  SetNonBlocking(impl_->wake_fds[1]);
+
+  impl_->thread = std::thread(&Impl::Run, impl_.get());
+}
+
+FoxgloveServer::~FoxgloveServer() {
+  impl_->stop = true;
+  impl_->Wake();
+  impl_->thread.join();
+  close(impl_->listen_fd);
+  close(impl_->wake_fds[0]);
+  close(impl_->wake_fds[1]);
+}
+
+void FoxgloveServer::Write(
+    const std::string& topic_name, const std::string& type_name,
+    std::shared_ptr<const rclcpp::SerializedMessage> message,
+    const rclcpp::Time& time) {
+  DRAKE_THROW_UNLESS(message != nullptr);
+  {
+    std::lock_guard<std::mutex> lock(impl_->mutex);
+    auto it = impl_->channel_ids.find(topic_name);
+    if (it == impl_->channel_ids.end()) {
+      const uint32_t channel_id = impl_->next_channel_id++;
+      it = impl_->channel_ids.emplace(topic_name, channel_id).first;
+      impl_->channels[channel_id].topic_name = topic_name;
+      impl_->channels[channel_id].type_name = type_name;
+      impl_->has_new_channels = true;
+    }
+    Channel& channel = impl_->channels.at(it->second);
+    channel.message = std::move(message);
+    channel.timestamp = static_cast<uint64_t>(time.nanoseconds());
+    ++channel.sequence;
+  }
+  impl_->Wake();
+}
+
+uint16_t FoxgloveServer::port() const { return impl_->port; }
+
+int FoxgloveServer::num_clients() const { return impl_->num_clients; }
+
+}  // namespace viz
+}  // namespace drake_ros
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include <drake_ros/core/message_sink_interface.h>
+#include <rclcpp/serialized_message.hpp>
+#include <rclcpp/time.hpp>
+
+namespace drake_ros {
+namespace viz {
+
+/** Set of parameters that configure a FoxgloveServer. */
+struct FoxgloveServerParams {
+  /** IPv4 address to listen on. */
+  std::string address{"0.0.0.0"};
+
+  /** TCP port to listen on. Zero to listen on any free port. */
+  uint16_t port{8765};
+
+  /** Server name to report to clients. */
+  std::string name{"drake_ros"};
+
+  /** Maximum rate at which messages are sent to each client on each of its
+   subscriptions, in Hz. Zero for no limit. */
+  double max_rate_per_client{30.0};
+
+  /** Maximum number of bytes that may be pending sending to a client before
+   messages to that client are held back. */
+  size_t max_send_buffer_size{10 * 1024 * 1024};
+};
+
+/** A WebSocket server for remote visualization with Foxglove.
+
+ This message sink serves the messages it is fed over the Foxglove
+ WebSocket protocol (`foxglove.websocket.v1`), so that remote clients
+ (e.g. Foxglove) can visualize them without joining the ROS network.
+ Attach it to the publisher systems of an RvizVisualizer, a
+ SceneTfBroadcasterSystem or any other RosPublisherSystem (e.g. one fed
+ by a ContactMarkersSystem) by means of their `AddMessageSink()` methods.
+
+ Each topic written to is advertised as a channel, using CDR encoding and
+ a `ros2msg` schema looked up in the ament index. The serialized messages
+ publishers send to ROS are shared with the server and sent to clients
+ as-is.
+
+ All networking takes place in a background I/O thread, so writes from
+ the simulation loop only take a brief lock to keep a reference to the
+ message. Only the latest message on each topic is kept: clients that
+ cannot keep up with publishers, whether due to the per-client rate limit
+ or to a slow connection, get the latest message when they can take one.
+ Clients that subscribe to a channel get its latest message right away.
+ */
+class FoxgloveServer final : public drake_ros::core::MessageSinkInterface {
+ public:
+  /** A constructor for the Foxglove server.
+    @param[in] params optional server configuration.
+    @throws std::runtime_error if the server cannot listen on the given
+      address and port.
+    */
+  explicit FoxgloveServer(FoxgloveServerParams params = {});
+
+  /** Disconnects all clients and stops the server. */
+  ~FoxgloveServer() override;
+
+  void Write(const std::string& topic_name, const std::string& type_name,
+             std::shared_ptr<const rclcpp::SerializedMessage> message,
+             const rclcpp::Time& time) override;
+
+  /** Returns the TCP port the server listens on. */
+  uint16_t port() const;
+
+  /** Returns the number of clients connected (and past the handshake). */
+  int num_clients() const;
+
+ private:
+  struct Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace viz
+}  // namespace drake_ros
@@ -0,0 +1,302 @@
+#include "internal_json.h"  // NOLINT(build/include)
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <utility>
+
+namespace drake_ros {
+namespace viz {
+namespace internal {
+namespace {
+// Deepest nesting of arrays and objects to parse.
+constexpr int kMaxDepth = 32;
+
+// A recursive descent parser for RFC 8259 JSON.
+class JsonParser {
+ public:
+  explicit JsonParser(const std::string& text) : text_(text) {}
+
+  bool ParseDocument(JsonValue* value) {
+    if (!ParseValue(value, 0)) {
+      return false;
+    }
+    SkipWhitespace();
+    return position_ == text_.size();
+  }
+
+ private:
+  void SkipWhitespace() {
+    while (position_ < text_.size() &&
+           (text_[position_] == ' ' || text_[position_] == '\t' ||
+            text_[position_] == '\n' || text_[position_] == '\r')) {
+      ++position_;
+    }
+  }
+
+  bool Consume(char c) {
+    SkipWhitespace();
+    if (position_ < text_.size() && text_[position_] == c) {
+      ++position_;
+      return true;
+    }
+    return false;
+  }
+
+  bool ConsumeLiteral(const char* literal) {
+    const std::string expected(literal);
+    if (text_.compare(position_, expected.size(), expected) != 0) {
+      return false;
+    }
+    position_ += expected.size();
+    return true;
+  }
+
+  bool ParseValue(JsonValue* value, int depth) {
+    if (depth > kMaxDepth) {
+      return false;
+    }
+    SkipWhitespace();
+    if (position_ >= text_.size()) {
+      return false;
+    }
+    const char c = text_[position_];
+    if (c == '{') {
+      ++position_;
+      value->type = JsonValue::Type::kObject;
+      if (Consume('}')) {
+        return true;
+      }
+      do {
+        std::pair<std::string, JsonValue> member;
+        SkipWhitespace();
+        if (!ParseString(&member.first) || !Consume(':') ||
+            !ParseValue(&member.second, depth + 1)) {
+          return false;
+        }
+        value->object.push_back(std::move(member));
+      } while (Consume(','));
+      return Consume('}');
+    }
+    if (c == '[') {
+      ++position_;
+      value->type = JsonValue::Type::kArray;
+      if (Consume(']')) {
+        return true;
+      }
+      do {
+        JsonValue element;
+        if (!ParseValue(&element, depth + 1)) {
+          return false;
+        }
+        value->array.push_back(std::move(element));
+      } while (Consume(','));
+      return Consume(']');
+    }
+    if (c == '"') {
+      value->type = JsonValue::Type::kString;
+      return ParseString(&value->string);
+    }
+    if (c == 't' || c == 'f') {
+      value->type = JsonValue::Type::kBool;
+      value->boolean = c == 't';
+      return ConsumeLiteral(value->boolean ? "true" : "false");
+    }
+    if (c == 'n') {
+      value->type = JsonValue::Type::kNull;
+      return ConsumeLiteral("null");
+    }
+    value->type = JsonValue::Type::kNumber;
+    return ParseNumber(&value->number);
+  }
+
+  bool ParseNumber(double* number) {
+    const size_t begin = position_;
+    if (position_ < text_.size() && text_[position_] == '-') {
+      ++position_;
+    }
+    const size_t digits_begin = position_;
+    while (position_ < text_.size() &&
+           std::string("0123456789.eE+-").find(text_[position_]) !=
+               std::string::npos) {
+      ++position_;
+    }
+    if (position_ == digits_begin) {
+      return false;
+    }
+    const std::string literal = text_.substr(begin, position_ - begin);
+    char* end = nullptr;
+    *number = std::strtod(literal.c_str(), &end);
+    return end == literal.c_str() + literal.size();
+  }
+
+  bool ParseHex4(uint32_t* code_point) {
+    if (position_ + 4 > text_.size()) {
+      return false;
+    }
+    *code_point = 0;
+    for (int i = 0; i < 4; ++i) {
+      const char c = text_[position_++];
+      *code_point <<= 4;
+      if (c >= '0' && c <= '9') {
+        *code_point |= c - '0';
+      } else if (c >= 'a' && c <= 'f') {
+        *code_point |= c - 'a' + 10;
+      } else if (c >= 'A' && c <= 'F') {
+        *code_point |= c - 'A' + 10;
+      } else {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  static void AppendUtf8(uint32_t code_point, std::string* string) {
+    if (code_point < 0x80) {
+      string->push_back(static_cast<char>(code_point));
+    } else if (code_point < 0x800) {
+      string->push_back(static_cast<char>(0xC0 | (code_point >> 6)));
+      string->push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+    } else if (code_point < 0x10000) {
+      string->push_back(static_cast<char>(0xE0 | (code_point >> 12)));
+      string->push_back(
+          static_cast<char>(0x80 | ((code_point >> 6) & 0x3F)));
+      string->push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+    } else {
+      string->push_back(static_cast<char>(0xF0 | (code_point >> 18)));
+      string->push_back(
+          static_cast<char>(0x80 | ((code_point >> 12) & 0x3F)));
+      string->push_back(
+          static_cast<char>(0x80 | ((code_point >> 6) & 0x3F)));
+      string->push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+    }
+  }
+
+  bool ParseString(std::string* string) {
+    if (position_ >= text_.size() || text_[position_] != '"') {
+      return false;
+    }
+    ++position_;
+    while (position_ < text_.size()) {
+      const char c = text_[position_++];
+      if (c == '"') {
+        return true;
+      }
+      if (static_cast<unsigned char>(c) < 0x20) {
+        return false;
+      }
+      if (c != '\\') {
+        string->push_back(c);
+        continue;
+      }
+      if (position_ >= text_.size()) {
+        return false;
+      }
+      const char escaped = text_[position_++];
+      switch (escaped) {
+        case '"':
+        case '\\':
+        case '/':
+          string->push_back(escaped);
+          break;
+        case 'b':
+          string->push_back('\b');
+          break;
+        case 'f':
+          string->push_back('\f');
+          break;
+        case 'n':
+          string->push_back('\n');
+          break;
+        case 'r':
+          string->push_back('\r');
+          break;
+        case 't':
+          string->push_back('\t');
+          break;
+        case 'u': {
+          uint32_t code_point;
+          if (!ParseHex4(&code_point)) {
+            return false;
+          }
+          if (code_point >= 0xD800 && code_point < 0xDC00) {
+            uint32_t low_surrogate;
+            if (!ConsumeLiteral("\\u") || !ParseHex4(&low_surrogate) ||
+                low_surrogate < 0xDC00 || low_surrogate >= 0xE000) {
+              return false;
+            }
+            code_point = 0x10000 + ((code_point - 0xD800) << 10) +
+                         (low_surrogate - 0xDC00);
+          }
+          AppendUtf8(code_point, string);
+          break;
+        }
+        default:
+          return false;
+      }
+    }
+    return false;
+  }
+
+  const std::string& text_;
+  size_t position_{0};
+};
+}  // namespace
+
+const JsonValue* JsonValue::Find(const std::string& key) const {
+  for (const auto& [member_key, member_value] : object) {
+    if (member_key == key) {
+      return &member_value;
+    }
+  }
+  return nullptr;
+}
+
+std::optional<JsonValue> ParseJson(const std::string& text) {
+  JsonValue value;
+  if (!JsonParser(text).ParseDocument(&value)) {
+    return std::nullopt;
+  }
+  return value;
+}
+
+std::string QuoteJsonString(const std::string& string) {
+  std::string quoted;
+  quoted.reserve(string.size() + 2);
+  quoted.push_back('"');
+  for (const char c : string) {
+    switch (c) {
+      case '"':
+        quoted += "\\\"";
+        break;
+      case '\\':
+        quoted += "\\\\";
+        break;
+      case '\n':
+        quoted += "\\n";
+        break;
+      case '\r':
+        quoted += "\\r";
+        break;
+      case '\t':
+        quoted += "\\t";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          char escaped[7];
+          std::snprintf(escaped, sizeof(escaped), "\\u%04x",
+                        static_cast<unsigned int>(c));
+          quoted += escaped;
+        } else {
+          quoted.push_back(c);
+        }
+    }
+  }
+  quoted.push_back('"');
+  return quoted;
+}
+
+}  // namespace internal
+}  // namespace viz
+}  // namespace drake_ros
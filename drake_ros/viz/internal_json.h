@@ -0,0 +1,38 @@
+#pragma once
+
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace drake_ros {
+namespace viz {
+namespace internal {
+
+/* A JSON value, as far as WebSocket protocol messages are concerned. */
+struct JsonValue {
+  enum class Type { kNull, kBool, kNumber, kString, kArray, kObject };
+
+  // Returns the value of the first member with the given key, if this is an
+  // object and has any such member, or nullptr otherwise.
+  const JsonValue* Find(const std::string& key) const;
+
+  Type type{Type::kNull};
+  bool boolean{false};
+  double number{0.0};
+  std::string string;
+  std::vector<JsonValue> array;
+  // Object members, in order of appearance.
+  std::vector<std::pair<std::string, JsonValue>> object;
+};
+
+/* Parses JSON `text`. Returns std::nullopt if it is malformed or nested
+ too deep. */
+std::optional<JsonValue> ParseJson(const std::string& text);
+
+/* Returns `string` as a quoted and escaped JSON string. */
+std::string QuoteJsonString(const std::string& string);
+
+}  // namespace internal
+}  // namespace viz
+}  // namespace drake_ros
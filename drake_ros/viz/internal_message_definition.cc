@@ -0,0 +1,118 @@
+#include "internal_message_definition.h"  // NOLINT(build/include)
+
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <ament_index_cpp/get_package_share_directory.hpp>
+
+namespace drake_ros {
+namespace viz {
+namespace internal {
+namespace {
+// Splits a message type name into package and type names. Both
+// "<package>/msg/<type>" and "<package>/<type>" forms are supported.
+std::pair<std::string, std::string> SplitTypeName(
+    const std::string& type_name) {
+  const size_t first_slash = type_name.find('/');
+  const size_t last_slash = type_name.rfind('/');
+  if (first_slash == std::string::npos || first_slash == 0 ||
+      last_slash + 1 == type_name.size()) {
+    throw std::runtime_error("invalid message type name '" + type_name +
+                             "'");
+  }
+  return {type_name.substr(0, first_slash),
+          type_name.substr(last_slash + 1)};
+}
+
+std::string ReadMessageDefinition(const std::string& package_name,
+                                  const std::string& message_name) {
+  std::string share_directory;
+  try {
+    share_directory =
+        ament_index_cpp::get_package_share_directory(package_name);
+  } catch (const ament_index_cpp::PackageNotFoundError&) {
+    throw std::runtime_error("package '" + package_name + "' not found");
+  }
+  const std::string path = share_directory + "/msg/" + message_name + ".msg";
+  std::ifstream file(path);
+  if (!file) {
+    throw std::runtime_error("cannot read message definition at " + path);
+  }
+  std::stringstream definition;
+  definition << file.rdbuf();
+  return definition.str();
+}
+
+// Returns the names of the message types a definition in `package_name`
+// refers to, in "<package>/<type>" form and in order of appearance.
+std::vector<std::string> FindDependencies(const std::string& definition,
+                                          const std::string& package_name) {
+  static const std::unordered_set<std::string> kPrimitiveTypes{
+      "bool",   "byte",  "char",   "float32", "float64",
+      "int8",   "uint8", "int16",  "uint16",  "int32",
+      "uint32", "int64", "uint64", "string",  "wstring"};
+  std::vector<std::string> dependencies;
+  std::istringstream lines(definition);
+  std::string line;
+  while (std::getline(lines, line)) {
+    std::istringstream tokens(line.substr(0, line.find('#')));
+    std::string field_type;
+    if (!(tokens >> field_type)) {
+      continue;
+    }
+    // Drop array and string bounds, if any.
+    field_type = field_type.substr(0, field_type.find_first_of("[<"));
+    if (kPrimitiveTypes.count(field_type) > 0) {
+      continue;
+    }
+    if (field_type.find('/') == std::string::npos) {
+      dependencies.push_back(package_name + "/" + field_type);
+    } else {
+      const auto [dependency_package_name, dependency_message_name] =
+          SplitTypeName(field_type);
+      dependencies.push_back(dependency_package_name + "/" +
+                             dependency_message_name);
+    }
+  }
+  return dependencies;
+}
+}  // namespace
+
+std::string GetFullMessageDefinition(const std::string& type_name) {
+  const auto [package_name, message_name] = SplitTypeName(type_name);
+  std::string full_definition =
+      ReadMessageDefinition(package_name, message_name);
+  std::vector<std::string> pending_dependencies =
+      FindDependencies(full_definition, package_name);
+  std::unordered_set<std::string> visited_dependencies;
+  // N.B. Dependencies are appended while iterating, breadth first.
+  for (size_t i = 0; i < pending_dependencies.size(); ++i) {
+    const std::string dependency = pending_dependencies[i];
+    if (!visited_dependencies.insert(dependency).second) {
+      continue;
+    }
+    const auto [dependency_package_name, dependency_message_name] =
+        SplitTypeName(dependency);
+    const std::string definition =
+        ReadMessageDefinition(dependency_package_name, dependency_message_name);
+    if (!full_definition.empty() && full_definition.back() != '\n') {
+      full_definition += '\n';
+    }
+    full_definition += std::string(80, '=') + "\nMSG: " + dependency + "\n";
+    full_definition += definition;
+    const std::vector<std::string> dependencies =
+        FindDependencies(definition, dependency_package_name);
+    pending_dependencies.insert(pending_dependencies.end(),
+                                dependencies.begin(), dependencies.end());
+  }
+  return full_definition;
+}
+
+}  // namespace internal
+}  // namespace viz
+}  // namespace drake_ros
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <string>
+
+namespace drake_ros {
+namespace viz {
+namespace internal {
+
+/* Returns the full definition of a ROS 2 message type, as per the `ros2msg`
+ schema encoding: its own .msg definition followed by the definitions of all
+ the message types it depends on, each preceded by a separator line and a
+ `MSG: <package>/<type>` line. Definitions are looked up in the ament index.
+ @param[in] type_name ROS message type name e.g. "std_msgs/msg/String".
+ @throws std::runtime_error if any definition cannot be found.
+ */
+std::string GetFullMessageDefinition(const std::string& type_name);
+
+}  // namespace internal
+}  // namespace viz
+}  // namespace drake_ros
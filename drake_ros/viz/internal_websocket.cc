@@ -0,0 +1,277 @@
+#include "internal_websocket.h"  // NOLINT(build/include)
+
+#include <array>
+#include <cctype>
+#include <string>
+#include <utility>
+
+namespace drake_ros {
+namespace viz {
+namespace internal {
+namespace {
+// GUID that RFC 6455 appends to handshake keys.
+constexpr char kWebSocketGuid[] = "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+
+uint32_t RotateLeft(uint32_t value, int bits) {
+  return (value << bits) | (value >> (32 - bits));
+}
+
+std::string Trim(const std::string& string) {
+  size_t begin = 0;
+  size_t end = string.size();
+  while (begin < end &&
+         std::isspace(static_cast<unsigned char>(string[begin]))) {
+    ++begin;
+  }
+  while (end > begin &&
+         std::isspace(static_cast<unsigned char>(string[end - 1]))) {
+    --end;
+  }
+  return string.substr(begin, end - begin);
+}
+}  // namespace
+
+std::array<uint8_t, 20> ComputeSha1(const std::string& data) {
+  uint32_t h[5] = {0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476,
+                   0xC3D2E1F0};
+  std::string message = data;
+  const uint64_t bit_length = static_cast<uint64_t>(data.size()) * 8;
+  message.push_back(static_cast<char>(0x80));
+  while (message.size() % 64 != 56) {
+    message.push_back('\0');
+  }
+  for (int i = 7; i >= 0; --i) {
+    message.push_back(static_cast<char>((bit_length >> (8 * i)) & 0xFF));
+  }
+  for (size_t chunk = 0; chunk < message.size(); chunk += 64) {
+    uint32_t w[80];
+    for (int i = 0; i < 16; ++i) {
+      w[i] = 0;
+      for (int j = 0; j < 4; ++j) {
+        w[i] = (w[i] << 8) |
+               static_cast<uint8_t>(message[chunk + 4 * i + j]);
+      }
+    }
+    for (int i = 16; i < 80; ++i) {
+      w[i] = RotateLeft(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+    }
+    uint32_t a = h[0], b = h[1], c = h[2], d = h[3], e = h[4];
+    for (int i = 0; i < 80; ++i) {
+      uint32_t f, k;
+      if (i < 20) {
+        f = (b & c) | (~b & d);
+        k = 0x5A827999;
+      } else if (i < 40) {
+        f = b ^ c ^ d;
+        k = 0x6ED9EBA1;
+      } else if (i < 60) {
+        f = (b & c) | (b & d) | (c & d);
+        k = 0x8F1BBCDC;
+      } else {
+        f = b ^ c ^ d;
+        k = 0xCA62C1D6;
+      }
+      const uint32_t temp = RotateLeft(a, 5) + f + e + k + w[i];
+      e = d;
+      d = c;
+      c = RotateLeft(b, 30);
+      b = a;
+      a = temp;
+    }
+    h[0] += a;
+    h[1] += b;
+    h[2] += c;
+    h[3] += d;
+    h[4] += e;
+  }
+  std::array<uint8_t, 20> digest;
+  for (int i = 0; i < 5; ++i) {
+    for (int j = 0; j < 4; ++j) {
+      digest[4 * i + j] = static_cast<uint8_t>(h[i] >> (24 - 8 * j));
+    }
+  }
+  return digest;
+}
+
+std::string EncodeBase64(const uint8_t* data, size_t size) {
+  constexpr char kAlphabet[] =
+      "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+  std::string encoded;
+  encoded.reserve(4 * ((size + 2) / 3));
+  for (size_t i = 0; i < size; i += 3) {
+    uint32_t group = static_cast<uint32_t>(data[i]) << 16;
+    if (i + 1 < size) group |= static_cast<uint32_t>(data[i + 1]) << 8;
+    if (i + 2 < size) group |= static_cast<uint32_t>(data[i + 2]);
+    encoded.push_back(kAlphabet[(group >> 18) & 0x3F]);
+    encoded.push_back(kAlphabet[(group >> 12) & 0x3F]);
+    encoded.push_back(i + 1 < size ? kAlphabet[(group >> 6) & 0x3F] : '=');
+    encoded.push_back(i + 2 < size ? kAlphabet[group & 0x3F] : '=');
+  }
+  return encoded;
+}
+
+std::string ComputeWebSocketAccept(const std::string& key) {
+  const std::array<uint8_t, 20> digest = ComputeSha1(key + kWebSocketGuid);
+  return EncodeBase64(digest.data(), digest.size());
+}
+
+std::optional<std::string> HttpRequest::GetHeader(
+    const std::string& name) const {
+  for (const auto& [header_name, header_value] : headers) {
+    if (header_name == name) {
+      return header_value;
+    }
+  }
+  return std::nullopt;
+}
+
+std::optional<HttpRequest> ParseHttpRequest(const std::string& head) {
+  HttpRequest request;
+  size_t begin = 0;
+  bool request_line = true;
+  while (begin < head.size()) {
+    size_t end = head.find("\r\n", begin);
+    if (end == std::string::npos) {
+      end = head.size();
+    }
+    const std::string line = head.substr(begin, end - begin);
+    begin = end + 2;
+    if (request_line) {
+      const size_t method_end = line.find(' ');
+      if (method_end == std::string::npos) {
+        return std::nullopt;
+      }
+      const size_t target_end = line.find(' ', method_end + 1);
+      if (target_end == std::string::npos) {
+        return std::nullopt;
+      }
+      request.method = line.substr(0, method_end);
+      request.target =
+          line.substr(method_end + 1, target_end - method_end - 1);
+      request_line = false;
+      continue;
+    }
+    if (line.empty()) {
+      break;
+    }
+    const size_t colon = line.find(':');
+    if (colon == std::string::npos) {
+      return std::nullopt;
+    }
+    std::string name = Trim(line.substr(0, colon));
+    for (char& c : name) {
+      c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    }
+    request.headers.emplace_back(std::move(name),
+                                 Trim(line.substr(colon + 1)));
+  }
+  if (request_line) {
+    return std::nullopt;
+  }
+  return request;
+}
+
+void AppendWebSocketFrameHeader(WebSocketOpcode opcode, uint64_t payload_size,
+                                std::string* buffer) {
+  buffer->push_back(static_cast<char>(0x80 | static_cast<uint8_t>(opcode)));
+  if (payload_size < 126) {
+    buffer->push_back(static_cast<char>(payload_size));
+  } else if (payload_size <= 0xFFFF) {
+    buffer->push_back(static_cast<char>(126));
+    buffer->push_back(static_cast<char>((payload_size >> 8) & 0xFF));
+    buffer->push_back(static_cast<char>(payload_size & 0xFF));
+  } else {
+    buffer->push_back(static_cast<char>(127));
+    for (int i = 7; i >= 0; --i) {
+      buffer->push_back(static_cast<char>((payload_size >> (8 * i)) & 0xFF));
+    }
+  }
+}
+
+void AppendWebSocketFrame(WebSocketOpcode opcode, const std::string& payload,
+                          std::string* buffer) {
+  AppendWebSocketFrameHeader(opcode, payload.size(), buffer);
+  buffer->append(payload);
+}
+
+bool WebSocketDecoder::Next(std::optional<WebSocketMessage>* message) {
+  message->reset();
+  while (true) {
+    if (buffer_.size() < 2) {
+      return true;
+    }
+    const uint8_t byte0 = static_cast<uint8_t>(buffer_[0]);
+    const uint8_t byte1 = static_cast<uint8_t>(buffer_[1]);
+    if ((byte0 & 0x70) != 0) {
+      return false;  // no extensions were negotiated
+    }
+    if ((byte1 & 0x80) == 0) {
+      return false;  // client frames must be masked
+    }
+    const bool fin = (byte0 & 0x80) != 0;
+    const uint8_t opcode = byte0 & 0x0F;
+    uint64_t size = byte1 & 0x7F;
+    size_t offset = 2;
+    if (size == 126 || size == 127) {
+      const size_t num_size_bytes = size == 126 ? 2 : 8;
+      if (buffer_.size() < offset + num_size_bytes) {
+        return true;
+      }
+      size = 0;
+      for (size_t i = 0; i < num_size_bytes; ++i) {
+        size = (size << 8) | static_cast<uint8_t>(buffer_[offset + i]);
+      }
+      offset += num_size_bytes;
+    }
+    if (size > max_message_size_) {
+      return false;
+    }
+    if (buffer_.size() < offset + 4 + size) {
+      return true;
+    }
+    const std::string mask = buffer_.substr(offset, 4);
+    offset += 4;
+    std::string payload = buffer_.substr(offset, size);
+    for (size_t i = 0; i < payload.size(); ++i) {
+      payload[i] ^= mask[i % 4];
+    }
+    buffer_.erase(0, offset + size);
+
+    if ((opcode & 0x08) != 0) {
+      if (opcode > static_cast<uint8_t>(WebSocketOpcode::kPong)) {
+        return false;  // reserved control opcode
+      }
+      if (!fin || size > 125) {
+        return false;  // control frames may not be fragmented
+      }
+      *message = WebSocketMessage{static_cast<WebSocketOpcode>(opcode),
+                                  std::move(payload)};
+      return true;
+    }
+    if (opcode == static_cast<uint8_t>(WebSocketOpcode::kContinuation)) {
+      if (!partial_ ||
+          partial_->payload.size() + size > max_message_size_) {
+        return false;
+      }
+      partial_->payload += payload;
+    } else if (opcode == static_cast<uint8_t>(WebSocketOpcode::kText) ||
+               opcode == static_cast<uint8_t>(WebSocketOpcode::kBinary)) {
+      if (partial_) {
+        return false;  // previous message is not complete
+      }
+      partial_ = WebSocketMessage{static_cast<WebSocketOpcode>(opcode),
+                                  std::move(payload)};
+    } else {
+      return false;  // reserved data opcode
+    }
+    if (fin) {
+      *message = std::move(partial_);
+      partial_.reset();
+      return true;
+    }
+  }
+}
+
+}  // namespace internal
+}  // namespace viz
+}  // namespace drake_ros
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace drake_ros {
+namespace viz {
+namespace internal {
+
+/* WebSocket frame opcodes, as per RFC 6455. */
+enum class WebSocketOpcode : uint8_t {
+  kContinuation = 0x0,
+  kText = 0x1,
+  kBinary = 0x2,
+  kClose = 0x8,
+  kPing = 0x9,
+  kPong = 0xA,
+};
+
+/* Computes the SHA-1 digest of `data`, as per RFC 3174. */
+std::array<uint8_t, 20> ComputeSha1(const std::string& data);
+
+/* Encodes `size` bytes of `data` in base64, as per RFC 4648. */
+std::string EncodeBase64(const uint8_t* data, size_t size);
+
+/* Computes the Sec-WebSocket-Accept header value for a given
+ Sec-WebSocket-Key header value. */
+std::string ComputeWebSocketAccept(const std::string& key);
+
+/* An HTTP request, as far as WebSocket handshakes are concerned. */
+struct HttpRequest {
+  std::string method;
+  std::string target;
+  // Header names are lowercased, header values are trimmed.
+  std::vector<std::pair<std::string, std::string>> headers;
+
+  // Returns the value of the first header with the given (lowercase) name,
+  // if any.
+  std::optional<std::string> GetHeader(const std::string& name) const;
+};
+
+/* Parses an HTTP request head (i.e. up to and excluding the empty line).
+ Returns std::nullopt if it is malformed. */
+std::optional<HttpRequest> ParseHttpRequest(const std::string& head);
+
+/* Appends the header of an unmasked, unfragmented WebSocket frame to
+ `buffer`. Exactly `payload_size` payload bytes must follow. */
+void AppendWebSocketFrameHeader(WebSocketOpcode opcode, uint64_t payload_size,
+                                std::string* buffer);
+
+/* Appends an unmasked, unfragmented WebSocket frame to `buffer`. */
+void AppendWebSocketFrame(WebSocketOpcode opcode, const std::string& payload,
+                          std::string* buffer);
+
+/* A WebSocket message, reassembled from one or more frames. */
+struct WebSocketMessage {
+  WebSocketOpcode opcode;
+  std::string payload;
+};
+
+/* An incremental decoder for (masked) client WebSocket frames.
+
+ Fragmented messages are reassembled. Control frames may be interleaved
+ with fragments, as RFC 6455 allows. */
+class WebSocketDecoder {
+ public:
+  /* @param[in] max_message_size largest message payload to accept, in
+     bytes. */
+  explicit WebSocketDecoder(size_t max_message_size)
+      : max_message_size_(max_message_size) {}
+
+  /* Feeds bytes received from the client. */
+  void Feed(const char* data, size_t size) { buffer_.append(data, size); }
+
+  /* Decodes the next complete message, if any.
+   @returns false if the stream is not valid WebSocket (or exceeds the
+     message size limit) and the connection should be dropped, true
+     otherwise. `message` is set only when a message was decoded.
+   */
+  bool Next(std::optional<WebSocketMessage>* message);
+
+ private:
+  const size_t max_message_size_;
+  std::string buffer_;
+  // Fragments of a message, if any is being reassembled.
+  std::optional<WebSocketMessage> partial_;
+};
+
+}  // namespace internal
+}  // namespace viz
+}  // namespace drake_ros
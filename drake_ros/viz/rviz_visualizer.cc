@@ -3,8 +3,10 @@
 #include <memory>
 #include <unordered_set>
 #include <utility>
+#include <vector>
 
 #include <drake/systems/framework/diagram_builder.h>
+#include <drake_ros/core/cdr_serializer.h>
 #include <drake_ros/core/drake_ros.h>
 #include <drake_ros/core/ros_publisher_system.h>
 #include <drake_ros/tf2/scene_tf_broadcaster_system.h>
@@ -20,6 +22,7 @@ class RvizVisualizer::RvizVisualizerPrivate {
  public:
   SceneMarkersSystem* scene_visual_markers;
   SceneMarkersSystem* scene_collision_markers;
+  std::vector<drake_ros::core::RosPublisherSystem*> publishers;
   drake_ros::tf2::SceneTfBroadcasterSystem* scene_tf_broadcaster{nullptr};
 };
 
@@ -28,31 +31,38 @@ RvizVisualizer::RvizVisualizer(drake_ros::core::DrakeRos* ros,
     : impl_(new RvizVisualizerPrivate()) {
   drake::systems::DiagramBuilder<double> builder;
 
+  using drake_ros::core::CdrSerializer;
   using drake_ros::core::RosPublisherSystem;
-  auto scene_visual_markers_publisher = builder.AddSystem(
-      RosPublisherSystem::Make<visualization_msgs::msg::MarkerArray>(
-          "/scene_markers/visual", rclcpp::QoS(1), ros, params.publish_triggers,
-          params.publish_period));
+  // Marker arrays are dominated by primitive sequences, which their CDR
+  // codec copies in bulk.
+  using MarkerArraySerializer =
+      CdrSerializer<visualization_msgs::msg::MarkerArray>;
+  auto scene_visual_markers_publisher = builder.AddSystem<RosPublisherSystem>(
+      std::make_shared<MarkerArraySerializer>(), "/scene_markers/visual",
+      rclcpp::QoS(1), ros, params.publish_triggers, params.publish_period);
 
   impl_->scene_visual_markers =
       builder.AddSystem<SceneMarkersSystem>(SceneMarkersParams::Illustration());
 
   builder.Connect(impl_->scene_visual_markers->get_markers_output_port(),
                   scene_visual_markers_publisher->get_input_port());
+  impl_->publishers.push_back(scene_visual_markers_publisher);
 
   builder.ExportInput(impl_->scene_visual_markers->get_graph_query_input_port(),
                       "graph_query");
 
-  auto scene_collision_markers_publisher = builder.AddSystem(
-      RosPublisherSystem::Make<visualization_msgs::msg::MarkerArray>(
+  auto scene_collision_markers_publisher =
+      builder.AddSystem<RosPublisherSystem>(
+          std::make_shared<MarkerArraySerializer>(),
           "/scene_markers/collision", rclcpp::QoS(1), ros,
-          params.publish_triggers, params.publish_period));
+          params.publish_triggers, params.publish_period);
 
   impl_->scene_collision_markers =
       builder.AddSystem<SceneMarkersSystem>(SceneMarkersParams::Proximity());
 
   builder.Connect(impl_->scene_collision_markers->get_markers_output_port(),
                   scene_collision_markers_publisher->get_input_port());
+  impl_->publishers.push_back(scene_collision_markers_publisher);
 
   builder.ConnectInput(
       "graph_query",
@@ -89,6 +99,16 @@ void RvizVisualizer::ComputeFrameHierarchy() {
   }
 }
 
+void RvizVisualizer::AddMessageSink(
+    std::shared_ptr<drake_ros::core::MessageSinkInterface> sink) {
+  for (drake_ros::core::RosPublisherSystem* publisher : impl_->publishers) {
+    publisher->AddMessageSink(sink);
+  }
+  if (impl_->scene_tf_broadcaster) {
+    impl_->scene_tf_broadcaster->AddMessageSink(std::move(sink));
+  }
+}
+
 const drake::systems::InputPort<double>&
 RvizVisualizer::get_graph_query_input_port() const {
   return get_input_port();
@@ -6,6 +6,7 @@
 #include <drake/multibody/plant/multibody_plant.h>
 #include <drake/systems/framework/diagram.h>
 #include <drake_ros/core/drake_ros.h>
+#include <drake_ros/core/message_sink_interface.h>
 #include <drake_ros/viz/defaults.h>
 
 namespace drake_ros {
@@ -53,6 +54,12 @@ class RvizVisualizer : public drake::systems::Diagram<double> {
 
   void ComputeFrameHierarchy();
 
+  /// Forwarded to RosPublisherSystem::AddMessageSink() for every publisher
+  /// in this visualizer, e.g. to serve scene markers and tf2 transforms
+  /// through a FoxgloveServer.
+  void AddMessageSink(
+      std::shared_ptr<drake_ros::core::MessageSinkInterface> sink);
+
   const drake::systems::InputPort<double>& get_graph_query_input_port() const;
 
  private:
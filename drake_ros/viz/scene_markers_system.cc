@@ -1,5 +1,8 @@
 #include "drake_ros/viz/scene_markers_system.h"
 
+#include <optional>
+#include <stdexcept>
+#include <string>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
@@ -20,6 +23,7 @@
 #include <visualization_msgs/msg/marker.hpp>
 #include <visualization_msgs/msg/marker_array.hpp>
 
+#include "drake_ros/core/ament_package_map.h"
 #include "drake_ros/core/geometry_conversions.h"
 #include "drake_ros/tf2/name_conventions.h"
 #include "drake_ros/viz/defaults.h"
@@ -28,10 +32,28 @@
 namespace drake_ros {
 namespace viz {
 
+using drake_ros::core::GetAmentPackageUri;
 using drake_ros::core::RigidTransformToRosPose;
 
 namespace {
 
+/// \internal
+/// Turns an absolute mesh file path into a mesh resource URI, preferably
+/// a package URI if requested and possible.
+std::string GetMeshResource(const std::string& path, bool use_package_uris) {
+  if (use_package_uris) {
+    try {
+      std::optional<std::string> uri = GetAmentPackageUri(path);
+      if (uri) {
+        return *uri;
+      }
+    } catch (const std::runtime_error&) {
+      // No ament index to look up.
+    }
+  }
+  return "file://" + path;
+}
+
 /// \internal
 /// Converts Drake shape descriptions to ROS Marker messages.
 class SceneGeometryToMarkers : public drake::geometry::ShapeReifier {
@@ -212,9 +234,10 @@ class SceneGeometryToMarkers : public drake::geometry::ShapeReifier {
     marker.scale.x = convex.scale();
     marker.scale.y = convex.scale();
     marker.scale.z = convex.scale();
-    // Assume it is an absolute path and turn it into a file URL.
+    // Assume it is an absolute path and turn it into a resource URI.
     DRAKE_THROW_UNLESS(convex.source().is_path());
-    marker.mesh_resource = "file://" + convex.source().path().string();
+    marker.mesh_resource = GetMeshResource(convex.source().path().string(),
+                                           params_.use_package_uris);
     marker.pose = RigidTransformToRosPose(X_FG_);
   }
 
@@ -226,9 +249,10 @@ class SceneGeometryToMarkers : public drake::geometry::ShapeReifier {
     marker.scale.x = mesh.scale();
     marker.scale.y = mesh.scale();
     marker.scale.z = mesh.scale();
-    // Assume it is an absolute path and turn it into a file URL.
+    // Assume it is an absolute path and turn it into a resource URI.
     DRAKE_THROW_UNLESS(mesh.source().is_path());
-    marker.mesh_resource = "file://" + mesh.source().path().string();
+    marker.mesh_resource = GetMeshResource(mesh.source().path().string(),
+                                           params_.use_package_uris);
     marker.pose = RigidTransformToRosPose(X_FG_);
   }
 
@@ -250,12 +274,20 @@ class SceneMarkersSystem::SceneMarkersSystemPrivate {
   drake::systems::InputPortIndex graph_query_port_index;
   drake::systems::OutputPortIndex scene_markers_port_index;
   std::unordered_set<const drake::multibody::MultibodyPlant<double>*> plants;
+};
+
+// Per-context scene markers data. Everything that changes during a
+// simulation lives here, so that many contexts can be evaluated concurrently.
+struct SceneMarkersSystem::SceneMarkersCache {
+  // Geometry version the markers were computed for.
+  drake::geometry::GeometryVersion version;
+  // Scene markers, without timestamps.
+  visualization_msgs::msg::MarkerArray marker_array;
   // Map each geometry to the id of the first marker it creates
   std::unordered_map<drake::geometry::GeometryId, int>
-      geometry_id_marker_id_map_{};
+      geometry_id_marker_id_map{};
   // Map each marker namespace and the next unique marker id
-  std::unordered_map<std::string, int> marker_namespace_id_map_{};
-  mutable drake::geometry::GeometryVersion version;
+  std::unordered_map<std::string, int> marker_namespace_id_map{};
 };
 
 SceneMarkersSystem::SceneMarkersSystem(SceneMarkersParams params)
@@ -322,30 +354,34 @@ SceneMarkersSystem::EvalSceneMarkers(
           .Eval<drake::geometry::QueryObject<double>>(context);
   const drake::geometry::GeometryVersion& current_version =
       query_object.inspector().geometry_version();
-  const bool same_version =
-      impl_->version.IsSameAs(current_version, impl_->params.role);
-  if (!same_version) {
-    // Invalidate scene markers cache
-    get_cache_entry(impl_->scene_markers_cache_index)
-        .get_mutable_cache_entry_value(context)
-        .mark_out_of_date();
-    impl_->version = current_version;
+  const drake::systems::CacheEntry& cache_entry =
+      get_cache_entry(impl_->scene_markers_cache_index);
+  bool same_version = false;
+  if (!cache_entry.is_out_of_date(context)) {
+    same_version = cache_entry.GetKnownUpToDate<SceneMarkersCache>(context)
+                       .version.IsSameAs(current_version, impl_->params.role);
+    if (!same_version) {
+      // Invalidate scene markers cache
+      cache_entry.get_mutable_cache_entry_value(context).mark_out_of_date();
+    }
   }
   if (cached) {
     *cached = same_version;
   }
-  return get_cache_entry(impl_->scene_markers_cache_index)
-      .Eval<visualization_msgs::msg::MarkerArray>(context);
+  return cache_entry.Eval<SceneMarkersCache>(context).marker_array;
 }
 
 void SceneMarkersSystem::CalcSceneMarkers(
     const drake::systems::Context<double>& context,
-    visualization_msgs::msg::MarkerArray* output_value) const {
+    SceneMarkersCache* cache) const {
   const drake::geometry::QueryObject<double>& query_object =
       get_input_port(impl_->graph_query_port_index)
           .Eval<drake::geometry::QueryObject<double>>(context);
   const drake::geometry::SceneGraphInspector<double>& inspector =
       query_object.inspector();
+  cache->version = inspector.geometry_version();
+  visualization_msgs::msg::MarkerArray* output_value = &cache->marker_array;
+  output_value->markers.clear();
   output_value->markers.reserve(
       inspector.NumGeometriesWithRole(impl_->params.role));
   for (const drake::geometry::FrameId& frame_id : inspector.GetAllFrameIds()) {
@@ -356,25 +392,25 @@ void SceneMarkersSystem::CalcSceneMarkers(
                                                   geometry_id);
       int marker_id = 0;
 
-      auto m_it = impl_->marker_namespace_id_map_.end();
-      auto g_it = impl_->geometry_id_marker_id_map_.find(geometry_id);
-      if (g_it != impl_->geometry_id_marker_id_map_.end()) {
+      auto m_it = cache->marker_namespace_id_map.end();
+      auto g_it = cache->geometry_id_marker_id_map.find(geometry_id);
+      if (g_it != cache->geometry_id_marker_id_map.end()) {
         // Reuse the marker ID if one was already given to this geometry
         marker_id = g_it->second;
       } else {
         // Every namespace starts with an ID of 0; initialize it if needed.
-        m_it = impl_->marker_namespace_id_map_.try_emplace(marker_namespace, 0)
+        m_it = cache->marker_namespace_id_map.try_emplace(marker_namespace, 0)
                    .first;
 
         marker_id = m_it->second;
-        impl_->geometry_id_marker_id_map_[geometry_id] = marker_id;
+        cache->geometry_id_marker_id_map[geometry_id] = marker_id;
       }
 
       size_t num_markers_before = output_value->markers.size();
       SceneGeometryToMarkers(impl_->params)
           .Populate(inspector, impl_->plants, geometry_id, marker_namespace,
                     marker_id, output_value);
-      if (m_it != impl_->marker_namespace_id_map_.end()) {
+      if (m_it != cache->marker_namespace_id_map.end()) {
         // Update namespace/id map with next unique ID
         m_it->second =
             marker_id + (output_value->markers.size() - num_markers_before);
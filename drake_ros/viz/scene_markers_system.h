@@ -36,6 +36,12 @@ struct SceneMarkersParams {
 
   /// Default marker color if no ("phong", "diffuse") property is found.
   drake::geometry::Rgba default_color{0.9, 0.9, 0.9, 1.0};
+
+  /// Reference meshes within ament packages by `package://` URI, for any
+  /// ROS visualizer to resolve, rather than by `file://` URL. Meshes
+  /// elsewhere are always referenced by `file://` URL. Off by default,
+  /// as it crawls the ament index on first use.
+  bool use_package_uris{false};
 };
 
 /// System for SceneGraph depiction as a ROS marker array.
@@ -89,11 +95,13 @@ class SceneMarkersSystem : public drake::systems::LeafSystem<double> {
       const drake::systems::Context<double>& context,
       bool* cached = nullptr) const;
 
+  // Per-context scene markers cache forward declaration.
+  struct SceneMarkersCache;
+
   // Inspects the SceneGraph and carries out the conversion
   // to visualization_msgs::msg::MarkerArray message unconditionally.
-  void CalcSceneMarkers(
-      const drake::systems::Context<double>& context,
-      visualization_msgs::msg::MarkerArray* output_value) const;
+  void CalcSceneMarkers(const drake::systems::Context<double>& context,
+                        SceneMarkersCache* cache) const;
 
   // PIMPL forward declaration
   class SceneMarkersSystemPrivate;
@@ -0,0 +1,264 @@
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <utility>
+
+#include <drake_ros/viz/foxglove_server.h>
+#include <gtest/gtest.h>
+#include <rclcpp/serialization.hpp>
+#include <rclcpp/serialized_message.hpp>
+#include <rclcpp/time.hpp>
+#include <std_msgs/msg/string.hpp>
+
+using drake_ros::viz::FoxgloveServer;
+using drake_ros::viz::FoxgloveServerParams;
+
+namespace {
+// A bare bones Foxglove WebSocket client.
+class TestClient {
+ public:
+  TestClient(uint16_t port, const std::string& subprotocol) {
+    fd_ = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd_ < 0) {
+      throw std::runtime_error("cannot create socket");
+    }
+    // Fail rather than hang if the server never replies.
+    timeval timeout{5, 0};
+    setsockopt(fd_, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (connect(fd_, reinterpret_cast<sockaddr*>(&address),
+                sizeof(address)) < 0) {
+      throw std::runtime_error("cannot connect");
+    }
+    SendAll(
+        "GET / HTTP/1.1\r\n"
+        "Host: localhost\r\n"
+        "Upgrade: websocket\r\n"
+        "Connection: Upgrade\r\n"
+        "Sec-WebSocket-Key: dGhlIHNhbXBsZSBub25jZQ==\r\n"
+        "Sec-WebSocket-Version: 13\r\n"
+        "Sec-WebSocket-Protocol: " +
+        subprotocol + "\r\n\r\n");
+    while (handshake_response_.find("\r\n\r\n") == std::string::npos) {
+      handshake_response_ += ReceiveExactly(1);
+    }
+  }
+
+  ~TestClient() { close(fd_); }
+
+  const std::string& handshake_response() const {
+    return handshake_response_;
+  }
+
+  // Sends a masked text frame.
+  void SendText(const std::string& text) {
+    const char mask[4] = {0x12, 0x34, 0x56, 0x78};
+    std::string frame;
+    frame.push_back(static_cast<char>(0x81));
+    if (text.size() < 126) {
+      frame.push_back(static_cast<char>(0x80 | text.size()));
+    } else {
+      frame.push_back(static_cast<char>(0x80 | 126));
+      frame.push_back(static_cast<char>(text.size() >> 8));
+      frame.push_back(static_cast<char>(text.size() & 0xFF));
+    }
+    frame.append(mask, 4);
+    for (size_t i = 0; i < text.size(); ++i) {
+      frame.push_back(text[i] ^ mask[i % 4]);
+    }
+    SendAll(frame);
+  }
+
+  // Receives the next (unfragmented) frame, as an opcode and payload pair.
+  std::pair<uint8_t, std::string> Receive() {
+    const std::string head = ReceiveExactly(2);
+    uint64_t size = static_cast<uint8_t>(head[1]) & 0x7F;
+    if (size >= 126) {
+      const std::string extended_size = ReceiveExactly(size == 126 ? 2 : 8);
+      size = 0;
+      for (const char byte : extended_size) {
+        size = (size << 8) | static_cast<uint8_t>(byte);
+      }
+    }
+    return {static_cast<uint8_t>(head[0]) & 0x0F, ReceiveExactly(size)};
+  }
+
+ private:
+  void SendAll(const std::string& bytes) {
+    if (send(fd_, bytes.data(), bytes.size(), 0) !=
+        static_cast<ssize_t>(bytes.size())) {
+      throw std::runtime_error("cannot send");
+    }
+  }
+
+  std::string ReceiveExactly(size_t size) {
+    std::string bytes(size, '\0');
+    size_t offset = 0;
+    while (offset < size) {
+      const ssize_t ret = recv(fd_, &bytes[offset], size - offset, 0);
+      if (ret <= 0) {
+        throw std::runtime_error("cannot receive");
+      }
+      offset += ret;
+    }
+    return bytes;
+  }
+
+  int fd_{-1};
+  std::string handshake_response_;
+};
+
+std::shared_ptr<rclcpp::SerializedMessage> Serialize(const std::string& data) {
+  std_msgs::msg::String message;
+  message.data = data;
+  auto serialized_message = std::make_shared<rclcpp::SerializedMessage>();
+  rclcpp::Serialization<std_msgs::msg::String>().serialize_message(
+      &message, serialized_message.get());
+  return serialized_message;
+}
+
+std::string GetBytes(const rclcpp::SerializedMessage& message) {
+  const auto& rcl_message = message.get_rcl_serialized_message();
+  return std::string(reinterpret_cast<const char*>(rcl_message.buffer),
+                     rcl_message.buffer_length);
+}
+
+// Returns the ID of the first channel in an advertisement.
+uint32_t GetFirstChannelId(const std::string& advertisement) {
+  const std::string key = "\"id\":";
+  const size_t position = advertisement.find(key);
+  if (position == std::string::npos) {
+    throw std::runtime_error("no channel advertised");
+  }
+  return std::stoul(advertisement.substr(position + key.size()));
+}
+
+// Returns subscription ID, timestamp, and payload of message data.
+std::tuple<uint32_t, uint64_t, std::string> ParseMessageData(
+    const std::string& payload) {
+  if (payload.size() < 13 || payload[0] != 0x01) {
+    throw std::runtime_error("not message data");
+  }
+  uint32_t subscription_id = 0;
+  for (int i = 4; i >= 1; --i) {
+    subscription_id = (subscription_id << 8) | static_cast<uint8_t>(payload[i]);
+  }
+  uint64_t timestamp = 0;
+  for (int i = 12; i >= 5; --i) {
+    timestamp = (timestamp << 8) | static_cast<uint8_t>(payload[i]);
+  }
+  return {subscription_id, timestamp, payload.substr(13)};
+}
+
+FoxgloveServerParams MakeLocalParams() {
+  FoxgloveServerParams params;
+  params.address = "127.0.0.1";
+  params.port = 0;
+  return params;
+}
+}  // namespace
+
+TEST(FoxgloveServer, Handshake) {
+  FoxgloveServer server(MakeLocalParams());
+  ASSERT_NE(server.port(), 0);
+
+  TestClient rejected_client(server.port(), "some.other.protocol");
+  EXPECT_NE(rejected_client.handshake_response().find("400 Bad Request"),
+            std::string::npos);
+
+  TestClient client(server.port(), "foxglove.websocket.v1");
+  // As per RFC 6455 examples.
+  EXPECT_NE(client.handshake_response().find("101 Switching Protocols"),
+            std::string::npos);
+  EXPECT_NE(client.handshake_response().find(
+                "Sec-WebSocket-Accept: s3pPLMBiTxaQ9kYGzzhZRbK+xOo="),
+            std::string::npos);
+  const auto [opcode, payload] = client.Receive();
+  EXPECT_EQ(opcode, 0x1);
+  EXPECT_NE(payload.find("\"op\":\"serverInfo\""), std::string::npos);
+  EXPECT_EQ(server.num_clients(), 1);
+}
+
+TEST(FoxgloveServer, Subscribe) {
+  FoxgloveServerParams params = MakeLocalParams();
+  params.max_rate_per_client = 0.0;
+  FoxgloveServer server(params);
+
+  TestClient client(server.port(), "foxglove.websocket.v1");
+  auto [opcode, payload] = client.Receive();
+  ASSERT_NE(payload.find("\"op\":\"serverInfo\""), std::string::npos);
+
+  auto message = Serialize("hello");
+  server.Write("/chatter", "std_msgs/msg/String", message, rclcpp::Time(42));
+
+  std::tie(opcode, payload) = client.Receive();
+  EXPECT_EQ(opcode, 0x1);
+  EXPECT_NE(payload.find("\"op\":\"advertise\""), std::string::npos);
+  EXPECT_NE(payload.find("\"topic\":\"/chatter\""), std::string::npos);
+  EXPECT_NE(payload.find("\"schemaName\":\"std_msgs/msg/String\""),
+            std::string::npos);
+  EXPECT_NE(payload.find("string data"), std::string::npos);
+  const uint32_t channel_id = GetFirstChannelId(payload);
+
+  // Latest message is sent on subscription.
+  client.SendText(
+      "{\"op\":\"subscribe\",\"subscriptions\":[{\"id\":7,\"channelId\":" +
+      std::to_string(channel_id) + "}]}");
+  std::tie(opcode, payload) = client.Receive();
+  EXPECT_EQ(opcode, 0x2);
+  auto [subscription_id, timestamp, data] = ParseMessageData(payload);
+  EXPECT_EQ(subscription_id, 7u);
+  EXPECT_EQ(timestamp, 42u);
+  EXPECT_EQ(data, GetBytes(*message));
+
+  message = Serialize("world");
+  server.Write("/chatter", "std_msgs/msg/String", message, rclcpp::Time(43));
+  std::tie(opcode, payload) = client.Receive();
+  std::tie(subscription_id, timestamp, data) = ParseMessageData(payload);
+  EXPECT_EQ(timestamp, 43u);
+  EXPECT_EQ(data, GetBytes(*message));
+}
+
+TEST(FoxgloveServer, RateLimiting) {
+  FoxgloveServerParams params = MakeLocalParams();
+  params.max_rate_per_client = 4.0;
+  FoxgloveServer server(params);
+
+  TestClient client(server.port(), "foxglove.websocket.v1");
+  client.Receive();  // server info
+  server.Write("/chatter", "std_msgs/msg/String", Serialize("first"),
+               rclcpp::Time(1));
+  const std::string advertisement = client.Receive().second;
+  client.SendText(
+      "{\"op\":\"subscribe\",\"subscriptions\":[{\"id\":1,\"channelId\":" +
+      std::to_string(GetFirstChannelId(advertisement)) + "}]}");
+  client.Receive();  // first message
+  const auto start = std::chrono::steady_clock::now();
+
+  // Messages in between are dropped, and the latest is delayed.
+  server.Write("/chatter", "std_msgs/msg/String", Serialize("second"),
+               rclcpp::Time(2));
+  const auto last_message = Serialize("third");
+  server.Write("/chatter", "std_msgs/msg/String", last_message,
+               rclcpp::Time(3));
+  const auto [subscription_id, timestamp, data] =
+      ParseMessageData(client.Receive().second);
+  const std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+  EXPECT_EQ(timestamp, 3u);
+  EXPECT_EQ(data, GetBytes(*last_message));
+  EXPECT_GT(elapsed.count(), 0.15);
+}
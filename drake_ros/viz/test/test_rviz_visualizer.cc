@@ -0,0 +1,154 @@
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include <drake/common/value.h>
+#include <drake/geometry/geometry_frame.h>
+#include <drake/geometry/geometry_instance.h>
+#include <drake/geometry/scene_graph.h>
+#include <drake/geometry/shape_specification.h>
+#include <drake/math/rigid_transform.h>
+#include <drake/systems/framework/diagram_builder.h>
+#include <drake/systems/primitives/constant_value_source.h>
+#include <drake_ros/core/drake_ros.h>
+#include <drake_ros/core/message_sink_interface.h>
+#include <drake_ros/core/ros_interface_system.h>
+#include <gtest/gtest.h>
+#include <rclcpp/serialization.hpp>
+#include <tf2_msgs/msg/tf_message.hpp>
+#include <visualization_msgs/msg/marker_array.hpp>
+
+#include "drake_ros/viz/rviz_visualizer.h"
+
+using drake_ros::core::DrakeRos;
+using drake_ros::core::MessageSinkInterface;
+using drake_ros::core::RosInterfaceSystem;
+using drake_ros::viz::RvizVisualizer;
+using drake_ros::viz::RvizVisualizerParams;
+
+namespace {
+// A message sink that keeps the latest message written on each topic.
+class RecordingSink final : public MessageSinkInterface {
+ public:
+  void Write(const std::string& topic_name, const std::string& type_name,
+             std::shared_ptr<const rclcpp::SerializedMessage> message,
+             const rclcpp::Time& time) override {
+    type_names[topic_name] = type_name;
+    messages[topic_name] = std::move(message);
+    times[topic_name] = time;
+  }
+
+  std::map<std::string, std::string> type_names;
+  std::map<std::string, std::shared_ptr<const rclcpp::SerializedMessage>>
+      messages;
+  std::map<std::string, rclcpp::Time> times;
+};
+
+template <typename MessageT>
+MessageT Deserialize(const rclcpp::SerializedMessage& serialized_message) {
+  MessageT message;
+  rclcpp::Serialization<MessageT>().deserialize_message(&serialized_message,
+                                                        &message);
+  return message;
+}
+}  // namespace
+
+TEST(RvizVisualizer, MessageSinks) {
+  drake_ros::core::init();
+
+  drake::systems::DiagramBuilder<double> builder;
+
+  auto system_ros = builder.AddSystem<RosInterfaceSystem>(
+      std::make_unique<DrakeRos>("rviz_visualizer"));
+
+  auto scene_graph = builder.AddSystem<drake::geometry::SceneGraph>();
+  const drake::geometry::SourceId source_id =
+      scene_graph->RegisterSource("test_source");
+  const drake::geometry::FrameId frame_id = scene_graph->RegisterFrame(
+      source_id, drake::geometry::GeometryFrame("base_link"));
+  const drake::geometry::GeometryId geometry_id =
+      scene_graph->RegisterGeometry(
+          source_id, frame_id,
+          std::make_unique<drake::geometry::GeometryInstance>(
+              drake::math::RigidTransform<double>::Identity(),
+              std::make_unique<drake::geometry::Sphere>(1.), "sphere"));
+  scene_graph->AssignRole(source_id, geometry_id,
+                          drake::geometry::IllustrationProperties());
+  scene_graph->AssignRole(source_id, geometry_id,
+                          drake::geometry::ProximityProperties());
+
+  const drake::geometry::FramePoseVector<double> pose_vector{
+      {frame_id, drake::math::RigidTransform<double>(
+                     drake::Vector3<double>{1., 2., 3.})}};
+  auto pose_vector_source =
+      builder.AddSystem<drake::systems::ConstantValueSource>(
+          *drake::AbstractValue::Make(pose_vector));
+  builder.Connect(pose_vector_source->get_output_port(),
+                  scene_graph->get_source_pose_port(source_id));
+
+  RvizVisualizerParams params;
+  params.publish_triggers = {drake::systems::TriggerType::kForced};
+  auto visualizer = builder.AddSystem<RvizVisualizer>(
+      system_ros->get_ros_interface(), params);
+  builder.Connect(scene_graph->get_query_output_port(),
+                  visualizer->get_graph_query_input_port());
+
+  // Every publisher in the visualizer writes to the sink.
+  auto sink = std::make_shared<RecordingSink>();
+  visualizer->AddMessageSink(sink);
+
+  auto diagram = builder.Build();
+  auto context = diagram->CreateDefaultContext();
+  context->SetTime(2.);
+  diagram->ForcedPublish(*context);
+
+  ASSERT_EQ(sink->messages.size(), 3u);
+  EXPECT_EQ(sink->type_names["/scene_markers/visual"],
+            "visualization_msgs/msg/MarkerArray");
+  EXPECT_EQ(sink->type_names["/scene_markers/collision"],
+            "visualization_msgs/msg/MarkerArray");
+  EXPECT_EQ(sink->type_names["/tf"], "tf2_msgs/msg/TFMessage");
+  EXPECT_EQ(sink->times["/tf"].seconds(), 2.);
+
+  const auto visual_markers =
+      Deserialize<visualization_msgs::msg::MarkerArray>(
+          *sink->messages["/scene_markers/visual"]);
+  ASSERT_FALSE(visual_markers.markers.empty());
+  EXPECT_EQ(visual_markers.markers.back().type,
+            visualization_msgs::msg::Marker::SPHERE);
+
+  const auto collision_markers =
+      Deserialize<visualization_msgs::msg::MarkerArray>(
+          *sink->messages["/scene_markers/collision"]);
+  ASSERT_FALSE(collision_markers.markers.empty());
+  EXPECT_EQ(collision_markers.markers.back().type,
+            visualization_msgs::msg::Marker::SPHERE);
+
+  const auto tf =
+      Deserialize<tf2_msgs::msg::TFMessage>(*sink->messages["/tf"]);
+  ASSERT_EQ(tf.transforms.size(), 1u);
+  EXPECT_EQ(tf.transforms[0].header.frame_id, "world");
+  EXPECT_DOUBLE_EQ(tf.transforms[0].transform.translation.x, 1.);
+  EXPECT_DOUBLE_EQ(tf.transforms[0].transform.translation.y, 2.);
+  EXPECT_DOUBLE_EQ(tf.transforms[0].transform.translation.z, 3.);
+
+  EXPECT_TRUE(drake_ros::core::shutdown());
+}
+
+// Only available in Bazel.
+#ifndef _TEST_DISABLE_RMW_ISOLATION
+#include "rmw_isolation/rmw_isolation.h"
+
+int main(int argc, char* argv[]) {
+  const char* TEST_TMPDIR = std::getenv("TEST_TMPDIR");
+  if (TEST_TMPDIR != nullptr) {
+    std::string ros_home = std::string(TEST_TMPDIR) + "/.ros";
+    setenv("ROS_HOME", ros_home.c_str(), 1);
+    ros2::isolate_rmw_by_path(argv[0], TEST_TMPDIR);
+  }
+
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
+#endif
@@ -1,4 +1,10 @@
+#include <unistd.h>
+
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
 #include <memory>
+#include <set>
 #include <string>
 #include <utility>
 
@@ -15,6 +21,7 @@
 
 #include "drake_ros/viz/scene_markers_system.h"
 
+using drake_ros::viz::SceneMarkersParams;
 using drake_ros::viz::SceneMarkersSystem;
 
 static constexpr char kSourceName[] = "test";
@@ -581,3 +588,67 @@ using SingleGeometrySceneTestDetails = ::testing::Types<
 INSTANTIATE_TYPED_TEST_SUITE_P(SingleGeometrySceneMarkersTests,
                                SceneMarkersTest,
                                SingleGeometrySceneTestDetails);
+
+TEST(SceneMarkersSystem, PackageUris) {
+  namespace fs = std::filesystem;
+  const char* test_tmpdir = std::getenv("TEST_TMPDIR");
+  const fs::path root =
+      (test_tmpdir != nullptr ? fs::path(test_tmpdir)
+                              : fs::temp_directory_path()) /
+      ("test_scene_markers_" + std::to_string(getpid()));
+  const fs::path prefix = root / "install";
+  const fs::path index = prefix / "share/ament_index/resource_index/packages";
+  fs::create_directories(index);
+  std::ofstream(index / "foo").close();
+  fs::create_directories(prefix / "share/foo/meshes");
+  fs::create_directories(root / "elsewhere");
+  const fs::path package_mesh = prefix / "share/foo/meshes/box.obj";
+  const fs::path other_mesh = root / "elsewhere/box.obj";
+
+  // N.B. The ament index is crawled once per process, on first use.
+  setenv("AMENT_PREFIX_PATH", prefix.c_str(), 1);
+  setenv("XDG_CACHE_HOME", (root / "cache").c_str(), 1);
+
+  drake::systems::DiagramBuilder<double> builder;
+  auto scene_graph = builder.AddSystem<drake::geometry::SceneGraph>();
+  auto source_id = scene_graph->RegisterSource(kSourceName);
+  for (const fs::path& path : {package_mesh, other_mesh}) {
+    const drake::geometry::GeometryId geometry_id =
+        scene_graph->RegisterAnchoredGeometry(
+            source_id, std::make_unique<drake::geometry::GeometryInstance>(
+                           drake::math::RigidTransform<double>::Identity(),
+                           std::make_unique<drake::geometry::Mesh>(
+                               path.string(), 1.),
+                           path.string()));
+    scene_graph->AssignRole(source_id, geometry_id,
+                            drake::geometry::IllustrationProperties());
+  }
+
+  SceneMarkersParams params;
+  params.use_package_uris = true;
+  auto scene_markers = builder.AddSystem<SceneMarkersSystem>(params);
+  builder.Connect(scene_graph->get_query_output_port(),
+                  scene_markers->get_graph_query_input_port());
+  builder.ExportOutput(scene_markers->get_markers_output_port());
+
+  std::unique_ptr<drake::systems::Diagram<double>> diagram = builder.Build();
+  std::unique_ptr<drake::systems::Context<double>> context =
+      diagram->CreateDefaultContext();
+  const auto& marker_array =
+      diagram->get_output_port().Eval<visualization_msgs::msg::MarkerArray>(
+          *context);
+
+  // Meshes within ament packages are referenced by package URI, and all
+  // others by file URL.
+  std::set<std::string> mesh_resources;
+  for (const visualization_msgs::msg::Marker& marker : marker_array.markers) {
+    if (marker.type == visualization_msgs::msg::Marker::MESH_RESOURCE) {
+      mesh_resources.insert(marker.mesh_resource);
+    }
+  }
+  EXPECT_EQ(mesh_resources,
+            (std::set<std::string>{"package://foo/meshes/box.obj",
+                                   "file://" + other_mesh.string()}));
+
+  fs::remove_all(root);
+}
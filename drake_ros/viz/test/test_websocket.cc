@@ -0,0 +1,246 @@
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "internal_json.h"       // NOLINT(build/include)
+#include "internal_websocket.h"  // NOLINT(build/include)
+#include <gtest/gtest.h>
+
+using drake_ros::viz::internal::AppendWebSocketFrame;
+using drake_ros::viz::internal::AppendWebSocketFrameHeader;
+using drake_ros::viz::internal::ComputeSha1;
+using drake_ros::viz::internal::ComputeWebSocketAccept;
+using drake_ros::viz::internal::JsonValue;
+using drake_ros::viz::internal::ParseHttpRequest;
+using drake_ros::viz::internal::ParseJson;
+using drake_ros::viz::internal::QuoteJsonString;
+using drake_ros::viz::internal::WebSocketDecoder;
+using drake_ros::viz::internal::WebSocketMessage;
+using drake_ros::viz::internal::WebSocketOpcode;
+
+namespace {
+std::string ToHex(const std::array<uint8_t, 20>& digest) {
+  constexpr char kDigits[] = "0123456789abcdef";
+  std::string hex;
+  for (const uint8_t byte : digest) {
+    hex.push_back(kDigits[byte >> 4]);
+    hex.push_back(kDigits[byte & 0x0F]);
+  }
+  return hex;
+}
+
+std::string Base64(const std::string& data) {
+  return drake_ros::viz::internal::EncodeBase64(
+      reinterpret_cast<const uint8_t*>(data.data()), data.size());
+}
+
+// Returns a masked client frame, with the mask key used in RFC 6455
+// examples.
+std::string MakeMaskedFrame(uint8_t byte0, const std::string& payload) {
+  const char mask[4] = {0x37, static_cast<char>(0xfa), 0x21, 0x3d};
+  std::string frame;
+  frame.push_back(static_cast<char>(byte0));
+  frame.push_back(static_cast<char>(0x80 | payload.size()));
+  frame.append(mask, 4);
+  for (size_t i = 0; i < payload.size(); ++i) {
+    frame.push_back(payload[i] ^ mask[i % 4]);
+  }
+  return frame;
+}
+
+// Feeds `bytes` to a decoder and returns the first message it decodes, if
+// any. Sets `valid` to whether the stream was valid.
+std::optional<WebSocketMessage> Decode(const std::string& bytes,
+                                       bool* valid = nullptr,
+                                       size_t max_message_size = 1024) {
+  WebSocketDecoder decoder(max_message_size);
+  decoder.Feed(bytes.data(), bytes.size());
+  std::optional<WebSocketMessage> message;
+  const bool ok = decoder.Next(&message);
+  if (valid) {
+    *valid = ok;
+  }
+  return message;
+}
+}  // namespace
+
+// Test vectors from RFC 3174, section 7.3.
+TEST(WebSocket, Sha1) {
+  EXPECT_EQ(ToHex(ComputeSha1("")),
+            "da39a3ee5e6b4b0d3255bfef95601890afd80709");
+  EXPECT_EQ(ToHex(ComputeSha1("abc")),
+            "a9993e364706816aba3e25717850c26c9cd0d89d");
+  EXPECT_EQ(ToHex(ComputeSha1(
+                "abcdbcdecdefdefgefghfghighijhijkijkljklmjklmnlmnomnopnopq")),
+            "84983e441c3bd26ebaae4aa1f95129e5e54670f1");
+  EXPECT_EQ(ToHex(ComputeSha1(std::string(1000000, 'a'))),
+            "34aa973cd4c4daa4f61eeb2bdbad27316534016f");
+}
+
+// Test vectors from RFC 4648, section 10.
+TEST(WebSocket, Base64) {
+  EXPECT_EQ(Base64(""), "");
+  EXPECT_EQ(Base64("f"), "Zg==");
+  EXPECT_EQ(Base64("fo"), "Zm8=");
+  EXPECT_EQ(Base64("foo"), "Zm9v");
+  EXPECT_EQ(Base64("foob"), "Zm9vYg==");
+  EXPECT_EQ(Base64("fooba"), "Zm9vYmE=");
+  EXPECT_EQ(Base64("foobar"), "Zm9vYmFy");
+}
+
+// Handshake example from RFC 6455, section 1.3.
+TEST(WebSocket, Handshake) {
+  EXPECT_EQ(ComputeWebSocketAccept("dGhlIHNhbXBsZSBub25jZQ=="),
+            "s3pPLMBiTxaQ9kYGzzhZRbK+xOo=");
+
+  const std::optional<drake_ros::viz::internal::HttpRequest> request =
+      ParseHttpRequest(
+          "GET /chat HTTP/1.1\r\n"
+          "Host: server.example.com\r\n"
+          "Upgrade: websocket\r\n"
+          "Connection: Upgrade\r\n"
+          "Sec-WebSocket-Key:  dGhlIHNhbXBsZSBub25jZQ== \r\n"
+          "Sec-WebSocket-Version: 13");
+  ASSERT_TRUE(request.has_value());
+  EXPECT_EQ(request->method, "GET");
+  EXPECT_EQ(request->target, "/chat");
+  EXPECT_EQ(request->GetHeader("sec-websocket-key"),
+            "dGhlIHNhbXBsZSBub25jZQ==");
+  EXPECT_EQ(request->GetHeader("upgrade"), "websocket");
+  EXPECT_FALSE(request->GetHeader("origin").has_value());
+
+  EXPECT_FALSE(ParseHttpRequest("").has_value());
+  EXPECT_FALSE(ParseHttpRequest("GET\r\n").has_value());
+  EXPECT_FALSE(ParseHttpRequest("GET / HTTP/1.1\r\nHost\r\n").has_value());
+}
+
+// Framing examples from RFC 6455, section 5.7.
+TEST(WebSocket, EncodeFrames) {
+  std::string buffer;
+  AppendWebSocketFrame(WebSocketOpcode::kText, "Hello", &buffer);
+  EXPECT_EQ(buffer, std::string("\x81\x05Hello"));
+
+  buffer.clear();
+  AppendWebSocketFrame(WebSocketOpcode::kPing, "Hello", &buffer);
+  EXPECT_EQ(buffer, std::string("\x89\x05Hello"));
+
+  buffer.clear();
+  AppendWebSocketFrameHeader(WebSocketOpcode::kBinary, 256, &buffer);
+  EXPECT_EQ(buffer, std::string("\x82\x7E\x01\x00", 4));
+
+  buffer.clear();
+  AppendWebSocketFrameHeader(WebSocketOpcode::kBinary, 65536, &buffer);
+  EXPECT_EQ(buffer,
+            std::string("\x82\x7F\x00\x00\x00\x00\x00\x01\x00\x00", 10));
+}
+
+// Framing examples from RFC 6455, section 5.7.
+TEST(WebSocket, DecodeFrames) {
+  // A single-frame masked text message.
+  std::optional<WebSocketMessage> message =
+      Decode("\x81\x85\x37\xfa\x21\x3d\x7f\x9f\x4d\x51\x58");
+  ASSERT_TRUE(message.has_value());
+  EXPECT_EQ(message->opcode, WebSocketOpcode::kText);
+  EXPECT_EQ(message->payload, "Hello");
+
+  // A masked pong.
+  message = Decode("\x8a\x85\x37\xfa\x21\x3d\x7f\x9f\x4d\x51\x58");
+  ASSERT_TRUE(message.has_value());
+  EXPECT_EQ(message->opcode, WebSocketOpcode::kPong);
+  EXPECT_EQ(message->payload, "Hello");
+
+  // A fragmented text message, with a ping in between fragments, fed one
+  // byte at a time.
+  const std::string bytes = MakeMaskedFrame(0x01, "Hel") +
+                            MakeMaskedFrame(0x89, "") +
+                            MakeMaskedFrame(0x80, "lo");
+  WebSocketDecoder decoder(1024);
+  std::vector<WebSocketMessage> messages;
+  for (const char byte : bytes) {
+    decoder.Feed(&byte, 1);
+    std::optional<WebSocketMessage> next;
+    ASSERT_TRUE(decoder.Next(&next));
+    if (next) {
+      messages.push_back(*next);
+    }
+  }
+  ASSERT_EQ(messages.size(), 2u);
+  EXPECT_EQ(messages[0].opcode, WebSocketOpcode::kPing);
+  EXPECT_EQ(messages[1].opcode, WebSocketOpcode::kText);
+  EXPECT_EQ(messages[1].payload, "Hello");
+}
+
+TEST(WebSocket, RejectInvalidFrames) {
+  bool valid = true;
+  // Unmasked client frames.
+  EXPECT_FALSE(Decode("\x81\x05Hello", &valid).has_value());
+  EXPECT_FALSE(valid);
+  // Reserved bits without negotiated extensions.
+  Decode(MakeMaskedFrame(0xC1, "Hello"), &valid);
+  EXPECT_FALSE(valid);
+  // Fragmented control frames.
+  Decode(MakeMaskedFrame(0x09, "Hello"), &valid);
+  EXPECT_FALSE(valid);
+  // Continuation frames with nothing to continue.
+  Decode(MakeMaskedFrame(0x80, "Hello"), &valid);
+  EXPECT_FALSE(valid);
+  // Reserved opcodes.
+  Decode(MakeMaskedFrame(0x83, "Hello"), &valid);
+  EXPECT_FALSE(valid);
+  Decode(MakeMaskedFrame(0x8B, "Hello"), &valid);
+  EXPECT_FALSE(valid);
+  // Messages over the size limit.
+  Decode(MakeMaskedFrame(0x81, "Hello"), &valid, 4);
+  EXPECT_FALSE(valid);
+  // Incomplete frames are not invalid, just pending.
+  EXPECT_FALSE(Decode("\x81\x85\x37\xfa", &valid).has_value());
+  EXPECT_TRUE(valid);
+}
+
+TEST(Json, Parse) {
+  const std::optional<JsonValue> value = ParseJson(
+      R"( {"op": "subscribe", "subscriptions": [{"id": 1, "channelId": 2}],)"
+      R"( "flag": true, "none": null, "text": "a\"b\\c\u00e9\ud83d\ude00"} )");
+  ASSERT_TRUE(value.has_value());
+  ASSERT_EQ(value->type, JsonValue::Type::kObject);
+  ASSERT_NE(value->Find("op"), nullptr);
+  EXPECT_EQ(value->Find("op")->string, "subscribe");
+  const JsonValue* subscriptions = value->Find("subscriptions");
+  ASSERT_NE(subscriptions, nullptr);
+  ASSERT_EQ(subscriptions->type, JsonValue::Type::kArray);
+  ASSERT_EQ(subscriptions->array.size(), 1u);
+  ASSERT_NE(subscriptions->array[0].Find("channelId"), nullptr);
+  EXPECT_EQ(subscriptions->array[0].Find("channelId")->number, 2.0);
+  EXPECT_EQ(value->Find("flag")->type, JsonValue::Type::kBool);
+  EXPECT_TRUE(value->Find("flag")->boolean);
+  EXPECT_EQ(value->Find("none")->type, JsonValue::Type::kNull);
+  EXPECT_EQ(value->Find("text")->string,
+            "a\"b\\c\xc3\xa9\xf0\x9f\x98\x80");
+  EXPECT_EQ(value->Find("missing"), nullptr);
+}
+
+TEST(Json, RejectMalformed) {
+  EXPECT_FALSE(ParseJson("").has_value());
+  EXPECT_FALSE(ParseJson("{").has_value());
+  EXPECT_FALSE(ParseJson("{\"a\": 1,}").has_value());
+  EXPECT_FALSE(ParseJson("[1] [2]").has_value());
+  EXPECT_FALSE(ParseJson("\"\\x\"").has_value());
+  // Unpaired surrogates.
+  EXPECT_FALSE(ParseJson("\"\\ud83d\"").has_value());
+  // Nesting too deep.
+  EXPECT_FALSE(
+      ParseJson(std::string(1000, '[') + std::string(1000, ']')).has_value());
+}
+
+TEST(Json, Quote) {
+  EXPECT_EQ(QuoteJsonString("plain"), "\"plain\"");
+  EXPECT_EQ(QuoteJsonString("a\"b\\c\nd\te\x01"),
+            "\"a\\\"b\\\\c\\nd\\te\\u0001\"");
+  // Quoted strings round trip.
+  const std::string text = "x\"\\\r\n\x1f";
+  const std::optional<JsonValue> value = ParseJson(QuoteJsonString(text));
+  ASSERT_TRUE(value.has_value());
+  EXPECT_EQ(value->string, text);
+}